@@ -0,0 +1,490 @@
+/*!
+ * @file        tsc_telemetry.c
+ *
+ * @brief       Linux host tool to record and decode the TSC telemetry stream
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-01-16
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/*
+ * Build:   gcc -O2 -Wall -o tsc_telemetry tsc_telemetry.c
+ *
+ * Usage:   tsc_telemetry [-d vid:pid] [-o file.csv] [-r file.bin]
+ *          tsc_telemetry -p file.bin [-o file.csv]
+ *
+ *          -d  USB device, default 314b:03e9 (Geehy HID example)
+ *          -o  Decoded records (CSV), default stdout
+ *          -r  Also record the raw stream, to be decoded later with -p
+ *          -p  Decode a raw stream recorded with -r instead of the device
+ *
+ * The device is opened with usbfs (/dev/bus/usb), which needs the read/write
+ * access to the device node, e.g. a udev rule or root. Only the telemetry
+ * interface is claimed, the HID keyboard keeps working.
+ * Ctrl+C stops the stream and prints the number of lost records.
+ */
+
+/* Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <errno.h>
+#include <sys/ioctl.h>
+#include <linux/usbdevice_fs.h>
+
+/* USB device */
+#define TELEM_VID               0x314B
+#define TELEM_PID               0x03E9
+#define TELEM_ITF               1
+#define TELEM_EP_IN             0x82
+#define TELEM_EP_OUT            0x02
+#define TELEM_TIMEOUT_MS        500
+
+/* Commands of the telemetry interface */
+#define TELEM_CMD_STREAM_STOP   0x00
+#define TELEM_CMD_STREAM_START  0x01
+
+/* Record: sync, size, seq, tick (2), channels, objects, 4 bytes per channel, 1 byte per object, checksum */
+#define TELEM_SYNC              0xA5
+#define TELEM_HEADER_SIZE       7
+#define TELEM_RECORD_SIZE(ch, obj)  (TELEM_HEADER_SIZE + (4 * (ch)) + (obj) + 1)
+
+/* Decoder state */
+typedef struct
+{
+    uint8_t  buffer[512];
+    uint32_t length;
+    uint32_t records;
+    uint32_t lost;
+    uint32_t resync;
+    int      seq;
+    int      nbChannels;
+    int      nbObjects;
+    FILE     *csv;
+} TELEM_DECODER_T;
+
+static volatile sig_atomic_t telemStop = 0;
+
+/*!
+ * @brief       Stop the recording on Ctrl+C
+ *
+ * @param       sig: signal number
+ *
+ * @retval      None
+ */
+static void Telem_StopHandler(int sig)
+{
+    (void)sig;
+    telemStop = 1;
+}
+
+/*!
+ * @brief       Read a numeric sysfs attribute of an USB device
+ *
+ * @param       dev: device directory name
+ *
+ * @param       attr: attribute name
+ *
+ * @param       base: number base of the attribute
+ *
+ * @retval      Value, -1 if not readable
+ */
+static long Telem_ReadSysfs(const char *dev, const char *attr, int base)
+{
+    char path[512];
+    char text[32];
+    FILE *f;
+    long value = -1;
+
+    snprintf(path, sizeof(path), "/sys/bus/usb/devices/%s/%s", dev, attr);
+    f = fopen(path, "r");
+    if (f == NULL)
+    {
+        return -1;
+    }
+    if (fgets(text, sizeof(text), f) != NULL)
+    {
+        value = strtol(text, NULL, base);
+    }
+    fclose(f);
+
+    return value;
+}
+
+/*!
+ * @brief       Open the usbfs node of the first device matching vid:pid
+ *
+ * @param       vid: vendor id
+ *
+ * @param       pid: product id
+ *
+ * @retval      File descriptor, -1 if not found
+ */
+static int Telem_OpenDevice(long vid, long pid)
+{
+    DIR *dir;
+    struct dirent *entry;
+    char path[64];
+    long bus;
+    long dev;
+    int fd = -1;
+
+    dir = opendir("/sys/bus/usb/devices");
+    if (dir == NULL)
+    {
+        return -1;
+    }
+
+    while ((fd < 0) && ((entry = readdir(dir)) != NULL))
+    {
+        /* Interfaces (x-y:c.i) have no idVendor */
+        if ((Telem_ReadSysfs(entry->d_name, "idVendor", 16) != vid) ||
+            (Telem_ReadSysfs(entry->d_name, "idProduct", 16) != pid))
+        {
+            continue;
+        }
+
+        bus = Telem_ReadSysfs(entry->d_name, "busnum", 10);
+        dev = Telem_ReadSysfs(entry->d_name, "devnum", 10);
+        snprintf(path, sizeof(path), "/dev/bus/usb/%03ld/%03ld", bus, dev);
+
+        fd = open(path, O_RDWR);
+        if (fd < 0)
+        {
+            fprintf(stderr, "%s: %s\n", path, strerror(errno));
+        }
+    }
+    closedir(dir);
+
+    return fd;
+}
+
+/*!
+ * @brief       Bulk transfer on the telemetry interface
+ *
+ * @param       fd: usbfs file descriptor
+ *
+ * @param       ep: endpoint address
+ *
+ * @param       data: data buffer
+ *
+ * @param       length: data length
+ *
+ * @retval      Number of bytes transferred, -1 on error
+ */
+static int Telem_Bulk(int fd, unsigned int ep, void *data, unsigned int length)
+{
+    struct usbdevfs_bulktransfer bulk;
+
+    bulk.ep = ep;
+    bulk.len = length;
+    bulk.timeout = TELEM_TIMEOUT_MS;
+    bulk.data = data;
+
+    return ioctl(fd, USBDEVFS_BULK, &bulk);
+}
+
+/*!
+ * @brief       Send a command to the telemetry interface
+ *
+ * @param       fd: usbfs file descriptor
+ *
+ * @param       cmd: command
+ *
+ * @retval      0 if sent
+ */
+static int Telem_SendCmd(int fd, uint8_t cmd)
+{
+    return (Telem_Bulk(fd, TELEM_EP_OUT, &cmd, 1) == 1) ? 0 : -1;
+}
+
+/*!
+ * @brief       Write a decoded record in the CSV output
+ *
+ * @param       dec: decoder
+ *
+ * @param       rec: record
+ *
+ * @retval      None
+ */
+static void Telem_WriteCsv(TELEM_DECODER_T *dec, const uint8_t *rec)
+{
+    int nbChannels = rec[5];
+    int nbObjects = rec[6];
+    const uint8_t *p = &rec[TELEM_HEADER_SIZE];
+    int i;
+
+    /* Header of the columns, again if the layout changes */
+    if ((nbChannels != dec->nbChannels) || (nbObjects != dec->nbObjects))
+    {
+        dec->nbChannels = nbChannels;
+        dec->nbObjects = nbObjects;
+
+        fprintf(dec->csv, "seq,tick");
+        for (i = 0; i < nbChannels; i++)
+        {
+            fprintf(dec->csv, ",meas%d,delta%d", i, i);
+        }
+        for (i = 0; i < nbObjects; i++)
+        {
+            fprintf(dec->csv, ",state%d", i);
+        }
+        fprintf(dec->csv, "\n");
+    }
+
+    fprintf(dec->csv, "%u,%u", rec[2], rec[3] | (rec[4] << 8));
+    for (i = 0; i < nbChannels; i++)
+    {
+        fprintf(dec->csv, ",%u,%d", p[0] | (p[1] << 8), (int16_t)(p[2] | (p[3] << 8)));
+        p += 4;
+    }
+    for (i = 0; i < nbObjects; i++)
+    {
+        fprintf(dec->csv, ",%u", *p++);
+    }
+    fprintf(dec->csv, "\n");
+}
+
+/*!
+ * @brief       Decode the records of a piece of the stream
+ *
+ * @param       dec: decoder
+ *
+ * @param       data: stream bytes
+ *
+ * @param       length: number of bytes
+ *
+ * @retval      None
+ *
+ * @note        The records can be split between two calls. A byte which does not
+ *              start a valid record (sync, size and checksum) is skipped.
+ */
+static void Telem_Decode(TELEM_DECODER_T *dec, const uint8_t *data, uint32_t length)
+{
+    uint32_t pos = 0;
+    uint32_t size;
+    uint32_t i;
+    uint8_t sum;
+
+    while (length > 0)
+    {
+        size = sizeof(dec->buffer) - dec->length;
+        size = (length < size) ? length : size;
+        memcpy(&dec->buffer[dec->length], data, size);
+        dec->length += size;
+        data += size;
+        length -= size;
+
+        pos = 0;
+        while (dec->length - pos >= TELEM_HEADER_SIZE)
+        {
+            const uint8_t *rec = &dec->buffer[pos];
+
+            size = rec[1];
+            if ((rec[0] != TELEM_SYNC) || (size != (uint32_t)TELEM_RECORD_SIZE(rec[5], rec[6])))
+            {
+                dec->resync++;
+                pos++;
+                continue;
+            }
+
+            if (dec->length - pos < size)
+            {
+                break;
+            }
+
+            sum = 0;
+            for (i = 0; i < size; i++)
+            {
+                sum += rec[i];
+            }
+            if (sum != 0)
+            {
+                dec->resync++;
+                pos++;
+                continue;
+            }
+
+            /* Frame number gap: records dropped by the device */
+            if (dec->seq >= 0)
+            {
+                dec->lost += (uint8_t)(rec[2] - dec->seq - 1);
+            }
+            dec->seq = rec[2];
+            dec->records++;
+
+            Telem_WriteCsv(dec, rec);
+            pos += size;
+        }
+
+        memmove(dec->buffer, &dec->buffer[pos], dec->length - pos);
+        dec->length -= pos;
+    }
+}
+
+/*!
+ * @brief       Main program
+ *
+ * @param       argc: number of arguments
+ *
+ * @param       argv: arguments
+ *
+ * @retval      Exit status
+ */
+int main(int argc, char *argv[])
+{
+    TELEM_DECODER_T dec;
+    uint8_t data[4096];
+    const char *csvName = NULL;
+    const char *rawName = NULL;
+    const char *playName = NULL;
+    FILE *raw = NULL;
+    long vid = TELEM_VID;
+    long pid = TELEM_PID;
+    unsigned int itf = TELEM_ITF;
+    int fd = -1;
+    int length;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "d:o:r:p:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'd':
+                if (sscanf(optarg, "%lx:%lx", &vid, &pid) != 2)
+                {
+                    fprintf(stderr, "bad device %s\n", optarg);
+                    return 1;
+                }
+                break;
+
+            case 'o':
+                csvName = optarg;
+                break;
+
+            case 'r':
+                rawName = optarg;
+                break;
+
+            case 'p':
+                playName = optarg;
+                break;
+
+            default:
+                fprintf(stderr, "usage: %s [-d vid:pid] [-o file.csv] [-r file.bin] | -p file.bin [-o file.csv]\n", argv[0]);
+                return 1;
+        }
+    }
+
+    memset(&dec, 0, sizeof(dec));
+    dec.seq = -1;
+    dec.nbChannels = -1;
+    dec.csv = stdout;
+    if ((csvName != NULL) && ((dec.csv = fopen(csvName, "w")) == NULL))
+    {
+        perror(csvName);
+        return 1;
+    }
+
+    /* Decode a recorded stream */
+    if (playName != NULL)
+    {
+        if ((raw = fopen(playName, "rb")) == NULL)
+        {
+            perror(playName);
+            return 1;
+        }
+        while ((length = (int)fread(data, 1, sizeof(data), raw)) > 0)
+        {
+            Telem_Decode(&dec, data, (uint32_t)length);
+        }
+        fclose(raw);
+        fprintf(stderr, "%u records, %u lost, %u bytes skipped\n", dec.records, dec.lost, dec.resync);
+        return 0;
+    }
+
+    if ((rawName != NULL) && ((raw = fopen(rawName, "wb")) == NULL))
+    {
+        perror(rawName);
+        return 1;
+    }
+
+    fd = Telem_OpenDevice(vid, pid);
+    if (fd < 0)
+    {
+        fprintf(stderr, "device %04lx:%04lx not found\n", vid, pid);
+        return 1;
+    }
+
+    if (ioctl(fd, USBDEVFS_CLAIMINTERFACE, &itf) < 0)
+    {
+        perror("claim interface");
+        return 1;
+    }
+
+    signal(SIGINT, Telem_StopHandler);
+    signal(SIGTERM, Telem_StopHandler);
+
+    if (Telem_SendCmd(fd, TELEM_CMD_STREAM_START) < 0)
+    {
+        perror("start");
+        return 1;
+    }
+
+    while (!telemStop)
+    {
+        length = Telem_Bulk(fd, TELEM_EP_IN, data, sizeof(data));
+        if (length < 0)
+        {
+            if (errno == ETIMEDOUT || errno == EINTR)
+            {
+                continue;
+            }
+            perror("read");
+            break;
+        }
+
+        if (raw != NULL)
+        {
+            fwrite(data, 1, (size_t)length, raw);
+        }
+        Telem_Decode(&dec, data, (uint32_t)length);
+    }
+
+    Telem_SendCmd(fd, TELEM_CMD_STREAM_STOP);
+    ioctl(fd, USBDEVFS_RELEASEINTERFACE, &itf);
+    close(fd);
+
+    if (raw != NULL)
+    {
+        fclose(raw);
+    }
+    if (dec.csv != stdout)
+    {
+        fclose(dec.csv);
+    }
+
+    fprintf(stderr, "%u records, %u lost, %u bytes skipped\n", dec.records, dec.lost, dec.resync);
+    return 0;
+}
@@ -46,14 +46,15 @@ extern "C" {
   @{
 */
 
-/** The number of channels (1..24) */
-#define TOUCH_TOTAL_CHANNELS (5)
-
-/** The number of blocks (1..8) */
-#define TOUCH_TOTAL_BLOCKS (3)
+/** The number of channels (1..24) and blocks (1..8)
+ *  - TOUCH_TOTAL_CHANNELS and TOUCH_TOTAL_BLOCKS are calculated from the
+ *    sensor description (TOUCH_SENSOR_CHANNELS) by tsc_sensor.h.
+ */
 
-/** The number of "Extended" TouchKeys (0..24) */
-#define TOUCH_TOTAL_TOUCHKEYS (5)
+/** The number of "Extended" TouchKeys (0..24)
+ *  - One TouchKey per channel of TOUCH_SENSOR_KEYS
+ */
+#define TOUCH_TOTAL_TOUCHKEYS (0 TOUCH_SENSOR_KEYS(TSC_SNS_X_ONE))
 
 /** The number of "Basic" TouchKeys (0..24) */
 #define TOUCH_TOTAL_TOUCHKEYS_B (0)
@@ -64,10 +65,19 @@ extern "C" {
 /** The number of "Basic" Linear and Rotary sensors (0..24) */
 #define TOUCH_TOTAL_LINROTS_B (0)
 
+/** The number of Matrix sensors (0..1 in this example, 0..8 in the library)
+ *  - A Matrix of R rows and C columns uses R + C channels for R x C keys
+ *  - 1: a 2 x 2 Matrix (keys '1' to '4') is added on the TOUCH_SENSOR_MATRIX channels
+ *  - A Matrix reports one key at a time: two keys on different rows and
+ *    columns can not be told from their two ghost keys and are ignored.
+ *    Use TouchKeys for the keys that must be pressed together.
+ */
+#define TOUCH_TOTAL_MATRICES (0)
+
 /** The number of sensors/objects (1..24)
- *  - Count all TouchKeys, Linear and Rotary sensors
+ *  - Count all TouchKeys, Linear, Rotary and Matrix sensors
  */
-#define TOUCH_TOTAL_OBJECTS (5)
+#define TOUCH_TOTAL_OBJECTS (TOUCH_TOTAL_TOUCHKEYS + TOUCH_TOTAL_MATRICES)
 
 /**@} Common_Parameters_Number_Of_Elements */
 
@@ -94,8 +104,274 @@ extern "C" {
 /** Acquisition interrupt mode (0=No, 1=Yes)
  *  - If No the TSC interrupt is not used.
  *  - If Yes the TSC interrupt is used.
+ *  - Requires TOUCH_USE_DISCHARGE_TIMER.
+ */
+#define TOUCH_USE_ACQ_INTERRUPT (1)
+
+/** Depth of the acquisition Frame queue (2, 4, 8, 16)
+ *  - Used only when TOUCH_USE_ACQ_INTERRUPT is enabled.
+ *  - The TSC interrupt routine acquires all Blocks in sequence and stores a
+ *    complete Frame in the queue. One slot is always kept free.
+ */
+#define TOUCH_ACQ_FRAME_QUEUE (4)
+
+/** Scan rate divider of the idle channels (1..16)
+ *  - Used only when TOUCH_USE_ACQ_INTERRUPT is enabled.
+ *  - The bursts of each Frame are scheduled from the channel-to-group map.
+ *    Channels of the active Objects (proximity, detect, touch, calibration or
+ *    debounce) are acquired in every Frame. Channels of the idle Objects
+ *    (release, error) are acquired every TOUCH_SCAN_IDLE_DIVIDER Frames.
+ *  - If all Objects are idle all channels are acquired in every Frame.
+ *  - 1 = all channels are acquired in every Frame.
+ */
+#define TOUCH_SCAN_IDLE_DIVIDER (4)
+
+/** Group counters readout by DMA (0=No, 1=Yes)
+ *  - If No the TSC interrupt routine reads the counters of each channel.
+ *  - If Yes a memory-to-memory DMA transfer copies the 8 group counters in the
+ *    Frame after the TSC interrupt routine. Its transfer complete interrupt
+ *    pushes the Frame, the next burst waits the end of the copy. The channels
+ *    are extracted and the deltas calculated in a single pass when the Frame is read.
+ *  - The interrupt routine of the DMA1 channel must call TSC_Acq_ProcessDmaReadout().
+ *  - Compare both modes with TOUCH_USE_ACQ_CYCLE_COUNT.
+ *  - Requires TOUCH_USE_ACQ_INTERRUPT.
+ */
+#define TOUCH_USE_DMA_READOUT (0)
+
+/** DMA1 channel used for the counters readout (1..7)
+ *  - Used only when TOUCH_USE_DMA_READOUT is enabled.
+ *  - The channel must not be used by another peripheral.
+ */
+#define TOUCH_DMA_READOUT_CHANNEL (7)
+
+/** Channel data layout (0=Array of structures, 1=Structure of arrays)
+ *  - If 0 each TSC_Channel_Data_T holds Flag, Refer, RefRest, Delta and Meas.
+ *  - If 1 Meas, Refer and Delta are stored in contiguous arrays (TSC_ChArrays)
+ *    and TSC_Channel_Data_T only holds Flag and RefRest. The deltas of a Frame
+ *    are then calculated for all channels in a single loop.
+ *  - All Blocks must use the Channel Data array given by TOUCH_SOA_CHANNEL_DATA.
+ */
+#define TOUCH_USE_SOA (0)
+
+/** Channel Data array of the application
+ *  - Used only when TOUCH_USE_SOA is enabled.
+ */
+#define TOUCH_SOA_CHANNEL_DATA MyChannels_Data
+
+/** Filter bank on the measures (0=No, 1=Yes)
+ *  - If Yes each channel can use a chain of filters (median, adaptive IIR, Kalman,
+ *    slew rate limiter) selected with TSC_Filt_ConfigChannels().
+ *  - The filters are applied to the valid measures before the delta calculation.
+ */
+#define TOUCH_USE_FILTER_BANK (1)
+
+/** Maximum number of filters in a chain (1..4)
+ *  - Used only when TOUCH_USE_FILTER_BANK is enabled.
+ */
+#define TOUCH_FILTER_MAX_STAGES (2)
+
+/** Measure the CPU cycles of the TSC interrupt routine (0=No, 1=Yes)
+ *  - If Yes the SysTick counter is sampled at entry and exit of the routine.
+ *  - Used to compare the readout modes. Read the result with TSC_Acq_ReadCycles().
+ *  - The example prints the result on COM1 every second and warns when the
+ *    routine lasts as long as the discharge delay.
+ */
+#define TOUCH_USE_ACQ_CYCLE_COUNT (0)
+
+/** Save the calibration in flash and restore it after reset (0=No, 1=Yes)
+ *  - If Yes the References are saved in a reserved flash page by TSC_Snap_Save() and
+ *    restored by TSC_Snap_ProcessRestore() when the first frames match them, instead
+ *    of waiting the end of the calibration.
+ *  - The flash page must be excluded from the application area in the linker settings.
+ */
+#define TOUCH_USE_SNAPSHOT (1)
+
+/** Address of the flash page reserved for the calibration snapshot
+ *  - Used only when TOUCH_USE_SNAPSHOT is enabled.
+ *  - Default is the last 2KB page of a 128KB device.
+ */
+#define TOUCH_SNAPSHOT_PAGE_ADDR (0x0801F800)
+
+/** Size in bytes of the flash page reserved for the calibration snapshot
+ *  - Used only when TOUCH_USE_SNAPSHOT is enabled.
+ */
+#define TOUCH_SNAPSHOT_PAGE_SIZE (2048)
+
+/** Number of frames checked before restoring the snapshot (1..8)
+ *  - Used only when TOUCH_USE_SNAPSHOT is enabled.
+ *  - Must be lower than TOUCH_CALIB_SAMPLES + TOUCH_CALIB_DELAY.
  */
-#define TOUCH_USE_ACQ_INTERRUPT (0)
+#define TOUCH_SNAPSHOT_CHECK_SAMPLES (2)
+
+/** Maximum difference between a measure and the saved Reference to restore it (1..255)
+ *  - Used only when TOUCH_USE_SNAPSHOT is enabled.
+ *  - Should be lower than TOUCH_KEY_DETECT_IN_TH so a key touched at reset is calibrated.
+ */
+#define TOUCH_SNAPSHOT_MATCH_TH (50)
+
+/** Minimum Reference drift to write a new snapshot (0..255)
+ *  - Used only when TOUCH_USE_SNAPSHOT is enabled.
+ *  - A higher value reduces the flash wear.
+ */
+#define TOUCH_SNAPSHOT_SAVE_TH (8)
+
+/** Period in sec of the snapshot save by the application (1..63)
+ *  - Used only when TOUCH_USE_SNAPSHOT is enabled.
+ */
+#define TOUCH_SNAPSHOT_PERIOD (60)
+
+/** Press and release events of the objects (0=No, 1=Yes)
+ *  - If Yes TSC_Obj_ProcessGroup() updates the PressMask and ChangeMask of the group
+ *    and writes an event in a queue when an object is pressed or released.
+ *  - The application reads the events with TSC_Event_Read() instead of scanning
+ *    the state of all objects.
+ */
+#define TOUCH_USE_EVENT (1)
+
+/** Depth of the event queue (2, 4, 8, 16, 32, 64)
+ *  - Used only when TOUCH_USE_EVENT is enabled.
+ */
+#define TOUCH_EVENT_QUEUE_SIZE (16)
+
+/** Gesture recognition from the events (0=No, 1=Yes)
+ *  - Used only when TOUCH_USE_EVENT is enabled.
+ *  - If Yes the application gives the events to TSC_Gesture_ProcessEvent(), calls TSC_Gesture_Process()
+ *    once per frame and reads the taps, double taps, long presses, repeats and swipes with TSC_Gesture_Read().
+ */
+#define TOUCH_USE_GESTURE (1)
+
+/** Depth of the gesture queue (2, 4, 8, 16, 32, 64)
+ *  - Used only when TOUCH_USE_GESTURE is enabled.
+ */
+#define TOUCH_GESTURE_QUEUE_SIZE (8)
+
+/** Longest press of a tap in ms (1..10000)
+ */
+#define TOUCH_GESTURE_TAP_MS (250)
+
+/** Longest time between the two taps of a double tap in ms (0..10000)
+ *  - 0 = No double tap: the tap is sent at the release instead of at the end of this time.
+ */
+#define TOUCH_GESTURE_DOUBLE_TAP_MS (250)
+
+/** Press time of a long press in ms (0..10000)
+ *  - 0 = No long press and no repeat.
+ */
+#define TOUCH_GESTURE_LONG_PRESS_MS (800)
+
+/** Repeat period while the press is held after a long press in ms (0..10000)
+ *  - 0 = No repeat.
+ */
+#define TOUCH_GESTURE_REPEAT_MS (100)
+
+/** Longest press of a swipe on a Linear/Rotary sensor in ms (0..10000)
+ *  - 0 = No swipe.
+ */
+#define TOUCH_GESTURE_SWIPE_MS (400)
+
+/** Smallest move of a swipe in RawPosition unit (1..255)
+ */
+#define TOUCH_GESTURE_SWIPE_DIST (48)
+
+/** Low-power guard scan (0=No, 1=Yes)
+ *  - Requires TOUCH_USE_ACQ_INTERRUPT.
+ *  - If Yes, after TOUCH_LP_IDLE_SEC without any object in proximity, detect, touch,
+ *    calibration or debounce state, the Frames only hold the guard burst: all channel
+ *    IOs of each group ganged as one channel. A guard burst is started every
+ *    TOUCH_LP_SCAN_PERIOD ms by the timing tick and the CPU sleeps between them.
+ *  - The timing tick must be the update interrupt of TOUCH_DISCHARGE_TIMER: its
+ *    period is lengthened between the guard bursts (up to 65 ms with a 1MHz counter)
+ *    and TSC_Time_ProcessInterrupt() counts the elapsed ticks.
+ *  - The full scan restarts when the delta of a guard channel reaches TOUCH_LP_WAKE_TH.
+ *  - The current consumption has not been measured on the board. TSC_Acq_ReadScanDuty()
+ *    only gives the burst duty and the timer wake-ups as an indicator.
+ */
+#define TOUCH_USE_LOWPOWER (1)
+
+/** Idle time in sec before the guard scan (1..63)
+ *  - Used only when TOUCH_USE_LOWPOWER is enabled.
+ */
+#define TOUCH_LP_IDLE_SEC (10)
+
+/** Period in ms of the guard scan (1..1000)
+ *  - Used only when TOUCH_USE_LOWPOWER is enabled.
+ *  - Also the longest delay before a hand is detected.
+ */
+#define TOUCH_LP_SCAN_PERIOD (50)
+
+/** Delta of a guard channel restarting the full scan (1..255)
+ *  - Used only when TOUCH_USE_LOWPOWER is enabled.
+ *  - The guard channel sums the capacitance of all electrodes of a group.
+ */
+#define TOUCH_LP_WAKE_TH (10)
+
+/** Pulse generator settings tuning at startup (0=No, 1=Yes)
+ *  - If Yes TSC_Tune_Process() measures all channels with charge transfer timings from
+ *    the shortest to the longest and applies the fastest valid one instead of
+ *    TOUCH_TSC_CTPHSEL, TOUCH_TSC_CTPLSEL and TOUCH_TSC_PGCDFSEL.
+ *  - A timing is valid when all measures are within TOUCH_ACQ_MIN and TOUCH_ACQ_MAX
+ *    and the mean of each channel is at least TOUCH_TUNE_SNR times its peak to peak noise.
+ *  - With TOUCH_USE_SNAPSHOT the timing is saved with the calibration. When a snapshot
+ *    is found at startup its timing is applied and the tuning is skipped, so the saved
+ *    References can match. Erase the snapshot page to tune again.
+ */
+#define TOUCH_USE_TUNE (1)
+
+/** Number of acquisitions of each timing (2..64)
+ *  - Used only when TOUCH_USE_TUNE is enabled.
+ */
+#define TOUCH_TUNE_SAMPLES (8)
+
+/** Minimum ratio of the mean measure to the peak to peak noise (1..1000)
+ *  - Used only when TOUCH_USE_TUNE is enabled.
+ *  - A touch changes the measure by a few percent: 200 keeps the touch delta about
+ *    5 times above the noise.
+ */
+#define TOUCH_TUNE_SNR (200)
+
+/** Try the spread spectrum on the noisy timings (0=No, 1=Yes)
+ *  - Used only when TOUCH_USE_TUNE is enabled.
+ *  - The deviation is given by TOUCH_TSC_SSERRVSEL and TOUCH_TSC_SSCDFSEL.
+ */
+#define TOUCH_TUNE_USE_SS (1)
+
+/** TouchKeys error recovery (0=No, 1=Yes)
+ *  - If Yes, a TouchKey in Error state is turned off (no more acquired) and the other
+ *    objects are still processed. It is recalibrated after TOUCH_RECOV_DELAY_MIN sec,
+ *    the delay is doubled up to TOUCH_RECOV_DELAY_MAX at each new error before it has
+ *    been stable for TOUCH_RECOV_STABLE_SEC.
+ *  - The faults are read with TSC_Recovery_ReadFaults() and TSC_Recovery_Read().
+ */
+#define TOUCH_USE_RECOVERY (1)
+
+/** First recalibration delay in sec (1..63)
+ *  - Used only when TOUCH_USE_RECOVERY is enabled.
+ */
+#define TOUCH_RECOV_DELAY_MIN (1)
+
+/** Longest recalibration delay in sec (TOUCH_RECOV_DELAY_MIN..63)
+ *  - Used only when TOUCH_USE_RECOVERY is enabled.
+ */
+#define TOUCH_RECOV_DELAY_MAX (32)
+
+/** Time in sec without error after a recalibration to clear the fault (1..63)
+ *  - Used only when TOUCH_USE_RECOVERY is enabled.
+ */
+#define TOUCH_RECOV_STABLE_SEC (30)
+
+/** Per-frame telemetry records (0=No, 1=Yes)
+ *  - If Yes TSC_Telem_Write() packs the measure, delta and state of the objects
+ *    in a binary record after each frame, while the stream is started.
+ *  - The records are read from a ring buffer with TSC_Telem_Read(). A record which
+ *    does not fit in the ring buffer is dropped and counted.
+ */
+#define TOUCH_USE_TELEMETRY (1)
+
+/** Size in bytes of the telemetry ring buffer (64, 128, 256, 512, 1024 or 2048)
+ *  - Used only when TOUCH_USE_TELEMETRY is enabled.
+ *  - Must hold at least one record (8 + 4 * number of channels + number of objects).
+ */
+#define TOUCH_TELEM_BUFFER_SIZE (1024)
 
 /**@} Common_Parameters_Optional_Features */
 
@@ -223,6 +499,28 @@ extern "C" {
 
 /**@} Common_Parameters_Thresholds_For_Linear_Rotary */
 
+/** @addtogroup Common_Parameters_Thresholds_For_Matrix
+  @{
+*/
+
+/** Matrix Detect state input threshold of a row or a column (0..255)
+ *  - Enter Detect state if the delta of a row and of a column are above
+ */
+#define TOUCH_MATRIX_DETECT_IN_TH (60)
+
+/** Matrix Detect state output threshold of a row or a column (0..255)
+ *  - Exit Detect state if the delta of all rows or of all columns are below
+ */
+#define TOUCH_MATRIX_DETECT_OUT_TH (40)
+
+/** Matrix Re-Calibration threshold (0..255)
+ *  - @warning The value is inverted in the sensor state machine
+ *  - Enter Calibration state if the delta of a row or a column is below
+ */
+#define TOUCH_MATRIX_CALIB_TH (50)
+
+/**@} Common_Parameters_Thresholds_For_Matrix */
+
 /** @addtogroup Common_Parameters_Used_Linear_Rotary
   @{
 */
@@ -287,6 +585,33 @@ extern "C" {
  */
 #define TOUCH_LINROT_DIR_CHG_DEB (1)
 
+/** Centroid position engine (0..1)
+ *  - 0 = Not Used
+ *  - 1 = TSC_Linrot_CalcPosCentroid() can be used as CalcPosition method instead of TSC_Linrot_CalcPos()
+ *  - The centroid engine works with any number of channels and does not need the position offset tables.
+ *    It interpolates between the strongest channel and its two neighbours without any division.
+ */
+#define TOUCH_LINROT_USE_CENTROID (1)
+
+/** Centroid engine position resolution in number of bits (8..12)
+ *  - FinePosition is given on this number of bits, RawPosition and Position are derived from it.
+ */
+#define TOUCH_LINROT_POS_BITS (10)
+
+/** Centroid engine position smoothing (0..4)
+ *  - 0 = Not Used
+ *  - A first order filter is applied on the position with a weight of 1/2^TOUCH_LINROT_SMOOTHING
+ *    for the new position.
+ *  - A High value will result in a stable position but slower to follow the finger.
+ */
+#define TOUCH_LINROT_SMOOTHING (2)
+
+/** Centroid engine velocity estimation (0..1)
+ *  - 0 = Not Used
+ *  - 1 = The mean of the last position changes can be read with TSC_Linrot_ReadVelocity()
+ */
+#define TOUCH_LINROT_USE_VELOCITY (1)
+
 /**@} Common_Parameters_Position_Linear_Rotary */
 
 /** @addtogroup Common_Parameters_Debounce_Counters
@@ -303,7 +628,7 @@ extern "C" {
  *  - A Low value will result in a higher sensitivity during the detection but with less noise filtering.
  *  - A High value will result in improving the system noise immunity but will increase the system response time.
  */
-#define TOUCH_DEBOUNCE_DETECT (3)
+#define TOUCH_DEBOUNCE_DETECT (2)
 
 /** Release state debounce in samples unit (0..63)
  *  - A Low value will result in a higher sensitivity during the end-detection but with less noise filtering.
@@ -323,6 +648,54 @@ extern "C" {
  */
 #define TOUCH_DEBOUNCE_ERROR (3)
 
+/** Adapt the Detect state debounce to the measured noise (0=No, 1=Yes)
+ *  - If Yes the delta variance of each TouchKey is tracked in the Release state and
+ *    the Detect debounce is chosen between TOUCH_DEBOUNCE_DETECT_MIN and
+ *    TOUCH_DEBOUNCE_DETECT_MAX instead of using TOUCH_DEBOUNCE_DETECT.
+ *  - A clean channel is detected in the first sample above the threshold, one sample
+ *    is added each time the noise standard deviation doubles.
+ *  - Defaults: each debounce sample adds one Frame of latency. With a gaussian
+ *    noise of standard deviation s, a sample crosses the threshold with the
+ *    probability Q(th/s) and a false detection needs (debounce + 1) such samples:
+ *      th/s = 8 -> debounce 0 -> 6e-16 per sample
+ *      th/s = 4 -> debounce 1 -> 1e-9
+ *      th/s = 2 -> debounce 2 -> 1e-5
+ *      th/s = 1 -> debounce 3 -> 6e-4
+ *    TOUCH_DEBOUNCE_SNR = 8 keeps the first sample detection for channels where
+ *    a false detection is negligible. TOUCH_DEBOUNCE_DETECT_MAX = 4 limits the
+ *    added latency to twice TOUCH_DEBOUNCE_DETECT: below th/s = 1 more samples
+ *    do not help much and the thresholds must be raised instead.
+ *  - The samples are assumed independent: with a smoothing filter on the measures
+ *    they are correlated and the false detection rate is higher.
+ *  - Not verified on recorded traces.
+ */
+#define TOUCH_USE_ADAPTIVE_DEBOUNCE (1)
+
+/** Detect state debounce on a clean channel in samples unit (0..63)
+ *  - Used only when TOUCH_USE_ADAPTIVE_DEBOUNCE is enabled.
+ */
+#define TOUCH_DEBOUNCE_DETECT_MIN (0)
+
+/** Detect state debounce on a noisy channel in samples unit (0..63)
+ *  - Used only when TOUCH_USE_ADAPTIVE_DEBOUNCE is enabled.
+ *  - Must be greater or equal to TOUCH_DEBOUNCE_DETECT_MIN.
+ */
+#define TOUCH_DEBOUNCE_DETECT_MAX (4)
+
+/** Signal to noise ratio for the minimum Detect debounce (1..15)
+ *  - Ratio between the Detect in threshold and the delta standard deviation above
+ *    which TOUCH_DEBOUNCE_DETECT_MIN is used.
+ *  - Used only when TOUCH_USE_ADAPTIVE_DEBOUNCE is enabled.
+ */
+#define TOUCH_DEBOUNCE_SNR (8)
+
+/** Weight of the noise estimation filter (1..6)
+ *  - The variance follows 1/2^N of each new sample.
+ *  - TOUCH_DEBOUNCE_DETECT is used during the first 2^N samples after calibration.
+ *  - Used only when TOUCH_USE_ADAPTIVE_DEBOUNCE is enabled.
+ */
+#define TOUCH_DEBOUNCE_NOISE_WEIGHT (4)
+
 /**@} Common_Parameters_Debounce_Counters */
 
 /** @addtogroup Common_Parameters_Environment_Change_System (ECS)
@@ -344,6 +717,25 @@ extern "C" {
  */
 #define TOUCH_ECS_DELAY (500)
 
+/** Spread the ECS over the frames (0=No, 1=Yes)
+ *  - If No the application calls TSC_Ecs_Process() every TOUCH_ECS_PERIOD msec and
+ *    all the References are updated at once.
+ *  - If Yes the application calls TSC_Ecs_ProcessSlice() after each frame and only
+ *    the channels whose update is due are processed.
+ */
+#define TOUCH_ECS_INCREMENTAL (1)
+
+/** Environment Change System period in msec (16..1000)
+ *  - Each Reference is updated once per period.
+ */
+#define TOUCH_ECS_PERIOD (100)
+
+/** Maximum number of References updated by one TSC_Ecs_ProcessSlice() call (1..32)
+ *  - Used only when TOUCH_ECS_INCREMENTAL is enabled.
+ *  - Limits the catch up after a long time without frame.
+ */
+#define TOUCH_ECS_MAX_SLICE (2)
+
 /**@} Common_Parameters_Environment_Change_System */
 
 /** @addtogroup Common_Parameters_Detection_Time_Out (DTO)
@@ -361,7 +753,7 @@ extern "C" {
  *@note The DTO can be changed in run-time by the application only if the
  *      default value is between 1 and 63.
  */
-#define TOUCH_DTO (0)
+#define TOUCH_DTO (10)
 
 /**@} Common_Parameters_Detection_Time_Out */
 
@@ -383,13 +775,34 @@ extern "C" {
  */
 #define TOUCH_TICK_FREQ (1000)
 
-/** Delay for discharging Cx and Cs capacitors (0..65535)
- *  - The value corresponds to the Softdelay function parameter.
- *  -  500 gives around  53 delay whatever HCLK
- *  - 1000 gives around 106 delay whatever HCLK
- *  - 2000 gives around 210 delay whatever HCLK
+/** Delay for discharging Cx and Cs capacitors in microseconds (1..1000)
+ *  - Without discharge timer the delay is a software loop calibrated with the
+ *    SysTick counter at startup, whatever HCLK.
+ */
+#define TOUCH_DELAY_DISCHARGE_US (106)
+
+/** Discharge delay measured by a hardware timer (0=No, 1=Yes)
+ *  - Requires TOUCH_USE_ACQ_INTERRUPT, and is required by it: the TSC interrupt
+ *    routine never waits the discharge delay in a software loop.
+ *  - If No the discharge delay is only used by the polling acquisition.
+ *  - If Yes the discharge starts at the end of each burst and the next burst is
+ *    started by the compare 1 interrupt of TOUCH_DISCHARGE_TIMER. The CPU is
+ *    free to process the Objects during the discharge.
+ *  - The timer must run with a 1MHz counter clock and its interrupt routine must
+ *    call TSC_Acq_ProcessDischarge() with a lower priority than the TSC interrupt.
  */
-#define TOUCH_DELAY_DISCHARGE_ALL (1000)
+#define TOUCH_USE_DISCHARGE_TIMER (1)
+
+/** Timer used for the discharge delay
+ *  - Used only when TOUCH_USE_DISCHARGE_TIMER is enabled.
+ *  - The compare channel 1 of the timer must not be used by the application.
+ */
+#define TOUCH_DISCHARGE_TIMER TMR14
+
+/** Counter period of the discharge timer (auto-reload value + 1)
+ *  - Used only when TOUCH_USE_DISCHARGE_TIMER is enabled.
+ */
+#define TOUCH_DISCHARGE_TIMER_PERIOD (1000)
 
 /**@} Common_Parameters_Miscellaneous_Parameters */
 
@@ -399,62 +812,66 @@ extern "C" {
 
 /** TSC GPIOs Configuration selection (0..1)
  *  - 0: Manual. The TSC GPIOs configuration must be done by the application code.
- *  - 1: Automatic. The TOUCH_TSC_GROUPx_IOy parameters below must be filled up.
- *  The TSC GPIOs configuration is automatically done by the Touch driver.
+ *  - 1: Automatic. The TSC GPIOs configuration is automatically done by the Touch driver
+ *       from the sensor description below.
  */
 #define TOUCH_TSC_GPIO_CONFIG (1)
 
 /** DO NOT CHANGE THESE VALUES */
-/** These defines must be applied to the TOUCH_TSC_GROUPx_IOy parameters below */
+/** Types of the TOUCH_TSC_GROUPx_IOy parameters generated by tsc_sensor.h */
 #define NU      (0) //!< Not Used IO
 #define CHANNEL (1) //!< Channel IO
 #define SHIELD  (2) //!< Shield IO (= Channel IO but not acquired)
 #define SAMPCAP (3) //!< Sampling Capacitor IO
 
-/** If TOUCH_TSC_GPIO_CONFIG=0 these parameters are ignored */
-/** If TOUCH_TSC_GPIO_CONFIG=1 assign each TOUCH_TSC_GROUPx_IOy parameters below */
-
-#define TOUCH_TSC_GROUP1_IO1  SAMPCAP       //!< PA0
-#define TOUCH_TSC_GROUP1_IO2  CHANNEL       //!< PA1
-#define TOUCH_TSC_GROUP1_IO3  NU       //!< PA2
-#define TOUCH_TSC_GROUP1_IO4  CHANNEL       //!< PA3
-
-#define TOUCH_TSC_GROUP2_IO1  SAMPCAP  //!< PA4
-#define TOUCH_TSC_GROUP2_IO2  CHANNEL  //!< PA5
-#define TOUCH_TSC_GROUP2_IO3  CHANNEL  //!< PA6
-#define TOUCH_TSC_GROUP2_IO4  CHANNEL       //!< PA7
-
-#define TOUCH_TSC_GROUP3_IO1  NU  //!< PC5
-#define TOUCH_TSC_GROUP3_IO2  NU  //!< PB0
-#define TOUCH_TSC_GROUP3_IO3  NU  //!< PB1
-#define TOUCH_TSC_GROUP3_IO4  NU       //!< PB2
-
-#define TOUCH_TSC_GROUP4_IO1  NU       //!< PA9
-#define TOUCH_TSC_GROUP4_IO2  NU       //!< PA10
-#define TOUCH_TSC_GROUP4_IO3  NU       //!< PA11
-#define TOUCH_TSC_GROUP4_IO4  NU       //!< PA12
-
-#define TOUCH_TSC_GROUP5_IO1  NU       //!< PB3
-#define TOUCH_TSC_GROUP5_IO2  NU       //!< PB4
-#define TOUCH_TSC_GROUP5_IO3  NU       //!< PB6
-#define TOUCH_TSC_GROUP5_IO4  NU       //!< PB7
-
-#define TOUCH_TSC_GROUP6_IO1  NU       //!< PB11
-#define TOUCH_TSC_GROUP6_IO2  NU       //!< PB12
-#define TOUCH_TSC_GROUP6_IO3  NU       //!< PB13
-#define TOUCH_TSC_GROUP6_IO4  NU       //!< PB14
-
-/** Warning: this group is available on some devices only */
-#define TOUCH_TSC_GROUP7_IO1  NU       //!< PE2
-#define TOUCH_TSC_GROUP7_IO2  NU       //!< PE3
-#define TOUCH_TSC_GROUP7_IO3  NU       //!< PE4
-#define TOUCH_TSC_GROUP7_IO4  NU       //!< PE5
-
-/** Warning: this group is available on some devices only */
-#define TOUCH_TSC_GROUP8_IO1  NU       //!< PD12
-#define TOUCH_TSC_GROUP8_IO2  NU       //!< PD13
-#define TOUCH_TSC_GROUP8_IO3  NU       //!< PD14
-#define TOUCH_TSC_GROUP8_IO4  NU       //!< PD15
+/** Sensor description
+ *  - X(Channel, Group, IO): Channel is the index in the Channel Data array (0..N-1).
+ *  - Channel, Group and IO must be decimal numbers.
+ *  - The channel and group masks, the Blocks and the TOUCH_TSC_GROUPx_IOy
+ *    parameters are generated from this list.
+ *
+ *  Group/IO to GPIO mapping:
+ *  - G1: PA0..PA3     - G2: PA4..PA7     - G3: PC5, PB0..PB2 - G4: PA9..PA12
+ *  - G5: PB3, PB4, PB6, PB7               - G6: PB11..PB14    - G7: PE2..PE5
+ *  - G8: PD12..PD15
+ */
+#define TOUCH_SENSOR_CHANNELS(X) \
+    TOUCH_SENSOR_KEYS(X) \
+    TOUCH_SENSOR_MATRIX(X)
+
+/** TouchKeys: X(Channel, Group, IO) */
+#define TOUCH_SENSOR_KEYS(X) \
+    X(0, 1, 4) /*!< TouchKey 0: PA3 */ \
+    X(1, 1, 2) /*!< TouchKey 1: PA1 */ \
+    X(2, 2, 2) /*!< TouchKey 2: PA5 */ \
+    X(3, 2, 3) /*!< TouchKey 3: PA6 */ \
+    X(4, 2, 4) /*!< TouchKey 4: PA7 */
+
+#if TOUCH_TOTAL_MATRICES > 0
+/** Matrix lines: X(Channel, Group, IO), the rows then the columns after the TouchKeys */
+#define TOUCH_SENSOR_MATRIX(X) \
+    X(5, 3, 2) /*!< Row 0: PB0 */ \
+    X(6, 3, 3) /*!< Row 1: PB1 */ \
+    X(7, 3, 4) /*!< Column 0: PB2 */ \
+    X(8, 5, 2) /*!< Column 1: PB4 */
+
+/** Sampling capacitors: X(Group, IO) */
+#define TOUCH_SENSOR_SAMPCAPS(X) \
+    X(1, 1) /*!< PA0 */ \
+    X(2, 1) /*!< PA4 */ \
+    X(3, 1) /*!< PC5 */ \
+    X(5, 1) /*!< PB3 */
+#else
+#define TOUCH_SENSOR_MATRIX(X)
+
+/** Sampling capacitors: X(Group, IO) */
+#define TOUCH_SENSOR_SAMPCAPS(X) \
+    X(1, 1) /*!< PA0 */ \
+    X(2, 1) /*!< PA4 */
+#endif
+
+/** Shields: X(Group, IO) (optional) */
+#define TOUCH_SENSOR_SHIELDS(X)
 
 /**@} APM32F0xx_Parameters_GPIOs_Configuration */
 
@@ -544,6 +961,7 @@ extern "C" {
 /**@} APM32F0xx_Parameters_Spread_Spectrum */
 
 /** Must be placed last */
+#include "tsc_sensor.h"
 #include "tsc_check.h"
 
 /**@} end of group TSC_Fuctions */
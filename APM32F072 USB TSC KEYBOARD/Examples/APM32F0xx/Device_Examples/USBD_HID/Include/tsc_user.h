@@ -45,49 +45,18 @@ extern "C" {
 /** @defgroup TSC_KeyLinearRotate_Macros Macros
   @{
 */
-#define CHANNEL_0_IO_MSK    (TSC_GROUP1_IO4)
-#define CHANNEL_0_GRP_MSK   (TSC_GROUP1)
-#define CHANNEL_0_SRC       (0) /*!< Index in source register (TSC->IOGXCR[]) */
-#define CHANNEL_0_DEST      (0) /*!< Index in destination result array */
-
-#define CHANNEL_1_IO_MSK    (TSC_GROUP1_IO2)
-#define CHANNEL_1_GRP_MSK   (TSC_GROUP1)
-#define CHANNEL_1_SRC       (0) /*!< Index in source register (TSC->IOGXCR[]) */
-#define CHANNEL_1_DEST      (1) /*!< Index in destination result array */
-
-#define CHANNEL_2_IO_MSK    (TSC_GROUP2_IO2)
-#define CHANNEL_2_GRP_MSK   (TSC_GROUP2)
-#define CHANNEL_2_SRC       (1) /*!< Index in source register (TSC->IOGXCR[]) */
-#define CHANNEL_2_DEST      (2) /*!< Index in destination result array */
-
-#define CHANNEL_3_IO_MSK    (TSC_GROUP2_IO3)
-#define CHANNEL_3_GRP_MSK   (TSC_GROUP2)
-#define CHANNEL_3_SRC       (1) /*!< Index in source register (TSC->IOGXCR[]) */
-#define CHANNEL_3_DEST      (3) /*!< Index in destination result array */
-
-#define CHANNEL_4_IO_MSK    (TSC_GROUP2_IO4)
-#define CHANNEL_4_GRP_MSK   (TSC_GROUP2)
-#define CHANNEL_4_SRC       (1) /*!< Index in source register (TSC->IOGXCR[]) */
-#define CHANNEL_4_DEST      (4) /*!< Index in destination result array */
-
-#define SHIELD_IO_MSK       (0)
-
-#define BLOCK_0_NUMCHANNELS      (2)
-#define BLOCK_0_MSK_CHANNELS     (CHANNEL_1_IO_MSK | CHANNEL_2_IO_MSK)
-#define BLOCK_0_MSK_GROUPS       (CHANNEL_1_GRP_MSK | CHANNEL_2_GRP_MSK)
-                                 
-#define BLOCK_1_NUMCHANNELS      (2)
-#define BLOCK_1_MSK_CHANNELS     (CHANNEL_0_IO_MSK | CHANNEL_4_IO_MSK)
-#define BLOCK_1_MSK_GROUPS       (CHANNEL_0_GRP_MSK |CHANNEL_4_GRP_MSK)
-
-#define BLOCK_2_NUMCHANNELS      (1)
-#define BLOCK_2_MSK_CHANNELS     (CHANNEL_3_IO_MSK)
-#define BLOCK_2_MSK_GROUPS       (CHANNEL_3_GRP_MSK)
+/* Channels, Blocks and GPIOs are generated from TOUCH_SENSOR_CHANNELS in tsc_config.h */
 /**@} end of group TSC_KeyLinearRotate_Macros*/
 
 #define TOUCHKEY_PRESS(Num) ((MyTouchKeys[(Num)].p_Data->StateId == TSC_STATEID_DETECT))
 #define TOUCHKEY_RELEASE(Num) ((MyTouchKeys[(Num)].p_Data->StateId == TSC_STATEID_RELEASE))
 
+/* Key sending the consumer controls (K4, no keyboard usage) */
+#define MEDIA_KEY_INDEX           (3)
+
+/* Size of the telemetry records sent in one USB transfer */
+#define TELEM_TX_SIZE             (256)
+
 typedef enum
 {
     TSC_TOUCH_K1 = 0x01,
@@ -105,13 +74,11 @@ enum
     HID_MOUSE_KEY_DOWN,
 };
 /* Timer tick */
-extern uint8_t cnt50ms ;
-extern uint8_t taskFlag ;
 extern uint8_t tscPressStatus ;
 extern uint16_t cntTick;
-extern __IO uint32_t Global_EOA;
 extern uint8_t keyRecord;
 extern uint8_t tscPressRecord;
+extern TSC_tTick_ms_T tscPressTick[];
 /** @defgroup TSC_KeyLinearRotate_Variables Variables
   @{
   */
@@ -135,8 +102,16 @@ void APM_EVAL_TMR14_Init(uint16_t period, uint16_t div);
 void TMR14_Isr(void);
 void MyKeys_ProcessOffState(void);
 void MyKeys_ProcessErrorState(void);
-void TSC_ReleaseHandler(void);
-void TSC_DetectHandler(void);
+uint8_t TSC_EventHandler(void);
+#if TOUCH_USE_GESTURE > 0
+void TSC_GestureHandler(void);
+#endif
+#if TOUCH_USE_TELEMETRY > 0
+void TSC_TelemetryHandler(void);
+#endif
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+void TSC_CycleHandler(void);
+#endif
 void TSC_User_Config(void);
 void TSC_User_Thresholds(void);
 TSC_STATUS_T TSC_User_Action(void);
@@ -45,13 +45,25 @@
   @{
 */
 
-#define USBD_SUP_CLASS_MAX_NUM              1
-#define USBD_SUP_INTERFACE_MAX_NUM          1
+#define USBD_SUP_CLASS_MAX_NUM              2
+#define USBD_SUP_INTERFACE_MAX_NUM          2
 #define USBD_SUP_CONFIGURATION_MAX_NUM      1
 #define USBD_SUP_STR_DESC_MAX_NUM           512
 
 #define USBD_HID_EP_IN_ADDR                 0x81
 #define USBD_HID_EP_IN_SIZE                 0x100
+#define USBD_HID_EP_OUT_ADDR                0x01
+#define USBD_HID_EP_OUT_SIZE                0x120
+#define USBD_HID_OUT_EP_EN                  1
+#define USBD_HID_QUEUE_SIZE                 8
+#define USBD_HID_QUEUE_COALESCE             1
+#define USBD_HID_KEYBOARD_NKRO              1
+#define USBD_HID_COMPOSITE                  1
+
+#define USBD_WINUSB_EP_IN_ADDR              0x82
+#define USBD_WINUSB_EP_IN_SIZE              0x140
+#define USBD_WINUSB_EP_OUT_ADDR             0x02
+#define USBD_WINUSB_EP_OUT_SIZE             0x180
 
 /* Only support LPM USB device */
 #define USBD_SUP_LPM                        0
@@ -44,9 +44,14 @@
 */
 
 #define USBD_DEVICE_DESCRIPTOR_SIZE             18
-#define USBD_CONFIG_DESCRIPTOR_SIZE             41
+#if USBD_HID_OUT_EP_EN
+#define USBD_CONFIG_DESCRIPTOR_SIZE             64
+#else
+#define USBD_CONFIG_DESCRIPTOR_SIZE             57
+#endif
 #define USBD_SERIAL_STRING_SIZE                 26
 #define USBD_LANGID_STRING_SIZE                 4
+#define USBD_WINUSB_OS_STRING_SIZE              18
 #define USBD_DEVICE_QUALIFIER_DESCRIPTOR_SIZE   10
 #define USBD_BOS_DESCRIPTOR_SIZE                12
 
@@ -60,6 +65,9 @@
 #define USBD_HID_ITF_PORTOCOL_KEYBOARD          0x01
 #define USBD_HID_ITF_PORTOCOL_MOUSE             0x02
 
+#define USBD_VENDOR_ITF_CLASS_ID                0xFF
+#define USBD_TELEM_ITF_NUM                      0x01
+
 /**@} end of group USBD_HID_Macros*/
 
 /** @defgroup USBD_HID_Variables Variables
@@ -0,0 +1,63 @@
+/*!
+ * @file        usbd_hid_itf.h
+ *
+ * @brief       usb device HID interface of the keyboard LEDs
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-01-16
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef _USBD_HID_ITF_H_
+#define _USBD_HID_ITF_H_
+
+/* Includes */
+#include "usbd_hid.h"
+
+/** @addtogroup Examples
+  * @brief USBD HID examples
+  @{
+  */
+
+/** @addtogroup USBD_HID
+  @{
+  */
+
+/** @defgroup USBD_HID_Macros Macros
+  @{
+*/
+
+/* Board LEDs of the keyboard lock state */
+#define HID_LED_NUM_LOCK                    LED2
+#define HID_LED_CAPS_LOCK                   LED3
+#define HID_LED_SCROLL_LOCK                 LED4
+
+/**@} end of group USBD_HID_Macros*/
+
+/** @defgroup USBD_HID_Variables Variables
+  @{
+  */
+
+extern USBD_HID_INTERFACE_T USBD_HID_INTERFACE_FS;
+
+/**@} end of group USBD_HID_Variables*/
+/**@} end of group USBD_HID */
+/**@} end of group Examples */
+
+#endif
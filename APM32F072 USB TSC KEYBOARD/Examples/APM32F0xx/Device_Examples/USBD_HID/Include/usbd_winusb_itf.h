@@ -0,0 +1,71 @@
+/*!
+ * @file        usbd_winusb_itf.h
+ *
+ * @brief       usb device WinUSB interface of the TSC telemetry
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-01-16
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef _USBD_WINUSB_ITF_H_
+#define _USBD_WINUSB_ITF_H_
+
+/* Includes */
+#include "usbd_winusb.h"
+
+/** @addtogroup Examples
+  * @brief USBD HID examples
+  @{
+  */
+
+/** @addtogroup USBD_HID
+  @{
+  */
+
+/** @defgroup USBD_HID_Macros Macros
+  @{
+*/
+
+/* Commands written by the host on the OUT endpoint */
+#define USBD_WINUSB_CMD_STREAM_STOP         0x00
+#define USBD_WINUSB_CMD_STREAM_START        0x01
+
+/**@} end of group USBD_HID_Macros*/
+
+/** @defgroup USBD_HID_Variables Variables
+  @{
+  */
+
+extern USBD_WINUSB_INTERFACE_T USBD_WINUSB_INTERFACE_FS;
+
+/**@} end of group USBD_HID_Variables*/
+
+/** @defgroup USBD_HID_Functions Functions
+  @{
+  */
+
+USBD_STA_T USBD_FS_WINUSB_ItfSend(uint8_t *buffer, uint16_t length);
+uint8_t USBD_FS_WINUSB_ReadStream(void);
+
+/**@} end of group USBD_HID_Functions */
+/**@} end of group USBD_HID */
+/**@} end of group Examples */
+
+#endif
@@ -161,15 +161,31 @@ void USBD_IRQHandler(void)
  */
 void TSC_IRQHandler(void)
 {
-#if TOUCH_TSC_IODEF > 0
-    /* Set IO default in Output PP Low to discharge all capacitors */
-    TSC->CTRL &= (uint32_t)(~(1 << 4));
-#endif
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+    /* Read the Block counters and start the next Block */
+    TSC_Acq_ProcessInterrupt();
+#else
     /* Clear EOAICLR and MCEICLR flags */
     TSC->INTFCLR |= 0x03;
-    /* To inform the main loop routine of the End Of Acquisition */
-    Global_EOA = 1;
+#endif
+}
+
+#if TOUCH_USE_DMA_READOUT > 0
+/*!
+ * @brief        This function handles DMA1 Channel 4 to 7 Handler
+ *
+ * @param        None
+ *
+ * @retval       None
+ *
+ * @note         TOUCH_DMA_READOUT_CHANNEL is 7
+ */
+void DMA1_CH4_5_6_7_IRQHandler(void)
+{
+    /* End of the TSC counters copy */
+    TSC_Acq_ProcessDmaReadout();
 }
+#endif
 
 /*!
  * @brief        This function handles TMR14 Handler
@@ -182,5 +198,9 @@ void TSC_IRQHandler(void)
  */
 void TMR14_IRQHandler(void)
 {
+#if TOUCH_USE_DISCHARGE_TIMER > 0
+    /* Start the next Block at the end of the capacitors discharge */
+    TSC_Acq_ProcessDischarge();
+#endif
     TMR14_Isr();
 }
\ No newline at end of file
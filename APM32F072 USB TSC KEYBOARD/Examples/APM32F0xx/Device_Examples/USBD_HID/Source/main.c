@@ -86,6 +86,7 @@ int main(void)
     APM_EVAL_LEDInit(LED1);
     APM_EVAL_LEDInit(LED2);
     APM_EVAL_LEDInit(LED3);
+    APM_EVAL_LEDInit(LED4);
     APM_EVAL_PBInit(BUTTON_KEY1,BUTTON_MODE_GPIO);
     APM_EVAL_PBInit(BUTTON_KEY2,BUTTON_MODE_GPIO);
     APM_EVAL_PBInit(BUTTON_KEY3,BUTTON_MODE_GPIO);
@@ -106,18 +107,11 @@ int main(void)
         HidMouse_Proc();
 			  if (TSC_User_Action() == TSC_STATUS_OK)
         {
-            if(taskFlag)
-            {
-                TSC_DetectHandler();
-            }
-            else
-            {
-                TSC_ReleaseHandler();	   
-            }
-						if(tscPressStatus!=0)
-						{
-							Menu_TSCHandler();
-						}
+            /* Update the pressed keys */
+            TSC_EventHandler();
+#if TOUCH_USE_GESTURE > 0
+            TSC_GestureHandler();
+#endif
 //						else
 //						{
 //							 if(tscPressRecord!=0)
@@ -131,6 +125,26 @@ int main(void)
 //							 }
 //						}
         }
+#if TOUCH_USE_LOWPOWER > 0
+        else
+        {
+            /* Sleep until the next interrupt during the guard scan */
+            TSC_LowPower_Sleep();
+        }
+#endif
+
+        /* Send a report when the pressed keys have changed, again while the endpoint is busy */
+        Menu_TSCHandler();
+
+#if TOUCH_USE_TELEMETRY > 0
+        /* Stream the frame records to the host */
+        TSC_TelemetryHandler();
+#endif
+
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+        /* Check the TSC interrupt load on COM1 */
+        TSC_CycleHandler();
+#endif
     }		
 }
 
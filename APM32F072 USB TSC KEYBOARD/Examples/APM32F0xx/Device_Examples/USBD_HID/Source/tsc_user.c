@@ -31,15 +31,64 @@
 #include "board_apm32f072_eval.h"
 #include "usbd_hid.h"
 #include "usb_device_user.h"
+#include "usbd_winusb_itf.h"
 #include "bsp_delay.h"
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+#include <stdio.h>
+#endif
 
 /* Timer tick */
-uint8_t cnt50ms = 0;
-uint8_t taskFlag = 0;
 uint8_t tscPressStatus = 0;
 uint16_t cntTick = 0;
 uint8_t keyRecord=0;
 uint8_t tscPressRecord=0;
+/* Tick_ms of the last press of each key */
+TSC_tTick_ms_T tscPressTick[TOUCH_TOTAL_KEYS];
+
+/* HID usage sent for each key, 0 = key not sent */
+static CONST uint8_t keyUsage[TOUCH_TOTAL_KEYS] =
+{
+    0x06, /*!< K1: 'c' */
+    0x07, /*!< K2: 'd' */
+    0x08, /*!< K3: 'e' */
+    0x00, /*!< K4 */
+    0x09  /*!< K5: 'f' */
+};
+
+/* Usages of a report: the touch keys, the board key and the matrix key */
+#define TSC_KEY_LIST_SIZE       (TOUCH_TOTAL_KEYS + 2)
+
+/* Pressed keys, oldest press first, the boot report follows this order */
+static uint8_t keyOrder[TOUCH_TOTAL_KEYS];
+static uint8_t keyOrderNum = 0;
+/* Keys in keyOrder (bit = key index) */
+static uint32_t keyListed = 0;
+/* Keys pressed since the last queued report */
+static uint32_t keyNotReported = 0;
+/* Keys released before a report with them has been queued */
+static uint32_t keyReleasePending = 0;
+/* The pressed keys have changed since the last queued report */
+static uint8_t keyReportDirty = 0;
+/* HID usage of the pressed board key, 0 = none */
+static uint8_t boardKeyUsage = 0;
+#if TOUCH_TOTAL_MATRICES > 0
+/* HID usage of each key of the Matrix (row x 2 + column) */
+static CONST uint8_t matrixUsage[4] =
+{
+    0x1E, /*!< Row 0, Column 0: '1' */
+    0x1F, /*!< Row 0, Column 1: '2' */
+    0x20, /*!< Row 1, Column 0: '3' */
+    0x21  /*!< Row 1, Column 1: '4' */
+};
+/* HID usage of the pressed Matrix key, 0 = none */
+static uint8_t matrixKeyUsage = 0;
+#endif
+#if (TOUCH_USE_GESTURE > 0) && USBD_HID_COMPOSITE
+/* Consumer control steps to send: usage then release */
+static uint16_t consumerUsage = 0;
+static uint8_t consumerSteps = 0;
+static uint8_t consumerPressed = 0;
+#endif
 /** @addtogroup Examples
   * @brief TSC touch examples
   @{
@@ -53,34 +102,16 @@ uint8_t tscPressRecord=0;
   @{
   */
 
-/* Source and Configuration (ROM) */
+/* Source and Configuration (ROM), ordered by Block */
 CONST TSC_Channel_Src_T MyChannels_Src[TOUCH_TOTAL_CHANNELS] =
 {
-    /* Block 0 */
-    { CHANNEL_1_SRC, CHANNEL_1_IO_MSK, CHANNEL_1_GRP_MSK },
-    { CHANNEL_2_SRC, CHANNEL_2_IO_MSK, CHANNEL_2_GRP_MSK },
-
-    /* Block 1 */
-    { CHANNEL_0_SRC, CHANNEL_0_IO_MSK, CHANNEL_0_GRP_MSK },
-    { CHANNEL_4_SRC, CHANNEL_4_IO_MSK, CHANNEL_4_GRP_MSK },
-    
-    /* Block 2 */
-    { CHANNEL_3_SRC, CHANNEL_3_IO_MSK, CHANNEL_3_GRP_MSK },
+    TOUCH_SENSOR_CHANNELS(TSC_SENSOR_SRC)
 };
 
-/* Destination (ROM) */
+/* Destination (ROM), ordered by Block */
 CONST TSC_Channel_Dest_T MyChannels_Dest[TOUCH_TOTAL_CHANNELS] =
 {
-    /* Block 0 */
-    { CHANNEL_1_DEST },
-    { CHANNEL_2_DEST },
-
-    /* Block 1 */
-    { CHANNEL_0_DEST },
-    { CHANNEL_4_DEST },
-    
-    /* Block 2 */
-    { CHANNEL_3_DEST },
+    TOUCH_SENSOR_CHANNELS(TSC_SENSOR_DEST)
 };
 
 /* Data (RAM) */
@@ -92,10 +123,15 @@ TSC_Channel_Data_T MyChannels_Data[TOUCH_TOTAL_CHANNELS];
   @{
 */
 /** List (ROM) */
-CONST TSC_Block_T MyBlocks[TOUCH_TOTAL_BLOCKS] = {
-    {&MyChannels_Src[0], &MyChannels_Dest[0], MyChannels_Data, BLOCK_0_NUMCHANNELS, BLOCK_0_MSK_CHANNELS, BLOCK_0_MSK_GROUPS},
-    {&MyChannels_Src[2], &MyChannels_Dest[2], MyChannels_Data, BLOCK_1_NUMCHANNELS, BLOCK_1_MSK_CHANNELS, BLOCK_1_MSK_GROUPS},
-    {&MyChannels_Src[4], &MyChannels_Dest[4], MyChannels_Data, BLOCK_2_NUMCHANNELS, BLOCK_2_MSK_CHANNELS, BLOCK_2_MSK_GROUPS}
+CONST TSC_Block_T MyBlocks[TOUCH_TOTAL_BLOCKS] =
+{
+    TSC_SENSOR_BLOCK(0, MyChannels_Src, MyChannels_Dest, MyChannels_Data),
+#if TOUCH_TOTAL_BLOCKS > 1
+    TSC_SENSOR_BLOCK(1, MyChannels_Src, MyChannels_Dest, MyChannels_Data),
+#endif
+#if TOUCH_TOTAL_BLOCKS > 2
+    TSC_SENSOR_BLOCK(2, MyChannels_Src, MyChannels_Dest, MyChannels_Data),
+#endif
 };
 
 /**@} Blocks_Config */
@@ -156,14 +192,24 @@ CONST TSC_State_T MyKeys_StateMachine[] =
     /* Touch states */
     { TSC_STATEMASK_TOUCH,              TSC_TouchKey_ProcessTouchState },     /*!< 12 */
     /* Error states */
+#if TOUCH_USE_RECOVERY > 0
+    /* Off until the recalibration, the other keys are still scanned */
+    { TSC_STATEMASK_ERROR,              TSC_Recovery_ProcessErrorState },    /*!< 13 */
+#else
     { TSC_STATEMASK_ERROR,              MyKeys_ProcessErrorState },          /*!< 13 */
+#endif
     { TSC_STATEMASK_DEB_ERROR_CALIB,    TSC_TouchKey_ProcessDebErrorState }, /*!< 14 */
     { TSC_STATEMASK_DEB_ERROR_RELEASE,  TSC_TouchKey_ProcessDebErrorState }, /*!< 15 */
     { TSC_STATEMASK_DEB_ERROR_PROX,     TSC_TouchKey_ProcessDebErrorState }, /*!< 16 */
     { TSC_STATEMASK_DEB_ERROR_DETECT,   TSC_TouchKey_ProcessDebErrorState }, /*!< 17 */
     { TSC_STATEMASK_DEB_ERROR_TOUCH,    TSC_TouchKey_ProcessDebErrorState }, /*!< 18 */
     /* Other states */
+#if TOUCH_USE_RECOVERY > 0
+    /* Recalibrate the key when its recovery delay has elapsed */
+    { TSC_STATEMASK_OFF,                TSC_Recovery_ProcessOffState } /*!< 19 */
+#else
     { TSC_STATEMASK_OFF,                MyKeys_ProcessOffState } /*!< 19 */
+#endif
 };
 
 /* Methods for "extended" type (ROM) */
@@ -173,26 +219,60 @@ CONST TSC_TouchKeyMethods_T MyKeys_Methods =
     TSC_TouchKey_Process
 };
 
-/* TouchKeys list (ROM) */
+/* TouchKeys list (ROM), one TouchKey per channel */
+#define MY_TOUCHKEY(ch, g, io) \
+    { &MyKeys_Data[ch], &MyKeys_Param[ch], &MyChannels_Data[ch], MyKeys_StateMachine, &MyKeys_Methods },
+
 CONST TSC_TouchKey_T MyTouchKeys[TOUCH_TOTAL_KEYS] =
 {
-  { &MyKeys_Data[0], &MyKeys_Param[0], &MyChannels_Data[CHANNEL_0_DEST], MyKeys_StateMachine, &MyKeys_Methods },
-  { &MyKeys_Data[1], &MyKeys_Param[1], &MyChannels_Data[CHANNEL_1_DEST], MyKeys_StateMachine, &MyKeys_Methods },
-  { &MyKeys_Data[2], &MyKeys_Param[2], &MyChannels_Data[CHANNEL_2_DEST], MyKeys_StateMachine, &MyKeys_Methods },
-  { &MyKeys_Data[3], &MyKeys_Param[3], &MyChannels_Data[CHANNEL_3_DEST], MyKeys_StateMachine, &MyKeys_Methods },
-  { &MyKeys_Data[4], &MyKeys_Param[4], &MyChannels_Data[CHANNEL_4_DEST], MyKeys_StateMachine, &MyKeys_Methods },
+    TOUCH_SENSOR_KEYS(MY_TOUCHKEY)
+};
+
+#if TOUCH_TOTAL_MATRICES > 0
+/* Matrix data (RAM) */
+TSC_MatrixData_T MyMatrix_Data;
+
+/* Matrix parameters (RAM) */
+TSC_MatrixParam_T MyMatrix_Param;
+
+/* 2 x 2 Matrix (ROM), its lines follow the TouchKeys channels */
+CONST TSC_Matrix_T MyMatrix =
+{
+    &MyMatrix_Data,
+    &MyMatrix_Param,
+    &MyChannels_Data[TOUCH_TOTAL_KEYS], /*!< Row 0, Row 1, Column 0, Column 1 */
+    2,                                  /*!< Number of rows */
+    2                                   /*!< Number of columns */
 };
+#endif
 
 /* List (ROM) */
+#define MY_OBJECT(ch, g, io) \
+    { TSC_OBJ_TOUCHKEY, (TSC_TouchKey_T *)&MyTouchKeys[ch] },
+
 CONST TSC_Object_T MyObjects[TOUCH_TOTAL_OBJECTS] =
 {
-    { TSC_OBJ_TOUCHKEY, (TSC_TouchKey_T *)&MyTouchKeys[0] },
-    { TSC_OBJ_TOUCHKEY, (TSC_TouchKey_T *)&MyTouchKeys[1] },
-    { TSC_OBJ_TOUCHKEY, (TSC_TouchKey_T *)&MyTouchKeys[2] },
-    { TSC_OBJ_TOUCHKEY, (TSC_TouchKey_T *)&MyTouchKeys[3] },
-    { TSC_OBJ_TOUCHKEY, (TSC_TouchKey_T *)&MyTouchKeys[4] },
+    TOUCH_SENSOR_KEYS(MY_OBJECT)
+#if TOUCH_TOTAL_MATRICES > 0
+    { TSC_OBJ_MATRIX, (TSC_Matrix_T *)&MyMatrix }, /*!< Index TOUCH_TOTAL_KEYS */
+#endif
+};
+
+#if TOUCH_USE_FILTER_BANK > 0
+/* Filter chain of the TouchKeys (ROM): spike removal, then smoothing with fast touch tracking */
+CONST TSC_FilterStage_T MyKeys_FilterStages[] =
+{
+    { TSC_FILT_MEDIAN3,      0,  0 },
+    { TSC_FILT_ADAPTIVE_IIR, 64, 2 }
 };
 
+CONST TSC_FilterChain_T MyKeys_Filter =
+{
+    MyKeys_FilterStages, /*!< First stage */
+    2                    /*!< Number of stages */
+};
+#endif
+
 /* Group (RAM) */
 TSC_ObjectGroup_T MyObjGroup =
 {
@@ -218,12 +298,22 @@ TSC_Params_T TSC_Params =
 #endif
 };
 
+#if TOUCH_ECS_INCREMENTAL == 0
 /* Hold the last time value for ECS */
 __IO TSC_tTick_ms_T Global_ECS_last_tick;
-/* Set by TSC interrupt routine to indicate the End Of Acquisition */
-__IO uint32_t Global_EOA;
+#endif
 uint32_t Global_ProcessSensor;
 
+#if TOUCH_USE_SNAPSHOT > 0
+/* Hold the last time value for the calibration snapshot */
+__IO TSC_tTick_sec_T Global_Snap_last_tick;
+#endif
+
+#if TOUCH_USE_TUNE > 0
+/* Pulse generator settings selected at startup */
+TSC_TuneResult_T MyTuneResult;
+#endif
+
 /**@} end of group TSC_KeyLinearRotate_Variables*/
 
 /** @defgroup TSC_KeyLinearRotate_Functions Functions
@@ -241,10 +331,50 @@ void TSC_User_Config(void)
 {
 #if TOUCH_TSC_GPIO_CONFIG == 0
     /* This function must be created by the user to initialize the Touch Sensing GPIOs */
+#endif
+#if TOUCH_USE_EVENT > 0
+    TSC_Event_Config();
 #endif
     TSC_Obj_ConfigGroup(&MyObjGroup);
+#if TOUCH_ECS_INCREMENTAL > 0
+    TSC_Ecs_ConfigGroup(&MyObjGroup);
+#endif
+#if TOUCH_USE_GESTURE > 0
+    TSC_Gesture_Config(&MyObjGroup);
+#endif
+#if TOUCH_USE_LOWPOWER > 0
+    TSC_LowPower_Config();
+#endif
+#if TOUCH_USE_RECOVERY > 0
+    TSC_Recovery_Config(&MyObjGroup);
+#endif
+#if TOUCH_USE_TELEMETRY > 0
+    TSC_Telem_Config(&MyObjGroup);
+#endif
+#if TOUCH_USE_SNAPSHOT > 0
+    /* Read the calibration saved before reset */
+    TSC_Snap_Config(&MyObjGroup);
+#endif
+#if TOUCH_USE_FILTER_BANK > 0
+    /* Same filter chain for all TouchKeys */
+    TSC_Filt_ConfigChannels(0, TOUCH_TOTAL_KEYS, &MyKeys_Filter);
+#endif
     TSC_Config(MyBlocks);
+#if TOUCH_USE_TUNE > 0
+#if TOUCH_USE_SNAPSHOT > 0
+    /* The saved References are only valid with the timing they were measured with */
+    if (TSC_Snap_ConfigCtrl() != TSC_STATUS_OK)
+#endif
+    {
+        /* Fastest charge transfer timing of the board, before the objects calibration */
+        TSC_Tune_Process(&MyTuneResult);
+    }
+#endif
     TSC_User_Thresholds();
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+    /* Blocks are now acquired in background by the TSC interrupt routine */
+    TSC_Acq_StartEngine();
+#endif
 }
 
 /*!
@@ -256,6 +386,86 @@ void TSC_User_Config(void)
  */
 TSC_STATUS_T TSC_User_Action(void)
 {
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+    CONST TSC_Frame_T *frame;
+
+    /* Check if a complete Frame has been acquired by the TSC interrupt routine */
+    frame = TSC_Acq_ReadFrame();
+    if (frame == 0)
+    {
+        return TSC_STATUS_BUSY;
+    }
+
+#if TOUCH_USE_LOWPOWER > 0
+    /* Guard Frame: only check if a hand is coming */
+    if (TSC_LowPower_ProcessFrame(frame) == TSC_STATUS_OK)
+    {
+        TSC_Acq_ReleaseFrame();
+        return TSC_STATUS_BUSY;
+    }
+#endif
+
+    TSC_Acq_ReadFrameResult(frame, 0, 0);
+    TSC_Acq_ReleaseFrame();
+
+#if TOUCH_USE_SNAPSHOT > 0
+    /* Skip the calibration if the saved one matches */
+    TSC_Snap_ProcessRestore(&MyObjGroup);
+#endif
+
+    /* Process objects, DxS and ECS */
+    TSC_Obj_ProcessGroup(&MyObjGroup);
+    TSC_Dxs_FirstObj(&MyObjGroup);
+
+#if TOUCH_USE_RECOVERY > 0
+    /* Clear the faults of the keys stable since their recalibration */
+    TSC_Recovery_Process();
+#endif
+
+#if TOUCH_USE_TELEMETRY > 0
+    /* Record of the frame for the host */
+    TSC_Telem_Write();
+#endif
+
+#if TOUCH_USE_LOWPOWER > 0
+    /* Guard scan after TOUCH_LP_IDLE_SEC without active object */
+    TSC_LowPower_ProcessGroup(&MyObjGroup);
+#endif
+
+#if TOUCH_ECS_INCREMENTAL > 0
+    /* ECS spread over the frames */
+    if (TSC_Ecs_ProcessSlice(&MyObjGroup) == TSC_STATUS_OK)
+    {
+        Global_ProcessSensor = 0;
+    }
+    else
+    {
+        Global_ProcessSensor = 1;
+    }
+#else
+    /* ECS every TOUCH_ECS_PERIOD ms */
+    if (TSC_Time_Delay_ms(TOUCH_ECS_PERIOD, &Global_ECS_last_tick) == TSC_STATUS_OK)
+    {
+        if (TSC_Ecs_Process(&MyObjGroup) == TSC_STATUS_OK)
+        {
+            Global_ProcessSensor = 0;
+        }
+        else
+        {
+            Global_ProcessSensor = 1;
+        }
+    }
+#endif
+
+#if TOUCH_USE_SNAPSHOT > 0
+    /* Save the calibration when the References have drifted */
+    if (TSC_Time_Delay_sec(TOUCH_SNAPSHOT_PERIOD, &Global_Snap_last_tick) == TSC_STATUS_OK)
+    {
+        TSC_Snap_Save(&MyObjGroup);
+    }
+#endif
+    return TSC_STATUS_OK;
+#else
     static uint32_t idx_block = 0;
     static uint32_t config_done = 0;
     TSC_STATUS_T status;
@@ -266,17 +476,10 @@ TSC_STATUS_T TSC_User_Action(void)
         TSC_Acq_ConfigBlock(idx_block);
         TSC_Acq_StartPerConfigBlock();
         config_done = 1;
-        #if TOUCH_USE_ACQ_INTERRUPT > 0
-        Global_EOA = 0; //!< Will be set by the TSC interrupt routine
-        #endif
     }
 
     /* Check end of acquisition */
-    #if TOUCH_USE_ACQ_INTERRUPT > 0
-    if (Global_EOA) //!< Set by the TSC interrupt routine
-    #else
     if (TSC_Acq_WaitBlockEOA() == TSC_STATUS_OK)
-    #endif
     {
         TSC_Acq_ReadBlockResult(idx_block, 0, 0);
         idx_block++;
@@ -289,11 +492,37 @@ TSC_STATUS_T TSC_User_Action(void)
         idx_block = 0;
         config_done = 0;
 
+#if TOUCH_USE_SNAPSHOT > 0
+        /* Skip the calibration if the saved one matches */
+        TSC_Snap_ProcessRestore(&MyObjGroup);
+#endif
+
         TSC_Obj_ProcessGroup(&MyObjGroup);
         TSC_Dxs_FirstObj(&MyObjGroup);
 
-        /* ECS every 100ms */
-        if (TSC_Time_Delay_ms(100, &Global_ECS_last_tick) == TSC_STATUS_OK)
+#if TOUCH_USE_RECOVERY > 0
+        /* Clear the faults of the keys stable since their recalibration */
+        TSC_Recovery_Process();
+#endif
+
+#if TOUCH_USE_TELEMETRY > 0
+        /* Record of the frame for the host */
+        TSC_Telem_Write();
+#endif
+
+#if TOUCH_ECS_INCREMENTAL > 0
+        /* ECS spread over the frames */
+        if (TSC_Ecs_ProcessSlice(&MyObjGroup) == TSC_STATUS_OK)
+        {
+            Global_ProcessSensor = 0;
+        }
+        else
+        {
+            Global_ProcessSensor = 1;
+        }
+#else
+        /* ECS every TOUCH_ECS_PERIOD ms */
+        if (TSC_Time_Delay_ms(TOUCH_ECS_PERIOD, &Global_ECS_last_tick) == TSC_STATUS_OK)
         {
             if (TSC_Ecs_Process(&MyObjGroup) == TSC_STATUS_OK)
             {
@@ -304,6 +533,15 @@ TSC_STATUS_T TSC_User_Action(void)
                 Global_ProcessSensor = 1;
             }
         }
+#endif
+
+#if TOUCH_USE_SNAPSHOT > 0
+        /* Save the calibration when the References have drifted */
+        if (TSC_Time_Delay_sec(TOUCH_SNAPSHOT_PERIOD, &Global_Snap_last_tick) == TSC_STATUS_OK)
+        {
+            TSC_Snap_Save(&MyObjGroup);
+        }
+#endif
         status = TSC_STATUS_OK;
     }
     else
@@ -311,6 +549,7 @@ TSC_STATUS_T TSC_User_Action(void)
         status = TSC_STATUS_BUSY;
     }
     return status;
+#endif
 }
 
 /*!
@@ -330,89 +569,473 @@ void TSC_User_Thresholds(void)
 /**@} end of group Examples */
 
 /*!
- * @brief       TSC detect handler
+ * @brief       Add a key to the pressed keys
  *
- * @param       None
+ * @param       idx: Key index
+ *
+ * @param       tick: Tick_ms of the press
  *
  * @retval      None
  */
+static void TSC_KeyPress(uint8_t idx, TSC_tTick_ms_T tick)
+{
+    uint32_t bit = (uint32_t)1 << idx;
+
+    tscPressTick[idx] = tick;
+
+    if ((keyListed & bit) == 0)
+    {
+        keyOrder[keyOrderNum++] = idx;
+        keyListed |= bit;
+    }
+
+    /* Pressed again before the host has seen the release: keep its place */
+    keyReleasePending &= ~bit;
+    keyNotReported |= bit;
+    keyReportDirty = 1;
+}
 
-void TSC_DetectHandler(void)
+/*!
+ * @brief       Remove a key from the pressed keys
+ *
+ * @param       idx: Key index
+ *
+ * @retval      None
+ */
+static void TSC_KeyRelease(uint8_t idx)
 {
-    uint8_t idx_key;
-	  uint8_t buffer[8];
+    uint32_t bit = (uint32_t)1 << idx;
+    uint8_t i;
 
-    for(idx_key = 0; idx_key < TOUCH_TOTAL_CHANNELS; idx_key++)
+    if ((keyListed & bit) == 0)
     {
-        if(TOUCHKEY_PRESS(idx_key))
+        return;
+    }
+
+    if (keyNotReported & bit)
+    {
+        /* Keep the key in the next report, the host must see each press */
+        keyReleasePending |= bit;
+    }
+    else
+    {
+        for (i = 0; keyOrder[i] != idx; i++)
+        {
+        }
+        keyOrderNum--;
+        for (; i < keyOrderNum; i++)
+        {
+            keyOrder[i] = keyOrder[i + 1];
+        }
+        keyListed &= ~bit;
+    }
+    keyReportDirty = 1;
+}
+
+/*!
+ * @brief       Update the pressed keys from a mask
+ *
+ * @param       mask: Pressed keys (bit = key index)
+ *
+ * @retval      None
+ *
+ * @note        Keys found pressed together are added in index order.
+ */
+static void TSC_KeySync(uint32_t mask)
+{
+    uint8_t idx;
+
+    for (idx = 0; idx < TOUCH_TOTAL_KEYS; idx++)
+    {
+        if (mask & ((uint32_t)1 << idx))
         {
-            switch(idx_key)
+            if ((keyListed & ~keyReleasePending) & ((uint32_t)1 << idx))
             {
-                case 0:
-                    tscPressStatus |= TSC_TOUCH_K1;
-                break;
-                
-                case 1:
-                    tscPressStatus |= TSC_TOUCH_K2;
-                break;
-                
-                case 2:
-                    tscPressStatus |= TSC_TOUCH_K3;
-                break;
-                
-                case 3:
-                    tscPressStatus |= TSC_TOUCH_K4;
-                break;
-                
-                case 4:
-                    tscPressStatus |= TSC_TOUCH_K5;
-                break;
+                continue;
             }
+            TSC_KeyPress(idx, TSC_Globals.Tick_ms);
+        }
+        else if ((keyReleasePending & ((uint32_t)1 << idx)) == 0)
+        {
+            TSC_KeyRelease(idx);
         }
     }
-		tscPressRecord=tscPressStatus;
 }
 
+#if TOUCH_TOTAL_MATRICES > 0
+/*!
+ * @brief       Update the HID usage of the Matrix key
+ *
+ * @param       key: Key of the Matrix (row x 2 + column) or TSC_MATRIX_NO_KEY
+ *
+ * @retval      1 if the usage has changed, 0 otherwise
+ *
+ * @note        The Matrix reports one key at a time, see TOUCH_TOTAL_MATRICES.
+ */
+static uint8_t TSC_MatrixKey(uint8_t key)
+{
+    uint8_t usage = 0;
+
+    if (key < sizeof(matrixUsage))
+    {
+        usage = matrixUsage[key];
+    }
+
+    if (usage == matrixKeyUsage)
+    {
+        return 0;
+    }
+
+    matrixKeyUsage = usage;
+    keyReportDirty = 1;
+
+    return 1;
+}
+#endif
+
 /*!
- * @brief       TSC release handler
+ * @brief       Write the key map and the press order of the pressed keys
+ *
+ * @param       keyMap: Key map, USBD_HID_KEYMAP_WORDS words cleared by the caller
+ *
+ * @param       keyList: Usages of the pressed keys, TSC_KEY_LIST_SIZE bytes
+ *
+ * @retval      Number of usages in keyList
+ *
+ * @note        The touch keys are listed in press order, the board key and
+ *              the matrix key follow.
+ */
+static uint8_t TSC_KeyMap(uint32_t *keyMap, uint8_t *keyList)
+{
+    uint8_t num = 0;
+    uint8_t i;
+
+    for (i = 0; i < keyOrderNum; i++)
+    {
+        if (keyUsage[keyOrder[i]] != 0)
+        {
+            USBD_HID_KEYMAP_SET(keyMap, keyUsage[keyOrder[i]]);
+            keyList[num++] = keyUsage[keyOrder[i]];
+        }
+    }
+
+    if (boardKeyUsage != 0)
+    {
+        USBD_HID_KEYMAP_SET(keyMap, boardKeyUsage);
+        keyList[num++] = boardKeyUsage;
+    }
+
+#if TOUCH_TOTAL_MATRICES > 0
+    if (matrixKeyUsage != 0)
+    {
+        USBD_HID_KEYMAP_SET(keyMap, matrixKeyUsage);
+        keyList[num++] = matrixKeyUsage;
+    }
+#endif
+
+    return num;
+}
+
+/*!
+ * @brief       TSC event handler, update the pressed keys
  *
  * @param       None
  *
- * @retval      None
+ * @retval      1 if a key has been pressed or released, 0 otherwise
+ *
+ * @note        Called after each TSC_User_Action() returning TSC_STATUS_OK.
  */
-void TSC_ReleaseHandler(void)
+uint8_t TSC_EventHandler(void)
 {
+    uint8_t changed = 0;
+#if TOUCH_USE_EVENT > 0
+    TSC_Event_T event;
+
+    /* Only the keys pressed or released since the last call */
+    while (TSC_Event_Read(&event) == TSC_STATUS_OK)
+    {
+#if TOUCH_USE_GESTURE > 0
+        TSC_Gesture_ProcessEvent(&event);
+#endif
+#if TOUCH_TOTAL_MATRICES > 0
+        if (event.Index >= TOUCH_TOTAL_KEYS)
+        {
+            /* A release then a press when the finger moves to another key */
+            TSC_MatrixKey((event.Type == TSC_EVENT_PRESS) ? event.Key : TSC_MATRIX_NO_KEY);
+            changed = 1;
+            continue;
+        }
+#endif
+        if (event.Type == TSC_EVENT_PRESS)
+        {
+            tscPressStatus |= (uint8_t)(0x01 << event.Index);
+            TSC_KeyPress(event.Index, event.Tick);
+        }
+        else
+        {
+            tscPressStatus &= (uint8_t)~(0x01 << event.Index);
+            TSC_KeyRelease(event.Index);
+        }
+        changed = 1;
+    }
+
+    /* The queue has been full, read again the pressed keys */
+    if (TSC_Event_ReadLost() != 0)
+    {
+        tscPressStatus = (uint8_t)(MyObjGroup.PressMask & (((uint32_t)1 << TOUCH_TOTAL_KEYS) - 1));
+        TSC_KeySync(MyObjGroup.PressMask);
+#if TOUCH_TOTAL_MATRICES > 0
+        TSC_MatrixKey(MyMatrix_Data.Key);
+#endif
+        changed = 1;
+    }
+
+#if TOUCH_USE_GESTURE > 0
+    /* Gesture timers, once per frame */
+    TSC_Gesture_Process();
+#endif
+#else
     uint8_t idx_key;
-    uint8_t buffer[8]={0,0,0};
-    for(idx_key = 0; idx_key < TOUCH_TOTAL_CHANNELS; idx_key++)
+    uint8_t status = tscPressStatus;
+
+    for(idx_key = 0; idx_key < TOUCH_TOTAL_KEYS; idx_key++)
     {
-        if(TOUCHKEY_RELEASE(idx_key))
+        if(TOUCHKEY_PRESS(idx_key))
         {
-            switch(idx_key)
-            {
-                case 0:
-                    tscPressStatus &= ~TSC_TOUCH_K1;
+            status |= (uint8_t)(0x01 << idx_key);
+        }
+        else if(TOUCHKEY_RELEASE(idx_key))
+        {
+            status &= (uint8_t)~(0x01 << idx_key);
+        }
+    }
+
+    if (status != tscPressStatus)
+    {
+        tscPressStatus = status;
+        TSC_KeySync(status);
+        changed = 1;
+    }
+#if TOUCH_TOTAL_MATRICES > 0
+    if (TSC_MatrixKey(MyMatrix_Data.Key))
+    {
+        changed = 1;
+    }
+#endif
+#endif
+    tscPressRecord = tscPressStatus;
+
+    return changed;
+}
+
+#if TOUCH_USE_GESTURE > 0
+#if USBD_HID_COMPOSITE
+/*!
+ * @brief       Add consumer control steps
+ *
+ * @param       usage: Consumer usage
+ *
+ * @param       count: Number of steps
+ *
+ * @retval      None
+ *
+ * @note        Steps of another usage replace the pending ones, the usage
+ *              being pressed is released first. The pending steps saturate
+ *              at 255.
+ */
+static void TSC_ConsumerStep(uint16_t usage, uint16_t count)
+{
+    if (usage != consumerUsage)
+    {
+        consumerUsage = usage;
+        consumerSteps = consumerPressed;
+    }
+
+    consumerSteps = ((uint32_t)consumerSteps + count > 0xFF) ? 0xFF : (uint8_t)(consumerSteps + count);
+}
+
+/*!
+ * @brief       Queue the pending consumer control steps
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Each step is a press and a release report, the remaining
+ *              steps are queued at the next call when the HID queue is full.
+ */
+static void TSC_ConsumerProcess(void)
+{
+    while (consumerSteps != 0)
+    {
+        if (USBD_HID_TxConsumer(&gUsbDeviceFS, consumerPressed ? 0 : consumerUsage) != USBD_OK)
+        {
+            break;
+        }
+
+        consumerPressed ^= 1;
+        if (consumerPressed == 0)
+        {
+            consumerSteps--;
+        }
+    }
+}
+#endif
+
+/*!
+ * @brief       TSC gesture handler
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Called after TSC_EventHandler(). With USBD_HID_COMPOSITE, the
+ *              media key sends consumer controls: tap = play/pause,
+ *              double tap = next track, long press and repeat = volume up.
+ *              A swipe sends one volume step per TOUCH_GESTURE_SWIPE_DIST.
+ */
+void TSC_GestureHandler(void)
+{
+    TSC_Gesture_T gesture;
+
+    while (TSC_Gesture_Read(&gesture) == TSC_STATUS_OK)
+    {
+        switch (gesture.Type)
+        {
+#if USBD_HID_COMPOSITE
+            case TSC_GESTURE_TAP:
+                if (gesture.Index == MEDIA_KEY_INDEX)
+                {
+                    TSC_ConsumerStep(USBD_HID_CONSUMER_PLAY_PAUSE, 1);
+                }
                 break;
-                
-                case 1:
-                    tscPressStatus &= ~TSC_TOUCH_K2;
+
+            case TSC_GESTURE_DOUBLE_TAP:
+                if (gesture.Index == MEDIA_KEY_INDEX)
+                {
+                    TSC_ConsumerStep(USBD_HID_CONSUMER_SCAN_NEXT, 1);
+                }
                 break;
-                
-                case 2:
-                    tscPressStatus &= ~TSC_TOUCH_K3;
+
+            case TSC_GESTURE_LONG_PRESS:
+            case TSC_GESTURE_REPEAT:
+                if (gesture.Index == MEDIA_KEY_INDEX)
+                {
+                    TSC_ConsumerStep(USBD_HID_CONSUMER_VOLUME_UP, 1);
+                }
                 break;
-                
-                case 3:
-                    tscPressStatus &= ~TSC_TOUCH_K4;
+
+            case TSC_GESTURE_SWIPE:
+                /* Up to 32768 / TOUCH_GESTURE_SWIPE_DIST steps, saturated by TSC_ConsumerStep() */
+                if (gesture.Distance > 0)
+                {
+                    TSC_ConsumerStep(USBD_HID_CONSUMER_VOLUME_UP, (uint16_t)(gesture.Distance / TOUCH_GESTURE_SWIPE_DIST));
+                }
+                else
+                {
+                    TSC_ConsumerStep(USBD_HID_CONSUMER_VOLUME_DOWN, (uint16_t)(-(int32_t)gesture.Distance / TOUCH_GESTURE_SWIPE_DIST));
+                }
                 break;
-                
-                case 4:
-                    tscPressStatus &= ~TSC_TOUCH_K5;
+#endif
+
+            default:
+                /* Add here your own processing */
                 break;
-            }
         }
     }
+
+#if USBD_HID_COMPOSITE
+    TSC_ConsumerProcess();
+#endif
+}
+#endif
+
+#if TOUCH_USE_TELEMETRY > 0
+/*!
+ * @brief       TSC telemetry handler
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Called in the main loop. The stream is started and stopped by the host
+ *              on the WinUSB interface. Two buffers are used so the next records are
+ *              read while the previous ones are sent.
+ */
+void TSC_TelemetryHandler(void)
+{
+    static uint8_t telemBuffer[2][TELEM_TX_SIZE];
+    static uint8_t idxBuffer = 0;
+    static uint16_t length = 0;
+    static uint8_t started = 0;
+    uint8_t stream = USBD_FS_WINUSB_ReadStream();
+
+    if (stream != started)
+    {
+        if (stream)
+        {
+            TSC_Telem_Start();
+        }
+        else
+        {
+            TSC_Telem_Stop();
+        }
+        started = stream;
+        length = 0;
+    }
+
+    if (started == 0)
+    {
+        return;
+    }
+
+    if (length == 0)
+    {
+        length = TSC_Telem_Read(telemBuffer[idxBuffer], TELEM_TX_SIZE);
+    }
+
+    if ((length > 0) && (USBD_FS_WINUSB_ItfSend(telemBuffer[idxBuffer], length) == USBD_OK))
+    {
+        idxBuffer ^= 1;
+        length = 0;
+    }
 }
+#endif
+
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+/*!
+ * @brief       TSC interrupt load check
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Called in the main loop. Prints every second on COM1 the CPU cycles
+ *              spent in the TSC interrupt routine. The routine must never last as
+ *              long as the capacitors discharge, which runs on the timer.
+ */
+void TSC_CycleHandler(void)
+{
+    static __IO TSC_tTick_ms_T lastTick = 0;
+    uint32_t last;
+    uint32_t max;
+    uint32_t discharge = TOUCH_DELAY_DISCHARGE_US * (SystemCoreClock / 1000000);
+
+    if (TSC_Time_Delay_ms(1000, &lastTick) != TSC_STATUS_OK)
+    {
+        return;
+    }
+
+    TSC_Acq_ReadCycles(&last, &max);
+    printf("TSC IRQ cycles: last %u, max %u\r\n", (unsigned int)last, (unsigned int)max);
+
+    if (max >= discharge)
+    {
+        printf("TSC IRQ error: %u cycles, discharge is %u cycles\r\n", (unsigned int)max, (unsigned int)discharge);
+    }
+}
+#endif
+
 /*!
  * @brief       Executed when a sensor is in Error state
  *
@@ -422,12 +1045,10 @@ void TSC_ReleaseHandler(void)
  */
 void MyKeys_ProcessErrorState(void)
 {
+    /* With TOUCH_USE_RECOVERY the state machine uses TSC_Recovery_ProcessErrorState() */
     TSC_TouchKey_ConfigOffState();
-    
-    while(1)
-    {
-    }
 }
+
 /*!
  * @brief       Executed when a sensor is in Off state
  *
@@ -492,19 +1113,17 @@ void APM_EVAL_TMR14_Init(uint16_t period, uint16_t div)
  */
 void TMR14_Isr(void)
 {
+    static TSC_tTick_ms_T lastTick = 0;
+
     if(TMR_ReadIntFlag(TMR14,TMR_INT_FLAG_UPDATE) == SET)
     {
         TMR_ClearIntFlag(TMR14,TMR_INT_FLAG_UPDATE);
-        cntTick++;
-			  cnt50ms++;
-        if(cnt50ms >= 50)
-        {
-            cnt50ms = 0;
-            
-            taskFlag ^= 1;
-        }
-			
-			
+        /* TSC time base, TOUCH_TICK_FREQ is 1000 */
+        TSC_Time_ProcessInterrupt();
+        /* Several ticks per update while the guard scan slows down TMR14 */
+        cntTick += (uint16_t)(TSC_tTick_ms_T)(TSC_Globals.Tick_ms - lastTick);
+        lastTick = TSC_Globals.Tick_ms;
+
         if(cntTick >= 500)
         {
             cntTick = 0;
@@ -526,9 +1145,7 @@ void HidMouse_Write(uint8_t key)
     int8_t y = 0;
 	
 	  int8_t Button = 0;
-	
-    uint8_t buffer[8] = {0, 0, 0, 0};
-    keyRecord=key;
+
     switch (key)
     {
         case HID_MOUSE_KEY_RIGHT:
@@ -551,9 +1168,13 @@ void HidMouse_Write(uint8_t key)
             return;
     }
 
-		buffer[3] = Button;
-		
-    USBD_HID_TxReport(&gUsbDeviceFS, (uint8_t*)buffer, 8);
+    /* Sent with the touch keys by Menu_TSCHandler() */
+    if (boardKeyUsage != (uint8_t)Button)
+    {
+        boardKeyUsage = (uint8_t)Button;
+        keyReportDirty = 1;
+    }
+    keyRecord = key;
 }
 /*!
  * @brief       Read key
@@ -601,97 +1222,71 @@ uint8_t HidMouse_ReadKey(void)
 void HidMouse_Proc(void)
 {
     uint8_t key = HID_MOUSE_KEY_NULL;
-	  uint8_t bufferM[8] = {0, 0, 0, 0};
-
-
 
     key = HidMouse_ReadKey();
     if(key != HID_MOUSE_KEY_NULL)
     {
-            HidMouse_Write(key);
-
-    }
-		else
-		{
-			 if(keyRecord)
-						{
-							 keyRecord=0;
-							 bufferM[0] = 0;
-               bufferM[1] = 0;
-               bufferM[2] = 0;
-							 bufferM[3] = 0;
-							 bufferM[4] = 0;
-		           APM_DelayMs(16);
-               USBD_HID_TxReport(&gUsbDeviceFS, (uint8_t*)bufferM, 8);
-						}
-		}
+        /* No new report while the key is held */
+        HidMouse_Write(key);
+    }
+    else if((keyRecord) && (keyReportDirty == 0))
+    {
+        /* Released once the press has been queued */
+        boardKeyUsage = 0;
+        keyReportDirty = 1;
+        keyRecord = 0;
+    }
 }
 
-
-
 /*!
- * @brief       TSC touch UI menu
+ * @brief       TSC touch UI menu, send the pressed keys to the host
  *
  * @param       None
  *
  * @retval      None
  *
- * @note
+ * @note        Called in the main loop. The report is built again until the
+ *              HID queue has a free slot, so keys pressed together are never lost.
+ *              The report is the NKRO bitmap or the boot report, as selected
+ *              by the host. The boot report lists the keys in press order.
  */
-
-#define  vector  2
 void Menu_TSCHandler(void)
 {
+    uint32_t keyMap[USBD_HID_KEYMAP_WORDS] = {0};
+    uint8_t keyList[TSC_KEY_LIST_SIZE];
+    uint8_t keyListNum;
     uint8_t i;
-    uint8_t temp;
-	
-	  int8_t x = 0;
-    int8_t y = 0;
-    uint8_t buffer[8] = {0, 0, 0, 0};
-   
-    for(i = 0; i < TOUCH_TOTAL_CHANNELS; i++)
-    {
-        
-        temp = tscPressStatus & (0x01 << i);
-			
-        switch(temp)
-        {
-            case TSC_TOUCH_K1:
-						      //x = 0x52;
-						     x = 0x06;
-                break;
-            
-            case TSC_TOUCH_K2:
-//						     x = 0x4f;
-						    x = 0x07;
-                break;
-            
-            case TSC_TOUCH_K3:
-//						     x = 0x51;
-						 y = 0x08;
-                break;
-            
-            case TSC_TOUCH_K4:
+    uint8_t num;
 
-                break;
-            
-            case TSC_TOUCH_K5:
-//						     x = 0x50;
-						x = 0x09;
-                break;
+    if (keyReportDirty == 0)
+    {
+        return;
+    }
+
+    /* Queued only if the pressed usages have changed */
+    keyListNum = TSC_KeyMap(keyMap, keyList);
+    if (USBD_HID_TxKeyMap(&gUsbDeviceFS, keyMap, keyList, keyListNum) != USBD_OK)
+    {
+        return;
+    }
+
+    keyReportDirty = 0;
+    keyNotReported = 0;
+
+    /* Remove the keys released during the report, the next report shows the release */
+    if (keyReleasePending)
+    {
+        num = 0;
+        for (i = 0; i < keyOrderNum; i++)
+        {
+            if ((keyReleasePending & ((uint32_t)1 << keyOrder[i])) == 0)
+            {
+                keyOrder[num++] = keyOrder[i];
+            }
         }
+        keyOrderNum = num;
+        keyListed &= ~keyReleasePending;
+        keyReleasePending = 0;
+        keyReportDirty = 1;
     }
-		tscPressStatus=0;
-		buffer[4] = y;
-		buffer[2] = x;
-    APM_DelayMs(16);
-    USBD_HID_TxReport(&gUsbDeviceFS, (uint8_t*)buffer, 8);		
-		
-		APM_DelayMs(16);
-		buffer[0] = 0;
-    buffer[2] = 0;
-		buffer[3] = 0;
-		buffer[4] = 0;
-		USBD_HID_TxReport(&gUsbDeviceFS, (uint8_t*)buffer, 8);	
 }
-
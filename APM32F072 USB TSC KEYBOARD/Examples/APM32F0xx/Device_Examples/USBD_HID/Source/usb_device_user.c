@@ -27,6 +27,8 @@
 #include "usb_device_user.h"
 #include "usbd_descriptor.h"
 #include "usbd_hid.h"
+#include "usbd_hid_itf.h"
+#include "usbd_winusb_itf.h"
 #include <stdio.h>
 
 /** @addtogroup Examples
@@ -131,6 +133,14 @@ void USB_DeviceInit(void)
 {
     /* USB device and class init */
     USBD_Init(&gUsbDeviceFS, USBD_SPEED_FS, &USBD_DESC_FS, &USBD_HID_CLASS, USB_DevUserHandler);
+    USBD_HID_RegisterItf(&gUsbDeviceFS, &USBD_HID_INTERFACE_FS);
+
+    /* WinUSB telemetry interface */
+    USBD_RegisterClass(&gUsbDeviceFS, &USBD_WINUSB_CLASS, USBD_TELEM_ITF_NUM);
+    USBD_WINUSB_RegisterItf(&gUsbDeviceFS, &USBD_WINUSB_INTERFACE_FS);
+
+    /* WinUSB answers the MS OS vendor request of the device */
+    USBD_ConfigDevReqClass(&gUsbDeviceFS, &USBD_WINUSB_CLASS);
 }
 
 /*!
@@ -164,6 +164,9 @@ void USBD_HardwareInit(USBD_INFO_T* usbInfo)
     USBD_Config(&usbDeviceHandler);
 
     USBD_ConfigPMA(&usbDeviceHandler, USBD_HID_EP_IN_ADDR, USBD_EP_BUFFER_SINGLE, USBD_HID_EP_IN_SIZE);
+    USBD_ConfigPMA(&usbDeviceHandler, USBD_HID_EP_OUT_ADDR, USBD_EP_BUFFER_SINGLE, USBD_HID_EP_OUT_SIZE);
+    USBD_ConfigPMA(&usbDeviceHandler, USBD_WINUSB_EP_IN_ADDR, USBD_EP_BUFFER_SINGLE, USBD_WINUSB_EP_IN_SIZE);
+    USBD_ConfigPMA(&usbDeviceHandler, USBD_WINUSB_EP_OUT_ADDR, USBD_EP_BUFFER_SINGLE, USBD_WINUSB_EP_OUT_SIZE);
 
     USBD_StartCallback(usbInfo);
 }
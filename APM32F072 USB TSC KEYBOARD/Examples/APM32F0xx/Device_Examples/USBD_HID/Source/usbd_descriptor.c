@@ -26,6 +26,7 @@
 /* Includes */
 #include "usbd_descriptor.h"
 #include "usbd_hid.h"
+#include "usbd_winusb.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -63,6 +64,7 @@ static USBD_DESC_INFO_T USBD_FS_LangIdDescHandler(uint8_t usbSpeed);
 static USBD_DESC_INFO_T USBD_FS_ManufacturerDescHandler(uint8_t usbSpeed);
 static USBD_DESC_INFO_T USBD_FS_ProductDescHandler(uint8_t usbSpeed);
 static USBD_DESC_INFO_T USBD_FS_SerialDescHandler(uint8_t usbSpeed);
+static USBD_DESC_INFO_T USBD_FS_WinUsbOsStrDescHandler(uint8_t usbSpeed);
 #if USBD_SUP_LPM
 static USBD_DESC_INFO_T USBD_FS_BosDescHandler(uint8_t usbSpeed);
 #endif
@@ -89,7 +91,7 @@ USBD_DESC_T USBD_DESC_FS =
 #if USBD_SUP_LPM
     USBD_FS_BosDescHandler,
 #endif
-    NULL,
+    USBD_FS_WinUsbOsStrDescHandler,
     USBD_OtherSpeedConfigDescHandler,
     USBD_DevQualifierDescHandler,
 };
@@ -154,7 +156,7 @@ uint8_t USBD_ConfigDesc[USBD_CONFIG_DESCRIPTOR_SIZE] =
     USBD_CONFIG_DESCRIPTOR_SIZE >> 8,
 
     /* bNumInterfaces */
-    0x01,
+    0x02,
     /* bConfigurationValue */
     0x01,
     /* iConfiguration */
@@ -178,7 +180,11 @@ uint8_t USBD_ConfigDesc[USBD_CONFIG_DESCRIPTOR_SIZE] =
     /* bAlternateSetting */
     0x00,
     /* bNumEndpoints */
+#if USBD_HID_OUT_EP_EN
     0x02,
+#else
+    0x01,
+#endif
     /* bInterfaceClass */
     USBD_HID_ITF_CLASS_ID,
     /* bInterfaceSubClass */
@@ -218,8 +224,9 @@ uint8_t USBD_ConfigDesc[USBD_CONFIG_DESCRIPTOR_SIZE] =
     USBD_HID_IN_EP_SIZE >> 8,
     /* bInterval: */
     USBD_HID_FS_INTERVAL,
-		
-		/* HID Mouse Endpoint */
+
+#if USBD_HID_OUT_EP_EN
+    /* HID Mouse OUT Endpoint */
     /* bLength */
     0x07,
     /* bDescriptorType: Endpoint */
@@ -229,10 +236,60 @@ uint8_t USBD_ConfigDesc[USBD_CONFIG_DESCRIPTOR_SIZE] =
     /* bmAttributes */
     0x03,
     /* wMaxPacketSize: */
-    USBD_HID_IN_EP_SIZE & 0xFF,
-    USBD_HID_IN_EP_SIZE >> 8,
+    USBD_HID_OUT_EP_SIZE & 0xFF,
+    USBD_HID_OUT_EP_SIZE >> 8,
     /* bInterval: */
     USBD_HID_FS_INTERVAL,
+#endif
+
+    /* WinUSB Telemetry Interface */
+    /* bLength */
+    0x09,
+    /* bDescriptorType */
+    USBD_DESC_INTERFACE,
+    /* bInterfaceNumber */
+    USBD_TELEM_ITF_NUM,
+    /* bAlternateSetting */
+    0x00,
+    /* bNumEndpoints */
+    0x02,
+    /* bInterfaceClass */
+    USBD_VENDOR_ITF_CLASS_ID,
+    /* bInterfaceSubClass */
+    0x00,
+    /* bInterfaceProtocol */
+    0x00,
+    /* iInterface */
+    0x00,
+
+    /* WinUSB Telemetry Endpoints */
+    /* bLength */
+    0x07,
+    /* bDescriptorType: Endpoint */
+    USBD_DESC_ENDPOINT,
+    /* bEndpointAddress */
+    USBD_WINUSB_DATA_IN_EP_ADDR,
+    /* bmAttributes */
+    0x02,
+    /* wMaxPacketSize: */
+    USBD_WINUSB_FS_MP_SIZE & 0xFF,
+    USBD_WINUSB_FS_MP_SIZE >> 8,
+    /* bInterval: */
+    0x00,
+
+    /* bLength */
+    0x07,
+    /* bDescriptorType: Endpoint */
+    USBD_DESC_ENDPOINT,
+    /* bEndpointAddress */
+    USBD_WINUSB_DATA_OUT_EP_ADDR,
+    /* bmAttributes */
+    0x02,
+    /* wMaxPacketSize: */
+    USBD_WINUSB_FS_MP_SIZE & 0xFF,
+    USBD_WINUSB_FS_MP_SIZE >> 8,
+    /* bInterval: */
+    0x00,
 };
 
 /**
@@ -249,7 +306,7 @@ uint8_t USBD_OtherSpeedCfgDesc[USBD_CONFIG_DESCRIPTOR_SIZE] =
     USBD_CONFIG_DESCRIPTOR_SIZE >> 8,
 
     /* bNumInterfaces */
-    0x01,
+    0x02,
     /* bConfigurationValue */
     0x01,
     /* iConfiguration */
@@ -273,7 +330,11 @@ uint8_t USBD_OtherSpeedCfgDesc[USBD_CONFIG_DESCRIPTOR_SIZE] =
     /* bAlternateSetting */
     0x00,
     /* bNumEndpoints */
+#if USBD_HID_OUT_EP_EN
+    0x02,
+#else
     0x01,
+#endif
     /* bInterfaceClass */
     USBD_HID_ITF_CLASS_ID,
     /* bInterfaceSubClass */
@@ -313,8 +374,9 @@ uint8_t USBD_OtherSpeedCfgDesc[USBD_CONFIG_DESCRIPTOR_SIZE] =
     USBD_HID_IN_EP_SIZE >> 8,
     /* bInterval: */
     USBD_HID_FS_INTERVAL,
-		
-		/* HID Mouse Endpoint */
+
+#if USBD_HID_OUT_EP_EN
+    /* HID Mouse OUT Endpoint */
     /* bLength */
     0x07,
     /* bDescriptorType: Endpoint */
@@ -324,10 +386,60 @@ uint8_t USBD_OtherSpeedCfgDesc[USBD_CONFIG_DESCRIPTOR_SIZE] =
     /* bmAttributes */
     0x03,
     /* wMaxPacketSize: */
-    USBD_HID_IN_EP_SIZE & 0xFF,
-    USBD_HID_IN_EP_SIZE >> 8,
+    USBD_HID_OUT_EP_SIZE & 0xFF,
+    USBD_HID_OUT_EP_SIZE >> 8,
     /* bInterval: */
     USBD_HID_FS_INTERVAL,
+#endif
+
+    /* WinUSB Telemetry Interface */
+    /* bLength */
+    0x09,
+    /* bDescriptorType */
+    USBD_DESC_INTERFACE,
+    /* bInterfaceNumber */
+    USBD_TELEM_ITF_NUM,
+    /* bAlternateSetting */
+    0x00,
+    /* bNumEndpoints */
+    0x02,
+    /* bInterfaceClass */
+    USBD_VENDOR_ITF_CLASS_ID,
+    /* bInterfaceSubClass */
+    0x00,
+    /* bInterfaceProtocol */
+    0x00,
+    /* iInterface */
+    0x00,
+
+    /* WinUSB Telemetry Endpoints */
+    /* bLength */
+    0x07,
+    /* bDescriptorType: Endpoint */
+    USBD_DESC_ENDPOINT,
+    /* bEndpointAddress */
+    USBD_WINUSB_DATA_IN_EP_ADDR,
+    /* bmAttributes */
+    0x02,
+    /* wMaxPacketSize: */
+    USBD_WINUSB_FS_MP_SIZE & 0xFF,
+    USBD_WINUSB_FS_MP_SIZE >> 8,
+    /* bInterval: */
+    0x00,
+
+    /* bLength */
+    0x07,
+    /* bDescriptorType: Endpoint */
+    USBD_DESC_ENDPOINT,
+    /* bEndpointAddress */
+    USBD_WINUSB_DATA_OUT_EP_ADDR,
+    /* bmAttributes */
+    0x02,
+    /* wMaxPacketSize: */
+    USBD_WINUSB_FS_MP_SIZE & 0xFF,
+    USBD_WINUSB_FS_MP_SIZE >> 8,
+    /* bInterval: */
+    0x00,
 };
 
 #if USBD_SUP_LPM
@@ -391,6 +503,23 @@ uint8_t USBD_LandIDStrDesc[USBD_LANGID_STRING_SIZE] =
     USBD_LANGID_STR & 0xFF, USBD_LANGID_STR >> 8
 };
 
+/**
+ * @brief   Microsoft OS string descriptor, binds WinUSB to the telemetry interface
+ */
+uint8_t USBD_WinUsbOsStrDesc[USBD_WINUSB_OS_STRING_SIZE] =
+{
+    /* Size */
+    USBD_WINUSB_OS_STRING_SIZE,
+    /* bDescriptorType */
+    USBD_DESC_STRING,
+    /* qwSignature "MSFT100" */
+    'M', 0x00, 'S', 0x00, 'F', 0x00, 'T', 0x00, '1', 0x00, '0', 0x00, '0', 0x00,
+    /* bMS_VendorCode */
+    USBD_VEN_REQ_MS_CODE,
+    /* bPad */
+    0x00
+};
+
 /**
  * @brief   Device qualifier descriptor
  */
@@ -552,6 +681,23 @@ static USBD_DESC_INFO_T USBD_FS_LangIdDescHandler(uint8_t usbSpeed)
     return descInfo;
 }
 
+/*!
+ * @brief     USB device FS Microsoft OS string descriptor
+ *
+ * @param     usbSpeed : usb speed
+ *
+ * @retval    usb descriptor information
+ */
+static USBD_DESC_INFO_T USBD_FS_WinUsbOsStrDescHandler(uint8_t usbSpeed)
+{
+    USBD_DESC_INFO_T descInfo;
+
+    descInfo.desc = USBD_WinUsbOsStrDesc;
+    descInfo.size = sizeof(USBD_WinUsbOsStrDesc);
+
+    return descInfo;
+}
+
 /*!
  * @brief     USB device FS manufacturer string descriptor
  *
@@ -0,0 +1,139 @@
+/*!
+ * @file        usbd_hid_itf.c
+ *
+ * @brief       usb device HID interface of the keyboard LEDs
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-01-16
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "usbd_hid_itf.h"
+#include "board.h"
+
+/** @addtogroup Examples
+  * @brief USBD HID examples
+  @{
+  */
+
+/** @addtogroup USBD_HID
+  @{
+  */
+
+/** @defgroup USBD_HID_Functions Functions
+  @{
+  */
+
+static USBD_STA_T USBD_FS_HID_ItfInit(void);
+static USBD_STA_T USBD_FS_HID_ItfDeInit(void);
+static USBD_STA_T USBD_FS_HID_ItfSetLed(uint8_t ledState);
+
+/**@} end of group USBD_HID_Functions */
+
+/** @defgroup USBD_HID_Structures Structures
+  @{
+  */
+
+/* HID interface handler */
+USBD_HID_INTERFACE_T USBD_HID_INTERFACE_FS =
+{
+    "HID Interface FS",
+    USBD_FS_HID_ItfInit,
+    USBD_FS_HID_ItfDeInit,
+    USBD_FS_HID_ItfSetLed,
+};
+
+/**@} end of group USBD_HID_Structures*/
+
+/** @defgroup USBD_HID_Functions Functions
+  @{
+  */
+
+/*!
+ * @brief       USB device initializes HID media handler
+ *
+ * @param       None
+ *
+ * @retval      USB device operation status
+ */
+static USBD_STA_T USBD_FS_HID_ItfInit(void)
+{
+    return USBD_FS_HID_ItfSetLed(0);
+}
+
+/*!
+ * @brief       USB device deinitializes HID media handler
+ *
+ * @param       None
+ *
+ * @retval      USB device operation status
+ */
+static USBD_STA_T USBD_FS_HID_ItfDeInit(void)
+{
+    /* No host to show the lock state */
+    return USBD_FS_HID_ItfSetLed(0);
+}
+
+/*!
+ * @brief       USB device HID keyboard LED handler
+ *
+ * @param       ledState: LED state of the host (USBD_HID_LED_NUM_LOCK...)
+ *
+ * @retval      USB device operation status
+ *
+ * @note        Called from the USB interrupt when the host changes the LED state,
+ *              by SET_REPORT or on the interrupt OUT endpoint.
+ */
+static USBD_STA_T USBD_FS_HID_ItfSetLed(uint8_t ledState)
+{
+    USBD_STA_T usbStatus = USBD_OK;
+
+    if (ledState & USBD_HID_LED_NUM_LOCK)
+    {
+        APM_EVAL_LEDOn(HID_LED_NUM_LOCK);
+    }
+    else
+    {
+        APM_EVAL_LEDOff(HID_LED_NUM_LOCK);
+    }
+
+    if (ledState & USBD_HID_LED_CAPS_LOCK)
+    {
+        APM_EVAL_LEDOn(HID_LED_CAPS_LOCK);
+    }
+    else
+    {
+        APM_EVAL_LEDOff(HID_LED_CAPS_LOCK);
+    }
+
+    if (ledState & USBD_HID_LED_SCROLL_LOCK)
+    {
+        APM_EVAL_LEDOn(HID_LED_SCROLL_LOCK);
+    }
+    else
+    {
+        APM_EVAL_LEDOff(HID_LED_SCROLL_LOCK);
+    }
+
+    return usbStatus;
+}
+
+/**@} end of group USBD_HID_Functions */
+/**@} end of group USBD_HID */
+/**@} end of group Examples */
@@ -0,0 +1,240 @@
+/*!
+ * @file        usbd_winusb_itf.c
+ *
+ * @brief       usb device WinUSB interface of the TSC telemetry
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-01-16
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "usbd_winusb_itf.h"
+#include "usb_device_user.h"
+
+/** @addtogroup Examples
+  * @brief USBD HID examples
+  @{
+  */
+
+/** @addtogroup USBD_HID
+  @{
+  */
+
+/** @defgroup USBD_HID_Functions Functions
+  @{
+  */
+
+static USBD_STA_T USBD_FS_WINUSB_ItfInit(void);
+static USBD_STA_T USBD_FS_WINUSB_ItfDeInit(void);
+static USBD_STA_T USBD_FS_WINUSB_ItfCtrl(uint8_t command, uint8_t *buffer, uint16_t length);
+static USBD_STA_T USBD_FS_WINUSB_ItfSendEnd(uint8_t epNum, uint8_t *buffer, uint32_t *length);
+static USBD_STA_T USBD_FS_WINUSB_ItfReceive(uint8_t *buffer, uint32_t *length);
+
+/**@} end of group USBD_HID_Functions */
+
+/** @defgroup USBD_HID_Structures Structures
+  @{
+  */
+
+/* WinUSB interface handler */
+USBD_WINUSB_INTERFACE_T USBD_WINUSB_INTERFACE_FS =
+{
+    "WINUSB Interface FS",
+    USBD_FS_WINUSB_ItfInit,
+    USBD_FS_WINUSB_ItfDeInit,
+    USBD_FS_WINUSB_ItfCtrl,
+    USBD_FS_WINUSB_ItfSend,
+    USBD_FS_WINUSB_ItfSendEnd,
+    USBD_FS_WINUSB_ItfReceive,
+};
+
+/**@} end of group USBD_HID_Structures*/
+
+/** @defgroup USBD_HID_Variables Variables
+  @{
+  */
+
+/* Commands received from the host */
+static uint8_t winusbRxBuffer[USBD_WINUSB_FS_MP_SIZE];
+
+/* Telemetry stream requested by the host */
+static __IO uint8_t winusbStream = 0;
+
+/**@} end of group USBD_HID_Variables*/
+
+/** @defgroup USBD_HID_Functions Functions
+  @{
+  */
+
+/*!
+ * @brief       USB device initializes WinUSB media handler
+ *
+ * @param       None
+ *
+ * @retval      USB device operation status
+ */
+static USBD_STA_T USBD_FS_WINUSB_ItfInit(void)
+{
+    USBD_STA_T usbStatus = USBD_OK;
+
+    USBD_WINUSB_ConfigRxBuffer(&gUsbDeviceFS, winusbRxBuffer);
+    winusbStream = 0;
+
+    return usbStatus;
+}
+
+/*!
+ * @brief       USB device deinitializes WinUSB media handler
+ *
+ * @param       None
+ *
+ * @retval      USB device operation status
+ */
+static USBD_STA_T USBD_FS_WINUSB_ItfDeInit(void)
+{
+    USBD_STA_T usbStatus = USBD_OK;
+
+    /* No host to read the records */
+    winusbStream = 0;
+
+    return usbStatus;
+}
+
+/*!
+ * @brief       USB device WinUSB interface control request handler
+ *
+ * @param       command: Command code
+ *
+ * @param       buffer: Command data buffer
+ *
+ * @param       length: Command data length
+ *
+ * @retval      USB device operation status
+ */
+static USBD_STA_T USBD_FS_WINUSB_ItfCtrl(uint8_t command, uint8_t *buffer, uint16_t length)
+{
+    USBD_STA_T usbStatus = USBD_OK;
+
+    return usbStatus;
+}
+
+/*!
+ * @brief       USB device WinUSB interface send handler
+ *
+ * @param       buffer: Data buffer
+ *
+ * @param       length: Data length
+ *
+ * @retval      USB device operation status
+ *
+ * @note        Returns USBD_BUSY while the previous buffer is being sent,
+ *              the buffer must not be changed before the next call returns USBD_OK.
+ */
+USBD_STA_T USBD_FS_WINUSB_ItfSend(uint8_t *buffer, uint16_t length)
+{
+    USBD_STA_T usbStatus = USBD_OK;
+    USBD_WINUSB_INFO_T *usbDevWINUSB = (USBD_WINUSB_INFO_T *)USBD_WINUSB_CLASS.classData;
+
+    if (usbDevWINUSB == NULL)
+    {
+        return USBD_FAIL;
+    }
+
+    if (usbDevWINUSB->winusbTx.state != USBD_WINUSB_XFER_IDLE)
+    {
+        return USBD_BUSY;
+    }
+
+    USBD_WINUSB_ConfigTxBuffer(&gUsbDeviceFS, buffer, length);
+    usbStatus = USBD_WINUSB_TxPacket(&gUsbDeviceFS);
+
+    return usbStatus;
+}
+
+/*!
+ * @brief       USB device WinUSB interface send end event handler
+ *
+ * @param       epNum: endpoint number
+ *
+ * @param       buffer: Data buffer
+ *
+ * @param       length: Data length
+ *
+ * @retval      USB device operation status
+ */
+static USBD_STA_T USBD_FS_WINUSB_ItfSendEnd(uint8_t epNum, uint8_t *buffer, uint32_t *length)
+{
+    USBD_STA_T usbStatus = USBD_OK;
+
+    return usbStatus;
+}
+
+/*!
+ * @brief       USB device WinUSB interface receive handler
+ *
+ * @param       buffer: Data buffer
+ *
+ * @param       length: Data length
+ *
+ * @retval      USB device operation status
+ *
+ * @note        The command is only recorded here, the ring buffer of the records
+ *              is reset by the main loop.
+ */
+static USBD_STA_T USBD_FS_WINUSB_ItfReceive(uint8_t *buffer, uint32_t *length)
+{
+    USBD_STA_T usbStatus = USBD_OK;
+
+    if (*length > 0)
+    {
+        switch (buffer[0])
+        {
+            case USBD_WINUSB_CMD_STREAM_START:
+                winusbStream = 1;
+                break;
+
+            case USBD_WINUSB_CMD_STREAM_STOP:
+                winusbStream = 0;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    USBD_WINUSB_RxPacket(&gUsbDeviceFS);
+
+    return usbStatus;
+}
+
+/*!
+ * @brief       Read the telemetry stream requested by the host
+ *
+ * @param       None
+ *
+ * @retval      1 if the stream is started, else 0
+ */
+uint8_t USBD_FS_WINUSB_ReadStream(void)
+{
+    return winusbStream;
+}
+
+/**@} end of group USBD_HID_Functions */
+/**@} end of group USBD_HID */
+/**@} end of group Examples */
@@ -36,10 +36,18 @@ extern "C" {
 #include "tsc_time.h"
 #include "tsc_touchkey.h"
 #include "tsc_linrot.h"
+#include "tsc_matrix.h"
 #include "tsc_object.h"
 #include "tsc_dxs.h"
 #include "tsc_ecs.h"
 #include "tsc_filter.h"
+#include "tsc_snapshot.h"
+#include "tsc_event.h"
+#include "tsc_gesture.h"
+#include "tsc_lowpower.h"
+#include "tsc_tune.h"
+#include "tsc_recovery.h"
+#include "tsc_telemetry.h"
 
 /** @addtogroup TSC_Driver_Library TSC Driver Library
   @{
@@ -85,6 +93,9 @@ typedef struct
 #if TOUCH_TOTAL_LNRTS > 0
     CONST TSC_LinRot_T   *For_LinRot; /*!< Pointer to the current Linear or Rotary sensor */
 #endif
+#if TOUCH_TOTAL_MATRICES > 0
+    CONST TSC_Matrix_T   *For_Matrix; /*!< Pointer to the current Matrix sensor */
+#endif
 } TSC_Globals_T;
 
 /**
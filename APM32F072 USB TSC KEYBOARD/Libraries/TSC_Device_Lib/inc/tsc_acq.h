@@ -64,6 +64,18 @@ extern "C" {
 
 #define TSC_NB_GROUPS (8)
 
+/* Access to the Meas, Refer and Delta of a channel from its Channel Data pointer */
+#if TOUCH_USE_SOA > 0
+#define TSC_CH_INDEX(pch)   ((TSC_tIndexDest_T)((pch) - TOUCH_SOA_CHANNEL_DATA))
+#define TSC_CH_MEAS(pch)    (TSC_ChArrays.Meas[TSC_CH_INDEX(pch)])
+#define TSC_CH_REFER(pch)   (TSC_ChArrays.Refer[TSC_CH_INDEX(pch)])
+#define TSC_CH_DELTA(pch)   (TSC_ChArrays.Delta[TSC_CH_INDEX(pch)])
+#else
+#define TSC_CH_MEAS(pch)    ((pch)->Meas)
+#define TSC_CH_REFER(pch)   ((pch)->Refer)
+#define TSC_CH_DELTA(pch)   ((pch)->Delta)
+#endif
+
 #define TSC_GROUP1 (0x01)
 #define TSC_GROUP2 (0x02)
 #define TSC_GROUP3 (0x04)
@@ -174,8 +186,32 @@ typedef struct
     unsigned int DataReady : 1;   /*!< To identify a new measurement (TSC_DATA_T) */
     unsigned int AcqStatus : 2;   /*!< Acquisition status (TSC_ACQ_STATUS_T) */
     unsigned int ObjStatus : 2;   /*!< Object status (TSC_OBJ_STATUS_T) */
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+    unsigned int ScanIdle  : 1;   /*!< Channel acquired at the idle rate, set by the Object */
+#endif
 } TSC_Channel_Flag_T;
 
+#if TOUCH_USE_SOA > 0
+/**
+ * @brief    Channel Data (status part)
+ *           Meas, Refer and Delta are stored in TSC_ChArrays at the same index.
+ */
+typedef struct
+{
+    TSC_Channel_Flag_T   Flag;    /*!< Flag */
+    TSC_tRefRest_T       RefRest; /*!< Reference rest for ECS */
+} TSC_Channel_Data_T;
+
+/**
+ * @brief    Channel arrays, indexed as the Channel Data array
+ */
+typedef struct
+{
+    TSC_tMeas_T          Meas[TOUCH_TOTAL_CHANNELS];  /*!< Last acquisition measures */
+    TSC_tRefer_T         Refer[TOUCH_TOTAL_CHANNELS]; /*!< References */
+    TSC_tDelta_T         Delta[TOUCH_TOTAL_CHANNELS]; /*!< Deltas */
+} TSC_ChannelArrays_T;
+#else
 /**
  * @brief    Channel Data
  */
@@ -189,6 +225,7 @@ typedef struct
     TSC_tMeas_T          Meas;    /*!< Hold the last acquisition measure */
 #endif
 } TSC_Channel_Data_T;
+#endif
 
 /**
  * @brief   Block Configuration
@@ -218,8 +255,104 @@ typedef struct
     TSC_tNum_T            numBlock;     /*!< Number of blocks in the zone */
 } TSC_Zone_T;
 
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+/**
+ * @brief   Frame of raw measurements.
+ *          A Frame holds the counters of all Blocks, stored by channel destination index.
+ */
+typedef struct
+{
+#if TOUCH_USE_DMA_READOUT > 0
+    TSC_tMeas_T      Raw[TOUCH_TOTAL_BLOCKS][TSC_NB_GROUPS]; /*!< Group counters of each burst copied by DMA */
+#else
+    TSC_tMeas_T      Meas[TOUCH_TOTAL_CHANNELS]; /*!< Raw measurements */
+#endif
+#if TOUCH_USE_DMA_READOUT > 0
+    uint8_t          Burst[TOUCH_TOTAL_CHANNELS]; /*!< Burst in which each channel was acquired */
+#endif
+    uint32_t         Acquired;                   /*!< Channels acquired in this Frame (bit n = destination index n) */
+    TSC_tTick_ms_T   Tick;                       /*!< Tick_ms value when the last Block ended */
+    TSC_STATUS_T     Status;                     /*!< TSC_STATUS_ERROR if a max count error occurred */
+#if TOUCH_USE_LOWPOWER > 0
+    uint8_t          Guard;                      /*!< 1 if the Frame holds the guard channels only */
+#endif
+} TSC_Frame_T;
+
+/**
+ * @brief   Burst of a Frame: one channel at most per group.
+ */
+typedef struct
+{
+    uint32_t         msk_IOCHCTRL_channels;        /*!< Mask of all channel IOs (electrodes and shields) */
+    uint32_t         msk_IOGCSTS_groups;           /*!< Mask of all groups acquired */
+    TSC_tIndexSrc_T  IdxSrc[TSC_NB_GROUPS];        /*!< Index of TSC->IOGxCNT[] registers of each channel */
+    TSC_tIndexDest_T IdxDest[TSC_NB_GROUPS];       /*!< Index in the Channel data array of each channel */
+    TSC_tNum_T       NumChannel;                   /*!< Number of channels acquired in the burst */
+} TSC_Burst_T;
+
+/**
+ * @brief   Burst schedule of the next Frame.
+ *          Variables of this structure type must be placed in RAM only.
+ */
+typedef struct
+{
+    TSC_Burst_T      Burst[TOUCH_TOTAL_BLOCKS];    /*!< Bursts of the Frame */
+#if TOUCH_USE_DMA_READOUT > 0
+    uint8_t          BurstOf[TOUCH_TOTAL_CHANNELS]; /*!< Burst of each channel */
+#endif
+    uint32_t         Acquired;                     /*!< Channels acquired (bit n = destination index n) */
+    uint32_t         msk_IOCHCTRL_shields;         /*!< Mask of the shield IOs, added to all bursts */
+    TSC_tNum_T       NumBurst;                     /*!< Number of bursts of the Frame */
+    TSC_tNum_T       FullBurst;                    /*!< Number of bursts when all channels are acquired */
+    uint8_t          IdleCount;                    /*!< Frames left before the idle channels are acquired */
+#if TOUCH_USE_LOWPOWER > 0
+    TSC_Burst_T      GuardBurst;                   /*!< All channel IOs of each group ganged as one channel */
+    uint8_t          GuardMode;                    /*!< 1 to acquire the guard burst only */
+    uint8_t          GuardFrame;                   /*!< 1 if the current Frame is the guard burst */
+    __IO uint16_t    GuardWait;                    /*!< Ticks left before the guard burst is started */
+    __IO uint16_t    TickExtra;                    /*!< Ticks of the current timer period minus 1 */
+    uint16_t         TickTotal;                    /*!< Ticks counted since the last duty read */
+    uint16_t         TickBusy;                     /*!< Ticks with a burst running or pending */
+    uint16_t         TickWake;                     /*!< Timer updates counted since the last duty read */
+#endif
+} TSC_Schedule_T;
+
+/**
+ * @brief   Single-producer/single-consumer queue of Frames.
+ *          The producer is the TSC interrupt routine and the consumer is the application.
+ *          Variables of this structure type must be placed in RAM only.
+ */
+typedef struct
+{
+    TSC_Frame_T      Frame[TOUCH_ACQ_FRAME_QUEUE]; /*!< Frame slots */
+    __IO uint8_t     Head;                         /*!< Next slot written, modified by the producer only */
+    __IO uint8_t     Tail;                         /*!< Next slot read, modified by the consumer only */
+    __IO TSC_tIndex_T Block;                       /*!< Burst currently acquired */
+    __IO uint16_t    Overrun;                      /*!< Number of Frames dropped because the queue was full */
+#if TOUCH_USE_DMA_READOUT > 0
+    __IO uint8_t     DmaBusy;                      /*!< Counters copy running */
+    __IO uint8_t     StartPending;                 /*!< Next burst to start at the end of the copy */
+#endif
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+    __IO uint32_t    Cycles;                       /*!< CPU cycles spent in the interrupt routines of the last burst */
+    __IO uint32_t    CyclesMax;                    /*!< Maximum CPU cycles spent in the interrupt routines of a burst */
+#endif
+} TSC_FrameQueue_T;
+#endif
+
 /**@} end of group TSC_Acquisition_Structures */
 
+/** @defgroup TSC_Acquisition_Variables Variables
+  @{
+*/
+
+#if TOUCH_USE_SOA > 0
+extern TSC_ChannelArrays_T TSC_ChArrays;
+extern TSC_Channel_Data_T TOUCH_SOA_CHANNEL_DATA[];
+#endif
+
+/**@} end of group TSC_Acquisition_Variables */
+
 /** @defgroup TSC_Acquisition_Functions Functions
   @{
   */
@@ -242,6 +375,32 @@ TSC_STATUS_T TSC_Acq_ReadBlockResult(TSC_tIndex_T idxBlock, TSC_pMeasFilter_T mf
 TSC_STATUS_T TSC_Acq_CalibrateBlock(TSC_tIndex_T block);
 void TSC_acq_ClearBlockData(TSC_tIndex_T block);
 
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+TSC_STATUS_T TSC_Acq_ConfigScheduler(void);
+TSC_tNum_T TSC_Acq_ReadBurstCount(void);
+void TSC_Acq_StartEngine(void);
+void TSC_Acq_StopEngine(void);
+void TSC_Acq_ProcessInterrupt(void);
+void TSC_Acq_ProcessDischarge(void);
+#if TOUCH_USE_DMA_READOUT > 0
+void TSC_Acq_ProcessDmaReadout(void);
+#endif
+CONST TSC_Frame_T* TSC_Acq_ReadFrame(void);
+void TSC_Acq_ReleaseFrame(void);
+uint16_t TSC_Acq_ReadOverrun(void);
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+void TSC_Acq_ReadCycles(uint32_t *last, uint32_t *max);
+#endif
+TSC_STATUS_T TSC_Acq_ReadFrameResult(CONST TSC_Frame_T *frame, TSC_pMeasFilter_T mfilter, TSC_pDeltaFilter_T dfilter);
+#if TOUCH_USE_LOWPOWER > 0
+void TSC_Acq_ConfigGuardMode(uint8_t enable);
+TSC_tNum_T TSC_Acq_ReadGuardCount(void);
+TSC_tMeas_T TSC_Acq_ReadGuardMeas(CONST TSC_Frame_T *frame, TSC_tIndex_T idx);
+uint16_t TSC_Acq_ProcessScanTick(void);
+uint16_t TSC_Acq_ReadScanDuty(uint16_t *wakeRate);
+#endif
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,6 +37,27 @@
 */
 
 /* Local check */
+#ifdef TOUCH_SENSOR_CHANNELS
+#ifndef TOUCH_SENSOR_SAMPCAPS
+#error "Please Config TOUCH_SENSOR_SAMPCAPS."
+#endif
+
+#if ((TSC_SENSOR_CHANNEL_MSK & TSC_SENSOR_SAMPCAP_MSK) != 0)
+#error "A TSC IO can not be used as channel and sampling capacitor."
+#endif
+
+#if ((TSC_SENSOR_SHIELD_MSK & (TSC_SENSOR_CHANNEL_MSK | TSC_SENSOR_SAMPCAP_MSK)) != 0)
+#error "A TSC IO used as shield can not be used as channel or sampling capacitor."
+#endif
+
+#if ((TSC_SNS_POPCNT4(TSC_SENSOR_SAMPCAP_MSK >> 0) > 1) || (TSC_SNS_POPCNT4(TSC_SENSOR_SAMPCAP_MSK >> 4) > 1) || \
+     (TSC_SNS_POPCNT4(TSC_SENSOR_SAMPCAP_MSK >> 8) > 1) || (TSC_SNS_POPCNT4(TSC_SENSOR_SAMPCAP_MSK >> 12) > 1) || \
+     (TSC_SNS_POPCNT4(TSC_SENSOR_SAMPCAP_MSK >> 16) > 1) || (TSC_SNS_POPCNT4(TSC_SENSOR_SAMPCAP_MSK >> 20) > 1) || \
+     (TSC_SNS_POPCNT4(TSC_SENSOR_SAMPCAP_MSK >> 24) > 1) || (TSC_SNS_POPCNT4(TSC_SENSOR_SAMPCAP_MSK >> 28) > 1))
+#error "Only one sampling capacitor per group is allowed."
+#endif
+#endif
+
 #if ((TOUCH_TOTAL_CHANNELS < 1) || (TOUCH_TOTAL_CHANNELS > 24))
 #error "TOUCH_TOTAL_CHANNELS can be (1 .. 24)."
 #endif
@@ -61,12 +82,16 @@
 #error "TOUCH_TOTAL_LINROTS_B can be (0 .. 24)."
 #endif
 
+#if ((TOUCH_TOTAL_MATRICES < 0) || (TOUCH_TOTAL_MATRICES > 8))
+#error "TOUCH_TOTAL_MATRICES can be (0 .. 8)."
+#endif
+
 #if ((TOUCH_TOTAL_OBJECTS < 1) || (TOUCH_TOTAL_OBJECTS > 24))
 #error "TOUCH_TOTAL_OBJECTS can be (1 .. 24)."
 #endif
 
-#if ((TOUCH_TOTAL_KEYS + TOUCH_TOTAL_LNRTS) > 24)
-#error "The Sum of TouchKeys and Linear/Rotary sensors exceeds 24."
+#if ((TOUCH_TOTAL_KEYS + TOUCH_TOTAL_LNRTS + TOUCH_TOTAL_MATRICES) > 24)
+#error "The Sum of TouchKeys, Linear/Rotary and Matrix sensors exceeds 24."
 #endif
 
 #ifndef TOUCH_TSC_GPIO_CONFIG
@@ -209,12 +234,16 @@
 #define TSC_GROUP8_ENABLED (1)
 #endif
 
-#ifndef TOUCH_DELAY_DISCHARGE_ALL
-#error "Please Config TOUCH_DELAY_DISCHARGE_ALL."
+#ifdef TOUCH_DELAY_DISCHARGE_ALL
+#error "TOUCH_DELAY_DISCHARGE_ALL is replaced by TOUCH_DELAY_DISCHARGE_US."
 #endif
 
-#if ((TOUCH_DELAY_DISCHARGE_ALL < 0) || (TOUCH_DELAY_DISCHARGE_ALL > 65535))
-#error "TOUCH_DELAY_DISCHARGE_ALL can be (0 .. 65535)."
+#ifndef TOUCH_DELAY_DISCHARGE_US
+#error "Please Config TOUCH_DELAY_DISCHARGE_US."
+#endif
+
+#if ((TOUCH_DELAY_DISCHARGE_US < 1) || (TOUCH_DELAY_DISCHARGE_US > 1000))
+#error "TOUCH_DELAY_DISCHARGE_US can be (1 .. 1000)."
 #endif
 
 /* Global check */
@@ -242,6 +271,10 @@
 #error "Please Config TOUCH_TOTAL_LINROTS_B."
 #endif
 
+#ifndef TOUCH_TOTAL_MATRICES
+#error "Please Config TOUCH_TOTAL_MATRICES."
+#endif
+
 #ifndef TOUCH_TOTAL_OBJECTS
 #error "Please Config TOUCH_TOTAL_OBJECTS."
 #endif
@@ -249,8 +282,8 @@
 #define TOUCH_TOTAL_KEYS (TOUCH_TOTAL_TOUCHKEYS + TOUCH_TOTAL_TOUCHKEYS_B)
 #define TOUCH_TOTAL_LNRTS (TOUCH_TOTAL_LINROTS + TOUCH_TOTAL_LINROTS_B)
 
-#if ((TOUCH_TOTAL_KEYS == 0) && (TOUCH_TOTAL_LNRTS == 0))
-#error "Please Config TouchKey and Linear/Rotary sensors."
+#if ((TOUCH_TOTAL_KEYS == 0) && (TOUCH_TOTAL_LNRTS == 0) && (TOUCH_TOTAL_MATRICES == 0))
+#error "Please Config TouchKey, Linear/Rotary and Matrix sensors."
 #endif
 
 #ifndef TOUCH_CALIB_SAMPLES
@@ -373,6 +406,32 @@
 #error "TOUCH_LINROT_CALIB_TH can be (0 .. 255)."
 #endif
 
+#if TOUCH_TOTAL_MATRICES > 0
+#ifndef TOUCH_MATRIX_DETECT_IN_TH
+#error "Please Config TOUCH_MATRIX_DETECT_IN_TH."
+#endif
+
+#ifndef TOUCH_MATRIX_DETECT_OUT_TH
+#error "Please Config TOUCH_MATRIX_DETECT_OUT_TH."
+#endif
+
+#if ((TOUCH_MATRIX_DETECT_OUT_TH < 1) || (TOUCH_MATRIX_DETECT_OUT_TH > (TOUCH_MATRIX_DETECT_IN_TH-1)))
+#error "TOUCH_MATRIX_DETECT_OUT_TH can be (1 .. TOUCH_MATRIX_DETECT_IN_TH-1)."
+#endif
+
+#if ((TOUCH_MATRIX_DETECT_IN_TH < (TOUCH_MATRIX_DETECT_OUT_TH+1)) || (TOUCH_MATRIX_DETECT_IN_TH > 255))
+#error "TOUCH_MATRIX_DETECT_IN_TH can be (TOUCH_MATRIX_DETECT_OUT_TH+1 .. 255)."
+#endif
+
+#ifndef TOUCH_MATRIX_CALIB_TH
+#error "Please Config TOUCH_MATRIX_CALIB_TH."
+#endif
+
+#if ((TOUCH_MATRIX_CALIB_TH < 0) || (TOUCH_MATRIX_CALIB_TH > 255))
+#error "TOUCH_MATRIX_CALIB_TH can be (0 .. 255)."
+#endif
+#endif
+
 #ifndef TOUCH_LINROT_USE_NORMDELTA
 #error "Please Config TOUCH_LINROT_USE_NORMDELTA."
 #endif
@@ -405,6 +464,40 @@
 #error "TOUCH_LINROT_RESOLUTION can be (1 .. 8)."
 #endif
 
+#ifndef TOUCH_LINROT_USE_CENTROID
+#error "Please Config TOUCH_LINROT_USE_CENTROID."
+#endif
+
+#if ((TOUCH_LINROT_USE_CENTROID < 0) || (TOUCH_LINROT_USE_CENTROID > 1))
+#error "TOUCH_LINROT_USE_CENTROID can be (0 .. 1)."
+#endif
+
+#if TOUCH_LINROT_USE_CENTROID > 0
+#ifndef TOUCH_LINROT_POS_BITS
+#error "Please Config TOUCH_LINROT_POS_BITS."
+#endif
+
+#if ((TOUCH_LINROT_POS_BITS < 8) || (TOUCH_LINROT_POS_BITS > 12))
+#error "TOUCH_LINROT_POS_BITS can be (8 .. 12)."
+#endif
+
+#ifndef TOUCH_LINROT_SMOOTHING
+#error "Please Config TOUCH_LINROT_SMOOTHING."
+#endif
+
+#if ((TOUCH_LINROT_SMOOTHING < 0) || (TOUCH_LINROT_SMOOTHING > 4))
+#error "TOUCH_LINROT_SMOOTHING can be (0 .. 4)."
+#endif
+
+#ifndef TOUCH_LINROT_USE_VELOCITY
+#error "Please Config TOUCH_LINROT_USE_VELOCITY."
+#endif
+
+#if ((TOUCH_LINROT_USE_VELOCITY < 0) || (TOUCH_LINROT_USE_VELOCITY > 1))
+#error "TOUCH_LINROT_USE_VELOCITY can be (0 .. 1)."
+#endif
+#endif
+
 #ifndef TOUCH_DEBOUNCE_PROX
 #error "Please Config TOUCH_DEBOUNCE_PROX."
 #endif
@@ -445,6 +538,48 @@
 #error "TOUCH_DEBOUNCE_ERROR can be (0 .. 63)."
 #endif
 
+#ifndef TOUCH_USE_ADAPTIVE_DEBOUNCE
+#error "Please Config TOUCH_USE_ADAPTIVE_DEBOUNCE."
+#endif
+
+#if ((TOUCH_USE_ADAPTIVE_DEBOUNCE != 0) && (TOUCH_USE_ADAPTIVE_DEBOUNCE != 1))
+#error "TOUCH_USE_ADAPTIVE_DEBOUNCE can be (0 .. 1)."
+#endif
+
+#if TOUCH_USE_ADAPTIVE_DEBOUNCE > 0
+#ifndef TOUCH_DEBOUNCE_DETECT_MIN
+#error "Please Config TOUCH_DEBOUNCE_DETECT_MIN."
+#endif
+
+#if ((TOUCH_DEBOUNCE_DETECT_MIN < 0) || (TOUCH_DEBOUNCE_DETECT_MIN > 63))
+#error "TOUCH_DEBOUNCE_DETECT_MIN can be (0 .. 63)."
+#endif
+
+#ifndef TOUCH_DEBOUNCE_DETECT_MAX
+#error "Please Config TOUCH_DEBOUNCE_DETECT_MAX."
+#endif
+
+#if ((TOUCH_DEBOUNCE_DETECT_MAX < TOUCH_DEBOUNCE_DETECT_MIN) || (TOUCH_DEBOUNCE_DETECT_MAX > 63))
+#error "TOUCH_DEBOUNCE_DETECT_MAX can be (TOUCH_DEBOUNCE_DETECT_MIN .. 63)."
+#endif
+
+#ifndef TOUCH_DEBOUNCE_SNR
+#error "Please Config TOUCH_DEBOUNCE_SNR."
+#endif
+
+#if ((TOUCH_DEBOUNCE_SNR < 1) || (TOUCH_DEBOUNCE_SNR > 15))
+#error "TOUCH_DEBOUNCE_SNR can be (1 .. 15)."
+#endif
+
+#ifndef TOUCH_DEBOUNCE_NOISE_WEIGHT
+#error "Please Config TOUCH_DEBOUNCE_NOISE_WEIGHT."
+#endif
+
+#if ((TOUCH_DEBOUNCE_NOISE_WEIGHT < 1) || (TOUCH_DEBOUNCE_NOISE_WEIGHT > 6))
+#error "TOUCH_DEBOUNCE_NOISE_WEIGHT can be (1 .. 6)."
+#endif
+#endif
+
 #ifndef TOUCH_LINROT_DIR_CHG_DEB
 #error "Please Config TOUCH_LINROT_DIR_CHG_DEB."
 #endif
@@ -477,6 +612,32 @@
 #error "TOUCH_ECS_DELAY can be (0 .. 5000)."
 #endif
 
+#ifndef TOUCH_ECS_INCREMENTAL
+#error "Please Config TOUCH_ECS_INCREMENTAL."
+#endif
+
+#if ((TOUCH_ECS_INCREMENTAL != 0) && (TOUCH_ECS_INCREMENTAL != 1))
+#error "TOUCH_ECS_INCREMENTAL can be (0 .. 1)."
+#endif
+
+#ifndef TOUCH_ECS_PERIOD
+#error "Please Config TOUCH_ECS_PERIOD."
+#endif
+
+#if ((TOUCH_ECS_PERIOD < 16) || (TOUCH_ECS_PERIOD > 1000))
+#error "TOUCH_ECS_PERIOD can be (16 .. 1000)."
+#endif
+
+#if TOUCH_ECS_INCREMENTAL > 0
+#ifndef TOUCH_ECS_MAX_SLICE
+#error "Please Config TOUCH_ECS_MAX_SLICE."
+#endif
+
+#if ((TOUCH_ECS_MAX_SLICE < 1) || (TOUCH_ECS_MAX_SLICE > 32))
+#error "TOUCH_ECS_MAX_SLICE can be (1 .. 32)."
+#endif
+#endif
+
 #ifndef TOUCH_USE_MEAS
 #error "Please Config TOUCH_USE_MEAS."
 #endif
@@ -509,6 +670,422 @@
 #error "TOUCH_USE_ACQ_INTERRUPT can be (0 .. 1)."
 #endif
 
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+#ifndef TOUCH_ACQ_FRAME_QUEUE
+#error "Please Config TOUCH_ACQ_FRAME_QUEUE."
+#endif
+
+#if ((TOUCH_ACQ_FRAME_QUEUE != 2) && (TOUCH_ACQ_FRAME_QUEUE != 4) && (TOUCH_ACQ_FRAME_QUEUE != 8) && (TOUCH_ACQ_FRAME_QUEUE != 16))
+#error "TOUCH_ACQ_FRAME_QUEUE can be (2, 4, 8, 16)."
+#endif
+
+#ifndef TOUCH_SCAN_IDLE_DIVIDER
+#error "Please Config TOUCH_SCAN_IDLE_DIVIDER."
+#endif
+
+#if ((TOUCH_SCAN_IDLE_DIVIDER < 1) || (TOUCH_SCAN_IDLE_DIVIDER > 16))
+#error "TOUCH_SCAN_IDLE_DIVIDER can be (1 .. 16)."
+#endif
+
+#if (TOUCH_TOTAL_CHANNELS > 32)
+#error "TOUCH_TOTAL_CHANNELS can be (1 .. 32) with TOUCH_USE_ACQ_INTERRUPT."
+#endif
+#endif
+
+#ifndef TOUCH_USE_DMA_READOUT
+#error "Please Config TOUCH_USE_DMA_READOUT."
+#endif
+
+#if ((TOUCH_USE_DMA_READOUT != 0) && (TOUCH_USE_DMA_READOUT != 1))
+#error "TOUCH_USE_DMA_READOUT can be (0 .. 1)."
+#endif
+
+#if ((TOUCH_USE_DMA_READOUT > 0) && (TOUCH_USE_ACQ_INTERRUPT == 0))
+#error "TOUCH_USE_DMA_READOUT requires TOUCH_USE_ACQ_INTERRUPT."
+#endif
+
+#if TOUCH_USE_DMA_READOUT > 0
+#ifndef TOUCH_DMA_READOUT_CHANNEL
+#error "Please Config TOUCH_DMA_READOUT_CHANNEL."
+#endif
+
+#if ((TOUCH_DMA_READOUT_CHANNEL < 1) || (TOUCH_DMA_READOUT_CHANNEL > 7))
+#error "TOUCH_DMA_READOUT_CHANNEL can be (1 .. 7)."
+#endif
+#endif
+
+#ifndef TOUCH_USE_SOA
+#error "Please Config TOUCH_USE_SOA."
+#endif
+
+#if ((TOUCH_USE_SOA != 0) && (TOUCH_USE_SOA != 1))
+#error "TOUCH_USE_SOA can be (0 .. 1)."
+#endif
+
+#if TOUCH_USE_SOA > 0
+#ifndef TOUCH_SOA_CHANNEL_DATA
+#error "Please Config TOUCH_SOA_CHANNEL_DATA."
+#endif
+#endif
+
+#ifndef TOUCH_USE_ACQ_CYCLE_COUNT
+#error "Please Config TOUCH_USE_ACQ_CYCLE_COUNT."
+#endif
+
+#if ((TOUCH_USE_ACQ_CYCLE_COUNT != 0) && (TOUCH_USE_ACQ_CYCLE_COUNT != 1))
+#error "TOUCH_USE_ACQ_CYCLE_COUNT can be (0 .. 1)."
+#endif
+
+#if ((TOUCH_USE_ACQ_CYCLE_COUNT > 0) && (TOUCH_USE_ACQ_INTERRUPT == 0))
+#error "TOUCH_USE_ACQ_CYCLE_COUNT requires TOUCH_USE_ACQ_INTERRUPT."
+#endif
+
+#ifndef TOUCH_USE_FILTER_BANK
+#error "Please Config TOUCH_USE_FILTER_BANK."
+#endif
+
+#if ((TOUCH_USE_FILTER_BANK != 0) && (TOUCH_USE_FILTER_BANK != 1))
+#error "TOUCH_USE_FILTER_BANK can be (0 .. 1)."
+#endif
+
+#if TOUCH_USE_FILTER_BANK > 0
+#ifndef TOUCH_FILTER_MAX_STAGES
+#error "Please Config TOUCH_FILTER_MAX_STAGES."
+#endif
+
+#if ((TOUCH_FILTER_MAX_STAGES < 1) || (TOUCH_FILTER_MAX_STAGES > 4))
+#error "TOUCH_FILTER_MAX_STAGES can be (1 .. 4)."
+#endif
+#endif
+
+#ifndef TOUCH_USE_SNAPSHOT
+#error "Please Config TOUCH_USE_SNAPSHOT."
+#endif
+
+#if ((TOUCH_USE_SNAPSHOT != 0) && (TOUCH_USE_SNAPSHOT != 1))
+#error "TOUCH_USE_SNAPSHOT can be (0 .. 1)."
+#endif
+
+#if TOUCH_USE_SNAPSHOT > 0
+#ifndef TOUCH_SNAPSHOT_PAGE_ADDR
+#error "Please Config TOUCH_SNAPSHOT_PAGE_ADDR."
+#endif
+
+#if ((TOUCH_SNAPSHOT_PAGE_ADDR < 0x08000000) || ((TOUCH_SNAPSHOT_PAGE_ADDR & 0x7FF) != 0))
+#error "TOUCH_SNAPSHOT_PAGE_ADDR must be the address of a 2KB flash page."
+#endif
+
+#ifndef TOUCH_SNAPSHOT_PAGE_SIZE
+#error "Please Config TOUCH_SNAPSHOT_PAGE_SIZE."
+#endif
+
+#if ((TOUCH_SNAPSHOT_PAGE_SIZE != 1024) && (TOUCH_SNAPSHOT_PAGE_SIZE != 2048))
+#error "TOUCH_SNAPSHOT_PAGE_SIZE can be (1024, 2048)."
+#endif
+
+#ifndef TOUCH_SNAPSHOT_CHECK_SAMPLES
+#error "Please Config TOUCH_SNAPSHOT_CHECK_SAMPLES."
+#endif
+
+#if ((TOUCH_SNAPSHOT_CHECK_SAMPLES < 1) || (TOUCH_SNAPSHOT_CHECK_SAMPLES > 8))
+#error "TOUCH_SNAPSHOT_CHECK_SAMPLES can be (1 .. 8)."
+#endif
+
+#if (TOUCH_SNAPSHOT_CHECK_SAMPLES >= (TOUCH_CALIB_SAMPLES + TOUCH_CALIB_DELAY))
+#error "TOUCH_SNAPSHOT_CHECK_SAMPLES must be lower than TOUCH_CALIB_SAMPLES + TOUCH_CALIB_DELAY."
+#endif
+
+#ifndef TOUCH_SNAPSHOT_MATCH_TH
+#error "Please Config TOUCH_SNAPSHOT_MATCH_TH."
+#endif
+
+#if ((TOUCH_SNAPSHOT_MATCH_TH < 1) || (TOUCH_SNAPSHOT_MATCH_TH > 255))
+#error "TOUCH_SNAPSHOT_MATCH_TH can be (1 .. 255)."
+#endif
+
+#ifndef TOUCH_SNAPSHOT_SAVE_TH
+#error "Please Config TOUCH_SNAPSHOT_SAVE_TH."
+#endif
+
+#if ((TOUCH_SNAPSHOT_SAVE_TH < 0) || (TOUCH_SNAPSHOT_SAVE_TH > 255))
+#error "TOUCH_SNAPSHOT_SAVE_TH can be (0 .. 255)."
+#endif
+
+#ifndef TOUCH_SNAPSHOT_PERIOD
+#error "Please Config TOUCH_SNAPSHOT_PERIOD."
+#endif
+
+#if ((TOUCH_SNAPSHOT_PERIOD < 1) || (TOUCH_SNAPSHOT_PERIOD > 63))
+#error "TOUCH_SNAPSHOT_PERIOD can be (1 .. 63)."
+#endif
+#endif
+
+#ifndef TOUCH_USE_EVENT
+#error "Please Config TOUCH_USE_EVENT."
+#endif
+
+#if ((TOUCH_USE_EVENT != 0) && (TOUCH_USE_EVENT != 1))
+#error "TOUCH_USE_EVENT can be (0 .. 1)."
+#endif
+
+#if TOUCH_USE_EVENT > 0
+#ifndef TOUCH_EVENT_QUEUE_SIZE
+#error "Please Config TOUCH_EVENT_QUEUE_SIZE."
+#endif
+
+#if ((TOUCH_EVENT_QUEUE_SIZE != 2) && (TOUCH_EVENT_QUEUE_SIZE != 4) && (TOUCH_EVENT_QUEUE_SIZE != 8) && \
+     (TOUCH_EVENT_QUEUE_SIZE != 16) && (TOUCH_EVENT_QUEUE_SIZE != 32) && (TOUCH_EVENT_QUEUE_SIZE != 64))
+#error "TOUCH_EVENT_QUEUE_SIZE can be (2, 4, 8, 16, 32, 64)."
+#endif
+#endif
+
+#ifndef TOUCH_USE_GESTURE
+#error "Please Config TOUCH_USE_GESTURE."
+#endif
+
+#if ((TOUCH_USE_GESTURE != 0) && (TOUCH_USE_GESTURE != 1))
+#error "TOUCH_USE_GESTURE can be (0 .. 1)."
+#endif
+
+#if TOUCH_USE_GESTURE > 0
+#if TOUCH_USE_EVENT == 0
+#error "TOUCH_USE_GESTURE needs TOUCH_USE_EVENT."
+#endif
+
+#ifndef TOUCH_GESTURE_QUEUE_SIZE
+#error "Please Config TOUCH_GESTURE_QUEUE_SIZE."
+#endif
+
+#if ((TOUCH_GESTURE_QUEUE_SIZE != 2) && (TOUCH_GESTURE_QUEUE_SIZE != 4) && (TOUCH_GESTURE_QUEUE_SIZE != 8) && \
+     (TOUCH_GESTURE_QUEUE_SIZE != 16) && (TOUCH_GESTURE_QUEUE_SIZE != 32) && (TOUCH_GESTURE_QUEUE_SIZE != 64))
+#error "TOUCH_GESTURE_QUEUE_SIZE can be (2, 4, 8, 16, 32, 64)."
+#endif
+
+#ifndef TOUCH_GESTURE_TAP_MS
+#error "Please Config TOUCH_GESTURE_TAP_MS."
+#endif
+
+#if ((TOUCH_GESTURE_TAP_MS < 1) || (TOUCH_GESTURE_TAP_MS > 10000))
+#error "TOUCH_GESTURE_TAP_MS can be (1 .. 10000)."
+#endif
+
+#ifndef TOUCH_GESTURE_DOUBLE_TAP_MS
+#error "Please Config TOUCH_GESTURE_DOUBLE_TAP_MS."
+#endif
+
+#if ((TOUCH_GESTURE_DOUBLE_TAP_MS < 0) || (TOUCH_GESTURE_DOUBLE_TAP_MS > 10000))
+#error "TOUCH_GESTURE_DOUBLE_TAP_MS can be (0 .. 10000)."
+#endif
+
+#ifndef TOUCH_GESTURE_LONG_PRESS_MS
+#error "Please Config TOUCH_GESTURE_LONG_PRESS_MS."
+#endif
+
+#if ((TOUCH_GESTURE_LONG_PRESS_MS < 0) || (TOUCH_GESTURE_LONG_PRESS_MS > 10000))
+#error "TOUCH_GESTURE_LONG_PRESS_MS can be (0 .. 10000)."
+#endif
+
+#ifndef TOUCH_GESTURE_REPEAT_MS
+#error "Please Config TOUCH_GESTURE_REPEAT_MS."
+#endif
+
+#if ((TOUCH_GESTURE_REPEAT_MS < 0) || (TOUCH_GESTURE_REPEAT_MS > 10000))
+#error "TOUCH_GESTURE_REPEAT_MS can be (0 .. 10000)."
+#endif
+
+#ifndef TOUCH_GESTURE_SWIPE_MS
+#error "Please Config TOUCH_GESTURE_SWIPE_MS."
+#endif
+
+#if ((TOUCH_GESTURE_SWIPE_MS < 0) || (TOUCH_GESTURE_SWIPE_MS > 10000))
+#error "TOUCH_GESTURE_SWIPE_MS can be (0 .. 10000)."
+#endif
+
+#ifndef TOUCH_GESTURE_SWIPE_DIST
+#error "Please Config TOUCH_GESTURE_SWIPE_DIST."
+#endif
+
+#if ((TOUCH_GESTURE_SWIPE_DIST < 1) || (TOUCH_GESTURE_SWIPE_DIST > 255))
+#error "TOUCH_GESTURE_SWIPE_DIST can be (1 .. 255)."
+#endif
+#endif
+
+#ifndef TOUCH_USE_LOWPOWER
+#error "Please Config TOUCH_USE_LOWPOWER."
+#endif
+
+#if ((TOUCH_USE_LOWPOWER != 0) && (TOUCH_USE_LOWPOWER != 1))
+#error "TOUCH_USE_LOWPOWER can be (0 .. 1)."
+#endif
+
+#if TOUCH_USE_LOWPOWER > 0
+#if TOUCH_USE_ACQ_INTERRUPT == 0
+#error "TOUCH_USE_LOWPOWER requires TOUCH_USE_ACQ_INTERRUPT."
+#endif
+
+#if ((TOUCH_DISCHARGE_TIMER_PERIOD * TOUCH_TICK_FREQ) != 1000000)
+#error "TOUCH_USE_LOWPOWER requires TOUCH_DISCHARGE_TIMER_PERIOD = 1000000 / TOUCH_TICK_FREQ (the timing tick is the discharge timer update)."
+#endif
+
+#ifndef TOUCH_LP_IDLE_SEC
+#error "Please Config TOUCH_LP_IDLE_SEC."
+#endif
+
+#if ((TOUCH_LP_IDLE_SEC < 1) || (TOUCH_LP_IDLE_SEC > 63))
+#error "TOUCH_LP_IDLE_SEC can be (1 .. 63)."
+#endif
+
+#ifndef TOUCH_LP_SCAN_PERIOD
+#error "Please Config TOUCH_LP_SCAN_PERIOD."
+#endif
+
+#if ((TOUCH_LP_SCAN_PERIOD < 1) || (TOUCH_LP_SCAN_PERIOD > 1000))
+#error "TOUCH_LP_SCAN_PERIOD can be (1 .. 1000)."
+#endif
+
+#ifndef TOUCH_LP_WAKE_TH
+#error "Please Config TOUCH_LP_WAKE_TH."
+#endif
+
+#if ((TOUCH_LP_WAKE_TH < 1) || (TOUCH_LP_WAKE_TH > 255))
+#error "TOUCH_LP_WAKE_TH can be (1 .. 255)."
+#endif
+#endif
+
+#ifndef TOUCH_USE_TUNE
+#error "Please Config TOUCH_USE_TUNE."
+#endif
+
+#if ((TOUCH_USE_TUNE != 0) && (TOUCH_USE_TUNE != 1))
+#error "TOUCH_USE_TUNE can be (0 .. 1)."
+#endif
+
+#if TOUCH_USE_TUNE > 0
+#ifndef TOUCH_TUNE_SAMPLES
+#error "Please Config TOUCH_TUNE_SAMPLES."
+#endif
+
+#if ((TOUCH_TUNE_SAMPLES < 2) || (TOUCH_TUNE_SAMPLES > 64))
+#error "TOUCH_TUNE_SAMPLES can be (2 .. 64)."
+#endif
+
+#ifndef TOUCH_TUNE_SNR
+#error "Please Config TOUCH_TUNE_SNR."
+#endif
+
+#if ((TOUCH_TUNE_SNR < 1) || (TOUCH_TUNE_SNR > 1000))
+#error "TOUCH_TUNE_SNR can be (1 .. 1000)."
+#endif
+
+#ifndef TOUCH_TUNE_USE_SS
+#error "Please Config TOUCH_TUNE_USE_SS."
+#endif
+
+#if ((TOUCH_TUNE_USE_SS != 0) && (TOUCH_TUNE_USE_SS != 1))
+#error "TOUCH_TUNE_USE_SS can be (0 .. 1)."
+#endif
+#endif
+
+#ifndef TOUCH_USE_RECOVERY
+#error "Please Config TOUCH_USE_RECOVERY."
+#endif
+
+#if ((TOUCH_USE_RECOVERY != 0) && (TOUCH_USE_RECOVERY != 1))
+#error "TOUCH_USE_RECOVERY can be (0 .. 1)."
+#endif
+
+#if TOUCH_USE_RECOVERY > 0
+#if TOUCH_TOTAL_KEYS == 0
+#error "TOUCH_USE_RECOVERY requires TouchKeys."
+#endif
+
+#if TOUCH_TOTAL_OBJECTS > 32
+#error "TOUCH_USE_RECOVERY supports up to 32 objects (one bit per object)."
+#endif
+
+#ifndef TOUCH_RECOV_DELAY_MIN
+#error "Please Config TOUCH_RECOV_DELAY_MIN."
+#endif
+
+#if ((TOUCH_RECOV_DELAY_MIN < 1) || (TOUCH_RECOV_DELAY_MIN > 63))
+#error "TOUCH_RECOV_DELAY_MIN can be (1 .. 63)."
+#endif
+
+#ifndef TOUCH_RECOV_DELAY_MAX
+#error "Please Config TOUCH_RECOV_DELAY_MAX."
+#endif
+
+#if ((TOUCH_RECOV_DELAY_MAX < TOUCH_RECOV_DELAY_MIN) || (TOUCH_RECOV_DELAY_MAX > 63))
+#error "TOUCH_RECOV_DELAY_MAX can be (TOUCH_RECOV_DELAY_MIN .. 63)."
+#endif
+
+#ifndef TOUCH_RECOV_STABLE_SEC
+#error "Please Config TOUCH_RECOV_STABLE_SEC."
+#endif
+
+#if ((TOUCH_RECOV_STABLE_SEC < 1) || (TOUCH_RECOV_STABLE_SEC > 63))
+#error "TOUCH_RECOV_STABLE_SEC can be (1 .. 63)."
+#endif
+#endif
+
+#ifndef TOUCH_USE_TELEMETRY
+#error "Please Config TOUCH_USE_TELEMETRY."
+#endif
+
+#if ((TOUCH_USE_TELEMETRY != 0) && (TOUCH_USE_TELEMETRY != 1))
+#error "TOUCH_USE_TELEMETRY can be (0 .. 1)."
+#endif
+
+#if TOUCH_USE_TELEMETRY > 0
+#ifndef TOUCH_TELEM_BUFFER_SIZE
+#error "Please Config TOUCH_TELEM_BUFFER_SIZE."
+#endif
+
+#if ((TOUCH_TELEM_BUFFER_SIZE < 64) || (TOUCH_TELEM_BUFFER_SIZE > 2048) || \
+     ((TOUCH_TELEM_BUFFER_SIZE & (TOUCH_TELEM_BUFFER_SIZE - 1)) != 0))
+#error "TOUCH_TELEM_BUFFER_SIZE can be (64, 128, 256, 512, 1024, 2048)."
+#endif
+
+#if ((8 + (4 * TOUCH_TOTAL_CHANNELS) + TOUCH_TOTAL_OBJECTS) > 255)
+#error "Too many channels and objects for the telemetry records."
+#endif
+
+#if ((8 + (4 * TOUCH_TOTAL_CHANNELS) + TOUCH_TOTAL_OBJECTS) > TOUCH_TELEM_BUFFER_SIZE)
+#error "TOUCH_TELEM_BUFFER_SIZE is too small for a telemetry record."
+#endif
+#endif
+
+#ifndef TOUCH_USE_DISCHARGE_TIMER
+#error "Please Config TOUCH_USE_DISCHARGE_TIMER."
+#endif
+
+#if ((TOUCH_USE_DISCHARGE_TIMER != 0) && (TOUCH_USE_DISCHARGE_TIMER != 1))
+#error "TOUCH_USE_DISCHARGE_TIMER can be (0 .. 1)."
+#endif
+
+#if ((TOUCH_USE_DISCHARGE_TIMER > 0) && (TOUCH_USE_ACQ_INTERRUPT == 0))
+#error "TOUCH_USE_DISCHARGE_TIMER requires TOUCH_USE_ACQ_INTERRUPT."
+#endif
+
+/* The TSC interrupt routine must not wait the discharge in a software loop */
+#if ((TOUCH_USE_ACQ_INTERRUPT > 0) && (TOUCH_USE_DISCHARGE_TIMER == 0))
+#error "TOUCH_USE_ACQ_INTERRUPT requires TOUCH_USE_DISCHARGE_TIMER."
+#endif
+
+#if TOUCH_USE_DISCHARGE_TIMER > 0
+#ifndef TOUCH_DISCHARGE_TIMER
+#error "Please Config TOUCH_DISCHARGE_TIMER."
+#endif
+
+#ifndef TOUCH_DISCHARGE_TIMER_PERIOD
+#error "Please Config TOUCH_DISCHARGE_TIMER_PERIOD."
+#endif
+
+#if ((TOUCH_DISCHARGE_TIMER_PERIOD <= TOUCH_DELAY_DISCHARGE_US) || (TOUCH_DISCHARGE_TIMER_PERIOD > 65536))
+#error "TOUCH_DISCHARGE_TIMER_PERIOD can be (TOUCH_DELAY_DISCHARGE_US+1 .. 65536)."
+#endif
+#endif
+
 #ifndef TOUCH_DTO
 #error "Please Config TOUCH_DTO."
 #endif
@@ -47,14 +47,17 @@ extern "C" {
 */
 
 #define FOR_OBJ_TYPE     TSC_Globals.For_Obj->Type
-#define FOR_KEY_REF      TSC_Globals.For_Key->p_ChD->Refer
+#define FOR_KEY_REF      TSC_CH_REFER(TSC_Globals.For_Key->p_ChD)
 #define FOR_KEY_REFREST  TSC_Globals.For_Key->p_ChD->RefRest
-#define FOR_KEY_DELTA    TSC_Globals.For_Key->p_ChD->Delta
+#define FOR_KEY_DELTA    TSC_CH_DELTA(TSC_Globals.For_Key->p_ChD)
 #define FOR_KEY_STATEID  TSC_Globals.For_Key->p_Data->StateId
 
 #define FOR_LINROT_STATEID      TSC_Globals.For_LinRot->p_Data->StateId
 #define FOR_LINROT_NB_CHANNELS  TSC_Globals.For_LinRot->NumChannel
 
+#define FOR_MATRIX_STATEID      TSC_Globals.For_Matrix->p_Data->StateId
+#define FOR_MATRIX_NB_CHANNELS  (TSC_Globals.For_Matrix->NumRow + TSC_Globals.For_Matrix->NumCol)
+
 /**@} end of group TSC_ECS_Macros */
 
 /** @defgroup TSC_ECS_Enumerations Enumerations
@@ -67,6 +70,20 @@ extern "C" {
   @{
 */
 
+#if TOUCH_ECS_INCREMENTAL > 0
+/**
+ * @brief   Channel of the incremental ECS list.
+ *          Built once by TSC_Ecs_ConfigGroup() from the objects of a group.
+ */
+typedef struct
+{
+    TSC_Channel_Data_T  *p_ChD;                     /*!< Channel Data (Meas, Refer, Delta, ...) */
+    TSC_STATEID_T       *p_StateId;                 /*!< State of the object owning the channel */
+    CONST TSC_Object_T  *p_Obj;                     /*!< Object owning the channel */
+    void (*ConfigCalibrationState)(TSC_tCounter_T); /*!< Calibration method of the object */
+} TSC_EcsChannel_T;
+#endif
+
 /**@} end of group TSC_ECS_Structures */
 
 /** @defgroup TSC_ECS_Variables Variables
@@ -82,6 +99,12 @@ extern "C" {
 TSC_tKCoeff_T TSC_Ecs_CalculateK(TSC_ObjectGroup_T *objgrp, TSC_tKCoeff_T kDiffer, TSC_tKCoeff_T kSame);
 void TSC_Ecs_ProcessK(TSC_ObjectGroup_T *objgrp, TSC_tKCoeff_T kCoeff);
 TSC_STATUS_T TSC_Ecs_Process(TSC_ObjectGroup_T *objgrp);
+#if TOUCH_ECS_INCREMENTAL > 0
+TSC_STATUS_T TSC_Ecs_ConfigGroup(TSC_ObjectGroup_T *objgrp);
+TSC_STATUS_T TSC_Ecs_ProcessSlice(TSC_ObjectGroup_T *objgrp);
+TSC_tKCoeff_T TSC_Ecs_ReadKCoeff(void);
+void TSC_Ecs_ConfigKCoeff(TSC_tKCoeff_T kCoeff);
+#endif
 
 #ifdef __cplusplus
 }
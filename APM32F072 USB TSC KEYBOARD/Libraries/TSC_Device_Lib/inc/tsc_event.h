@@ -0,0 +1,113 @@
+/*!
+ * @file        tsc_event.h
+ *
+ * @brief       This file contains external declarations of the tsc_event.c file.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __TSC_EVENT_H
+#define __TSC_EVENT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "tsc_acq.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Event_Driver TSC Event Driver
+  @{
+*/
+
+/** @defgroup TSC_Event_Macros Macros
+  @{
+*/
+
+#if TOUCH_USE_EVENT > 0
+/* State mask bits of a pressed object, outside of the debounce states */
+#define TSC_EVENT_PRESS_MASK    (TSC_STATE_DETECT_BIT_MASK | TSC_STATE_TOUCH_BIT_MASK)
+#endif
+
+/**@} end of group TSC_Event_Macros */
+
+/** @defgroup TSC_Event_Enumerations Enumerations
+  @{
+*/
+
+/**
+ * @brief   Event type
+ */
+typedef enum
+{
+    TSC_EVENT_RELEASE = 0, /*!< The object has left the Detect/Touch states */
+    TSC_EVENT_PRESS   = 1  /*!< The object has entered the Detect/Touch states */
+} TSC_EVENT_T;
+
+/**@} end of group TSC_Event_Enumerations */
+
+/** @defgroup TSC_Event_Structures Structures
+  @{
+*/
+
+/**
+ * @brief   Press or release event of an object
+ */
+typedef struct
+{
+    uint8_t        Type;   /*!< Event type (TSC_EVENT_T) */
+    uint8_t        Index;  /*!< Index of the object in its group */
+    uint8_t        Key;    /*!< Key of a Matrix object (0 for the other objects) */
+    TSC_tTick_ms_T Tick;   /*!< TSC_Globals.Tick_ms when the event has been written */
+} TSC_Event_T;
+
+/**@} end of group TSC_Event_Structures */
+
+/** @defgroup TSC_Event_Variables Variables
+  @{
+*/
+
+/**@} end of group TSC_Event_Variables */
+
+/** @defgroup TSC_Event_Functions Functions
+  @{
+*/
+
+#if TOUCH_USE_EVENT > 0
+void TSC_Event_Config(void);
+TSC_STATUS_T TSC_Event_Write(TSC_EVENT_T type, TSC_tIndex_T idxObj, uint8_t key);
+TSC_STATUS_T TSC_Event_Read(TSC_Event_T *event);
+uint16_t TSC_Event_ReadLost(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_EVENT_H */
+
+/**@} end of group TSC_Event_Functions */
+/**@} end of group TSC_Event_Driver */
+/**@} end of group TSC_Driver_Library */
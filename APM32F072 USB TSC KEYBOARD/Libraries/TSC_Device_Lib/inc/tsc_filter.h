@@ -58,12 +58,79 @@ extern "C" {
   @{
 */
 
+/**
+ * @brief   Filters of the filter bank
+ */
+typedef enum
+{
+    TSC_FILT_NONE         = 0, /*!< Stage not used */
+    TSC_FILT_MEDIAN3      = 1, /*!< Moving median of 3 samples */
+    TSC_FILT_MEDIAN5      = 2, /*!< Moving median of 5 samples */
+    TSC_FILT_ADAPTIVE_IIR = 3, /*!< First order IIR, the coefficient rises with the slew */
+    TSC_FILT_KALMAN       = 4, /*!< Scalar Kalman tracker of the measure level */
+    TSC_FILT_SLEW_LIMIT   = 5  /*!< Slew rate limiter */
+} TSC_FILTER_TYPE_T;
+
 /**@} end of group TSC_Filter_Enumerations */
 
 /** @defgroup TSC_Filter_Structures Structures
   @{
 */
 
+#if TOUCH_USE_FILTER_BANK > 0
+/**
+ * @brief   Filter stage of a chain
+ *          Param1 and Param2 depend on the filter:
+ *          - MEDIAN3, MEDIAN5: not used
+ *          - ADAPTIVE_IIR: Param1 = minimum coefficient (1..256, k = Param1/256),
+ *                          Param2 = slew shift (0..8, k = Param1 + (|slew| << Param2))
+ *          - KALMAN:       Param1 = measure noise variance R (1..65535, counts^2),
+ *                          Param2 = process noise Q (0..65535, counts^2/16)
+ *          - SLEW_LIMIT:   Param1 = maximum step per sample (1..65535, counts)
+ */
+typedef struct
+{
+    TSC_FILTER_TYPE_T   Type;   /*!< Filter */
+    uint16_t            Param1; /*!< First parameter */
+    uint16_t            Param2; /*!< Second parameter */
+} TSC_FilterStage_T;
+
+/**
+ * @brief   Chain of filters, applied in order.
+ *          Variables of this structure type can be placed in RAM or ROM.
+ */
+typedef struct
+{
+    CONST TSC_FilterStage_T *p_Stage;  /*!< First stage */
+    TSC_tNum_T               NumStage; /*!< Number of stages (1..TOUCH_FILTER_MAX_STAGES) */
+} TSC_FilterChain_T;
+
+/**
+ * @brief   Data of a filter stage for one channel
+ */
+typedef union
+{
+    struct
+    {
+        TSC_tMeas_T     Hist[4]; /*!< Last samples, most recent first */
+        uint8_t         Num;     /*!< Number of valid samples */
+    } Median;
+    struct
+    {
+        uint32_t        Out;     /*!< Last output (Q8) */
+    } Iir;
+    struct
+    {
+        uint32_t        X;       /*!< Estimate (Q4) */
+        uint32_t        P;       /*!< Estimate variance (counts^2 Q4) */
+    } Kalman;
+    struct
+    {
+        TSC_tMeas_T     Out;     /*!< Last output */
+    } Slew;
+} TSC_FilterData_T;
+#endif
+
 /**@} end of group TSC_Filter_Structures */
 
 /** @defgroup TSC_Filter_Variables Variables
@@ -79,6 +146,18 @@ extern "C" {
 TSC_tMeas_T TSC_Filt_MeasFilter(TSC_tMeas_T preMeasn, TSC_tMeas_T curMeasn);
 TSC_tDelta_T TSC_Filt_DeltaFilter(TSC_tDelta_T delta);
 
+#if TOUCH_USE_FILTER_BANK > 0
+TSC_tMeas_T TSC_Filt_Median3(TSC_FilterData_T *data, TSC_tMeas_T meas);
+TSC_tMeas_T TSC_Filt_Median5(TSC_FilterData_T *data, TSC_tMeas_T meas);
+TSC_tMeas_T TSC_Filt_AdaptiveIir(TSC_FilterData_T *data, TSC_tMeas_T meas, uint16_t kMin, uint16_t slewShift);
+TSC_tMeas_T TSC_Filt_Kalman(TSC_FilterData_T *data, TSC_tMeas_T meas, uint16_t noiseR, uint16_t noiseQ);
+TSC_tMeas_T TSC_Filt_SlewLimit(TSC_FilterData_T *data, TSC_tMeas_T meas, uint16_t maxStep);
+TSC_tMeas_T TSC_Filt_ProcessChain(CONST TSC_FilterChain_T *chain, TSC_FilterData_T *data, TSC_tMeas_T meas);
+
+void TSC_Filt_ConfigChannels(TSC_tIndexDest_T idxDest, TSC_tNum_T numChannel, CONST TSC_FilterChain_T *chain);
+TSC_tMeas_T TSC_Filt_ProcessBank(TSC_tIndexDest_T idxDest, TSC_tMeas_T meas);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
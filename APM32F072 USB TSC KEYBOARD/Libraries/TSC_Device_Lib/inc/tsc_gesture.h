@@ -0,0 +1,128 @@
+/*!
+ * @file        tsc_gesture.h
+ *
+ * @brief       This file contains external declarations of the tsc_gesture.c file.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __TSC_GESTURE_H
+#define __TSC_GESTURE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "tsc_event.h"
+#include "tsc_object.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Gesture_Driver TSC Gesture Driver
+  @{
+*/
+
+/** @defgroup TSC_Gesture_Macros Macros
+  @{
+*/
+
+/**@} end of group TSC_Gesture_Macros */
+
+/** @defgroup TSC_Gesture_Enumerations Enumerations
+  @{
+*/
+
+/**
+ * @brief   Gesture type
+ */
+typedef enum
+{
+    TSC_GESTURE_TAP        = 0, /*!< Short press, not followed by a second one */
+    TSC_GESTURE_DOUBLE_TAP = 1, /*!< Two short presses */
+    TSC_GESTURE_LONG_PRESS = 2, /*!< Press held for the long press time */
+    TSC_GESTURE_REPEAT     = 3, /*!< Press still held, sent each repeat period after the long press */
+    TSC_GESTURE_SWIPE      = 4  /*!< Fast move on a Linear/Rotary sensor */
+} TSC_GESTURE_T;
+
+/**@} end of group TSC_Gesture_Enumerations */
+
+/** @defgroup TSC_Gesture_Structures Structures
+  @{
+*/
+
+/**
+ * @brief   Gesture recognized on an object
+ */
+typedef struct
+{
+    uint8_t   Type;      /*!< Gesture type (TSC_GESTURE_T) */
+    uint8_t   Index;     /*!< Index of the object in its group */
+    uint8_t   Count;     /*!< Number of TSC_GESTURE_REPEAT since the long press */
+    int16_t   Distance;  /*!< Swipe: RawPosition change, positive = clockwise direction */
+    uint16_t  Speed;     /*!< Swipe: RawPosition units per second */
+} TSC_Gesture_T;
+
+/**
+ * @brief   Timings of the gestures, in ms.
+ *          Variables of this structure type must be placed in RAM only.
+ */
+typedef struct
+{
+    uint16_t  TapMax;        /*!< Longest press of a tap */
+    uint16_t  DoubleTapGap;  /*!< Longest time between the two taps of a double tap (0 = no double tap) */
+    uint16_t  LongPress;     /*!< Press time of a long press (0 = no long press) */
+    uint16_t  RepeatPeriod;  /*!< Repeat period after a long press (0 = no repeat) */
+    uint16_t  SwipeMax;      /*!< Longest press of a swipe (0 = no swipe) */
+    uint8_t   SwipeMinDist;  /*!< Smallest RawPosition change of a swipe */
+} TSC_GestureParam_T;
+
+/**@} end of group TSC_Gesture_Structures */
+
+/** @defgroup TSC_Gesture_Variables Variables
+  @{
+*/
+
+/**@} end of group TSC_Gesture_Variables */
+
+/** @defgroup TSC_Gesture_Functions Functions
+  @{
+*/
+
+#if TOUCH_USE_GESTURE > 0
+void TSC_Gesture_Config(CONST TSC_ObjectGroup_T *objgrp);
+TSC_GestureParam_T *TSC_Gesture_ReadParam(void);
+void TSC_Gesture_ProcessEvent(CONST TSC_Event_T *event);
+void TSC_Gesture_Process(void);
+TSC_STATUS_T TSC_Gesture_Read(TSC_Gesture_T *gesture);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_GESTURE_H */
+
+/**@} end of group TSC_Gesture_Functions */
+/**@} end of group TSC_Gesture_Driver */
+/**@} end of group TSC_Driver_Library */
@@ -117,6 +117,16 @@ typedef struct
     unsigned int           CounterDirection : 6; /*!< Counter for direction debounce management (TSC_tCounter_T) */
     unsigned int           DxsLock          : 1; /*!< The State is locked by the DxS (TSC_BOOL_T) */
     unsigned int           Direction        : 1; /*!< Movement direction (TSC_BOOL_T) */
+#if TOUCH_LINROT_USE_CENTROID > 0
+    unsigned int           FineValid        : 1; /*!< FinePosition holds a position of the current touch (TSC_BOOL_T) */
+    uint16_t               FinePosition;         /*!< Position on TOUCH_LINROT_POS_BITS bits (centroid engine) */
+#if TOUCH_LINROT_SMOOTHING > 0
+    uint16_t               FilterPosition;       /*!< Smoothed position in 1/16 of FinePosition unit */
+#endif
+#if TOUCH_LINROT_USE_VELOCITY > 0
+    int16_t                Velocity;             /*!< Position change per calculation in 1/16 of FinePosition unit */
+#endif
+#endif
 } TSC_LinRotData_T;
 
 /**
@@ -147,6 +157,9 @@ typedef struct
     /* Other parameters */
     TSC_tCounter_T         Resolution;           /*!< Position resolution */
     TSC_tsignPosition_T    DirChangePos;         /*!< Direction change position threshold */
+#if TOUCH_LINROT_USE_CENTROID > 0
+    uint16_t               Pitch;                /*!< Distance between two electrodes in 1/16 of FinePosition unit */
+#endif
 } TSC_LinRotParam_T;
 
 /**
@@ -223,14 +236,24 @@ extern CONST TSC_tPosition_T TSC_POSOFF_6CH_ROT_M[6][6];
 void TSC_Linrot_Config(void);
 void TSC_Linrot_Process(void);
 TSC_STATUS_T TSC_Linrot_CalcPos(void);
+#if TOUCH_LINROT_USE_CENTROID > 0
+TSC_STATUS_T TSC_Linrot_CalcPosCentroid(void);
+#endif
 
 /* Utility functions */
 void TSC_Linrot_ConfigCalibrationState(TSC_tCounter_T delay);
 void TSC_Linrot_ConfigOffState(void);
+void TSC_Linrot_ConfigReleaseState(void);
 void TSC_Linrot_ConfigBurstOnlyState(void);
 TSC_STATEID_T TSC_Linrot_ReadStateId(void);
 TSC_STATEMASK_T TSC_Linrot_ReadStateMask(void);
 TSC_tNum_T TSC_Linrot_ReadChangeFlag(void);
+#if TOUCH_LINROT_USE_CENTROID > 0
+uint16_t TSC_Linrot_ReadFinePosition(void);
+#if TOUCH_LINROT_USE_VELOCITY > 0
+int16_t TSC_Linrot_ReadVelocity(void);
+#endif
+#endif
 
 /* State machine functions */
 void TSC_Linrot_ProcessCalibrationState(void);
@@ -261,6 +284,9 @@ TSC_STATUS_T TSC_Linrot_Process_OneChannel_DeltaAbove(TSC_tThreshold_T threshold
 TSC_STATUS_T TSC_Linrot_Process_AllChannel_DeltaBelowEqu(TSC_tThreshold_T threshold, TSC_tIndex_T Cmd);
 void TSC_Linrot_Process_AllChannel_ClearRef(void);
 TSC_tDelta_T TSC_Linrot_NormDelta(TSC_Channel_Data_T *channel, TSC_tIndex_T index);
+#if TOUCH_LINROT_USE_CENTROID > 0
+int32_t TSC_Linrot_DivRatio(int32_t num, uint32_t den);
+#endif
 
 #ifdef __cplusplus
 }
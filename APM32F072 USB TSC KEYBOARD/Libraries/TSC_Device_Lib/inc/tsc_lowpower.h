@@ -0,0 +1,99 @@
+/*!
+ * @file        tsc_lowpower.h
+ *
+ * @brief       This file contains external declarations of the tsc_lowpower.c file.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __TSC_LOWPOWER_H
+#define __TSC_LOWPOWER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "tsc_acq.h"
+#include "tsc_object.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_LowPower_Driver TSC Low Power Driver
+  @{
+*/
+
+/** @defgroup TSC_LowPower_Macros Macros
+  @{
+*/
+
+/**@} end of group TSC_LowPower_Macros */
+
+/** @defgroup TSC_LowPower_Enumerations Enumerations
+  @{
+*/
+
+/**
+ * @brief   Scan mode
+ */
+typedef enum
+{
+    TSC_LP_MODE_ACTIVE = 0, /*!< All Blocks acquired at full rate */
+    TSC_LP_MODE_GUARD  = 1  /*!< Guard channels acquired every TOUCH_LP_SCAN_PERIOD ms, CPU in Sleep mode */
+} TSC_LP_MODE_T;
+
+/**@} end of group TSC_LowPower_Enumerations */
+
+/** @defgroup TSC_LowPower_Structures Structures
+  @{
+*/
+
+/**@} end of group TSC_LowPower_Structures */
+
+/** @defgroup TSC_LowPower_Variables Variables
+  @{
+*/
+
+/**@} end of group TSC_LowPower_Variables */
+
+/** @defgroup TSC_LowPower_Functions Functions
+  @{
+*/
+
+#if TOUCH_USE_LOWPOWER > 0
+void TSC_LowPower_Config(void);
+TSC_STATUS_T TSC_LowPower_ProcessFrame(CONST TSC_Frame_T *frame);
+void TSC_LowPower_ProcessGroup(CONST TSC_ObjectGroup_T *objgrp);
+TSC_LP_MODE_T TSC_LowPower_ReadMode(void);
+void TSC_LowPower_Sleep(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_LOWPOWER_H */
+
+/**@} end of group TSC_LowPower_Functions */
+/**@} end of group TSC_LowPower_Driver */
+/**@} end of group TSC_Driver_Library */
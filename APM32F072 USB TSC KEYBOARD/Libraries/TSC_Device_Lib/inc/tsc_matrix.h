@@ -0,0 +1,142 @@
+/*!
+ * @file        tsc_matrix.h
+ *
+ * @brief       This file contains external declarations of the tsc_matrix.c file.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __TSC_MATRIX_H
+#define __TSC_MATRIX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "tsc_acq.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Matrix_Driver TSC Matrix Driver
+  @{
+*/
+
+/** @defgroup TSC_Matrix_Macros Macros
+  @{
+*/
+
+/* Key index when no key of the matrix is pressed */
+#define TSC_MATRIX_NO_KEY     ((uint8_t)0xFF)
+/* Key index when the pressed key can not be resolved (two keys on different rows and columns) */
+#define TSC_MATRIX_GHOST      ((uint8_t)0xFE)
+
+/**@} end of group TSC_Matrix_Macros */
+
+/** @defgroup TSC_Matrix_Enumerations Enumerations
+  @{
+*/
+
+/**@} end of group TSC_Matrix_Enumerations */
+
+/** @defgroup TSC_Matrix_Structures Structures
+  @{
+*/
+
+/**
+ * @brief   Contains all data related to a Matrix sensor.
+ *          Variables of this structure type must be placed in RAM only.
+ */
+typedef struct
+{
+    TSC_STATEID_T      StateId;           /*!< Current state identifier */
+    TSC_tCounter_T     CounterDebounce;   /*!< Counter for debounce and calibration management */
+    unsigned int       Change     : 1;    /*!< The State is different from the previous one (TSC_STATE_T) */
+    unsigned int       KeyChange  : 1;    /*!< The Key is different from the previous one (TSC_STATE_T) */
+    uint8_t            Key;               /*!< Pressed key (row x NumCol + column) or TSC_MATRIX_NO_KEY */
+    uint8_t            Candidate;         /*!< Key being debounced */
+} TSC_MatrixData_T;
+
+/**
+ * @brief   Contains all parameters related to a Matrix sensor.
+ *          Variables of this structure type can be placed in RAM or ROM.
+ */
+typedef struct
+{
+    TSC_tThreshold_T  DetectInTh;         /*!< Detection in threshold of a row or a column */
+    TSC_tThreshold_T  DetectOutTh;        /*!< Detection out threshold of a row or a column */
+    TSC_tThreshold_T  CalibTh;            /*!< Calibration threshold */
+    TSC_tCounter_T    CounterDebCalib;    /*!< Debounce counter to enter in Calibration state */
+    TSC_tCounter_T    CounterDebDetect;   /*!< Debounce counter to enter in Detect state or to change the key */
+    TSC_tCounter_T    CounterDebRelease;  /*!< Debounce counter to enter in Release state */
+    TSC_tCounter_T    CounterDebError;    /*!< Debounce counter to enter in Error state */
+} TSC_MatrixParam_T;
+
+/**
+ * @brief   Contains definition of a Matrix sensor.
+ *          The keys are at the crossings of the row and column electrodes, each
+ *          electrode is one channel: NumRow x NumCol keys use NumRow + NumCol channels.
+ *          Only one key is reported at a time: two keys on different rows and
+ *          columns touch the same lines as the two other crossings (ghost keys)
+ *          and are rejected: the Matrix keeps its current key, or stays released.
+ *          Keys pressed together must be TouchKeys.
+ *          Variables of this structure type can be placed in RAM or ROM.
+ */
+typedef struct
+{
+    TSC_MatrixData_T            *p_Data;    /*!< Data (state id, counter, key, ...) */
+    TSC_MatrixParam_T           *p_Param;   /*!< Parameters (thresholds, debounce, ...) */
+    TSC_Channel_Data_T          *p_ChD;     /*!< First Channel Data, the rows then the columns */
+    TSC_tNum_T                  NumRow;     /*!< Number of rows */
+    TSC_tNum_T                  NumCol;     /*!< Number of columns */
+} TSC_Matrix_T;
+
+/**@} end of group TSC_Matrix_Structures */
+
+/** @defgroup TSC_Matrix_Functions Functions
+  @{
+*/
+
+/* "Object methods" functions */
+void TSC_Matrix_ConfigCtx(CONST TSC_Matrix_T *matrix);
+void TSC_Matrix_ProcessCtx(CONST TSC_Matrix_T *matrix);
+
+/* Utility functions */
+void TSC_Matrix_ConfigCalibrationStateCtx(CONST TSC_Matrix_T *matrix, TSC_tCounter_T delay);
+void TSC_Matrix_ConfigReleaseStateCtx(CONST TSC_Matrix_T *matrix);
+void TSC_Matrix_ConfigOffStateCtx(CONST TSC_Matrix_T *matrix);
+TSC_tNum_T TSC_Matrix_ReadStateMaskCtx(CONST TSC_Matrix_T *matrix);
+
+/* Functions applied to the current global object */
+void TSC_Matrix_ConfigCalibrationState(TSC_tCounter_T delay);
+void TSC_Matrix_ConfigReleaseState(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_MATRIX_H */
+
+/**@} end of group TSC_Matrix_Functions */
+/**@} end of group TSC_Matrix_Driver */
+/**@} end of group TSC_Driver_Library */
@@ -34,6 +34,7 @@ extern "C" {
 /* Includes */
 #include "tsc_touchkey.h"
 #include "tsc_linrot.h"
+#include "tsc_matrix.h"
 
 /** @addtogroup TSC_Driver_Library TSC Driver Library
   @{
@@ -50,6 +51,7 @@ extern "C" {
 #define TSC_OBJ_TYPE_KEY_MASK     (0x10)  /*!< TouchKey object mask */
 #define TSC_OBJ_TYPE_LINROT_MASK   (0x20) /*!< Linear and Rotary objects mask */
 #define TSC_OBJ_TYPE_TRACKNAV_MASK (0x40) /*!< TrackPad and NaviPad objects mask */
+#define TSC_OBJ_TYPE_MATRIX_MASK   (0x80) /*!< Matrix objects mask */
 
 /**@} end of group TSC_Object_Macros */
 
@@ -69,7 +71,8 @@ typedef enum
     TSC_OBJ_ROTARY     = (TSC_OBJ_TYPE_LINROT_MASK + 2),   /*!< Normal Rotary sensor */
     TSC_OBJ_ROTARYB    = (TSC_OBJ_TYPE_LINROT_MASK + 3),   /*!< Basic Rotary sensor */
     TSC_OBJ_TRACKPAD   = (TSC_OBJ_TYPE_TRACKNAV_MASK + 0), /*!< TrackPad sensor */
-    TSC_OBJ_NAVIPAD    = (TSC_OBJ_TYPE_TRACKNAV_MASK + 1)  /*!< NaviPad sensor */
+    TSC_OBJ_NAVIPAD    = (TSC_OBJ_TYPE_TRACKNAV_MASK + 1), /*!< NaviPad sensor */
+    TSC_OBJ_MATRIX     = (TSC_OBJ_TYPE_MATRIX_MASK + 0)    /*!< Matrix sensor (row and column electrodes) */
 } TSC_OBJECT_T;
 
 /**@} end of group TSC_Object_Enumerations */
@@ -103,6 +106,10 @@ typedef struct
     TSC_tIndex_T           wait;       /*!< Flag for the ECS delay */
     TSC_tTick_ms_T         time;       /*!< Keep the time for the ECS delay */
 #endif
+#if TOUCH_USE_EVENT > 0
+    uint32_t               PressMask;  /*!< Objects in Detect or Touch state (bit = object index) */
+    uint32_t               ChangeMask; /*!< Objects pressed or released by the last TSC_Obj_ProcessGroup() */
+#endif
 } TSC_ObjectGroup_T;
 
 /**@} end of group TSC_Object_Structures */
@@ -115,6 +122,11 @@ void TSC_Obj_ConfigGroup(TSC_ObjectGroup_T *objgrp);
 void TSC_Obj_ProcessGroup(TSC_ObjectGroup_T *objgrp);
 void TSC_Obj_ConfigGlobalObj(CONST TSC_Object_T *pObj);
 
+/* Object processing with the object given by the caller (declared here as it uses TSC_Object_T) */
+#if TOUCH_TOTAL_KEYS > 0
+void TSC_TouchKey_ProcessCtx(CONST TSC_Object_T *pObj);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,114 @@
+/*!
+ * @file        tsc_recovery.h
+ *
+ * @brief       This file contains external declarations of the tsc_recovery.c file.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __TSC_RECOVERY_H
+#define __TSC_RECOVERY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "tsc_acq.h"
+#include "tsc_object.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Recovery_Driver TSC Recovery Driver
+  @{
+*/
+
+/** @defgroup TSC_Recovery_Macros Macros
+  @{
+*/
+
+/**@} end of group TSC_Recovery_Macros */
+
+/** @defgroup TSC_Recovery_Enumerations Enumerations
+  @{
+*/
+
+/**
+ * @brief   Recovery state of an object
+ */
+typedef enum
+{
+    TSC_RECOV_STATE_OK    = 0, /*!< No fault, or the last recalibration has been stable for TOUCH_RECOV_STABLE_SEC */
+    TSC_RECOV_STATE_OFF   = 1, /*!< In error, the channels are not acquired until the recalibration delay */
+    TSC_RECOV_STATE_RETRY = 2  /*!< Recalibrated, not yet stable for TOUCH_RECOV_STABLE_SEC */
+} TSC_RECOV_STATE_T;
+
+/**@} end of group TSC_Recovery_Enumerations */
+
+/** @defgroup TSC_Recovery_Structures Structures
+  @{
+*/
+
+/**
+ * @brief   Fault diagnostics of an object
+ */
+typedef struct
+{
+    uint8_t   State;      /*!< Recovery state (TSC_RECOV_STATE_T) */
+    uint8_t   Errors;     /*!< Number of Error states since the config, saturated at 255 */
+    uint8_t   Delay;      /*!< Delay in sec before the next recalibration */
+    uint8_t   AcqStatus;  /*!< Acquisition status of the last Error state (TSC_ACQ_STATUS_T) */
+} TSC_Fault_T;
+
+/**@} end of group TSC_Recovery_Structures */
+
+/** @defgroup TSC_Recovery_Variables Variables
+  @{
+*/
+
+/**@} end of group TSC_Recovery_Variables */
+
+/** @defgroup TSC_Recovery_Functions Functions
+  @{
+*/
+
+#if TOUCH_USE_RECOVERY > 0
+void TSC_Recovery_Config(CONST TSC_ObjectGroup_T *objgrp);
+void TSC_Recovery_ProcessErrorState(void);
+void TSC_Recovery_ProcessOffState(void);
+void TSC_Recovery_ProcessErrorStateCtx(CONST TSC_Object_T *pObj);
+void TSC_Recovery_ProcessOffStateCtx(CONST TSC_Object_T *pObj);
+void TSC_Recovery_Process(void);
+uint32_t TSC_Recovery_ReadFaults(void);
+TSC_STATUS_T TSC_Recovery_Read(TSC_tIndex_T idxObj, TSC_Fault_T *fault);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_RECOVERY_H */
+
+/**@} end of group TSC_Recovery_Functions */
+/**@} end of group TSC_Recovery_Driver */
+/**@} end of group TSC_Driver_Library */
@@ -0,0 +1,212 @@
+/*!
+ * @file        tsc_sensor.h
+ *
+ * @brief       This file contains the macros used to build the TSC configuration from a sensor description.
+ *
+ * @version     V1.0.1
+ *
+ * @date        2022-09-20
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __TSC_SENSOR_H
+#define __TSC_SENSOR_H
+
+#ifdef __cplusplus
+  extern "C" {
+#endif
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Sensor_Driver TSC Sensor Description
+  @{
+*/
+
+/** @defgroup TSC_Sensor_Macros Macros
+  @{
+*/
+
+/**
+ * The sensor is described in tsc_config.h with the following lists:
+ *  - TOUCH_SENSOR_CHANNELS(X): X(Channel, Group, IO) for each channel.
+ *    Channel is the index in the Channel Data array and must go from 0 to N-1.
+ *  - TOUCH_SENSOR_SAMPCAPS(X): X(Group, IO) for each sampling capacitor.
+ *  - TOUCH_SENSOR_SHIELDS(X):  X(Group, IO) for each shield (optional).
+ *  Channel, Group and IO must be written as decimal numbers.
+ *
+ * The Blocks are built with one channel per group: the Nth channel of each
+ * group (in IO order) goes in Block N. The number of Blocks is then the
+ * maximum number of channels in a group, which is the minimum possible.
+ */
+#ifdef TOUCH_SENSOR_CHANNELS
+
+/* IO and group masks in the IOCHCTRL/IOGCSTS registers layout */
+#define TSC_SNS_BIT(g, io)              (1UL << ((((g) - 1) * 4) + ((io) - 1)))
+#define TSC_SNS_GRP(g)                  (1UL << ((g) - 1))
+
+#define TSC_SNS_X_ONE(ch, g, io)        + 1
+#define TSC_SNS_X_CH_BIT(ch, g, io)     | TSC_SNS_BIT(g, io)
+#define TSC_SNS_X_IO_BIT(g, io)         | TSC_SNS_BIT(g, io)
+
+#define TSC_SENSOR_CHANNEL_MSK          (0 TOUCH_SENSOR_CHANNELS(TSC_SNS_X_CH_BIT))
+#define TSC_SENSOR_SAMPCAP_MSK          (0 TOUCH_SENSOR_SAMPCAPS(TSC_SNS_X_IO_BIT))
+#ifdef TOUCH_SENSOR_SHIELDS
+#define TSC_SENSOR_SHIELD_MSK           (0 TOUCH_SENSOR_SHIELDS(TSC_SNS_X_IO_BIT))
+#else
+#define TSC_SENSOR_SHIELD_MSK           (0)
+#endif
+
+/* Number of channels of a group */
+#define TSC_SNS_NIBBLE(g)               ((TSC_SENSOR_CHANNEL_MSK >> (((g) - 1) * 4)) & 0xF)
+#define TSC_SNS_POPCNT4(n)              (((n) & 1) + (((n) >> 1) & 1) + (((n) >> 2) & 1) + (((n) >> 3) & 1))
+#define TSC_SNS_GROUP_NUMCH(g)          TSC_SNS_POPCNT4(TSC_SNS_NIBBLE(g))
+#define TSC_SNS_MAX(a, b)               (((a) > (b)) ? (a) : (b))
+#define TSC_SNS_MIN(a, b)               (((a) < (b)) ? (a) : (b))
+
+/* Number of elements, usable in preprocessor expressions */
+#define TOUCH_TOTAL_CHANNELS            (0 TOUCH_SENSOR_CHANNELS(TSC_SNS_X_ONE))
+#define TOUCH_TOTAL_BLOCKS              TSC_SNS_MAX(TSC_SNS_MAX(TSC_SNS_MAX(TSC_SNS_GROUP_NUMCH(1), TSC_SNS_GROUP_NUMCH(2)), \
+                                                            TSC_SNS_MAX(TSC_SNS_GROUP_NUMCH(3), TSC_SNS_GROUP_NUMCH(4))), \
+                                                TSC_SNS_MAX(TSC_SNS_MAX(TSC_SNS_GROUP_NUMCH(5), TSC_SNS_GROUP_NUMCH(6)), \
+                                                            TSC_SNS_MAX(TSC_SNS_GROUP_NUMCH(7), TSC_SNS_GROUP_NUMCH(8))))
+
+/* Type of each IO, used by the GPIOs configuration */
+#define TSC_SNS_IO_TYPE(g, io)          (((TSC_SENSOR_SAMPCAP_MSK & TSC_SNS_BIT(g, io)) != 0) ? SAMPCAP : \
+                                         ((TSC_SENSOR_CHANNEL_MSK & TSC_SNS_BIT(g, io)) != 0) ? CHANNEL : \
+                                         ((TSC_SENSOR_SHIELD_MSK  & TSC_SNS_BIT(g, io)) != 0) ? SHIELD  : NU)
+
+#define TOUCH_TSC_GROUP1_IO1            TSC_SNS_IO_TYPE(1, 1)
+#define TOUCH_TSC_GROUP1_IO2            TSC_SNS_IO_TYPE(1, 2)
+#define TOUCH_TSC_GROUP1_IO3            TSC_SNS_IO_TYPE(1, 3)
+#define TOUCH_TSC_GROUP1_IO4            TSC_SNS_IO_TYPE(1, 4)
+#define TOUCH_TSC_GROUP2_IO1            TSC_SNS_IO_TYPE(2, 1)
+#define TOUCH_TSC_GROUP2_IO2            TSC_SNS_IO_TYPE(2, 2)
+#define TOUCH_TSC_GROUP2_IO3            TSC_SNS_IO_TYPE(2, 3)
+#define TOUCH_TSC_GROUP2_IO4            TSC_SNS_IO_TYPE(2, 4)
+#define TOUCH_TSC_GROUP3_IO1            TSC_SNS_IO_TYPE(3, 1)
+#define TOUCH_TSC_GROUP3_IO2            TSC_SNS_IO_TYPE(3, 2)
+#define TOUCH_TSC_GROUP3_IO3            TSC_SNS_IO_TYPE(3, 3)
+#define TOUCH_TSC_GROUP3_IO4            TSC_SNS_IO_TYPE(3, 4)
+#define TOUCH_TSC_GROUP4_IO1            TSC_SNS_IO_TYPE(4, 1)
+#define TOUCH_TSC_GROUP4_IO2            TSC_SNS_IO_TYPE(4, 2)
+#define TOUCH_TSC_GROUP4_IO3            TSC_SNS_IO_TYPE(4, 3)
+#define TOUCH_TSC_GROUP4_IO4            TSC_SNS_IO_TYPE(4, 4)
+#define TOUCH_TSC_GROUP5_IO1            TSC_SNS_IO_TYPE(5, 1)
+#define TOUCH_TSC_GROUP5_IO2            TSC_SNS_IO_TYPE(5, 2)
+#define TOUCH_TSC_GROUP5_IO3            TSC_SNS_IO_TYPE(5, 3)
+#define TOUCH_TSC_GROUP5_IO4            TSC_SNS_IO_TYPE(5, 4)
+#define TOUCH_TSC_GROUP6_IO1            TSC_SNS_IO_TYPE(6, 1)
+#define TOUCH_TSC_GROUP6_IO2            TSC_SNS_IO_TYPE(6, 2)
+#define TOUCH_TSC_GROUP6_IO3            TSC_SNS_IO_TYPE(6, 3)
+#define TOUCH_TSC_GROUP6_IO4            TSC_SNS_IO_TYPE(6, 4)
+#define TOUCH_TSC_GROUP7_IO1            TSC_SNS_IO_TYPE(7, 1)
+#define TOUCH_TSC_GROUP7_IO2            TSC_SNS_IO_TYPE(7, 2)
+#define TOUCH_TSC_GROUP7_IO3            TSC_SNS_IO_TYPE(7, 3)
+#define TOUCH_TSC_GROUP7_IO4            TSC_SNS_IO_TYPE(7, 4)
+#define TOUCH_TSC_GROUP8_IO1            TSC_SNS_IO_TYPE(8, 1)
+#define TOUCH_TSC_GROUP8_IO2            TSC_SNS_IO_TYPE(8, 2)
+#define TOUCH_TSC_GROUP8_IO3            TSC_SNS_IO_TYPE(8, 3)
+#define TOUCH_TSC_GROUP8_IO4            TSC_SNS_IO_TYPE(8, 4)
+
+/* Block of a channel and position in the Block ordered tables (enumeration constants) */
+#define TSC_SNS_RANK(g, io)             TSC_SNS_POPCNT4(TSC_SNS_NIB##g & ((1 << ((io) - 1)) - 1))
+#define TSC_SNS_X_RANK(ch, g, io)       TSC_SNS_RANK_CH##ch = TSC_SNS_RANK(g, io),
+
+#define TSC_SNS_BLOCK_FIRST(b)          (TSC_SNS_MIN(TSC_SNS_NUMCH1, b) + TSC_SNS_MIN(TSC_SNS_NUMCH2, b) + \
+                                         TSC_SNS_MIN(TSC_SNS_NUMCH3, b) + TSC_SNS_MIN(TSC_SNS_NUMCH4, b) + \
+                                         TSC_SNS_MIN(TSC_SNS_NUMCH5, b) + TSC_SNS_MIN(TSC_SNS_NUMCH6, b) + \
+                                         TSC_SNS_MIN(TSC_SNS_NUMCH7, b) + TSC_SNS_MIN(TSC_SNS_NUMCH8, b))
+#define TSC_SNS_BLOCK_NUMCH(b)          ((TSC_SNS_NUMCH1 > (b)) + (TSC_SNS_NUMCH2 > (b)) + \
+                                         (TSC_SNS_NUMCH3 > (b)) + (TSC_SNS_NUMCH4 > (b)) + \
+                                         (TSC_SNS_NUMCH5 > (b)) + (TSC_SNS_NUMCH6 > (b)) + \
+                                         (TSC_SNS_NUMCH7 > (b)) + (TSC_SNS_NUMCH8 > (b)))
+#define TSC_SNS_GROUPS_BEFORE(g, b)     (((1 < (g)) && (TSC_SNS_NUMCH1 > (b))) + ((2 < (g)) && (TSC_SNS_NUMCH2 > (b))) + \
+                                         ((3 < (g)) && (TSC_SNS_NUMCH3 > (b))) + ((4 < (g)) && (TSC_SNS_NUMCH4 > (b))) + \
+                                         ((5 < (g)) && (TSC_SNS_NUMCH5 > (b))) + ((6 < (g)) && (TSC_SNS_NUMCH6 > (b))) + \
+                                         ((7 < (g)) && (TSC_SNS_NUMCH7 > (b))))
+#define TSC_SNS_POS(ch, g)              (TSC_SNS_BLOCK_FIRST(TSC_SNS_RANK_CH##ch) + TSC_SNS_GROUPS_BEFORE(g, TSC_SNS_RANK_CH##ch))
+
+/* IO and group masks of a Block */
+#define TSC_SNS_X_BLK_IO_0(ch, g, io)   | ((TSC_SNS_RANK_CH##ch == 0) ? TSC_SNS_BIT(g, io) : 0)
+#define TSC_SNS_X_BLK_IO_1(ch, g, io)   | ((TSC_SNS_RANK_CH##ch == 1) ? TSC_SNS_BIT(g, io) : 0)
+#define TSC_SNS_X_BLK_IO_2(ch, g, io)   | ((TSC_SNS_RANK_CH##ch == 2) ? TSC_SNS_BIT(g, io) : 0)
+#define TSC_SNS_X_BLK_GRP_0(ch, g, io)  | ((TSC_SNS_RANK_CH##ch == 0) ? TSC_SNS_GRP(g) : 0)
+#define TSC_SNS_X_BLK_GRP_1(ch, g, io)  | ((TSC_SNS_RANK_CH##ch == 1) ? TSC_SNS_GRP(g) : 0)
+#define TSC_SNS_X_BLK_GRP_2(ch, g, io)  | ((TSC_SNS_RANK_CH##ch == 2) ? TSC_SNS_GRP(g) : 0)
+#define TSC_SNS_BLOCK_IO_MSK(b)         ((0 TOUCH_SENSOR_CHANNELS(TSC_SNS_X_BLK_IO_##b)) | TSC_SENSOR_SHIELD_MSK)
+#define TSC_SNS_BLOCK_GRP_MSK(b)        (0 TOUCH_SENSOR_CHANNELS(TSC_SNS_X_BLK_GRP_##b))
+
+/**
+ * Table entries, to be used as:
+ *  - CONST TSC_Channel_Src_T  Src[]  = { TOUCH_SENSOR_CHANNELS(TSC_SENSOR_SRC) };
+ *  - CONST TSC_Channel_Dest_T Dest[] = { TOUCH_SENSOR_CHANNELS(TSC_SENSOR_DEST) };
+ *  - CONST TSC_Block_T Blocks[] = { TSC_SENSOR_BLOCK(0, Src, Dest, Data), ... };
+ */
+#define TSC_SENSOR_SRC(ch, g, io)       [TSC_SNS_POS(ch, g)] = { (g) - 1, TSC_SNS_BIT(g, io), TSC_SNS_GRP(g) },
+#define TSC_SENSOR_DEST(ch, g, io)      [TSC_SNS_POS(ch, g)] = { (ch) },
+#define TSC_SENSOR_BLOCK(b, src, dest, data) \
+    { &(src)[TSC_SNS_BLOCK_FIRST(b)], &(dest)[TSC_SNS_BLOCK_FIRST(b)], (data), \
+      TSC_SNS_BLOCK_NUMCH(b), TSC_SNS_BLOCK_IO_MSK(b), TSC_SNS_BLOCK_GRP_MSK(b) }
+
+#endif /* TOUCH_SENSOR_CHANNELS */
+
+/**@} end of group TSC_Sensor_Macros */
+
+/** @defgroup TSC_Sensor_Enumerations Enumerations
+  @{
+*/
+
+#ifdef TOUCH_SENSOR_CHANNELS
+/**
+ * @brief   Channel IOs and number of channels of each group, Block of each channel
+ */
+enum
+{
+    TSC_SNS_NIB1 = TSC_SNS_NIBBLE(1),
+    TSC_SNS_NIB2 = TSC_SNS_NIBBLE(2),
+    TSC_SNS_NIB3 = TSC_SNS_NIBBLE(3),
+    TSC_SNS_NIB4 = TSC_SNS_NIBBLE(4),
+    TSC_SNS_NIB5 = TSC_SNS_NIBBLE(5),
+    TSC_SNS_NIB6 = TSC_SNS_NIBBLE(6),
+    TSC_SNS_NIB7 = TSC_SNS_NIBBLE(7),
+    TSC_SNS_NIB8 = TSC_SNS_NIBBLE(8),
+    TSC_SNS_NUMCH1 = TSC_SNS_POPCNT4(TSC_SNS_NIB1),
+    TSC_SNS_NUMCH2 = TSC_SNS_POPCNT4(TSC_SNS_NIB2),
+    TSC_SNS_NUMCH3 = TSC_SNS_POPCNT4(TSC_SNS_NIB3),
+    TSC_SNS_NUMCH4 = TSC_SNS_POPCNT4(TSC_SNS_NIB4),
+    TSC_SNS_NUMCH5 = TSC_SNS_POPCNT4(TSC_SNS_NIB5),
+    TSC_SNS_NUMCH6 = TSC_SNS_POPCNT4(TSC_SNS_NIB6),
+    TSC_SNS_NUMCH7 = TSC_SNS_POPCNT4(TSC_SNS_NIB7),
+    TSC_SNS_NUMCH8 = TSC_SNS_POPCNT4(TSC_SNS_NIB8),
+    TOUCH_SENSOR_CHANNELS(TSC_SNS_X_RANK)
+    TSC_SNS_RANK_END
+};
+#endif /* TOUCH_SENSOR_CHANNELS */
+
+/**@} end of group TSC_Sensor_Enumerations */
+
+/**@} end of group TSC_Sensor_Driver */
+/**@} end of group TSC_Driver_Library */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_SENSOR_H */
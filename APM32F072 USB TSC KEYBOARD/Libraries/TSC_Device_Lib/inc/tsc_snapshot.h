@@ -0,0 +1,113 @@
+/*!
+ * @file        tsc_snapshot.h
+ *
+ * @brief       This file contains external declarations of the tsc_snapshot.c file.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __TSC_SNAPSHOT_H
+#define __TSC_SNAPSHOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "tsc_object.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Snapshot_Driver TSC Snapshot Driver
+  @{
+*/
+
+/** @defgroup TSC_Snapshot_Macros Macros
+  @{
+*/
+
+#if TOUCH_USE_SNAPSHOT > 0
+/* Identifier of the record layout, change it when TSC_Snapshot_T is modified */
+#define TSC_SNAP_MAGIC          ((uint32_t)0x5455)
+
+/* Size of a record and number of records in the flash page */
+#define TSC_SNAP_RECORD_WORDS   (sizeof(TSC_Snapshot_T) / 4)
+#define TSC_SNAP_NUM_RECORDS    (TOUCH_SNAPSHOT_PAGE_SIZE / sizeof(TSC_Snapshot_T))
+#endif
+
+/**@} end of group TSC_Snapshot_Macros */
+
+/** @defgroup TSC_Snapshot_Enumerations Enumerations
+  @{
+*/
+
+/**@} end of group TSC_Snapshot_Enumerations */
+
+/** @defgroup TSC_Snapshot_Structures Structures
+  @{
+*/
+
+#if TOUCH_USE_SNAPSHOT > 0
+/**
+ * @brief   Calibration snapshot record, as written in flash.
+ *          Two words per channel, in the order of the objects of the group:
+ *          - Reference (bits 0..15), RefRest (bits 16..23), noise samples (bits 24..31)
+ *          - Noise variance (bits 0..15)
+ */
+typedef struct
+{
+    uint32_t Header;                            /*!< Magic (bits 16..31), number of channels (bits 8..15), ECS K (bits 0..7) */
+    uint32_t Ctrl;                              /*!< Pulse generator settings of the References (TSC CTRL bits 12..31) */
+    uint32_t Channel[2 * TOUCH_TOTAL_CHANNELS]; /*!< Channels state */
+    uint32_t Crc;                               /*!< CRC32 of the previous words, written last */
+} TSC_Snapshot_T;
+#endif
+
+/**@} end of group TSC_Snapshot_Structures */
+
+/** @defgroup TSC_Snapshot_Variables Variables
+  @{
+*/
+
+/**@} end of group TSC_Snapshot_Variables */
+
+/** @defgroup TSC_Snapshot_Functions Functions
+  @{
+*/
+
+#if TOUCH_USE_SNAPSHOT > 0
+TSC_STATUS_T TSC_Snap_Config(TSC_ObjectGroup_T *objgrp);
+TSC_STATUS_T TSC_Snap_ConfigCtrl(void);
+TSC_STATUS_T TSC_Snap_ProcessRestore(TSC_ObjectGroup_T *objgrp);
+TSC_STATUS_T TSC_Snap_Save(TSC_ObjectGroup_T *objgrp);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_SNAPSHOT_H */
+
+/**@} end of group TSC_Snapshot_Functions */
+/**@} end of group TSC_Snapshot_Driver */
+/**@} end of group TSC_Driver_Library */
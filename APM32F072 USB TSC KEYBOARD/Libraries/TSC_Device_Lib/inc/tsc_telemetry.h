@@ -0,0 +1,110 @@
+/*!
+ * @file        tsc_telemetry.h
+ *
+ * @brief       This file contains external declarations of the tsc_telemetry.c file.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __TSC_TELEMETRY_H
+#define __TSC_TELEMETRY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "tsc_object.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Telemetry_Driver TSC Telemetry Driver
+  @{
+*/
+
+/** @defgroup TSC_Telemetry_Macros Macros
+  @{
+*/
+
+/* First byte of a record */
+#define TSC_TELEM_SYNC              ((uint8_t)0xA5)
+
+/* Size of a record, without the channels and the objects */
+#define TSC_TELEM_HEADER_SIZE       (7)
+#define TSC_TELEM_RECORD_SIZE(ch, obj)  (TSC_TELEM_HEADER_SIZE + (4 * (ch)) + (obj) + 1)
+
+/**@} end of group TSC_Telemetry_Macros */
+
+/** @defgroup TSC_Telemetry_Enumerations Enumerations
+  @{
+*/
+
+/**@} end of group TSC_Telemetry_Enumerations */
+
+/** @defgroup TSC_Telemetry_Structures Structures
+  @{
+*/
+
+/**
+ * @brief   Telemetry record, one per frame, little endian.
+ *          This is the layout of the bytes, not a C structure:
+ *          - Sync (1 byte): TSC_TELEM_SYNC
+ *          - Size (1 byte): size of the whole record
+ *          - Seq (1 byte): frame number, also incremented for the dropped records
+ *          - Tick (2 bytes): TSC_Globals.Tick_ms of the frame
+ *          - NbChannels (1 byte), NbObjects (1 byte)
+ *          - NbChannels x (Meas (2 bytes), Delta (2 bytes signed)), in the order of the objects
+ *          - NbObjects x StateId (1 byte)
+ *          - Checksum (1 byte): the sum of all the bytes of the record is 0
+ */
+
+/**@} end of group TSC_Telemetry_Structures */
+
+/** @defgroup TSC_Telemetry_Variables Variables
+  @{
+*/
+
+/**@} end of group TSC_Telemetry_Variables */
+
+/** @defgroup TSC_Telemetry_Functions Functions
+  @{
+*/
+
+#if TOUCH_USE_TELEMETRY > 0
+void TSC_Telem_Config(CONST TSC_ObjectGroup_T *objgrp);
+void TSC_Telem_Start(void);
+void TSC_Telem_Stop(void);
+void TSC_Telem_Write(void);
+uint16_t TSC_Telem_Read(uint8_t *buffer, uint16_t size);
+uint32_t TSC_Telem_ReadDrops(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_TELEMETRY_H */
+
+/**@} end of group TSC_Telemetry_Functions */
+/**@} end of group TSC_Telemetry_Driver */
+/**@} end of group TSC_Driver_Library */
@@ -70,6 +70,10 @@ typedef struct
     unsigned int       CounterDTO : 6;    /*!< Counter for DTO management (TSC_tCounter_T) */
     unsigned int       Change     : 1;    /*!< The State is different from the previous one (TSC_STATE_T) */
     unsigned int       DxsLock    : 1;    /*!< The State is locked by the DxS (TSC_BOOL_T) */
+#if TOUCH_USE_ADAPTIVE_DEBOUNCE > 0
+    unsigned int       NoiseCount : 7;    /*!< Number of samples in the noise estimation */
+    uint16_t           NoiseVar;          /*!< Delta variance measured in Release state */
+#endif
 } TSC_TouchKeyData_T;
 
 /**
@@ -133,10 +137,14 @@ void TSC_TouchKey_Process(void);
 /* Utility functions */
 void TSC_TouchKey_ConfigCalibrationState(TSC_tCounter_T delay);
 void TSC_TouchKey_ConfigOffState(void);
+void TSC_TouchKey_ConfigReleaseState(void);
 void TSC_TouchKey_ConfigBurstOnlyState(void);
 TSC_STATEID_T TSC_TouchKey_ReadStateId(void);
 TSC_STATEMASK_T TSC_TouchKey_ReadStateMask(void);
 TSC_tNum_T TSC_TouchKey_ReadChangeFlag(void);
+#if TOUCH_USE_ADAPTIVE_DEBOUNCE > 0
+TSC_tCounter_T TSC_TouchKey_ReadDebounceDetect(void);
+#endif
 
 /* State machine functions */
 void TSC_TouchKey_ProcessCalibrationState(void);
@@ -154,6 +162,33 @@ void TSC_TouchKey_ProcessDebDetectState(void);
 void TSC_TouchKey_ProcessTouchState(void);
 void TSC_TouchKey_ProcessDebErrorState(void);
 
+/* Reentrant functions, the TouchKey is given by the caller instead of TSC_Globals */
+void TSC_TouchKey_ConfigCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ConfigCalibrationStateCtx(CONST TSC_TouchKey_T *key, TSC_tCounter_T delay);
+void TSC_TouchKey_ConfigOffStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ConfigReleaseStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ConfigBurstOnlyStateCtx(CONST TSC_TouchKey_T *key);
+TSC_STATEID_T TSC_TouchKey_ReadStateIdCtx(CONST TSC_TouchKey_T *key);
+TSC_tNum_T TSC_TouchKey_ReadChangeFlagCtx(CONST TSC_TouchKey_T *key);
+#if TOUCH_USE_ADAPTIVE_DEBOUNCE > 0
+TSC_tCounter_T TSC_TouchKey_ReadDebounceDetectCtx(CONST TSC_TouchKey_T *key);
+#endif
+
+void TSC_TouchKey_ProcessCalibrationStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessDebCalibrationStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessReleaseStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessDebReleaseProxStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessDebReleaseDetectStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessDebReleaseTouchStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessProxStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessDebProxStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessDebProxDetectStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessDebProxTouchStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessDetectStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessDebDetectStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessTouchStateCtx(CONST TSC_TouchKey_T *key);
+void TSC_TouchKey_ProcessDebErrorStateCtx(CONST TSC_TouchKey_T *key);
+
 #ifdef __cplusplus
 }
 #endif
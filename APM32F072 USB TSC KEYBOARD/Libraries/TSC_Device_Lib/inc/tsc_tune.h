@@ -0,0 +1,99 @@
+/*!
+ * @file        tsc_tune.h
+ *
+ * @brief       This file contains external declarations of the tsc_tune.c file.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __TSC_TUNE_H
+#define __TSC_TUNE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "tsc_acq.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Tune_Driver TSC Tune Driver
+  @{
+*/
+
+/** @defgroup TSC_Tune_Macros Macros
+  @{
+*/
+
+/**@} end of group TSC_Tune_Macros */
+
+/** @defgroup TSC_Tune_Enumerations Enumerations
+  @{
+*/
+
+/**@} end of group TSC_Tune_Enumerations */
+
+/** @defgroup TSC_Tune_Structures Structures
+  @{
+*/
+
+/**
+ * @brief   Pulse generator settings found by the tuning
+ */
+typedef struct
+{
+    uint8_t      CtpHigh;        /*!< Charge transfer pulse high (CTPHSEL) */
+    uint8_t      CtpLow;         /*!< Charge transfer pulse low (CTPLSEL) */
+    uint8_t      Pgcdf;          /*!< Pulse generator clock divide factor (PGCDFSEL) */
+    uint8_t      SpreadSpectrum; /*!< 1 if the spread spectrum is enabled with TOUCH_TSC_SSERRVSEL */
+    TSC_tMeas_T  MaxMeas;        /*!< Highest mean measure of the channels */
+    TSC_tMeas_T  MaxNoise;       /*!< Highest peak to peak noise of the channels */
+    uint32_t     BurstCycles;    /*!< Estimated HCLK cycles of the longest burst */
+} TSC_TuneResult_T;
+
+/**@} end of group TSC_Tune_Structures */
+
+/** @defgroup TSC_Tune_Variables Variables
+  @{
+*/
+
+/**@} end of group TSC_Tune_Variables */
+
+/** @defgroup TSC_Tune_Functions Functions
+  @{
+*/
+
+#if TOUCH_USE_TUNE > 0
+TSC_STATUS_T TSC_Tune_Process(TSC_TuneResult_T *result);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_TUNE_H */
+
+/**@} end of group TSC_Tune_Functions */
+/**@} end of group TSC_Tune_Driver */
+/**@} end of group TSC_Driver_Library */
@@ -80,6 +80,14 @@ TSC_STATUS_T TSC_Config(CONST TSC_Block_T *block)
         retval = TSC_Acq_Config();
     }
 
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+    /* Schedule the bursts from the channel-to-group map */
+    if (retval == TSC_STATUS_OK)
+    {
+        retval = TSC_Acq_ConfigScheduler();
+    }
+#endif
+
     return retval;
 }
 
@@ -27,6 +27,13 @@
 #include "tsc.h"
 #include "tsc_acq.h"
 #include "apm32f0xx_int.h"
+#include "apm32f0xx_misc.h"
+#if TOUCH_USE_DMA_READOUT > 0
+#include "apm32f0xx_dma.h"
+#endif
+#if TOUCH_USE_DISCHARGE_TIMER > 0
+#include "apm32f0xx_tmr.h"
+#endif
 
 /** @addtogroup TSC_Driver_Library TSC Driver Library
   @{
@@ -40,6 +47,33 @@
   @{
 */
 
+#if TOUCH_USE_DMA_READOUT > 0
+/* DMA1 channel and transfer complete flag used for the counters readout */
+#define TSC_DMA_CHANNEL   ((DMA_CHANNEL_T*)(DMA1_CHANNEL_1_BASE + (0x14 * (TOUCH_DMA_READOUT_CHANNEL - 1))))
+#define TSC_DMA_FLAG_GINT ((uint32_t)0x01 << (4 * (TOUCH_DMA_READOUT_CHANNEL - 1)))
+#define TSC_DMA_FLAG_TF   ((uint32_t)0x02 << (4 * (TOUCH_DMA_READOUT_CHANNEL - 1)))
+/* DMA1 channel 1, channels 2-3 and channels 4-7 share the interrupt lines 9, 10 and 11 */
+#if TOUCH_DMA_READOUT_CHANNEL == 1
+#define TSC_DMA_IRQn      ((IRQn_Type)9)
+#elif TOUCH_DMA_READOUT_CHANNEL <= 3
+#define TSC_DMA_IRQn      ((IRQn_Type)10)
+#else
+#define TSC_DMA_IRQn      ((IRQn_Type)11)
+#endif
+#endif
+
+/* Number of loops used to calibrate the discharge software delay */
+#define TSC_DELAY_CALIB_LOOPS  (256)
+
+#if TOUCH_USE_LOWPOWER > 0
+/* Ticks between two guard bursts, rounded up */
+#define TSC_GUARD_TICKS  ((((uint32_t)TOUCH_LP_SCAN_PERIOD * TOUCH_TICK_FREQ) + 999) / 1000)
+/* Longest period of the timing tick timer during the guard wait, in ticks */
+#define TSC_GUARD_STEP_MAX  (65536 / TOUCH_DISCHARGE_TIMER_PERIOD)
+/* Timer counts kept between the counter and a new auto-reload value */
+#define TSC_GUARD_STEP_MARGIN  (8)
+#endif
+
 /**@} end of group TSC_Acquisition_Macros */
 
 /** @defgroup TSC_Acquisition_Enumerations Enumerations
@@ -60,6 +94,20 @@
 
 uint32_t DelayDischarge;
 
+#if TOUCH_USE_SOA > 0
+/* Meas, Refer and Delta of all channels */
+TSC_ChannelArrays_T TSC_ChArrays;
+#endif
+
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+/* Frame queue filled by the TSC interrupt routine */
+static TSC_FrameQueue_T FrameQueue;
+/* Set while the acquisition engine is running */
+static __IO uint8_t EngineRun;
+/* Bursts of the Frame being acquired */
+static TSC_Schedule_T Schedule;
+#endif
+
 /**@} end of group TSC_Acquisition_Variables */
 
 /** @defgroup TSC_Acquisition_Functions Functions
@@ -67,6 +115,17 @@ uint32_t DelayDischarge;
 */
 
 void SoftDelay(uint32_t val);
+static uint32_t TSC_Acq_CalibrateDelay(uint32_t delayUs);
+static void TSC_Acq_StartBurst(void);
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+static void TSC_Acq_StartNextBurst(void);
+static void TSC_Acq_PushFrame(void);
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+static void TSC_Acq_CountCycles(uint32_t tickStart, uint32_t add);
+#endif
+#endif
+static TSC_STATUS_T TSC_Acq_ProcessChannel(TSC_Channel_Data_T *pchData, TSC_tIndexDest_T idxDest, TSC_tMeas_T newMeas,
+                                           TSC_pMeasFilter_T mfilter, TSC_pDeltaFilter_T dfilter);
 
 /*!
  * @brief       Output Open-Drain for Sampling Capacitor in GPIOA
@@ -979,11 +1038,11 @@ TSC_STATUS_T TSC_Acq_Config(void)
     /* Config both EOAIEN and MCEIEN interrupts */
     TSC->INTEN |= 0x03;
     /* Configure NVIC */
-    NVIC_EnableIRQRequest(TSC_IRQn,0)
+    NVIC_EnableIRQRequest(TSC_IRQn, 0);
 #endif
 
     /* Configure the delay that will be used to discharge the capacitors */
-    DelayDischarge = (uint32_t)((TOUCH_DELAY_DISCHARGE_ALL * (uint32_t)(SystemCoreClock/1000000)) / 48);
+    DelayDischarge = TSC_Acq_CalibrateDelay(TOUCH_DELAY_DISCHARGE_US);
     return TSC_STATUS_OK;
 }
 
@@ -1046,12 +1105,24 @@ TSC_STATUS_T TSC_Acq_ConfigBlock(TSC_tIndex_T idxBlock)
  */
 void TSC_Acq_StartPerConfigBlock(void)
 {
-    /* Clear both EOAIC and MCEIC flag */
-    TSC->INTFCLR |= 0x03;
-
     /* Wait capacitors discharge */
     SoftDelay(DelayDischarge);
 
+    TSC_Acq_StartBurst();
+}
+
+/*!
+ * @brief       Start acquisition once the capacitors are discharged (private routine)
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void TSC_Acq_StartBurst(void)
+{
+    /* Clear both EOAIC and MCEIC flag */
+    TSC->INTFCLR |= 0x03;
+
 #if TOUCH_TSC_IODEF > 0
     /* Config IO default in Input Floating */
     TSC->CTRL |= (1 << 4);
@@ -1202,6 +1273,132 @@ void SoftDelay(uint32_t val)
     {}
 }
 
+/*!
+ * @brief       Calculate the SoftDelay parameter of a delay (private routine)
+ *
+ * @param       delayUs: Delay in microseconds
+ *
+ * @retval      SoftDelay parameter
+ *
+ * @note        The SoftDelay loop is measured with the SysTick counter, which must be running.
+ */
+static uint32_t TSC_Acq_CalibrateDelay(uint32_t delayUs)
+{
+    uint32_t primask;
+    uint32_t tickStart;
+    uint32_t cycles;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    tickStart = SysTick->VAL;
+    SoftDelay(TSC_DELAY_CALIB_LOOPS);
+    /* SysTick is a down counter */
+    cycles = tickStart - SysTick->VAL;
+    if (cycles > SysTick->LOAD)
+    {
+        cycles += SysTick->LOAD + 1;
+    }
+
+    __set_PRIMASK(primask);
+
+    if (cycles == 0)
+    {
+        cycles = TSC_DELAY_CALIB_LOOPS;
+    }
+
+    return ((delayUs * (SystemCoreClock / 1000000) * TSC_DELAY_CALIB_LOOPS) / cycles);
+}
+
+/*!
+ * @brief       Store a new measurement in a channel and calculate delta (private routine)
+ *
+ * @param       pchData: Pointer to the channel data
+ *
+ * @param       idxDest: Index of the channel in the Channel Data array
+ *
+ * @param       newMeas: Measure of the last acquisition on this channel
+ *
+ * @param       mfilter: Pointer to the measure filter
+ *
+ * @param       dfilter: Pointer to the delta filter
+ *
+ * @retval      Status
+ */
+static TSC_STATUS_T TSC_Acq_ProcessChannel(TSC_Channel_Data_T *pchData, TSC_tIndexDest_T idxDest, TSC_tMeas_T newMeas,
+                                           TSC_pMeasFilter_T mfilter, TSC_pDeltaFilter_T dfilter)
+{
+    TSC_tMeas_T  oldMeas;
+    TSC_tDelta_T newDelta;
+
+    pchData->Flag.DataReady = TSC_DATA_READY;
+
+    #if TOUCH_USE_MEAS > 0
+    oldMeas = TSC_CH_MEAS(pchData);
+    #else
+    oldMeas = newMeas;
+    #endif
+
+    #if TOUCH_USE_MEAS > 0
+    TSC_CH_MEAS(pchData) = newMeas;
+    #endif
+
+    /* Check acquisition value min/max */
+    if (newMeas > TSC_Params.AcqMax)
+    {
+        pchData->Flag.AcqStatus = TSC_ACQ_STATUS_ERROR_MAX;
+        TSC_CH_DELTA(pchData) = 0;
+        return TSC_STATUS_ERROR;
+    }
+
+    if (newMeas < TSC_Params.AcqMin)
+    {
+        pchData->Flag.AcqStatus = TSC_ACQ_STATUS_ERROR_MIN;
+        TSC_CH_DELTA(pchData) = 0;
+        return TSC_STATUS_ERROR;
+    }
+
+    /* The measure is OK */
+#if TOUCH_USE_FILTER_BANK > 0
+    newMeas = TSC_Filt_ProcessBank(idxDest, newMeas);
+    #if TOUCH_USE_MEAS > 0
+    TSC_CH_MEAS(pchData) = newMeas;
+    #endif
+#endif
+
+    if (TSC_Acq_UseFilter(pchData) == 0)
+    {
+        TSC_CH_DELTA(pchData) = TSC_Acq_ComputeDelta(TSC_CH_REFER(pchData), newMeas);
+        pchData->Flag.AcqStatus = TSC_Acq_CheckNoise();
+    }
+    else
+    {
+        /* Measure filter*/
+        if (mfilter)
+        {
+            newMeas = mfilter(oldMeas, newMeas);
+            /* Store the measure */
+            #if TOUCH_USE_MEAS > 0
+            TSC_CH_MEAS(pchData) = newMeas;
+            #endif
+        }
+
+        newDelta = TSC_Acq_ComputeDelta(TSC_CH_REFER(pchData), newMeas);
+        pchData->Flag.AcqStatus = TSC_Acq_CheckNoise();
+
+        /* Delta filter */
+        if (dfilter == 0)
+        {
+            TSC_CH_DELTA(pchData) = newDelta;
+        }
+        else
+        {
+            TSC_CH_DELTA(pchData) = dfilter(newDelta);
+        }
+    }
+    return TSC_STATUS_OK;
+}
+
 /*!
  * @brief       Read all channels measurement of a Block, calculate delta
  *
@@ -1218,8 +1415,6 @@ TSC_STATUS_T TSC_Acq_ReadBlockResult(TSC_tIndex_T idxBlock, TSC_pMeasFilter_T mf
     TSC_STATUS_T       retval = TSC_STATUS_OK;
     TSC_tIndex_T       idxChannel;
     TSC_tIndexDest_T   idxDest;
-    TSC_tMeas_T        oldMeas, newMeas;
-    TSC_tDelta_T       newDelta;
     CONST TSC_Block_T   *block = &(TSC_Globals.Block_Array[idxBlock]);
     CONST TSC_Channel_Dest_T *pchDest = block->p_chDest;
     CONST TSC_Channel_Src_T  *pchSrc = block->p_chSrc;
@@ -1231,75 +1426,1106 @@ TSC_STATUS_T TSC_Acq_ReadBlockResult(TSC_tIndex_T idxBlock, TSC_pMeasFilter_T mf
 
         if (block->p_chData[idxDest].Flag.ObjStatus == TSC_OBJ_STATUS_ON)
         {
-            block->p_chData[idxDest].Flag.DataReady = TSC_DATA_READY;
-            newMeas = TSC_Acq_ReadMeasurVal(pchSrc->IdxSrc);
+            if (TSC_Acq_ProcessChannel(&block->p_chData[idxDest], idxDest, TSC_Acq_ReadMeasurVal(pchSrc->IdxSrc),
+                                       mfilter, dfilter) != TSC_STATUS_OK)
+            {
+                retval = TSC_STATUS_ERROR;
+            }
+        }
+        pchDest++;
+        pchSrc++;
+    }
+    return retval;
+}
 
-            #if TOUCH_USE_MEAS > 0
-            oldMeas = block->p_chData[idxDest].Meas;
-            #else
-            oldMeas = newMeas;
-            #endif
+#if (TOUCH_USE_SOA > 0) && (TOUCH_USE_ACQ_INTERRUPT > 0)
 
-            #if TOUCH_USE_MEAS > 0
-            block->p_chData[idxDest].Meas = newMeas;
-            #endif
+/*!
+ * @brief       Store the measurement of one channel and calculate delta (private routine)
+ *
+ * @param       idx: Index of the channel in the Channel Data array
+ *
+ * @param       newMeas: Measure of the last acquisition on this channel
+ *
+ * @param       acqMin: Minimum acquisition value
+ *
+ * @param       acqMax: Maximum acquisition value
+ *
+ * @param       acquired: Channels acquired in the Frame
+ *
+ * @retval      1 if the measure is out of range, 0 otherwise
+ */
+__STATIC_INLINE uint32_t TSC_Acq_BatchChannel(TSC_tIndexDest_T idx, TSC_tMeas_T newMeas,
+                                              TSC_tMeas_T acqMin, TSC_tMeas_T acqMax, uint32_t acquired)
+{
+    TSC_Channel_Data_T *pchData = &TOUCH_SOA_CHANNEL_DATA[idx];
+
+    if ((pchData->Flag.ObjStatus != TSC_OBJ_STATUS_ON) || ((acquired & ((uint32_t)1 << idx)) == 0))
+    {
+        return 0;
+    }
+
+    pchData->Flag.DataReady = TSC_DATA_READY;
+    TSC_ChArrays.Meas[idx] = newMeas;
+
+    if (newMeas > acqMax)
+    {
+        pchData->Flag.AcqStatus = TSC_ACQ_STATUS_ERROR_MAX;
+        TSC_ChArrays.Delta[idx] = 0;
+        return 1;
+    }
+
+    if (newMeas < acqMin)
+    {
+        pchData->Flag.AcqStatus = TSC_ACQ_STATUS_ERROR_MIN;
+        TSC_ChArrays.Delta[idx] = 0;
+        return 1;
+    }
+
+#if TOUCH_USE_FILTER_BANK > 0
+    newMeas = TSC_Filt_ProcessBank(idx, newMeas);
+    TSC_ChArrays.Meas[idx] = newMeas;
+#endif
+
+    pchData->Flag.AcqStatus = TSC_ACQ_STATUS_OK;
+    TSC_ChArrays.Delta[idx] = TSC_Acq_ComputeDelta(TSC_ChArrays.Refer[idx], newMeas);
+    return 0;
+}
+
+/*!
+ * @brief       Store the measurements of all channels and calculate deltas (private routine)
+ *
+ * @param       newMeas: Measures indexed as the Channel Data array
+ *
+ * @param       acquired: Channels acquired in the Frame
+ *
+ * @retval      Status
+ *
+ * @note        The loop is unrolled by 4 to reduce the branch overhead on Cortex-M0.
+ *              There is no SIMD variant: the Cortex-M0 has no SIMD instructions and
+ *              each channel branches on its own status and range checks.
+ */
+static TSC_STATUS_T TSC_Acq_BatchChannels(CONST TSC_tMeas_T *newMeas, uint32_t acquired)
+{
+    TSC_tIndexDest_T idx = 0;
+    TSC_tMeas_T      acqMin = TSC_Params.AcqMin;
+    TSC_tMeas_T      acqMax = TSC_Params.AcqMax;
+    uint32_t         error = 0;
+
+#if TOUCH_TOTAL_CHANNELS >= 4
+    for (; idx <= (TOUCH_TOTAL_CHANNELS - 4); idx += 4)
+    {
+        error |= TSC_Acq_BatchChannel(idx,     newMeas[idx],     acqMin, acqMax, acquired);
+        error |= TSC_Acq_BatchChannel(idx + 1, newMeas[idx + 1], acqMin, acqMax, acquired);
+        error |= TSC_Acq_BatchChannel(idx + 2, newMeas[idx + 2], acqMin, acqMax, acquired);
+        error |= TSC_Acq_BatchChannel(idx + 3, newMeas[idx + 3], acqMin, acqMax, acquired);
+    }
+#endif
+    for (; idx < TOUCH_TOTAL_CHANNELS; idx++)
+    {
+        error |= TSC_Acq_BatchChannel(idx, newMeas[idx], acqMin, acqMax, acquired);
+    }
+
+    return (error ? TSC_STATUS_ERROR : TSC_STATUS_OK);
+}
+
+#endif
+
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+
+/*!
+ * @brief       Config the burst scheduler from the channel-to-group map of the Blocks
+ *
+ * @param       None
+ *
+ * @retval      Status
+ *
+ * @note        Called by TSC_Config(). The Blocks only give the channel-to-group map:
+ *              the Nth channel of each group is acquired in the Nth burst, so the number
+ *              of bursts is the maximum number of channels in a group.
+ */
+TSC_STATUS_T TSC_Acq_ConfigScheduler(void)
+{
+    TSC_tIndex_T       idxBlock;
+    TSC_tIndex_T       idxChannel;
+    uint8_t            numGroup[TSC_NB_GROUPS];
+    uint32_t           chMask;
+    uint32_t           shieldMask = 0;
+    TSC_tNum_T         fullBurst = 0;
+    CONST TSC_Block_T  *block = TSC_Globals.Block_Array;
+    CONST TSC_Channel_Src_T  *pchSrc;
+    CONST TSC_Channel_Dest_T *pchDest;
+#if TOUCH_USE_LOWPOWER > 0
+    TSC_Burst_T        *guard = &Schedule.GuardBurst;
+
+    guard->msk_IOCHCTRL_channels = 0;
+    guard->msk_IOGCSTS_groups = 0;
+    guard->NumChannel = 0;
+#endif
+
+    for (idxChannel = 0; idxChannel < TSC_NB_GROUPS; idxChannel++)
+    {
+        numGroup[idxChannel] = 0;
+    }
+
+    for (idxBlock = 0; idxBlock < TOUCH_TOTAL_BLOCKS; idxBlock++)
+    {
+        pchSrc = block->p_chSrc;
+        pchDest = block->p_chDest;
+        chMask = 0;
 
-            /* Check acquisition value min/max */
-            if (newMeas > TSC_Params.AcqMax)
+        for (idxChannel = 0; idxChannel < block->NumChannel; idxChannel++)
+        {
+            if ((pchSrc->IdxSrc >= TSC_NB_GROUPS) || (pchDest->IdxDest >= 32))
             {
-                block->p_chData[idxDest].Flag.AcqStatus = TSC_ACQ_STATUS_ERROR_MAX;
-                block->p_chData[idxDest].Delta = 0;
-                retval = TSC_STATUS_ERROR;
+                return TSC_STATUS_ERROR;
             }
-            else
+
+            numGroup[pchSrc->IdxSrc]++;
+            if (numGroup[pchSrc->IdxSrc] > fullBurst)
+            {
+                fullBurst = numGroup[pchSrc->IdxSrc];
+            }
+            chMask |= pchSrc->msk_IOCHCTRL_channel;
+#if TOUCH_USE_LOWPOWER > 0
+            /* One guard channel per group, stored at the index of the group in the burst */
+            if ((guard->msk_IOGCSTS_groups & pchSrc->msk_IOGCSTS_group) == 0)
+            {
+                guard->msk_IOGCSTS_groups |= pchSrc->msk_IOGCSTS_group;
+                guard->IdxSrc[guard->NumChannel] = pchSrc->IdxSrc;
+                guard->IdxDest[guard->NumChannel] = guard->NumChannel;
+                guard->NumChannel++;
+            }
+#endif
+            pchSrc++;
+            pchDest++;
+        }
+
+        /* The other IOs of the Block are shields */
+        shieldMask |= block->msk_IOCHCTRL_channels & ~chMask;
+#if TOUCH_USE_LOWPOWER > 0
+        guard->msk_IOCHCTRL_channels |= block->msk_IOCHCTRL_channels;
+#endif
+        block++;
+    }
+
+    if (fullBurst > TOUCH_TOTAL_BLOCKS)
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    Schedule.msk_IOCHCTRL_shields = shieldMask;
+    Schedule.FullBurst = fullBurst;
+    Schedule.NumBurst = 0;
+    Schedule.IdleCount = 0;
+
+    return TSC_STATUS_OK;
+}
+
+/*!
+ * @brief       Return the number of bursts needed to acquire all channels
+ *
+ * @param       None
+ *
+ * @retval      Number of bursts
+ */
+TSC_tNum_T TSC_Acq_ReadBurstCount(void)
+{
+    return Schedule.FullBurst;
+}
+
+/*!
+ * @brief       Build the bursts of the next Frame (private routine)
+ *
+ * @param       full: 1 to acquire all channels, 0 to skip the channels of the idle Objects
+ *
+ * @retval      Number of bursts, 0 if no channel is selected
+ */
+static TSC_tNum_T TSC_Acq_ScheduleBursts(uint32_t full)
+{
+    TSC_tIndex_T       idxBlock;
+    TSC_tIndex_T       idxChannel;
+    TSC_tIndexDest_T   idxDest;
+    TSC_tIndexSrc_T    idxSrc;
+    TSC_tNum_T         numBurst = 0;
+    uint8_t            numGroup[TSC_NB_GROUPS];
+    uint8_t            idxBurst;
+    TSC_Channel_Flag_T flag;
+    TSC_Burst_T        *burst;
+    CONST TSC_Block_T  *block = TSC_Globals.Block_Array;
+    CONST TSC_Channel_Src_T  *pchSrc;
+    CONST TSC_Channel_Dest_T *pchDest;
+
+    for (idxBurst = 0; idxBurst < TOUCH_TOTAL_BLOCKS; idxBurst++)
+    {
+        Schedule.Burst[idxBurst].msk_IOCHCTRL_channels = Schedule.msk_IOCHCTRL_shields;
+        Schedule.Burst[idxBurst].msk_IOGCSTS_groups = 0;
+        Schedule.Burst[idxBurst].NumChannel = 0;
+    }
+    for (idxBurst = 0; idxBurst < TSC_NB_GROUPS; idxBurst++)
+    {
+        numGroup[idxBurst] = 0;
+    }
+    Schedule.Acquired = 0;
+
+    for (idxBlock = 0; idxBlock < TOUCH_TOTAL_BLOCKS; idxBlock++)
+    {
+        pchSrc = block->p_chSrc;
+        pchDest = block->p_chDest;
+
+        for (idxChannel = 0; idxChannel < block->NumChannel; idxChannel++)
+        {
+            idxDest = pchDest->IdxDest;
+            flag = block->p_chData[idxDest].Flag;
+
+            if ((flag.ObjStatus != TSC_OBJ_STATUS_OFF) && (full || (flag.ScanIdle == 0)))
             {
-                if (newMeas < TSC_Params.AcqMin)
+                /* The Nth selected channel of a group goes in the Nth burst */
+                idxSrc = pchSrc->IdxSrc;
+                idxBurst = numGroup[idxSrc]++;
+                burst = &Schedule.Burst[idxBurst];
+                burst->msk_IOCHCTRL_channels |= pchSrc->msk_IOCHCTRL_channel;
+
+                if (flag.ObjStatus == TSC_OBJ_STATUS_ON)
                 {
-                    block->p_chData[idxDest].Flag.AcqStatus = TSC_ACQ_STATUS_ERROR_MIN;
-                    block->p_chData[idxDest].Delta = 0;
-                    retval = TSC_STATUS_ERROR;
+                    burst->msk_IOGCSTS_groups |= pchSrc->msk_IOGCSTS_group;
+                    burst->IdxSrc[burst->NumChannel] = idxSrc;
+                    burst->IdxDest[burst->NumChannel] = idxDest;
+                    burst->NumChannel++;
+                    Schedule.Acquired |= (uint32_t)1 << idxDest;
+                #if TOUCH_USE_DMA_READOUT > 0
+                    Schedule.BurstOf[idxDest] = idxBurst;
+                #endif
                 }
-                else /*!< The measure is OK */
+
+                if (idxBurst >= numBurst)
                 {
-                    if (TSC_Acq_UseFilter(&block->p_chData[idxDest]) == 0)
-                    {
-                        block->p_chData[idxDest].Delta = TSC_Acq_ComputeDelta(block->p_chData[idxDest].Refer, newMeas);
-                        block->p_chData[idxDest].Flag.AcqStatus = TSC_Acq_CheckNoise();
-                    }
-                    else
-                    {
-                        /* Measure filter*/
-                        if (mfilter)
-                        {
-                            newMeas = mfilter(oldMeas, newMeas);
-                            /* Store the measure */
-                            #if TOUCH_USE_MEAS > 0
-                            block->p_chData[idxDest].Meas = newMeas;
-                            #endif
-                        }
-
-                        newDelta = TSC_Acq_ComputeDelta(block->p_chData[idxDest].Refer, newMeas);
-                        block->p_chData[idxDest].Flag.AcqStatus = TSC_Acq_CheckNoise();
-
-                        /* Delta filter */
-                        if (dfilter == 0)
-                        {
-                            block->p_chData[idxDest].Delta = newDelta;
-                        }
-                        else
-                        {
-                            block->p_chData[idxDest].Delta = dfilter(newDelta);
-                        }
-                    }
+                    numBurst = (TSC_tNum_T)(idxBurst + 1);
                 }
             }
+            pchSrc++;
+            pchDest++;
         }
-        pchDest++;
-        pchSrc++;
+        block++;
+    }
+
+    Schedule.NumBurst = numBurst;
+    return numBurst;
+}
+
+/*!
+ * @brief       Select the channels of the next Frame and build its bursts (private routine)
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        The channels of the idle Objects are acquired every TOUCH_SCAN_IDLE_DIVIDER Frames.
+ *              If no Object is active all channels are acquired.
+ *              In guard mode the Frame only holds the guard burst.
+ */
+static void TSC_Acq_ScheduleFrame(void)
+{
+#if TOUCH_USE_LOWPOWER > 0
+    Schedule.GuardFrame = Schedule.GuardMode;
+
+    if (Schedule.GuardFrame)
+    {
+        /* The guard channels are not Channel Data: no channel is marked as acquired */
+        Schedule.Burst[0] = Schedule.GuardBurst;
+        Schedule.NumBurst = 1;
+        Schedule.Acquired = 0;
+        return;
+    }
+#endif
+
+#if TOUCH_SCAN_IDLE_DIVIDER > 1
+    if (Schedule.IdleCount > 0)
+    {
+        Schedule.IdleCount--;
+
+        if (TSC_Acq_ScheduleBursts(0) > 0)
+        {
+            return;
+        }
+    }
+    Schedule.IdleCount = TOUCH_SCAN_IDLE_DIVIDER - 1;
+#endif
+
+    if (TSC_Acq_ScheduleBursts(1) == 0)
+    {
+        /* All channels are off: keep one empty burst to run the Frames */
+        Schedule.NumBurst = 1;
     }
-    return retval;
 }
 
+/*!
+ * @brief       Config a burst of the current Frame (private routine)
+ *
+ * @param       idxBurst: Index of the burst
+ *
+ * @retval      None
+ */
+static void TSC_Acq_ConfigBurst(TSC_tIndex_T idxBurst)
+{
+    /* Enable the Gx_IOy used as channels (channels + shield) */
+    TSC->IOCHCTRL = Schedule.Burst[idxBurst].msk_IOCHCTRL_channels;
+    /* Enable acquisition on selected Groups */
+    TSC->IOGCSTS = Schedule.Burst[idxBurst].msk_IOGCSTS_groups;
+}
+
+/*!
+ * @brief       Copy the schedule of the current Frame in a Frame slot (private routine)
+ *
+ * @param       frame: Pointer to the Frame
+ *
+ * @retval      None
+ */
+static void TSC_Acq_StartFrame(TSC_Frame_T *frame)
+{
+#if TOUCH_USE_DMA_READOUT > 0
+    TSC_tIndexDest_T idxDest;
+
+    for (idxDest = 0; idxDest < TOUCH_TOTAL_CHANNELS; idxDest++)
+    {
+        frame->Burst[idxDest] = Schedule.BurstOf[idxDest];
+    }
+#endif
+    frame->Acquired = Schedule.Acquired;
+    frame->Status = TSC_STATUS_OK;
+#if TOUCH_USE_LOWPOWER > 0
+    frame->Guard = Schedule.GuardFrame;
+#endif
+}
+
+/*!
+ * @brief       Start the discharge delay on the compare 1 channel of the timer (private routine)
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void TSC_Acq_StartDischarge(void)
+{
+    uint32_t compare = TOUCH_DISCHARGE_TIMER->CNT + TOUCH_DELAY_DISCHARGE_US;
+
+    if (compare >= TOUCH_DISCHARGE_TIMER_PERIOD)
+    {
+        compare -= TOUCH_DISCHARGE_TIMER_PERIOD;
+    }
+
+    TOUCH_DISCHARGE_TIMER->CC1 = compare;
+    TMR_ClearIntFlag(TOUCH_DISCHARGE_TIMER, TMR_INT_FLAG_CH1);
+    TMR_EnableInterrupt(TOUCH_DISCHARGE_TIMER, TMR_INT_CH1);
+}
+
+/*!
+ * @brief       Start the next burst at the end of the discharge delay
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        This function must be called from the interrupt routine of TOUCH_DISCHARGE_TIMER.
+ */
+void TSC_Acq_ProcessDischarge(void)
+{
+    if (TMR_ReadIntFlag(TOUCH_DISCHARGE_TIMER, TMR_INT_FLAG_CH1) == SET)
+    {
+        TMR_DisableInterrupt(TOUCH_DISCHARGE_TIMER, TMR_INT_CH1);
+        TMR_ClearIntFlag(TOUCH_DISCHARGE_TIMER, TMR_INT_FLAG_CH1);
+
+#if TOUCH_USE_LOWPOWER > 0
+        /* The guard burst is started by the tick */
+        if (Schedule.GuardWait > 0)
+        {
+            return;
+        }
+#endif
+        if (EngineRun)
+        {
+            TSC_Acq_StartNextBurst();
+        }
+    }
+}
+
+/*!
+ * @brief       Start the next burst once its counters can be cleared (private routine)
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        With DMA readout the start is delayed to the end of the counters copy.
+ */
+static void TSC_Acq_StartNextBurst(void)
+{
+#if TOUCH_USE_DMA_READOUT > 0
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (FrameQueue.DmaBusy)
+    {
+        /* Started by TSC_Acq_ProcessDmaReadout() */
+        FrameQueue.StartPending = 1;
+        __set_PRIMASK(primask);
+        return;
+    }
+    __set_PRIMASK(primask);
+#endif
+
+    TSC_Acq_StartBurst();
+}
+
+/*!
+ * @brief       Start the interrupt driven acquisition of all Blocks
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        The TSC interrupt routine must call TSC_Acq_ProcessInterrupt().
+ *              Each complete Frame is read with TSC_Acq_ReadFrame().
+ */
+void TSC_Acq_StartEngine(void)
+{
+#if TOUCH_USE_DMA_READOUT > 0
+    DMA_Config_T dmaConfig;
+#endif
+
+    FrameQueue.Head = 0;
+    FrameQueue.Tail = 0;
+    FrameQueue.Block = 0;
+    FrameQueue.Overrun = 0;
+#if TOUCH_USE_DMA_READOUT > 0
+    FrameQueue.DmaBusy = 0;
+    FrameQueue.StartPending = 0;
+#endif
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+    FrameQueue.Cycles = 0;
+    FrameQueue.CyclesMax = 0;
+#endif
+
+#if TOUCH_USE_DMA_READOUT > 0
+    RCM_EnableAHBPeriphClock(RCM_AHB_PERIPH_DMA1);
+
+    /* Copy the 8 group counters (32-bit) in the Frame (16-bit) */
+    DMA_Reset(TSC_DMA_CHANNEL);
+    DMA_ConfigStructInit(&dmaConfig);
+    dmaConfig.peripheralAddress = (uint32_t)&TSC->IOGxCNT[0];
+    dmaConfig.memoryAddress = (uint32_t)&FrameQueue.Frame[0].Raw[0][0];
+    dmaConfig.direction = DMA_DIR_PERIPHERAL;
+    dmaConfig.bufferSize = TSC_NB_GROUPS;
+    dmaConfig.peripheralDataSize = DMA_PERIPHERAL_DATASIZE_WORD;
+    dmaConfig.memoryDataSize = DMA_MEMORY_DATASIZE_HALFWORD;
+    dmaConfig.peripheralInc = DMA_PERIPHERAL_INC_ENABLE;
+    dmaConfig.memoryInc = DMA_MEMORY_INC_ENABLE;
+    dmaConfig.priority = DMA_PRIORITY_LEVEL_VERYHIGH;
+    dmaConfig.memoryTomemory = DMA_M2M_ENABLE;
+    DMA_Config(TSC_DMA_CHANNEL, &dmaConfig);
+
+    /* The end of the copy is handled by TSC_Acq_ProcessDmaReadout() */
+    DMA_EnableInterrupt(TSC_DMA_CHANNEL, DMA_INT_TFIE);
+    NVIC_EnableIRQRequest(TSC_DMA_IRQn, 0);
+#endif
+
+    EngineRun = 1;
+#if TOUCH_USE_LOWPOWER > 0
+    Schedule.GuardWait = 0;
+#endif
+
+    TSC_Acq_ScheduleFrame();
+    TSC_Acq_StartFrame(&FrameQueue.Frame[0]);
+    TSC_Acq_ConfigBurst(0);
+    TSC_Acq_StartDischarge();
+}
+
+/*!
+ * @brief       Stop the interrupt driven acquisition after the current Block
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+void TSC_Acq_StopEngine(void)
+{
+    EngineRun = 0;
+}
+
+#if TOUCH_USE_LOWPOWER > 0
+/*!
+ * @brief       Set the period of the timing tick timer (private routine)
+ *
+ * @param       step: Ticks until the next update of the timer (1 .. TSC_GUARD_STEP_MAX)
+ *
+ * @retval      None
+ *
+ * @note        The auto-reload preload of the timer must be disabled: the period is
+ *              applied at once, the counter must be lower than the new period.
+ */
+static void TSC_Acq_ConfigTickStep(uint16_t step)
+{
+    Schedule.TickExtra = (uint16_t)(step - 1);
+    TOUCH_DISCHARGE_TIMER->AUTORLD = ((uint32_t)step * TOUCH_DISCHARGE_TIMER_PERIOD) - 1;
+}
+
+/*!
+ * @brief       Select the guard mode of the acquisition engine
+ *
+ * @param       enable: 1 to acquire the guard burst only, 0 to acquire the Blocks
+ *
+ * @retval      None
+ *
+ * @note        The mode is applied to the next Frame. In guard mode a Frame is started
+ *              every TOUCH_LP_SCAN_PERIOD ms by TSC_Acq_ProcessScanTick().
+ */
+void TSC_Acq_ConfigGuardMode(uint8_t enable)
+{
+    uint32_t primask;
+    uint32_t count;
+    uint16_t step;
+
+    Schedule.GuardMode = enable;
+
+    if (enable)
+    {
+        return;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (Schedule.GuardWait > 0)
+    {
+        /* Do not wait the end of the period to go back to the full scan:
+           the slowed down timer period ends at the next tick */
+        if (Schedule.TickExtra > 0)
+        {
+            count = TOUCH_DISCHARGE_TIMER->CNT;
+            step = (uint16_t)((count / TOUCH_DISCHARGE_TIMER_PERIOD) + 1);
+            if (((uint32_t)step * TOUCH_DISCHARGE_TIMER_PERIOD) < (count + TSC_GUARD_STEP_MARGIN))
+            {
+                step++;
+            }
+            if (step <= Schedule.TickExtra)
+            {
+                TSC_Acq_ConfigTickStep(step);
+            }
+        }
+        Schedule.GuardWait = (uint16_t)(Schedule.TickExtra + 1);
+    }
+    __set_PRIMASK(primask);
+}
+
+/*!
+ * @brief       Return the number of guard channels (one per group used)
+ *
+ * @param       None
+ *
+ * @retval      Number of guard channels
+ */
+TSC_tNum_T TSC_Acq_ReadGuardCount(void)
+{
+    return Schedule.GuardBurst.NumChannel;
+}
+
+/*!
+ * @brief       Read the measure of a guard channel
+ *
+ * @param       frame: Pointer to a guard Frame
+ *
+ * @param       idx: Index of the guard channel
+ *
+ * @retval      Measure
+ */
+TSC_tMeas_T TSC_Acq_ReadGuardMeas(CONST TSC_Frame_T *frame, TSC_tIndex_T idx)
+{
+#if TOUCH_USE_DMA_READOUT > 0
+    return frame->Raw[0][Schedule.GuardBurst.IdxSrc[idx]];
+#else
+    return frame->Meas[idx];
+#endif
+}
+
+/*!
+ * @brief       Start the guard burst at the end of the scan period
+ *
+ * @param       None
+ *
+ * @retval      Ticks elapsed since the previous update of the timer
+ *
+ * @note        This function must be called from the update interrupt routine of
+ *              TOUCH_DISCHARGE_TIMER, which gives the timing tick, with a lower priority
+ *              than the TSC interrupt.
+ *              During the guard wait the timer period is lengthened up to TSC_GUARD_STEP_MAX
+ *              ticks, so the CPU is not woken up every tick. The returned value must be
+ *              added to the tick counters.
+ */
+uint16_t TSC_Acq_ProcessScanTick(void)
+{
+    uint16_t step = (uint16_t)(Schedule.TickExtra + 1);
+
+    if (Schedule.TickTotal > (0xFFFF - TSC_GUARD_STEP_MAX))
+    {
+        /* Keep the ratio when the duty is not read */
+        Schedule.TickTotal >>= 1;
+        Schedule.TickBusy >>= 1;
+        Schedule.TickWake >>= 1;
+    }
+    Schedule.TickTotal += step;
+    Schedule.TickWake++;
+
+    if (Schedule.GuardWait == 0)
+    {
+        if (Schedule.TickExtra > 0)
+        {
+            /* The engine has been restarted during the guard wait */
+            TSC_Acq_ConfigTickStep(1);
+        }
+        Schedule.TickBusy += step;
+        return step;
+    }
+
+    if (Schedule.GuardWait > step)
+    {
+        Schedule.GuardWait -= step;
+        TSC_Acq_ConfigTickStep((Schedule.GuardWait < TSC_GUARD_STEP_MAX) ? Schedule.GuardWait : TSC_GUARD_STEP_MAX);
+        return step;
+    }
+
+    Schedule.GuardWait = 0;
+    TSC_Acq_ConfigTickStep(1);
+    if (EngineRun)
+    {
+        /* The capacitors have been discharged during the wait */
+        TSC_Acq_StartNextBurst();
+        /* The guard burst ends before the next tick, which sees the next wait only */
+        Schedule.TickBusy++;
+    }
+
+    return step;
+}
+
+/*!
+ * @brief       Return the active duty of the acquisition since the last call
+ *
+ * @param       wakeRate: If not null, updates of the timing tick timer per second,
+ *                        each one wakes up the CPU
+ *
+ * @retval      Ticks with a burst running or pending, in per mille of the ticks
+ *
+ * @note        Used as a current consumption indicator of the scan mode, the tick
+ *              of a guard burst is counted as busy. It has not been compared
+ *              with a current measurement.
+ */
+uint16_t TSC_Acq_ReadScanDuty(uint16_t *wakeRate)
+{
+    uint32_t primask;
+    uint32_t total;
+    uint32_t busy;
+    uint32_t wake;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    total = Schedule.TickTotal;
+    busy = Schedule.TickBusy;
+    wake = Schedule.TickWake;
+    Schedule.TickTotal = 0;
+    Schedule.TickBusy = 0;
+    Schedule.TickWake = 0;
+    __set_PRIMASK(primask);
+
+    if (total == 0)
+    {
+        if (wakeRate != 0)
+        {
+            *wakeRate = 0;
+        }
+        return 0;
+    }
+    if (wakeRate != 0)
+    {
+        *wakeRate = (uint16_t)((wake * TOUCH_TICK_FREQ) / total);
+    }
+    return (uint16_t)((busy * 1000) / total);
+}
+#endif
+
+/*!
+ * @brief       Read the counters of the acquired burst and start the next one
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        This function must be called from the TSC interrupt routine.
+ *              When the last burst has been read the Frame is pushed to the queue
+ *              and the bursts of the next Frame are scheduled.
+ *              If the queue is full the Frame is dropped and Overrun is incremented.
+ *              With DMA readout the routine only starts the copy of the counters,
+ *              the Frame is pushed by TSC_Acq_ProcessDmaReadout().
+ */
+void TSC_Acq_ProcessInterrupt(void)
+{
+    TSC_tIndex_T       idxBurst = FrameQueue.Block;
+    TSC_tIndex_T       nextBurst;
+    TSC_Frame_T        *frame = &FrameQueue.Frame[FrameQueue.Head];
+#if TOUCH_USE_DMA_READOUT == 0
+    TSC_tIndex_T       idxChannel;
+    CONST TSC_Burst_T  *burst = &Schedule.Burst[idxBurst];
+#endif
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+    uint32_t           tickStart = SysTick->VAL;
+#endif
+
+#if TOUCH_TSC_IODEF > 0
+    /* Config IO default in Output PP Low to discharge all capacitors */
+    TSC->CTRL &= (uint32_t)(~(1 << 4));
+#endif
+
+    /* The discharge runs while the counters are read and the next burst is configured */
+    if (EngineRun)
+    {
+        TSC_Acq_StartDischarge();
+    }
+
+    /* Check MCEFLG flag */
+    if (TSC->INTSTS & 0x02)
+    {
+        frame->Status = TSC_STATUS_ERROR;
+    }
+
+    /* Clear both EOAIC and MCEIC flag */
+    TSC->INTFCLR |= 0x03;
+
+#if TOUCH_USE_DMA_READOUT > 0
+    /* Start the copy of all group counters, the CPU leaves the interrupt routine while it runs */
+    FrameQueue.DmaBusy = 1;
+    TSC_DMA_CHANNEL->CHMADDR = (uint32_t)&frame->Raw[idxBurst][0];
+    TSC_DMA_CHANNEL->CHNDATA = TSC_NB_GROUPS;
+    TSC_DMA_CHANNEL->CHCFG_B.CHEN = BIT_SET;
+#else
+    /* Copy the counters of the burst in the Frame */
+    for (idxChannel = 0; idxChannel < burst->NumChannel; idxChannel++)
+    {
+        frame->Meas[burst->IdxDest[idxChannel]] = (TSC_tMeas_T)(TSC->IOGxCNT[burst->IdxSrc[idxChannel]].IOGCNT);
+    }
+#endif
+
+    nextBurst = (TSC_tIndex_T)(idxBurst + 1);
+    if (nextBurst >= Schedule.NumBurst)
+    {
+        nextBurst = 0;
+    }
+
+    if (EngineRun)
+    {
+        if (nextBurst == 0)
+        {
+            /* The counters of the last burst are read: the next Frame can be scheduled */
+            TSC_Acq_ScheduleFrame();
+#if TOUCH_USE_LOWPOWER > 0
+            if (Schedule.GuardFrame)
+            {
+                Schedule.GuardWait = TSC_GUARD_TICKS;
+            }
+#endif
+        }
+        TSC_Acq_ConfigBurst(nextBurst);
+    }
+
+    FrameQueue.Block = nextBurst;
+
+#if TOUCH_USE_DMA_READOUT == 0
+    /* Check if all bursts have been acquired */
+    if (nextBurst == 0)
+    {
+        TSC_Acq_PushFrame();
+    }
+#endif
+
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+    TSC_Acq_CountCycles(tickStart, 0);
+#endif
+}
+
+#if TOUCH_USE_DMA_READOUT > 0
+/*!
+ * @brief       End the counters copy and start the next burst if its discharge is done
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        This function must be called from the interrupt routine of the DMA1
+ *              channel TOUCH_DMA_READOUT_CHANNEL. The interrupt is enabled by
+ *              TSC_Acq_StartEngine() with the priority of the TSC interrupt.
+ */
+void TSC_Acq_ProcessDmaReadout(void)
+{
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+    uint32_t tickStart = SysTick->VAL;
+#endif
+
+    if ((DMA1->INTSTS & TSC_DMA_FLAG_TF) == 0)
+    {
+        return;
+    }
+
+    DMA1->INTFCLR = TSC_DMA_FLAG_GINT | TSC_DMA_FLAG_TF;
+    TSC_DMA_CHANNEL->CHCFG_B.CHEN = BIT_RESET;
+
+    /* Check if all bursts have been acquired */
+    if (FrameQueue.Block == 0)
+    {
+        TSC_Acq_PushFrame();
+    }
+
+    FrameQueue.DmaBusy = 0;
+
+    /* The discharge has ended during the copy */
+    if (FrameQueue.StartPending)
+    {
+        FrameQueue.StartPending = 0;
+        if (EngineRun)
+        {
+            TSC_Acq_StartBurst();
+        }
+    }
+
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+    /* Added to the cycles of the TSC interrupt of the same burst */
+    TSC_Acq_CountCycles(tickStart, 1);
+#endif
+}
+#endif
+
+/*!
+ * @brief       Push the acquired Frame to the queue (private routine)
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void TSC_Acq_PushFrame(void)
+{
+    uint8_t            head = FrameQueue.Head;
+    uint8_t            next = (uint8_t)((head + 1) & (TOUCH_ACQ_FRAME_QUEUE - 1));
+    TSC_Frame_T        *frame = &FrameQueue.Frame[head];
+
+    frame->Tick = TSC_Globals.Tick_ms;
+
+    if (next == FrameQueue.Tail)
+    {
+        /* Queue full: the slot is reused for the next Frame */
+        FrameQueue.Overrun++;
+    }
+    else
+    {
+        /* Make the Frame content visible before publishing it */
+        __DMB();
+        FrameQueue.Head = next;
+        frame = &FrameQueue.Frame[next];
+    }
+    TSC_Acq_StartFrame(frame);
+}
+
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+/*!
+ * @brief       Update the cycles of the interrupt routines (private routine)
+ *
+ * @param       tickStart: SysTick value at entry of the routine
+ *
+ * @param       add: 1 to add the cycles to the last routine of the same burst
+ *
+ * @retval      None
+ */
+static void TSC_Acq_CountCycles(uint32_t tickStart, uint32_t add)
+{
+    /* SysTick is a down counter */
+    uint32_t cycles = tickStart - SysTick->VAL;
+
+    if (cycles > SysTick->LOAD)
+    {
+        cycles += SysTick->LOAD + 1;
+    }
+    if (add)
+    {
+        cycles += FrameQueue.Cycles;
+    }
+
+    FrameQueue.Cycles = cycles;
+    if (cycles > FrameQueue.CyclesMax)
+    {
+        FrameQueue.CyclesMax = cycles;
+    }
+}
+#endif
+
+/*!
+ * @brief       Return the oldest Frame of the queue
+ *
+ * @param       None
+ *
+ * @retval      Pointer to the Frame or 0 if the queue is empty
+ *
+ * @note        The Frame must be released with TSC_Acq_ReleaseFrame() once processed.
+ */
+CONST TSC_Frame_T* TSC_Acq_ReadFrame(void)
+{
+    uint8_t tail = FrameQueue.Tail;
+
+    if (tail == FrameQueue.Head)
+    {
+        return 0;
+    }
+
+    /* Do not read the Frame content before the Head index */
+    __DMB();
+    return &FrameQueue.Frame[tail];
+}
+
+/*!
+ * @brief       Release the Frame returned by TSC_Acq_ReadFrame()
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+void TSC_Acq_ReleaseFrame(void)
+{
+    __DMB();
+    FrameQueue.Tail = (uint8_t)((FrameQueue.Tail + 1) & (TOUCH_ACQ_FRAME_QUEUE - 1));
+}
+
+/*!
+ * @brief       Return the Frames dropped because the queue was full
+ *
+ * @param       None
+ *
+ * @retval      Number of Frames dropped since TSC_Acq_StartEngine()
+ */
+uint16_t TSC_Acq_ReadOverrun(void)
+{
+    return FrameQueue.Overrun;
+}
+
+/*!
+ * @brief       Read all channels measurement of a Frame, calculate delta
+ *
+ * @param       frame: Pointer to the Frame
+ *
+ * @param       mfilter: Pointer to the measure filter
+ *
+ * @param       dfilter: Pointer to the delta filter
+ *
+ * @retval      Status
+ */
+TSC_STATUS_T TSC_Acq_ReadFrameResult(CONST TSC_Frame_T *frame, TSC_pMeasFilter_T mfilter, TSC_pDeltaFilter_T dfilter)
+{
+    TSC_STATUS_T       retval = frame->Status;
+    uint32_t           acquired = frame->Acquired;
+    TSC_tIndex_T       idxBlock;
+    TSC_tIndex_T       idxChannel;
+    TSC_tIndexDest_T   idxDest;
+    TSC_tMeas_T        newMeas;
+    CONST TSC_Block_T  *block = TSC_Globals.Block_Array;
+    CONST TSC_Channel_Dest_T *pchDest;
+#if TOUCH_USE_DMA_READOUT > 0
+    CONST TSC_Channel_Src_T  *pchSrc;
+#endif
+#if (TOUCH_USE_SOA > 0) && (TOUCH_USE_DMA_READOUT > 0)
+    TSC_tMeas_T        meas[TOUCH_TOTAL_CHANNELS];
+#endif
+
+#if TOUCH_USE_SOA > 0
+    /* Without filter all channels are processed in a single loop */
+    if ((mfilter == 0) && (dfilter == 0))
+    {
+    #if TOUCH_USE_DMA_READOUT > 0
+        /* Gather the channels from the group counters of each burst */
+        for (idxBlock = 0; idxBlock < TOUCH_TOTAL_BLOCKS; idxBlock++)
+        {
+            pchDest = block->p_chDest;
+            pchSrc = block->p_chSrc;
+
+            for (idxChannel = 0; idxChannel < block->NumChannel; idxChannel++)
+            {
+                idxDest = pchDest->IdxDest;
+                meas[idxDest] = frame->Raw[frame->Burst[idxDest]][pchSrc->IdxSrc];
+                pchDest++;
+                pchSrc++;
+            }
+            block++;
+        }
+
+        if (TSC_Acq_BatchChannels(meas, acquired) != TSC_STATUS_OK)
+    #else
+        if (TSC_Acq_BatchChannels(frame->Meas, acquired) != TSC_STATUS_OK)
+    #endif
+        {
+            retval = TSC_STATUS_ERROR;
+        }
+        return retval;
+    }
+#endif
+
+    for (idxBlock = 0; idxBlock < TOUCH_TOTAL_BLOCKS; idxBlock++)
+    {
+        pchDest = block->p_chDest;
+#if TOUCH_USE_DMA_READOUT > 0
+        pchSrc = block->p_chSrc;
+#endif
+
+        for (idxChannel = 0; idxChannel < block->NumChannel; idxChannel++)
+        {
+            idxDest = pchDest->IdxDest;
+
+            /* Channels not acquired in this Frame keep their last delta */
+            if ((block->p_chData[idxDest].Flag.ObjStatus == TSC_OBJ_STATUS_ON) &&
+                ((acquired & ((uint32_t)1 << idxDest)) != 0))
+            {
+#if TOUCH_USE_DMA_READOUT > 0
+                newMeas = frame->Raw[frame->Burst[idxDest]][pchSrc->IdxSrc];
+#else
+                newMeas = frame->Meas[idxDest];
+#endif
+                if (TSC_Acq_ProcessChannel(&block->p_chData[idxDest], idxDest, newMeas, mfilter, dfilter) != TSC_STATUS_OK)
+                {
+                    retval = TSC_STATUS_ERROR;
+                }
+            }
+            pchDest++;
+#if TOUCH_USE_DMA_READOUT > 0
+            pchSrc++;
+#endif
+        }
+        block++;
+    }
+    return retval;
+}
+
+#if TOUCH_USE_ACQ_CYCLE_COUNT > 0
+/*!
+ * @brief       Read the CPU cycles spent in the TSC interrupt routine
+ *
+ * @param       last: Cycles of the last burst
+ *
+ * @param       max: Maximum cycles of a burst since the engine was started
+ *
+ * @retval      None
+ *
+ * @note        With DMA readout the cycles of a burst include the DMA interrupt routine.
+ */
+void TSC_Acq_ReadCycles(uint32_t *last, uint32_t *max)
+{
+    *last = FrameQueue.Cycles;
+    *max = FrameQueue.CyclesMax;
+}
+#endif
+
+#endif /* TOUCH_USE_ACQ_INTERRUPT > 0 */
+
 /*!
  * @brief       Calibrate a Block
  *
@@ -1346,7 +2572,7 @@ TSC_STATUS_T TSC_Acq_CalibrateBlock(TSC_tIndex_T idxBlock)
                 }
                 else
                 {
-                    block->p_chData[idxDest].Refer += newMeas;
+                    TSC_CH_REFER(&block->p_chData[idxDest]) += newMeas;
                 }
                 pchDest++;
                 pchSrc++;
@@ -1366,7 +2592,7 @@ TSC_STATUS_T TSC_Acq_CalibrateBlock(TSC_tIndex_T idxBlock)
                 {
                     idxDest = pchDest->IdxDest;
                     /* Divide the Reference by the number of samples */
-                    block->p_chData[idxDest].Refer >>= CalibDiv;
+                    TSC_CH_REFER(&block->p_chData[idxDest]) >>= CalibDiv;
                     pchDest++;
                 }
                 goCalibration = 0;
@@ -1435,8 +2661,8 @@ void TSC_acq_ClearBlockData(TSC_tIndex_T idxBlock)
     for (idxChannel = 0; idxChannel < block->NumChannel; idxChannel++)
     {
         idx_Dest = pchDest->IdxDest;
-        block->p_chData[idx_Dest].Refer = 0;
-        block->p_chData[idx_Dest].Delta = 0;
+        TSC_CH_REFER(&block->p_chData[idx_Dest]) = 0;
+        TSC_CH_DELTA(&block->p_chData[idx_Dest]) = 0;
         pchDest++;
     }
 }
@@ -39,6 +39,11 @@
   @{
 */
 
+#if TOUCH_ECS_INCREMENTAL > 0
+/* ECS period in Tick_ms unit */
+#define TSC_ECS_PERIOD_TICKS  ((uint32_t)TOUCH_ECS_PERIOD * TOUCH_TICK_FREQ / 1000)
+#endif
+
 /**@} end of group TSC_ECS_Macros */
 
 /** @defgroup TSC_ECS_Enumerations Enumerations
@@ -57,12 +62,99 @@
   @{
 */
 
+#if TOUCH_ECS_INCREMENTAL > 0
+static TSC_EcsChannel_T EcsList[TOUCH_TOTAL_CHANNELS];
+static TSC_tNum_T       EcsNumChannel;
+static TSC_tNum_T       EcsIndex;
+static uint32_t         EcsCredit;
+static TSC_tTick_ms_T   EcsTick;
+static TSC_tKCoeff_T    EcsKCoeff = TOUCH_ECS_K_DIFFER;
+static TSC_tDelta_T     EcsDir;
+static TSC_tDelta_T     EcsCmd = 1;
+#endif
+
 /**@} end of group TSC_ECS_Variables */
 
 /** @defgroup TSC_ECS_Functions Functions
   @{
 */
 
+/*!
+ * @brief       Move the Reference of a channel toward its measure
+ *
+ * @param       p_Ch: Pointer to the channel data
+ *
+ * @param       kCoeff: K coefficient to apply
+ *
+ * @retval      TSC_TRUE if the new Reference is out of range
+ *
+ * @note        Refer = Refer + K x (Meas - Refer) / 256 with the Reference on 8.8 bits
+ *              (Refer + RefRest). This is the same filter as Refer x (256 - K) + Meas x K
+ *              with a single multiply.
+ */
+static TSC_BOOL_T TSC_Ecs_UpdateReference(TSC_Channel_Data_T *p_Ch, TSC_tKCoeff_T kCoeff)
+{
+    int32_t meas, refer;
+
+    meas = (int32_t)TSC_Acq_ComputeMeas(TSC_CH_REFER(p_Ch), TSC_CH_DELTA(p_Ch));
+    meas <<= 8;
+
+    refer = (int32_t)TSC_CH_REFER(p_Ch);
+    refer <<= 8;
+    refer += p_Ch->RefRest;
+    refer += ((meas - refer) * (int32_t)kCoeff) >> 8;
+
+    p_Ch->RefRest = (TSC_tRefRest_T)(refer & 0xFF);
+    TSC_CH_REFER(p_Ch) = (TSC_tRefer_T)(refer >> 8);
+
+    return TSC_Acq_TestReferenceRange(p_Ch);
+}
+
+/*!
+ * @brief       Check the ECS execution condition of a group of objects
+ *
+ * @param       objgrp: Pointer to the objects group to process
+ *
+ * @retval      None
+ *
+ * @note        Update objgrp->execution.
+ */
+static void TSC_Ecs_CheckExecution(TSC_ObjectGroup_T *objgrp)
+{
+    if ((objgrp->StateMask & TSC_STATE_RELEASE_BIT_MASK) && !(objgrp->StateMask & TSC_STATEMASK_ACTIVE))
+    {
+        #if TOUCH_ECS_DELAY > 0
+        if (!objgrp->wait)
+        {
+            disableInterrupts();
+            objgrp->time = TSC_Globals.Tick_ms;
+            enableInterrupts();
+            objgrp->wait = 1;
+            objgrp->execution = 0;
+        }
+        #else
+        objgrp->execution = 1;
+        #endif
+    }
+    else
+    {
+        #if TOUCH_ECS_DELAY > 0
+        objgrp->wait = 0;
+        #endif
+        objgrp->execution = 0;
+    }
+
+    #if TOUCH_ECS_DELAY > 0
+    if (objgrp->wait && (!objgrp->execution))
+    {
+        if (TSC_Time_Delay_ms(TOUCH_ECS_DELAY, &objgrp->time) == TSC_STATUS_OK)
+        {
+            objgrp->execution = 1;
+        }
+    }
+    #endif
+}
+
 /*!
  * @brief       Calculate the K coefficient
  *
@@ -120,6 +212,18 @@ TSC_tKCoeff_T TSC_Ecs_CalculateK(TSC_ObjectGroup_T *objgrp, TSC_tKCoeff_T kDiffe
                 p_Ch = TSC_Globals.For_LinRot->p_ChD;
                 break;
             #endif
+
+            #if TOUCH_TOTAL_MATRICES > 0
+            case TSC_OBJ_MATRIX:
+                if (FOR_MATRIX_STATEID != TSC_STATEID_RELEASE)
+                {
+                    pObj++;
+                    continue;
+                }
+                numChannel = FOR_MATRIX_NB_CHANNELS;
+                p_Ch = TSC_Globals.For_Matrix->p_ChD;
+                break;
+            #endif
             default:
                 break;
         }
@@ -127,13 +231,14 @@ TSC_tKCoeff_T TSC_Ecs_CalculateK(TSC_ObjectGroup_T *objgrp, TSC_tKCoeff_T kDiffe
         /* Check all channels of current object */
         for (idxChannel = 0; idxChannel < numChannel; idxChannel++)
         {
-            value = p_Ch->Delta;
+            value = TSC_CH_DELTA(p_Ch);
 
             if (value)
             {
-               if (value >= 0)
+                /* The first non zero delta gives the direction */
+                if (value > 0)
                 {
-                    if (Dir > 0)
+                    if (Dir >= 0)
                     {
                         Dir = 1;
                     }
@@ -144,7 +249,7 @@ TSC_tKCoeff_T TSC_Ecs_CalculateK(TSC_ObjectGroup_T *objgrp, TSC_tKCoeff_T kDiffe
                 }
                 else
                 {
-                    if (Dir < 0)
+                    if (Dir <= 0)
                     {
                         Dir = -1;
                     }
@@ -184,17 +289,12 @@ void TSC_Ecs_ProcessK(TSC_ObjectGroup_T *objgrp, TSC_tKCoeff_T kCoeff)
     TSC_tIndex_T        idxObj;
     TSC_tIndex_T        idxChannel;
     CONST TSC_Object_T  *pObj;
-    TSC_tKCoeff_T       kCoeffComp;
-    uint32_t            meas, refer;
     TSC_tNum_T          numChannel = 0;
     TSC_Channel_Data_T  *p_Ch = 0;
     void(*pFunc_SetStateCalibration)(TSC_tCounter_T delay) = 0;
 
     pObj = objgrp->p_Obj;
 
-    /* Calculate the K coefficient complement */
-    kCoeffComp = (0xFF ^ kCoeff) + 1;
-
     /* Process all objects */
     for (idxObj = 0; idxObj < objgrp->NbObjects; idxObj++)
     {
@@ -231,6 +331,19 @@ void TSC_Ecs_ProcessK(TSC_ObjectGroup_T *objgrp, TSC_tKCoeff_T kCoeff)
                 pFunc_SetStateCalibration = &TSC_Linrot_ConfigCalibrationState;
                 break;
             #endif
+
+            #if TOUCH_TOTAL_MATRICES > 0
+            case TSC_OBJ_MATRIX:
+                if (FOR_MATRIX_STATEID != TSC_STATEID_RELEASE)
+                {
+                    pObj++;
+                    continue;
+                }
+                numChannel = FOR_MATRIX_NB_CHANNELS;
+                p_Ch = TSC_Globals.For_Matrix->p_ChD;
+                pFunc_SetStateCalibration = &TSC_Matrix_ConfigCalibrationState;
+                break;
+            #endif
             default:
                 break;
         }
@@ -238,20 +351,8 @@ void TSC_Ecs_ProcessK(TSC_ObjectGroup_T *objgrp, TSC_tKCoeff_T kCoeff)
         /* Calculate the new reference + rest for all channels */
         for (idxChannel = 0; idxChannel < numChannel; idxChannel++)
         {
-            meas = TSC_Acq_ComputeMeas(p_Ch->Refer, p_Ch->Delta);
-            meas <<= 8;
-
-            refer = (uint32_t)(p_Ch->Refer);
-            refer <<= 8;
-            refer += p_Ch->RefRest;
-            refer *= kCoeffComp;
-            refer += (kCoeff * meas);
-
-            p_Ch->RefRest = (TSC_tRefRest_T)((refer >> 8) & 0xFF);
-            p_Ch->Refer = (TSC_tRefer_T)(refer >> 16);
-
             /* Go in Calibration state in the Reference is out of Range */
-            if (TSC_Acq_TestReferenceRange(p_Ch) == TSC_TRUE)
+            if (TSC_Ecs_UpdateReference(p_Ch, kCoeff) == TSC_TRUE)
             {
                 pFunc_SetStateCalibration(0);
             }
@@ -276,53 +377,238 @@ TSC_STATUS_T TSC_Ecs_Process(TSC_ObjectGroup_T *objgrp)
     TSC_tKCoeff_T myKcoeff;
     TSC_STATUS_T  retval;
 
-    if ((objgrp->StateMask & TSC_STATE_RELEASE_BIT_MASK) && !(objgrp->StateMask & TSC_STATEMASK_ACTIVE))
+    TSC_Ecs_CheckExecution(objgrp);
+
+    if (objgrp->execution == 0)
     {
-        #if TOUCH_ECS_DELAY > 0
-        if (!objgrp->wait)
-        {
-            disableInterrupts();
-            objgrp->time = TSC_Globals.Tick_ms;
-            enableInterrupts();
-            objgrp->wait = 1;
-            objgrp->execution = 0;
-        }
-        #else
-        objgrp->execution = 1;
-        #endif
+        retval = TSC_STATUS_BUSY;
     }
     else
     {
-        #if TOUCH_ECS_DELAY > 0
-        objgrp->wait = 0;
-        #endif
-        objgrp->execution = 0;
+        /* Calculate the K coefficient */
+        myKcoeff = TSC_Ecs_CalculateK(objgrp, TOUCH_ECS_K_DIFFER, TOUCH_ECS_K_SAME);
+        /* Process the objects */
+        TSC_Ecs_ProcessK(objgrp, myKcoeff);
+        retval = TSC_STATUS_OK;
     }
+    return retval;
+}
 
-    #if TOUCH_ECS_DELAY > 0
-    if (objgrp->wait && (!objgrp->execution))
+#if TOUCH_ECS_INCREMENTAL > 0
+/*!
+ * @brief       Build the flat channel list of the incremental ECS
+ *
+ * @param       objgrp: Pointer to the objects group to process
+ *
+ * @retval      Status
+ *
+ * @note        Must be called once after TSC_Obj_ConfigGroup().
+ */
+TSC_STATUS_T TSC_Ecs_ConfigGroup(TSC_ObjectGroup_T *objgrp)
+{
+    TSC_tIndex_T        idxObj;
+    TSC_tIndex_T        idxChannel;
+    CONST TSC_Object_T  *pObj;
+    TSC_tNum_T          numChannel = 0;
+    TSC_Channel_Data_T  *p_Ch = 0;
+    TSC_STATEID_T       *p_StateId = 0;
+    void(*pFunc_SetStateCalibration)(TSC_tCounter_T delay) = 0;
+
+    pObj = objgrp->p_Obj;
+    EcsNumChannel = 0;
+
+    for (idxObj = 0; idxObj < objgrp->NbObjects; idxObj++)
     {
-        if (TSC_Time_Delay_ms(TOUCH_ECS_DELAY, &objgrp->time) == TSC_STATUS_OK)
+        TSC_Obj_ConfigGlobalObj(pObj);
+
+        switch (FOR_OBJ_TYPE)
         {
-            objgrp->execution = 1;
+            #if TOUCH_TOTAL_KEYS > 0
+            case TSC_OBJ_TOUCHKEY:
+            case TSC_OBJ_TOUCHKEYB:
+                numChannel = 1;
+                p_Ch = TSC_Globals.For_Key->p_ChD;
+                p_StateId = &FOR_KEY_STATEID;
+                pFunc_SetStateCalibration = &TSC_TouchKey_ConfigCalibrationState;
+                break;
+            #endif
+
+            #if TOUCH_TOTAL_LNRTS > 0
+            case TSC_OBJ_LINEAR:
+            case TSC_OBJ_LINEARB:
+            case TSC_OBJ_ROTARY:
+            case TSC_OBJ_ROTARYB:
+                numChannel = FOR_LINROT_NB_CHANNELS;
+                p_Ch = TSC_Globals.For_LinRot->p_ChD;
+                p_StateId = &FOR_LINROT_STATEID;
+                pFunc_SetStateCalibration = &TSC_Linrot_ConfigCalibrationState;
+                break;
+            #endif
+
+            #if TOUCH_TOTAL_MATRICES > 0
+            case TSC_OBJ_MATRIX:
+                numChannel = FOR_MATRIX_NB_CHANNELS;
+                p_Ch = TSC_Globals.For_Matrix->p_ChD;
+                p_StateId = &FOR_MATRIX_STATEID;
+                pFunc_SetStateCalibration = &TSC_Matrix_ConfigCalibrationState;
+                break;
+            #endif
+            default:
+                numChannel = 0;
+                break;
+        }
+
+        for (idxChannel = 0; idxChannel < numChannel; idxChannel++)
+        {
+            if (EcsNumChannel >= TOUCH_TOTAL_CHANNELS)
+            {
+                return TSC_STATUS_ERROR;
+            }
+            EcsList[EcsNumChannel].p_ChD = p_Ch;
+            EcsList[EcsNumChannel].p_StateId = p_StateId;
+            EcsList[EcsNumChannel].p_Obj = pObj;
+            EcsList[EcsNumChannel].ConfigCalibrationState = pFunc_SetStateCalibration;
+            EcsNumChannel++;
+            p_Ch++;
         }
+        pObj++;
     }
-    #endif
 
-    if (objgrp->execution == 0)
+    EcsIndex = 0;
+    EcsCredit = 0;
+    EcsKCoeff = TOUCH_ECS_K_DIFFER;
+    EcsDir = 0;
+    EcsCmd = 1;
+    disableInterrupts();
+    EcsTick = TSC_Globals.Tick_ms;
+    enableInterrupts();
+
+    return TSC_STATUS_OK;
+}
+
+/*!
+ * @brief       Incremental ECS algorithm on a group of objects
+ *              To be called after each TSC_Obj_ProcessGroup(). The References of the
+ *              released channels are updated a few at a time so that each channel is
+ *              updated once every TOUCH_ECS_PERIOD msec, whatever the frame rate.
+ *
+ * @param       objgrp: Pointer to the objects group to process
+ *
+ * @retval      Status (TSC_STATUS_BUSY if the ECS condition is not reached)
+ *
+ * @note        The K coefficient used during a pass over the channel list is chosen
+ *              from the delta directions seen during the previous pass.
+ */
+TSC_STATUS_T TSC_Ecs_ProcessSlice(TSC_ObjectGroup_T *objgrp)
+{
+    TSC_EcsChannel_T *p_Ecs;
+    TSC_tDelta_T     value;
+    TSC_tTick_ms_T   tick;
+
+    disableInterrupts();
+    tick = TSC_Globals.Tick_ms;
+    enableInterrupts();
+
+    TSC_Ecs_CheckExecution(objgrp);
+
+    if ((objgrp->execution == 0) || (EcsNumChannel == 0))
     {
-        retval = TSC_STATUS_BUSY;
+        /* No credit is accumulated while the ECS is stopped */
+        EcsTick = tick;
+        EcsCredit = 0;
+        return TSC_STATUS_BUSY;
     }
-    else
+
+    /* Each channel earns one update per ECS period */
+    EcsCredit += (uint32_t)(TSC_tTick_ms_T)(tick - EcsTick) * EcsNumChannel;
+    EcsTick = tick;
+    if (EcsCredit > (uint32_t)TOUCH_ECS_MAX_SLICE * TSC_ECS_PERIOD_TICKS)
     {
-        /* Calculate the K coefficient */
-        myKcoeff = TSC_Ecs_CalculateK(objgrp, TOUCH_ECS_K_DIFFER, TOUCH_ECS_K_SAME);
-        /* Process the objects */
-        TSC_Ecs_ProcessK(objgrp, myKcoeff);
-        retval = TSC_STATUS_OK;
+        EcsCredit = (uint32_t)TOUCH_ECS_MAX_SLICE * TSC_ECS_PERIOD_TICKS;
     }
-    return retval;
+
+    while (EcsCredit >= TSC_ECS_PERIOD_TICKS)
+    {
+        EcsCredit -= TSC_ECS_PERIOD_TICKS;
+        p_Ecs = &EcsList[EcsIndex];
+
+        if (*p_Ecs->p_StateId == TSC_STATEID_RELEASE)
+        {
+            /* Direction of the delta for the next pass */
+            value = TSC_CH_DELTA(p_Ecs->p_ChD);
+            if (value > 0)
+            {
+                if (EcsDir >= 0)
+                {
+                    EcsDir = 1;
+                }
+                else
+                {
+                    EcsCmd = 0;
+                }
+            }
+            else if (value < 0)
+            {
+                if (EcsDir <= 0)
+                {
+                    EcsDir = -1;
+                }
+                else
+                {
+                    EcsCmd = 0;
+                }
+            }
+            else
+            {
+                EcsCmd = 0;
+            }
+
+            /* Go in Calibration state in the Reference is out of Range */
+            if (TSC_Ecs_UpdateReference(p_Ecs->p_ChD, EcsKCoeff) == TSC_TRUE)
+            {
+                TSC_Obj_ConfigGlobalObj(p_Ecs->p_Obj);
+                p_Ecs->ConfigCalibrationState(0);
+            }
+        }
+
+        /* End of pass: latch the K coefficient */
+        EcsIndex++;
+        if (EcsIndex >= EcsNumChannel)
+        {
+            EcsIndex = 0;
+            EcsKCoeff = EcsCmd ? TOUCH_ECS_K_SAME : TOUCH_ECS_K_DIFFER;
+            EcsDir = 0;
+            EcsCmd = 1;
+        }
+    }
+
+    return TSC_STATUS_OK;
+}
+
+/*!
+ * @brief       Return the K coefficient of the current pass of the incremental ECS
+ *
+ * @param       None
+ *
+ * @retval      K coefficient
+ */
+TSC_tKCoeff_T TSC_Ecs_ReadKCoeff(void)
+{
+    return EcsKCoeff;
+}
+
+/*!
+ * @brief       Set the K coefficient of the current pass of the incremental ECS
+ *
+ * @param       kCoeff: K coefficient (TOUCH_ECS_K_DIFFER or TOUCH_ECS_K_SAME)
+ *
+ * @retval      None
+ */
+void TSC_Ecs_ConfigKCoeff(TSC_tKCoeff_T kCoeff)
+{
+    EcsKCoeff = kCoeff;
 }
+#endif
 
 /**@} end of group TSC_ECS_Functions */
 /**@} end of group TSC_ECS_Driver */
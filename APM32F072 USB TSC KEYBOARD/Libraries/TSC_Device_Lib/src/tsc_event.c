@@ -0,0 +1,169 @@
+/*!
+ * @file        tsc_event.c
+ *
+ * @brief       This file contains all functions to manage the press and release events.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "tsc.h"
+#include "tsc_event.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Event_Driver TSC Event Driver
+  @{
+*/
+
+/** @defgroup TSC_Event_Macros Macros
+  @{
+*/
+
+#if TOUCH_USE_EVENT > 0
+
+/* Index in the queue, the size is a power of 2 */
+#define EVENT_INDEX(i)  ((i) & (TOUCH_EVENT_QUEUE_SIZE - 1))
+
+/**@} end of group TSC_Event_Macros */
+
+/** @defgroup TSC_Event_Enumerations Enumerations
+  @{
+*/
+
+/**@} end of group TSC_Event_Enumerations */
+
+/** @defgroup TSC_Event_Structures Structures
+  @{
+*/
+
+/**@} end of group TSC_Event_Structures */
+
+/** @defgroup TSC_Event_Variables Variables
+  @{
+*/
+
+/* Event queue, written by TSC_Obj_ProcessGroup() and read by the application */
+static TSC_Event_T     EventQueue[TOUCH_EVENT_QUEUE_SIZE];
+/* Free running write and read counters */
+static __IO uint8_t    EventHead;
+static __IO uint8_t    EventTail;
+/* Number of events lost because the queue was full */
+static uint16_t        EventLost;
+
+/**@} end of group TSC_Event_Variables */
+
+/** @defgroup TSC_Event_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Config the event queue
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+void TSC_Event_Config(void)
+{
+    EventHead = 0;
+    EventTail = 0;
+    EventLost = 0;
+}
+
+/*!
+ * @brief       Add an event in the queue
+ *
+ * @param       type: Event type
+ *
+ * @param       idxObj: Index of the object in its group
+ *
+ * @param       key: Key of a Matrix object, 0 for the other objects
+ *
+ * @retval      Status Return TSC_STATUS_ERROR if the queue is full
+ *
+ * @note        When an event is lost the application should read again the
+ *              PressMask of the group.
+ */
+TSC_STATUS_T TSC_Event_Write(TSC_EVENT_T type, TSC_tIndex_T idxObj, uint8_t key)
+{
+    uint8_t head = EventHead;
+
+    if ((uint8_t)(head - EventTail) >= TOUCH_EVENT_QUEUE_SIZE)
+    {
+        if (EventLost < 0xFFFF)
+        {
+            EventLost++;
+        }
+        return TSC_STATUS_ERROR;
+    }
+
+    EventQueue[EVENT_INDEX(head)].Type = (uint8_t)type;
+    EventQueue[EVENT_INDEX(head)].Index = (uint8_t)idxObj;
+    EventQueue[EVENT_INDEX(head)].Key = key;
+    EventQueue[EVENT_INDEX(head)].Tick = TSC_Globals.Tick_ms;
+    EventHead = (uint8_t)(head + 1);
+
+    return TSC_STATUS_OK;
+}
+
+/*!
+ * @brief       Read the oldest event of the queue
+ *
+ * @param       event: Returns the event
+ *
+ * @retval      Status Return TSC_STATUS_BUSY if the queue is empty
+ */
+TSC_STATUS_T TSC_Event_Read(TSC_Event_T *event)
+{
+    uint8_t tail = EventTail;
+
+    if (tail == EventHead)
+    {
+        return TSC_STATUS_BUSY;
+    }
+
+    *event = EventQueue[EVENT_INDEX(tail)];
+    EventTail = (uint8_t)(tail + 1);
+
+    return TSC_STATUS_OK;
+}
+
+/*!
+ * @brief       Return and clear the number of lost events
+ *
+ * @param       None
+ *
+ * @retval      Number of events lost since the last call
+ */
+uint16_t TSC_Event_ReadLost(void)
+{
+    uint16_t lost = EventLost;
+
+    EventLost = 0;
+    return lost;
+}
+#endif /* TOUCH_USE_EVENT > 0 */
+
+/**@} end of group TSC_Event_Functions */
+/**@} end of group TSC_Event_Driver */
+/**@} end of group TSC_Driver_Library */
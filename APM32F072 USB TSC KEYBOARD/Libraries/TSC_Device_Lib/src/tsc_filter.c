@@ -38,6 +38,9 @@
   @{
 */
 
+/* Sort two measures in ascending order */
+#define TSC_FILT_SORT(a, b)     { if ((a) > (b)) { TSC_tMeas_T t = (a); (a) = (b); (b) = t; } }
+
 /**@} end of group TSC_Filter_Macros */
 
 /** @defgroup TSC_Filter_Enumerations Enumerations
@@ -56,6 +59,13 @@
   @{
 */
 
+#if TOUCH_USE_FILTER_BANK > 0
+/* Filter chain of each channel, indexed as the Channel Data array */
+static CONST TSC_FilterChain_T *FilterChain[TOUCH_TOTAL_CHANNELS];
+/* Data of each filter stage of each channel */
+static TSC_FilterData_T FilterData[TOUCH_TOTAL_CHANNELS][TOUCH_FILTER_MAX_STAGES];
+#endif
+
 /**@} end of group TSC_Filter_Variables */
 
 /** @defgroup TSC_Filter_Functions Functions
@@ -103,6 +113,350 @@ TSC_tDelta_T TSC_Filt_DeltaFilter(TSC_tDelta_T delta)
     return(delta);
 }
 
+#if TOUCH_USE_FILTER_BANK > 0
+
+/*!
+ * @brief       Moving median of 3 samples
+ *
+ * @param       data: Pointer to the filter data of the channel
+ *
+ * @param       meas: Current measure value
+ *
+ * @retval      Filtered measure
+ *
+ * @note        Removes single sample spikes, delay of 1 sample.
+ *              Cost: about 30 cycles per channel on Cortex-M0.
+ */
+TSC_tMeas_T TSC_Filt_Median3(TSC_FilterData_T *data, TSC_tMeas_T meas)
+{
+    TSC_tMeas_T a = data->Median.Hist[0];
+    TSC_tMeas_T b = data->Median.Hist[1];
+    TSC_tMeas_T c = meas;
+
+    data->Median.Hist[1] = a;
+    data->Median.Hist[0] = meas;
+
+    if (data->Median.Num < 2)
+    {
+        data->Median.Num++;
+        return meas;
+    }
+
+    TSC_FILT_SORT(a, b);
+    TSC_FILT_SORT(b, c);
+    TSC_FILT_SORT(a, b);
+
+    return b;
+}
+
+/*!
+ * @brief       Moving median of 5 samples
+ *
+ * @param       data: Pointer to the filter data of the channel
+ *
+ * @param       meas: Current measure value
+ *
+ * @retval      Filtered measure
+ *
+ * @note        Removes bursts of up to 2 samples, delay of 2 samples.
+ *              Cost: about 70 cycles per channel on Cortex-M0.
+ */
+TSC_tMeas_T TSC_Filt_Median5(TSC_FilterData_T *data, TSC_tMeas_T meas)
+{
+    TSC_tMeas_T p0 = data->Median.Hist[0];
+    TSC_tMeas_T p1 = data->Median.Hist[1];
+    TSC_tMeas_T p2 = data->Median.Hist[2];
+    TSC_tMeas_T p3 = data->Median.Hist[3];
+    TSC_tMeas_T p4 = meas;
+
+    data->Median.Hist[3] = p2;
+    data->Median.Hist[2] = p1;
+    data->Median.Hist[1] = p0;
+    data->Median.Hist[0] = meas;
+
+    if (data->Median.Num < 4)
+    {
+        data->Median.Num++;
+        return meas;
+    }
+
+    /* 7 exchanges median network */
+    TSC_FILT_SORT(p0, p1);
+    TSC_FILT_SORT(p3, p4);
+    TSC_FILT_SORT(p0, p3);
+    TSC_FILT_SORT(p1, p4);
+    TSC_FILT_SORT(p1, p2);
+    TSC_FILT_SORT(p2, p3);
+    TSC_FILT_SORT(p1, p2);
+
+    return p2;
+}
+
+/*!
+ * @brief       First order IIR filter with a coefficient rising with the slew
+ *
+ * @param       data: Pointer to the filter data of the channel
+ *
+ * @param       meas: Current measure value
+ *
+ * @param       kMin: Coefficient when the measure is stable (1..256, k = kMin/256)
+ *
+ * @param       slewShift: Coefficient rise, k = kMin + (|meas - output| << slewShift)
+ *
+ * @retval      Filtered measure
+ *
+ * @note        Strong smoothing of the noise and fast tracking of a touch.
+ *              Cost: about 35 cycles per channel on Cortex-M0.
+ */
+TSC_tMeas_T TSC_Filt_AdaptiveIir(TSC_FilterData_T *data, TSC_tMeas_T meas, uint16_t kMin, uint16_t slewShift)
+{
+    uint32_t value = (uint32_t)meas << 4;
+    uint32_t out = data->Iir.Out;
+    uint32_t diff;
+    uint32_t k;
+
+    if (out == 0)
+    {
+        data->Iir.Out = value;
+        return meas;
+    }
+
+    diff = (value >= out) ? (value - out) : (out - value);
+    k = kMin + ((diff >> 4) << slewShift);
+    if (k > 256)
+    {
+        k = 256;
+    }
+
+    if (value >= out)
+    {
+        out += (diff * k) >> 8;
+    }
+    else
+    {
+        out -= (diff * k) >> 8;
+    }
+
+    data->Iir.Out = out;
+    return (TSC_tMeas_T)((out + 8) >> 4);
+}
+
+/*!
+ * @brief       Scalar Kalman tracker of the measure level
+ *
+ * @param       data: Pointer to the filter data of the channel
+ *
+ * @param       meas: Current measure value
+ *
+ * @param       noiseR: Measure noise variance (counts^2)
+ *
+ * @param       noiseQ: Process noise, level drift between two samples (counts^2/16)
+ *
+ * @retval      Filtered measure
+ *
+ * @note        The gain converges to the optimal value for the given noises.
+ *              A step larger than 3 standard deviations (touch) restarts the tracking.
+ *              Cost: about 140 cycles per channel on Cortex-M0 (one 32-bit division).
+ */
+TSC_tMeas_T TSC_Filt_Kalman(TSC_FilterData_T *data, TSC_tMeas_T meas, uint16_t noiseR, uint16_t noiseQ)
+{
+    uint32_t value = (uint32_t)meas << 4;
+    uint32_t x = data->Kalman.X;
+    uint32_t p = data->Kalman.P;
+    uint32_t r = (uint32_t)noiseR << 4;
+    uint32_t innov;
+    uint32_t step;
+    uint32_t k;
+
+    if (p == 0)
+    {
+        data->Kalman.X = value;
+        data->Kalman.P = r;
+        return meas;
+    }
+
+    innov = (value >= x) ? (value - x) : (x - value);
+
+    /* Step of the level: trust the measure again */
+    step = innov >> 4;
+    if ((step * step) > (9 * (uint32_t)noiseR))
+    {
+        p = r << 4;
+    }
+
+    /* Prediction */
+    p += noiseQ;
+    if (p > 0x00FFFFFF)
+    {
+        p = 0x00FFFFFF;
+    }
+
+    /* Gain (Q8) and update */
+    k = (p << 8) / (p + r);
+
+    if (value >= x)
+    {
+        x += (innov * k) >> 8;
+    }
+    else
+    {
+        x -= (innov * k) >> 8;
+    }
+
+    p = ((256 - k) * p) >> 8;
+    if (p == 0)
+    {
+        p = 1;
+    }
+
+    data->Kalman.X = x;
+    data->Kalman.P = p;
+    return (TSC_tMeas_T)((x + 8) >> 4);
+}
+
+/*!
+ * @brief       Slew rate limiter
+ *
+ * @param       data: Pointer to the filter data of the channel
+ *
+ * @param       meas: Current measure value
+ *
+ * @param       maxStep: Maximum change of the output per sample (counts)
+ *
+ * @retval      Filtered measure
+ *
+ * @note        Limits the effect of a large spike to maxStep.
+ *              Cost: about 20 cycles per channel on Cortex-M0.
+ */
+TSC_tMeas_T TSC_Filt_SlewLimit(TSC_FilterData_T *data, TSC_tMeas_T meas, uint16_t maxStep)
+{
+    TSC_tMeas_T out = data->Slew.Out;
+
+    if (out == 0)
+    {
+        out = meas;
+    }
+    else if (meas > out)
+    {
+        out = ((meas - out) > maxStep) ? (TSC_tMeas_T)(out + maxStep) : meas;
+    }
+    else
+    {
+        out = ((out - meas) > maxStep) ? (TSC_tMeas_T)(out - maxStep) : meas;
+    }
+
+    data->Slew.Out = out;
+    return out;
+}
+
+/*!
+ * @brief       Apply a chain of filters
+ *
+ * @param       chain: Pointer to the filter chain
+ *
+ * @param       data: Pointer to the filter data of the channel (one per stage)
+ *
+ * @param       meas: Current measure value
+ *
+ * @retval      Filtered measure
+ *
+ * @note        Cost: sum of the stages plus about 15 cycles per stage.
+ */
+TSC_tMeas_T TSC_Filt_ProcessChain(CONST TSC_FilterChain_T *chain, TSC_FilterData_T *data, TSC_tMeas_T meas)
+{
+    TSC_tNum_T idxStage;
+    CONST TSC_FilterStage_T *stage = chain->p_Stage;
+
+    for (idxStage = 0; (idxStage < chain->NumStage) && (idxStage < TOUCH_FILTER_MAX_STAGES); idxStage++)
+    {
+        switch (stage->Type)
+        {
+          case TSC_FILT_MEDIAN3:
+            meas = TSC_Filt_Median3(data, meas);
+            break;
+
+          case TSC_FILT_MEDIAN5:
+            meas = TSC_Filt_Median5(data, meas);
+            break;
+
+          case TSC_FILT_ADAPTIVE_IIR:
+            meas = TSC_Filt_AdaptiveIir(data, meas, stage->Param1, stage->Param2);
+            break;
+
+          case TSC_FILT_KALMAN:
+            meas = TSC_Filt_Kalman(data, meas, stage->Param1, stage->Param2);
+            break;
+
+          case TSC_FILT_SLEW_LIMIT:
+            meas = TSC_Filt_SlewLimit(data, meas, stage->Param1);
+            break;
+
+          default:
+            break;
+        }
+        stage++;
+        data++;
+    }
+    return meas;
+}
+
+/*!
+ * @brief       Select the filter chain of consecutive channels
+ *
+ * @param       idxDest: Index of the first channel in the Channel Data array
+ *
+ * @param       numChannel: Number of channels (all channels of an Object)
+ *
+ * @param       chain: Pointer to the filter chain, 0 to remove the filters
+ *
+ * @retval      None
+ *
+ * @note        The filters of the channels are restarted.
+ */
+void TSC_Filt_ConfigChannels(TSC_tIndexDest_T idxDest, TSC_tNum_T numChannel, CONST TSC_FilterChain_T *chain)
+{
+    TSC_tNum_T idxStage;
+    TSC_tNum_T idxHist;
+
+    for (; (numChannel > 0) && (idxDest < TOUCH_TOTAL_CHANNELS); numChannel--, idxDest++)
+    {
+        FilterChain[idxDest] = chain;
+
+        for (idxStage = 0; idxStage < TOUCH_FILTER_MAX_STAGES; idxStage++)
+        {
+            /* The history overlaps the data of all other filters */
+            for (idxHist = 0; idxHist < 4; idxHist++)
+            {
+                FilterData[idxDest][idxStage].Median.Hist[idxHist] = 0;
+            }
+            FilterData[idxDest][idxStage].Median.Num = 0;
+        }
+    }
+}
+
+/*!
+ * @brief       Apply the filter chain of a channel
+ *
+ * @param       idxDest: Index of the channel in the Channel Data array
+ *
+ * @param       meas: Current measure value
+ *
+ * @retval      Filtered measure
+ */
+TSC_tMeas_T TSC_Filt_ProcessBank(TSC_tIndexDest_T idxDest, TSC_tMeas_T meas)
+{
+    CONST TSC_FilterChain_T *chain = FilterChain[idxDest];
+
+    if (chain == 0)
+    {
+        return meas;
+    }
+
+    return TSC_Filt_ProcessChain(chain, FilterData[idxDest], meas);
+}
+
+#endif /* TOUCH_USE_FILTER_BANK > 0 */
+
 /**@} end of group TSC_Filter_Functions */
 /**@} end of group TSC_Filter_Driver */
 /**@} end of group TSC_Driver_Library */
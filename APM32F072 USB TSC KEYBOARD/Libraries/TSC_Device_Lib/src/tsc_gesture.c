@@ -0,0 +1,538 @@
+/*!
+ * @file        tsc_gesture.c
+ *
+ * @brief       This file contains all functions to recognize the gestures from the press and release events.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "tsc.h"
+#include "tsc_gesture.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Gesture_Driver TSC Gesture Driver
+  @{
+*/
+
+/** @defgroup TSC_Gesture_Macros Macros
+  @{
+*/
+
+#if TOUCH_USE_GESTURE > 0
+
+/* Index in the queue, the size is a power of 2 */
+#define GESTURE_INDEX(i)                ((i) & (TOUCH_GESTURE_QUEUE_SIZE - 1))
+
+/* Convert a time in ms into TSC_Globals.Tick_ms unit */
+#if TOUCH_TICK_FREQ == 1000
+#define GESTURE_TICKS(ms)               ((TSC_tTick_ms_T)(ms))
+#else
+#define GESTURE_TICKS(ms)               ((TSC_tTick_ms_T)(((uint32_t)(ms) * TOUCH_TICK_FREQ) / 1000))
+#endif
+
+/* The tick has reached the deadline, the timings are shorter than half of the tick range */
+#define GESTURE_EXPIRED(tick, deadline) ((int16_t)(TSC_tTick_ms_T)((tick) - (deadline)) >= 0)
+
+/**@} end of group TSC_Gesture_Macros */
+
+/** @defgroup TSC_Gesture_Enumerations Enumerations
+  @{
+*/
+
+/**
+ * @brief   Gesture state of an object
+ */
+typedef enum
+{
+    GESTURE_STATE_IDLE      = 0, /*!< Released */
+    GESTURE_STATE_PRESS     = 1, /*!< Pressed */
+    GESTURE_STATE_PRESS_TAP = 2, /*!< Pressed again after a tap */
+    GESTURE_STATE_HOLD      = 3, /*!< Pressed after the long press */
+    GESTURE_STATE_WAIT_TAP  = 4  /*!< Released after a tap, waiting for a second tap */
+} GESTURE_STATE_T;
+
+/**@} end of group TSC_Gesture_Enumerations */
+
+/** @defgroup TSC_Gesture_Structures Structures
+  @{
+*/
+
+/**
+ * @brief   Gesture data of an object
+ */
+typedef struct
+{
+    TSC_tTick_ms_T  PressTick;  /*!< Tick of the press event */
+    TSC_tTick_ms_T  Deadline;   /*!< Tick of the next timer (long press, repeat or end of double tap) */
+    uint8_t         State;      /*!< Gesture state (GESTURE_STATE_T) */
+    uint8_t         Count;      /*!< Number of repeats */
+    uint8_t         StartPos;   /*!< RawPosition at the beginning of the touch (Linear/Rotary sensor) */
+} GestureData_T;
+
+/**@} end of group TSC_Gesture_Structures */
+
+/** @defgroup TSC_Gesture_Variables Variables
+  @{
+*/
+
+/* Group of the events */
+static CONST TSC_ObjectGroup_T *GestureGroup;
+/* Timings */
+static TSC_GestureParam_T   GestureParam;
+/* Data of each object of the group */
+static GestureData_T        GestureData[TOUCH_TOTAL_OBJECTS];
+/* Objects with a running timer, and the earliest deadline of them */
+static uint32_t             GestureArmed;
+static TSC_tTick_ms_T       GestureNextDeadline;
+/* Linear/Rotary sensors pressed by the last events, their start position is read at the next frame */
+static uint32_t             GestureStartPending;
+static uint32_t             GestureStartRead;
+/* Linear/Rotary sensors with a valid start position */
+static uint32_t             GestureStartValid;
+/* Gesture queue, written by the gesture functions and read by the application */
+static TSC_Gesture_T        GestureQueue[TOUCH_GESTURE_QUEUE_SIZE];
+static uint8_t              GestureHead;
+static uint8_t              GestureTail;
+
+/**@} end of group TSC_Gesture_Variables */
+
+/** @defgroup TSC_Gesture_Functions Functions
+  @{
+*/
+
+static void TSC_Gesture_Write(TSC_GESTURE_T type, TSC_tIndex_T idxObj, int16_t distance, uint16_t speed);
+static void TSC_Gesture_ConfigTimer(TSC_tIndex_T idxObj, TSC_tTick_ms_T deadline);
+static void TSC_Gesture_ProcessTimer(TSC_tIndex_T idxObj);
+static TSC_STATUS_T TSC_Gesture_ProcessSwipe(TSC_tIndex_T idxObj, TSC_tTick_ms_T duration,
+                                             int16_t *distance, uint16_t *speed);
+
+/*!
+ * @brief       Config the gesture recognition
+ *
+ * @param       objgrp: Group of the objects sending the events
+ *
+ * @retval      None
+ *
+ * @note        The timings are set with the TOUCH_GESTURE_xxx parameters,
+ *              they can be changed after with TSC_Gesture_ReadParam().
+ *              The recognition is replayed on the host (test/src/test_gesture.c),
+ *              the timings have not been checked with a finger on the target.
+ */
+void TSC_Gesture_Config(CONST TSC_ObjectGroup_T *objgrp)
+{
+    TSC_tIndex_T idxObj;
+
+    GestureGroup = objgrp;
+
+    GestureParam.TapMax       = TOUCH_GESTURE_TAP_MS;
+    GestureParam.DoubleTapGap = TOUCH_GESTURE_DOUBLE_TAP_MS;
+    GestureParam.LongPress    = TOUCH_GESTURE_LONG_PRESS_MS;
+    GestureParam.RepeatPeriod = TOUCH_GESTURE_REPEAT_MS;
+    GestureParam.SwipeMax     = TOUCH_GESTURE_SWIPE_MS;
+    GestureParam.SwipeMinDist = TOUCH_GESTURE_SWIPE_DIST;
+
+    for (idxObj = 0; idxObj < TOUCH_TOTAL_OBJECTS; idxObj++)
+    {
+        GestureData[idxObj].State = GESTURE_STATE_IDLE;
+    }
+
+    GestureArmed        = 0;
+    GestureStartPending = 0;
+    GestureStartRead    = 0;
+    GestureStartValid   = 0;
+    GestureHead         = 0;
+    GestureTail         = 0;
+}
+
+/*!
+ * @brief       Return the timings of the gestures
+ *
+ * @param       None
+ *
+ * @retval      Pointer to the timings, they are used from the next events
+ */
+TSC_GestureParam_T *TSC_Gesture_ReadParam(void)
+{
+    return &GestureParam;
+}
+
+/*!
+ * @brief       Process a press or release event
+ *
+ * @param       event: Event read with TSC_Event_Read()
+ *
+ * @retval      None
+ *
+ * @note        The events of the Matrix objects are not processed.
+ */
+void TSC_Gesture_ProcessEvent(CONST TSC_Event_T *event)
+{
+    TSC_tIndex_T    idxObj = event->Index;
+    uint32_t        mask;
+    GestureData_T   *data;
+    TSC_tTick_ms_T  duration;
+    int16_t         distance;
+    uint16_t        speed;
+
+    if ((idxObj >= TOUCH_TOTAL_OBJECTS) || (idxObj >= GestureGroup->NbObjects))
+    {
+        return;
+    }
+    if (GestureGroup->p_Obj[idxObj].Type & TSC_OBJ_TYPE_MATRIX_MASK)
+    {
+        return;
+    }
+
+    data = &GestureData[idxObj];
+    mask = (uint32_t)1 << idxObj;
+
+    if (event->Type == TSC_EVENT_PRESS)
+    {
+        data->State = (data->State == GESTURE_STATE_WAIT_TAP) ? GESTURE_STATE_PRESS_TAP : GESTURE_STATE_PRESS;
+        data->PressTick = event->Tick;
+        data->Count = 0;
+
+        if (GestureParam.LongPress)
+        {
+            TSC_Gesture_ConfigTimer(idxObj, (TSC_tTick_ms_T)(event->Tick + GESTURE_TICKS(GestureParam.LongPress)));
+        }
+        else
+        {
+            GestureArmed &= ~mask;
+        }
+
+        if (GestureGroup->p_Obj[idxObj].Type & TSC_OBJ_TYPE_LINROT_MASK)
+        {
+            GestureStartPending |= mask;
+        }
+        GestureStartValid &= ~mask;
+        return;
+    }
+
+    /* Release */
+    GestureArmed &= ~mask;
+    GestureStartPending &= ~mask;
+    GestureStartRead &= ~mask;
+    duration = (TSC_tTick_ms_T)(event->Tick - data->PressTick);
+
+    if ((data->State == GESTURE_STATE_PRESS) || (data->State == GESTURE_STATE_PRESS_TAP))
+    {
+        if (TSC_Gesture_ProcessSwipe(idxObj, duration, &distance, &speed) == TSC_STATUS_OK)
+        {
+            if (data->State == GESTURE_STATE_PRESS_TAP)
+            {
+                TSC_Gesture_Write(TSC_GESTURE_TAP, idxObj, 0, 0);
+            }
+            TSC_Gesture_Write(TSC_GESTURE_SWIPE, idxObj, distance, speed);
+            data->State = GESTURE_STATE_IDLE;
+        }
+        else if (duration <= GESTURE_TICKS(GestureParam.TapMax))
+        {
+            if (data->State == GESTURE_STATE_PRESS_TAP)
+            {
+                TSC_Gesture_Write(TSC_GESTURE_DOUBLE_TAP, idxObj, 0, 0);
+                data->State = GESTURE_STATE_IDLE;
+            }
+            else if (GestureParam.DoubleTapGap)
+            {
+                /* The tap is sent when no second tap comes */
+                data->State = GESTURE_STATE_WAIT_TAP;
+                TSC_Gesture_ConfigTimer(idxObj, (TSC_tTick_ms_T)(event->Tick + GESTURE_TICKS(GestureParam.DoubleTapGap)));
+            }
+            else
+            {
+                TSC_Gesture_Write(TSC_GESTURE_TAP, idxObj, 0, 0);
+                data->State = GESTURE_STATE_IDLE;
+            }
+        }
+        else
+        {
+            /* Too long for a tap, too short for a long press: only the first tap is kept */
+            if (data->State == GESTURE_STATE_PRESS_TAP)
+            {
+                TSC_Gesture_Write(TSC_GESTURE_TAP, idxObj, 0, 0);
+            }
+            data->State = GESTURE_STATE_IDLE;
+        }
+    }
+    else
+    {
+        data->State = GESTURE_STATE_IDLE;
+    }
+}
+
+/*!
+ * @brief       Process the timers and the start positions of the Linear/Rotary sensors
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Must be called once per frame, after the events have been read.
+ *              Without any expired timer it only compares the tick with the earliest deadline.
+ */
+void TSC_Gesture_Process(void)
+{
+    TSC_tIndex_T    idxObj;
+    uint32_t        mask;
+    TSC_tTick_ms_T  tick = TSC_Globals.Tick_ms;
+    TSC_tTick_ms_T  earliest = 0;
+    TSC_BOOL_T      armed = TSC_FALSE;
+
+    /* The position has been calculated in the frame after the press */
+    if (GestureStartRead)
+    {
+        for (idxObj = 0, mask = 1; idxObj < TOUCH_TOTAL_OBJECTS; idxObj++, mask <<= 1)
+        {
+            if (GestureStartRead & mask)
+            {
+                GestureData[idxObj].StartPos = ((TSC_LinRot_T *)GestureGroup->p_Obj[idxObj].MyObj)->p_Data->RawPosition;
+            }
+        }
+        GestureStartValid |= GestureStartRead;
+    }
+    GestureStartRead = GestureStartPending;
+    GestureStartPending = 0;
+
+    if ((GestureArmed == 0) || (!GESTURE_EXPIRED(tick, GestureNextDeadline)))
+    {
+        return;
+    }
+
+    for (idxObj = 0, mask = 1; idxObj < TOUCH_TOTAL_OBJECTS; idxObj++, mask <<= 1)
+    {
+        if (GestureArmed & mask)
+        {
+            if (GESTURE_EXPIRED(tick, GestureData[idxObj].Deadline))
+            {
+                TSC_Gesture_ProcessTimer(idxObj);
+            }
+
+            /* Earliest deadline of the timers still running */
+            if (GestureArmed & mask)
+            {
+                if ((armed == TSC_FALSE) || ((int16_t)(TSC_tTick_ms_T)(GestureData[idxObj].Deadline - earliest) < 0))
+                {
+                    earliest = GestureData[idxObj].Deadline;
+                    armed = TSC_TRUE;
+                }
+            }
+        }
+    }
+    GestureNextDeadline = earliest;
+}
+
+/*!
+ * @brief       Read the oldest gesture of the queue
+ *
+ * @param       gesture: Returns the gesture
+ *
+ * @retval      Status Return TSC_STATUS_BUSY if the queue is empty
+ */
+TSC_STATUS_T TSC_Gesture_Read(TSC_Gesture_T *gesture)
+{
+    if (GestureTail == GestureHead)
+    {
+        return TSC_STATUS_BUSY;
+    }
+
+    *gesture = GestureQueue[GESTURE_INDEX(GestureTail)];
+    GestureTail++;
+
+    return TSC_STATUS_OK;
+}
+
+/** @defgroup Private Functions
+  @{
+*/
+
+/*!
+ * @brief       Add a gesture in the queue
+ *
+ * @param       type: Gesture type
+ *
+ * @param       idxObj: Index of the object in its group
+ *
+ * @param       distance: Swipe distance, 0 for the other gestures
+ *
+ * @param       speed: Swipe speed, 0 for the other gestures
+ *
+ * @retval      None
+ *
+ * @note        The gesture is lost if the queue is full.
+ */
+static void TSC_Gesture_Write(TSC_GESTURE_T type, TSC_tIndex_T idxObj, int16_t distance, uint16_t speed)
+{
+    TSC_Gesture_T *gesture;
+
+    if ((uint8_t)(GestureHead - GestureTail) >= TOUCH_GESTURE_QUEUE_SIZE)
+    {
+        return;
+    }
+
+    gesture = &GestureQueue[GESTURE_INDEX(GestureHead)];
+    gesture->Type     = (uint8_t)type;
+    gesture->Index    = (uint8_t)idxObj;
+    gesture->Count    = GestureData[idxObj].Count;
+    gesture->Distance = distance;
+    gesture->Speed    = speed;
+    GestureHead++;
+}
+
+/*!
+ * @brief       Start the timer of an object
+ *
+ * @param       idxObj: Index of the object in its group
+ *
+ * @param       deadline: Tick when the timer expires
+ *
+ * @retval      None
+ */
+static void TSC_Gesture_ConfigTimer(TSC_tIndex_T idxObj, TSC_tTick_ms_T deadline)
+{
+    GestureData[idxObj].Deadline = deadline;
+
+    if ((GestureArmed == 0) || ((int16_t)(TSC_tTick_ms_T)(deadline - GestureNextDeadline) < 0))
+    {
+        GestureNextDeadline = deadline;
+    }
+    GestureArmed |= (uint32_t)1 << idxObj;
+}
+
+/*!
+ * @brief       Process the expired timer of an object
+ *
+ * @param       idxObj: Index of the object in its group
+ *
+ * @retval      None
+ */
+static void TSC_Gesture_ProcessTimer(TSC_tIndex_T idxObj)
+{
+    GestureData_T *data = &GestureData[idxObj];
+
+    switch (data->State)
+    {
+        case GESTURE_STATE_PRESS_TAP:
+            /* The first tap is not followed by a second one */
+            TSC_Gesture_Write(TSC_GESTURE_TAP, idxObj, 0, 0);
+            /* No break: long press */
+
+        case GESTURE_STATE_PRESS:
+            data->State = GESTURE_STATE_HOLD;
+            data->Count = 0;
+            TSC_Gesture_Write(TSC_GESTURE_LONG_PRESS, idxObj, 0, 0);
+            break;
+
+        case GESTURE_STATE_HOLD:
+            if (data->Count < 0xFF)
+            {
+                data->Count++;
+            }
+            TSC_Gesture_Write(TSC_GESTURE_REPEAT, idxObj, 0, 0);
+            break;
+
+        case GESTURE_STATE_WAIT_TAP:
+            data->State = GESTURE_STATE_IDLE;
+            TSC_Gesture_Write(TSC_GESTURE_TAP, idxObj, 0, 0);
+            break;
+
+        default:
+            break;
+    }
+
+    if ((data->State == GESTURE_STATE_HOLD) && (GestureParam.RepeatPeriod))
+    {
+        data->Deadline += GESTURE_TICKS(GestureParam.RepeatPeriod);
+        /* Do not send the missed repeats in a burst */
+        if (GESTURE_EXPIRED(TSC_Globals.Tick_ms, data->Deadline))
+        {
+            data->Deadline = (TSC_tTick_ms_T)(TSC_Globals.Tick_ms + GESTURE_TICKS(GestureParam.RepeatPeriod));
+        }
+    }
+    else
+    {
+        GestureArmed &= ~((uint32_t)1 << idxObj);
+    }
+}
+
+/*!
+ * @brief       Check the swipe on a Linear/Rotary sensor released
+ *
+ * @param       idxObj: Index of the object in its group
+ *
+ * @param       duration: Press duration in ticks
+ *
+ * @param       distance: Returns the swipe distance
+ *
+ * @param       speed: Returns the swipe speed
+ *
+ * @retval      Status Return TSC_STATUS_OK if the move is a swipe
+ */
+static TSC_STATUS_T TSC_Gesture_ProcessSwipe(TSC_tIndex_T idxObj, TSC_tTick_ms_T duration,
+                                             int16_t *distance, uint16_t *speed)
+{
+    CONST TSC_Object_T *pObj = &GestureGroup->p_Obj[idxObj];
+    int16_t  move;
+    uint16_t absMove;
+    uint32_t rate;
+
+    if ((!(GestureStartValid & ((uint32_t)1 << idxObj))) || (GestureParam.SwipeMax == 0) ||
+        (duration > GESTURE_TICKS(GestureParam.SwipeMax)))
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    move = (int16_t)((TSC_LinRot_T *)pObj->MyObj)->p_Data->RawPosition - (int16_t)GestureData[idxObj].StartPos;
+
+    /* Shortest way around a Rotary sensor */
+    if ((pObj->Type == TSC_OBJ_ROTARY) || (pObj->Type == TSC_OBJ_ROTARYB))
+    {
+        move = (int8_t)move;
+    }
+
+    absMove = (uint16_t)((move < 0) ? -move : move);
+    if (absMove < GestureParam.SwipeMinDist)
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    /* Only one division per swipe */
+    if (duration == 0)
+    {
+        duration = 1;
+    }
+    rate = ((uint32_t)absMove * TOUCH_TICK_FREQ) / duration;
+
+    *distance = move;
+    *speed = (rate > 0xFFFF) ? 0xFFFF : (uint16_t)rate;
+    return TSC_STATUS_OK;
+}
+
+/**@} Private Functions */
+
+#endif /* TOUCH_USE_GESTURE > 0 */
+
+/**@} end of group TSC_Gesture_Functions */
+/**@} end of group TSC_Gesture_Driver */
+/**@} end of group TSC_Driver_Library */
@@ -53,6 +53,10 @@
 #define FOR_COUNTER_DTO           TSC_Globals.For_LinRot->p_Data->CounterDTO
 #define FOR_DXSLOCK               TSC_Globals.For_LinRot->p_Data->DxsLock
 #define FOR_DIRECTION             TSC_Globals.For_LinRot->p_Data->Direction
+#define FOR_FINE_VALID            TSC_Globals.For_LinRot->p_Data->FineValid
+#define FOR_FINE_POSITION         TSC_Globals.For_LinRot->p_Data->FinePosition
+#define FOR_FILTER_POSITION       TSC_Globals.For_LinRot->p_Data->FilterPosition
+#define FOR_VELOCITY              TSC_Globals.For_LinRot->p_Data->Velocity
 
 #define FOR_PROXIN_TH             TSC_Globals.For_LinRot->p_Param->ProxInTh
 #define FOR_PROXOUT_TH            TSC_Globals.For_LinRot->p_Param->ProxOutTh
@@ -62,6 +66,7 @@
 
 #define FOR_RESOLUTION            TSC_Globals.For_LinRot->p_Param->Resolution
 #define FOR_DIR_CHG_POS           TSC_Globals.For_LinRot->p_Param->DirChangePos
+#define FOR_PITCH                 TSC_Globals.For_LinRot->p_Param->Pitch
 
 #define FOR_COUNTER_DEB_CALIB     TSC_Globals.For_LinRot->p_Param->CounterDebCalib
 #define FOR_COUNTER_DEB_PROX      TSC_Globals.For_LinRot->p_Param->CounterDebProx
@@ -84,6 +89,13 @@
 #define DIRECTION_CHANGE_TOTAL_STEPS      (256)
 #define RESOLUTION_CALCULATION            (8)
 
+/* Centroid engine: FinePosition range and the 1/16 sub-unit used for the intermediate results */
+#define CENTROID_POS_SPAN                 ((uint32_t)1 << TOUCH_LINROT_POS_BITS)
+#define CENTROID_POS_MAX                  (CENTROID_POS_SPAN - 1)
+#define CENTROID_SUB_BITS                 (4)
+/* Interpolation ratio between the peak electrode and its neighbours, in Q12 */
+#define CENTROID_RATIO_BITS               (12)
+
 /**@} end of group TSC_Linrot_Macros */
 
 /** @defgroup TSC_Linrot_Enumerations Enumerations
@@ -104,6 +116,32 @@
 
 static TSC_tNum_T CalibDiv;
 
+#if TOUCH_LINROT_USE_CENTROID > 0
+/**
+ * @brief   Reciprocal table used by the centroid engine instead of a division
+ *          (the Cortex-M0 has no hardware divider): 65536 / (128 + index)
+ */
+static CONST uint16_t TSC_LinrotRecip[128] =
+{
+    512, 508, 504, 500, 496, 493, 489, 485,
+    482, 478, 475, 471, 468, 465, 462, 458,
+    455, 452, 449, 446, 443, 440, 437, 434,
+    431, 428, 426, 423, 420, 417, 415, 412,
+    410, 407, 405, 402, 400, 397, 395, 392,
+    390, 388, 386, 383, 381, 379, 377, 374,
+    372, 370, 368, 366, 364, 362, 360, 358,
+    356, 354, 352, 350, 349, 347, 345, 343,
+    341, 340, 338, 336, 334, 333, 331, 329,
+    328, 326, 324, 323, 321, 320, 318, 317,
+    315, 314, 312, 311, 309, 308, 306, 305,
+    303, 302, 301, 299, 298, 297, 295, 294,
+    293, 291, 290, 289, 287, 286, 285, 284,
+    282, 281, 280, 279, 278, 277, 275, 274,
+    273, 272, 271, 270, 269, 267, 266, 265,
+    264, 263, 262, 261, 260, 259, 258, 257
+};
+#endif
+
 /**
  * @brief   3 CHANNELS - CH1 CH2 CH3
  *            LINEAR - MONO - 0/255 at extremities
@@ -393,6 +431,24 @@ void TSC_Linrot_Config(void)
     FOR_DIR_CHG_POS           = TOUCH_LINROT_DIR_CHG_POS;
     FOR_COUNTER_DEB_DIRECTION = TOUCH_LINROT_DIR_CHG_DEB;
 
+#if TOUCH_LINROT_USE_CENTROID > 0
+    /* Electrode pitch: the linear sensor ends on the last electrode, the rotary one wraps to the first.
+        This is the only division of the centroid engine and it is done once. */
+    FOR_PITCH = 0;
+    if ((FOR_OBJ_TYPE == TSC_OBJ_LINEAR) || (FOR_OBJ_TYPE == TSC_OBJ_LINEARB))
+    {
+        if (FOR_NB_CHANNELS > 1)
+        {
+            FOR_PITCH = (uint16_t)((CENTROID_POS_MAX << CENTROID_SUB_BITS) / (FOR_NB_CHANNELS - 1));
+        }
+    }
+    else if (FOR_NB_CHANNELS > 0)
+    {
+        FOR_PITCH = (uint16_t)((CENTROID_POS_SPAN << CENTROID_SUB_BITS) / FOR_NB_CHANNELS);
+    }
+    FOR_FINE_VALID = TSC_FALSE;
+#endif
+
     /* Config state */
     TSC_Linrot_ConfigCalibrationState(TOUCH_CALIB_DELAY);
 }
@@ -438,6 +494,14 @@ void TSC_Linrot_Process(void)
             FOR_CHANGE = TSC_STATE_NOT_CHANGED;
         }
 
+        #if TOUCH_LINROT_USE_CENTROID > 0
+        /* The next touch restarts the smoothing and the velocity from its first position */
+        if ((TSC_Linrot_ReadStateMask() & (TSC_STATE_DETECT_BIT_MASK | TSC_STATE_TOUCH_BIT_MASK)) == 0)
+        {
+            FOR_FINE_VALID = TSC_FALSE;
+        }
+        #endif
+
         #if TOUCH_USE_DXS > 0
         if (FOR_STATEID != TSC_STATEID_DETECT)
         {
@@ -498,7 +562,7 @@ TSC_STATUS_T TSC_Linrot_CalcPos(void)
         #if TOUCH_LINROT_USE_NORMDELTA > 0
         normDelta = TSC_Linrot_NormDelta(p_Ch, index);
         #else
-        normDelta = p_Ch->Delta;
+        normDelta = TSC_CH_DELTA(p_Ch);
         #endif
 
         if (normDelta < 0)
@@ -726,6 +790,251 @@ TSC_STATUS_T TSC_Linrot_CalcPos(void)
     }
 }
 
+#if TOUCH_LINROT_USE_CENTROID > 0
+/*!
+ * @brief       Calculate the position with the centroid engine
+ *
+ * @param       None
+ *
+ * @retval      Status Return OK if the Position has changed
+ *
+ * @note        Works with any number of channels (2 or more for a linear sensor, 3 or more for a rotary one)
+ *              and does not use the position offset tables. The result is given on TOUCH_LINROT_POS_BITS
+ *              bits in FinePosition, RawPosition and Position are derived from it.
+ *              The linearity depends on the electrode shape and has not been checked
+ *              on a sensor: compare with TSC_Linrot_CalcPos() on the target before use.
+ */
+TSC_STATUS_T TSC_Linrot_CalcPosCentroid(void)
+{
+    TSC_tIndex_T     index;
+    TSC_tIndex_T     peak = 0;
+    TSC_tDelta_T     normDelta;
+    TSC_tDelta_T     peakDelta = 0;
+    TSC_tDelta_T     leftDelta = 0;
+    TSC_tDelta_T     rightDelta = 0;
+    TSC_tDelta_T     firstDelta = 0;
+    TSC_tDelta_T     prevDelta = 0;
+    TSC_tDelta_T     baseDelta;
+    int32_t          ratio;
+    int32_t          curPosition;
+    int32_t          step;
+    TSC_BOOL_T       rotary;
+    uint16_t         finePosition;
+    TSC_tsignPosition_T   updatePosition;
+
+    TSC_Channel_Data_T *p_Ch = TSC_Globals.For_LinRot->p_ChD;
+
+    FOR_POSCHANGE = TSC_STATE_NOT_CHANGED;
+
+    rotary = ((FOR_OBJ_TYPE == TSC_OBJ_ROTARY) || (FOR_OBJ_TYPE == TSC_OBJ_ROTARYB)) ? TSC_TRUE : TSC_FALSE;
+
+    if ((FOR_NB_CHANNELS < 2) || ((rotary == TSC_TRUE) && (FOR_NB_CHANNELS < 3)))
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    /**
+     *  Single pass on the channels' delta
+     *    - peakDelta and peak = biggest
+     *    - leftDelta and rightDelta = neighbours of the biggest
+     */
+    for (index = 0; index < FOR_NB_CHANNELS; index++)
+    {
+        #if TOUCH_LINROT_USE_NORMDELTA > 0
+        normDelta = TSC_Linrot_NormDelta(p_Ch, index);
+        #else
+        normDelta = TSC_CH_DELTA(p_Ch);
+        #endif
+
+        if (normDelta < 0)
+        {
+            normDelta = 0;
+        }
+
+        if (index == 0)
+        {
+            firstDelta = normDelta;
+        }
+        else if (index == (peak + 1))
+        {
+            rightDelta = normDelta;
+        }
+
+        if (normDelta > peakDelta)
+        {
+            peakDelta  = normDelta;
+            peak       = index;
+            leftDelta  = prevDelta;
+            rightDelta = 0;
+        }
+
+        prevDelta = normDelta;
+        p_Ch++;
+    }
+
+    /* The neighbours of the ends of a rotary sensor are on the other end */
+    if (rotary == TSC_TRUE)
+    {
+        if (peak == 0)
+        {
+            leftDelta = prevDelta;
+        }
+        if (peak == (FOR_NB_CHANNELS - 1))
+        {
+            rightDelta = firstDelta;
+        }
+    }
+
+    if (((leftDelta > rightDelta) ? leftDelta : rightDelta) < ((TSC_tThreshold_T)(FOR_DETECTOUT_TH >> 1) - 1))
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    /******************** Position calculation **********************/
+
+    /**
+     * - The smallest neighbour is removed from the three signals, then
+     *   Ratio = (Right - Left) / (Left + Peak + Right)    (-1/2 .. 1/2)
+     *   Position = (Peak + Ratio) x Pitch
+     *
+     * - The Ratio is computed in Q12 with the reciprocal table and the
+     *   Position in 1/16 of FinePosition unit.
+     */
+    baseDelta   = (leftDelta < rightDelta) ? leftDelta : rightDelta;
+    leftDelta  -= baseDelta;
+    rightDelta -= baseDelta;
+    peakDelta  -= baseDelta;
+
+    ratio = TSC_Linrot_DivRatio((int32_t)rightDelta - leftDelta,
+                                (uint32_t)leftDelta + (uint32_t)peakDelta + (uint32_t)rightDelta);
+
+    curPosition = (int32_t)peak * FOR_PITCH;
+    if (ratio < 0)
+    {
+        curPosition -= (int32_t)(((uint32_t)(-ratio) * FOR_PITCH) >> CENTROID_RATIO_BITS);
+    }
+    else
+    {
+        curPosition += (int32_t)(((uint32_t)ratio * FOR_PITCH) >> CENTROID_RATIO_BITS);
+    }
+
+    /* Position is clamped on a LINEAR sensor and wrapped on a ROTARY sensor */
+    if (rotary == TSC_TRUE)
+    {
+        curPosition &= (int32_t)((CENTROID_POS_SPAN << CENTROID_SUB_BITS) - 1);
+    }
+    else if (curPosition < 0)
+    {
+        curPosition = 0;
+    }
+    else if (curPosition > (int32_t)(CENTROID_POS_MAX << CENTROID_SUB_BITS))
+    {
+        curPosition = (int32_t)(CENTROID_POS_MAX << CENTROID_SUB_BITS);
+    }
+
+    /******************** Smoothing and velocity **********************/
+
+    if (FOR_FINE_VALID != TSC_TRUE)
+    {
+        /* First position of the touch */
+        step = 0;
+        #if TOUCH_LINROT_SMOOTHING > 0
+        FOR_FILTER_POSITION = (uint16_t)curPosition;
+        #endif
+        #if TOUCH_LINROT_USE_VELOCITY > 0
+        FOR_VELOCITY = 0;
+        #endif
+    }
+    else
+    {
+        #if TOUCH_LINROT_SMOOTHING > 0
+        step = curPosition - (int32_t)FOR_FILTER_POSITION;
+        #else
+        step = curPosition - ((int32_t)FOR_FINE_POSITION << CENTROID_SUB_BITS);
+        #endif
+
+        /* Shortest way around a ROTARY sensor */
+        if (rotary == TSC_TRUE)
+        {
+            if (step >= (int32_t)(CENTROID_POS_SPAN << (CENTROID_SUB_BITS - 1)))
+            {
+                step -= (int32_t)(CENTROID_POS_SPAN << CENTROID_SUB_BITS);
+            }
+            else if (step < -(int32_t)(CENTROID_POS_SPAN << (CENTROID_SUB_BITS - 1)))
+            {
+                step += (int32_t)(CENTROID_POS_SPAN << CENTROID_SUB_BITS);
+            }
+        }
+
+        #if TOUCH_LINROT_SMOOTHING > 0
+        /* First order filter: Filter += (Position - Filter) / 2^TOUCH_LINROT_SMOOTHING */
+        if (step < 0)
+        {
+            step = -(int32_t)((uint32_t)(-step) >> TOUCH_LINROT_SMOOTHING);
+        }
+        else
+        {
+            step = (int32_t)((uint32_t)step >> TOUCH_LINROT_SMOOTHING);
+        }
+        curPosition = (int32_t)FOR_FILTER_POSITION + step;
+        if (rotary == TSC_TRUE)
+        {
+            curPosition &= (int32_t)((CENTROID_POS_SPAN << CENTROID_SUB_BITS) - 1);
+        }
+        FOR_FILTER_POSITION = (uint16_t)curPosition;
+        #endif
+
+        #if TOUCH_LINROT_USE_VELOCITY > 0
+        /* Mean of the last steps: Velocity = (Velocity + Step) / 2 */
+        FOR_VELOCITY = (int16_t)((FOR_VELOCITY + step) / 2);
+        #endif
+
+        if (step > 0)
+        {
+            FOR_DIRECTION = TSC_FALSE; /*!<Clockwise direction */
+        }
+        else if (step < 0)
+        {
+            FOR_DIRECTION = TSC_TRUE;  /*!<Anticlockwise direction */
+        }
+    }
+
+    /******************** Final result **********************/
+
+    finePosition = (uint16_t)((uint32_t)(curPosition + (1 << (CENTROID_SUB_BITS - 1))) >> CENTROID_SUB_BITS);
+    if (rotary == TSC_TRUE)
+    {
+        finePosition &= (uint16_t)CENTROID_POS_MAX;
+    }
+    else if (finePosition > CENTROID_POS_MAX)
+    {
+        finePosition = (uint16_t)CENTROID_POS_MAX;
+    }
+
+    if ((FOR_FINE_VALID != TSC_TRUE) || (FOR_FINE_POSITION != finePosition))
+    {
+        FOR_FINE_POSITION = finePosition;
+        FOR_POSCHANGE = TSC_STATE_CHANGED;
+    }
+    FOR_FINE_VALID = TSC_TRUE;
+
+    FOR_RAW_POSITION = (TSC_tsignPosition_T)(finePosition >> (TOUCH_LINROT_POS_BITS - RESOLUTION_CALCULATION));
+
+    updatePosition = (TSC_tsignPosition_T)(FOR_RAW_POSITION >> (RESOLUTION_CALCULATION - FOR_RESOLUTION));
+
+    /* The status follows the Position only, the Detection Time Out is not reset by the noise on FinePosition */
+    if (FOR_POSITION != updatePosition)
+    {
+        FOR_POSITION = updatePosition;
+        return TSC_STATUS_OK;
+    }
+    else
+    {
+        return TSC_STATUS_ERROR;
+    }
+}
+#endif
+
 /**@} "Object_methods" Functions */
 
 /** @defgroup Utility Functions
@@ -779,6 +1088,22 @@ void TSC_Linrot_ConfigOffState(void)
     TSC_Linrot_Process_AllChannel_Status(TSC_OBJ_STATUS_OFF);
 }
 
+/*!
+ * @brief       Go in Release state with sensor "on"
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        The References must be already valid (restored calibration).
+ */
+void TSC_Linrot_ConfigReleaseState(void)
+{
+    FOR_STATEID = TSC_STATEID_RELEASE;
+    FOR_CHANGE = TSC_STATE_CHANGED;
+    TSC_Linrot_Process_AllChannel_Status(TSC_OBJ_STATUS_ON);
+}
+
 /*!
  * @brief       Go in Off state with sensor in "Burst mode only"
  *
@@ -849,6 +1174,35 @@ TSC_tNum_T TSC_Linrot_ReadChangeFlag(void)
     return(FOR_CHANGE);
 }
 
+#if TOUCH_LINROT_USE_CENTROID > 0
+/*!
+ * @brief       Return the position calculated by the centroid engine
+ *
+ * @param       None
+ *
+ * @retval      Position on TOUCH_LINROT_POS_BITS bits
+ */
+uint16_t TSC_Linrot_ReadFinePosition(void)
+{
+    return(FOR_FINE_POSITION);
+}
+
+#if TOUCH_LINROT_USE_VELOCITY > 0
+/*!
+ * @brief       Return the velocity calculated by the centroid engine
+ *
+ * @param       None
+ *
+ * @retval      Position change per calculation in 1/16 of FinePosition unit
+ *              (positive = clockwise direction)
+ */
+int16_t TSC_Linrot_ReadVelocity(void)
+{
+    return(FOR_VELOCITY);
+}
+#endif
+#endif
+
 /**@} Utility Functions */
 
 /** @defgroup State_machine Functions
@@ -1107,19 +1461,19 @@ void TSC_Linrot_ProcessCalibrationState(void)
         {
             /* Read the new measure or Calculate it */
             #if TOUCH_USE_MEAS > 0
-            newMeas = p_Ch->Meas;
+            newMeas = TSC_CH_MEAS(p_Ch);
             #else
-            newMeas = TSC_Acq_ComputeMeas(p_Ch->Refer, p_Ch->Delta);
+            newMeas = TSC_Acq_ComputeMeas(TSC_CH_REFER(p_Ch), TSC_CH_DELTA(p_Ch));
             #endif
 
             /* Verify the first Reference value */
             if (FOR_COUNTER_DEB != (TSC_tCounter_T)TSC_Params.NumCalibSample)
             {
-                p_Ch->Refer += newMeas;
+                TSC_CH_REFER(p_Ch) += newMeas;
 
-                if (p_Ch->Refer < newMeas)
+                if (TSC_CH_REFER(p_Ch) < newMeas)
                 {
-                    p_Ch->Refer = 0;
+                    TSC_CH_REFER(p_Ch) = 0;
                     FOR_STATEID = TSC_STATEID_ERROR;
                     return;
                 }
@@ -1128,11 +1482,11 @@ void TSC_Linrot_ProcessCalibrationState(void)
             {
                 if (TSC_Acq_TestFirstReference(p_Ch, newMeas))
                 {
-                    p_Ch->Refer = newMeas;
+                    TSC_CH_REFER(p_Ch) = newMeas;
                 }
                 else
                 {
-                    p_Ch->Refer = 0;
+                    TSC_CH_REFER(p_Ch) = 0;
                     return;
                 }
             }
@@ -1150,9 +1504,9 @@ void TSC_Linrot_ProcessCalibrationState(void)
 
             for (index = 0; index < FOR_NB_CHANNELS; index++)
             {
-                p_Ch->Refer >>= CalibDiv;
+                TSC_CH_REFER(p_Ch) >>= CalibDiv;
                 p_Ch->RefRest = 0;
-                p_Ch->Delta = 0;
+                TSC_CH_DELTA(p_Ch) = 0;
                 p_Ch++;
             }
             FOR_STATEID = TSC_STATEID_RELEASE;
@@ -1841,7 +2195,7 @@ TSC_STATUS_T TSC_Linrot_Process_OneChannel_DeltaBelowEquMinus(TSC_tThreshold_T t
         #if TOUCH_LINROT_USE_NORMDELTA > 0
         normDelta = TSC_Linrot_NormDelta(p_Ch, index);
         #else
-        normDelta = p_Ch->Delta;
+        normDelta = TSC_CH_DELTA(p_Ch);
         #endif
 
         #if TOUCH_COEFF_TH > 0
@@ -1890,7 +2244,7 @@ TSC_STATUS_T TSC_Linrot_Process_OneChannel_DeltaAboveEqu(TSC_tThreshold_T thresh
         #if TOUCH_LINROT_USE_NORMDELTA > 0
         normDelta = TSC_Linrot_NormDelta(p_Ch, index);
         #else
-        normDelta = p_Ch->Delta;
+        normDelta = TSC_CH_DELTA(p_Ch);
         #endif
 
         #if TOUCH_COEFF_TH > 0
@@ -1946,7 +2300,7 @@ TSC_STATUS_T TSC_Linrot_Process_OneChannel_DeltaAbove(TSC_tThreshold_T threshold
         #if TOUCH_LINROT_USE_NORMDELTA > 0
         normDelta = TSC_Linrot_NormDelta(p_Ch, index);
         #else
-        normDelta = p_Ch->Delta;
+        normDelta = TSC_CH_DELTA(p_Ch);
         #endif
 
         #if TOUCH_COEFF_TH > 0
@@ -2002,7 +2356,7 @@ TSC_STATUS_T TSC_Linrot_Process_AllChannel_DeltaBelowEqu(TSC_tThreshold_T thresh
         #if TOUCH_LINROT_USE_NORMDELTA > 0
         normDelta = TSC_Linrot_NormDelta(p_Ch, index);
         #else
-        normDelta = p_Ch->Delta;
+        normDelta = TSC_CH_DELTA(p_Ch);
         #endif
 
         #if TOUCH_COEFF_TH > 0
@@ -2038,7 +2392,7 @@ void TSC_Linrot_Process_AllChannel_ClearRef(void)
     TSC_Channel_Data_T *p_Ch = TSC_Globals.For_LinRot->p_ChD;
     for (index = 0; index < FOR_NB_CHANNELS; index++)
     {
-        p_Ch->Refer = 0;
+        TSC_CH_REFER(p_Ch) = 0;
         p_Ch->RefRest = 0;
         p_Ch++;
     }
@@ -2055,7 +2409,7 @@ void TSC_Linrot_Process_AllChannel_ClearRef(void)
  */
 TSC_tDelta_T TSC_Linrot_NormDelta(TSC_Channel_Data_T *channel, TSC_tIndex_T index)
 {
-    uint32_t tmpdelta = channel->Delta;
+    uint32_t tmpdelta = TSC_CH_DELTA(channel);
 
     if (TSC_Globals.For_LinRot->p_DeltaCoeff[index] != 0x0100)
     {
@@ -2064,6 +2418,68 @@ TSC_tDelta_T TSC_Linrot_NormDelta(TSC_Channel_Data_T *channel, TSC_tIndex_T inde
     }
     return (TSC_tDelta_T)tmpdelta;
 }
+
+#if TOUCH_LINROT_USE_CENTROID > 0
+/*!
+ * @brief      Divide with the reciprocal table
+ *
+ * @param      num: Numerator, its absolute value must not be greater than den
+ *
+ * @param      den: Denominator
+ *
+ * @retval     num / den in Q12 (-4096 .. 4096), 0 if den is 0
+ *
+ * @note       The denominator is rounded to 8 significant bits (128 .. 255): the
+ *             relative error is at most 0.5 / 128 (0.4%) plus the table rounding.
+ */
+int32_t TSC_Linrot_DivRatio(int32_t num, uint32_t den)
+{
+    uint32_t quot;
+    int8_t   shift = 16 - CENTROID_RATIO_BITS;
+
+    if (den == 0)
+    {
+        return 0;
+    }
+
+    quot = (num < 0) ? (uint32_t)(-num) : (uint32_t)num;
+
+    /* den = (128 .. 255) x 2^(shift - 4), rounded */
+    while (den > 511)
+    {
+        den >>= 1;
+        shift++;
+    }
+    if (den > 255)
+    {
+        den = (den + 1) >> 1;
+        shift++;
+    }
+    if (den > 255)
+    {
+        den >>= 1;
+        shift++;
+    }
+    while (den < 128)
+    {
+        den <<= 1;
+        shift--;
+    }
+
+    quot *= TSC_LinrotRecip[den - 128];
+
+    if (shift > 0)
+    {
+        quot = (quot + ((uint32_t)1 << (shift - 1))) >> shift;
+    }
+    else
+    {
+        quot <<= -shift;
+    }
+
+    return (num < 0) ? -(int32_t)quot : (int32_t)quot;
+}
+#endif
 #endif /*!<#if TOUCH_TOTAL_LNRTS > 0 */
 
 /**@} Private Functions */
@@ -0,0 +1,260 @@
+/*!
+ * @file        tsc_lowpower.c
+ *
+ * @brief       This file contains all functions to scan the guard channels at low rate when the objects are idle.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "tsc.h"
+#include "tsc_lowpower.h"
+#if TOUCH_USE_LOWPOWER > 0
+#include "apm32f0xx_pmu.h"
+#endif
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_LowPower_Driver TSC Low Power Driver
+  @{
+*/
+
+/** @defgroup TSC_LowPower_Macros Macros
+  @{
+*/
+
+#if TOUCH_USE_LOWPOWER > 0
+
+/* States of an object which keep the full scan running */
+#define LP_ACTIVE_STATE_MASK  (TSC_STATE_DEBOUNCE_BIT_MASK | TSC_STATE_CALIB_BIT_MASK | TSC_STATE_TOUCH_BIT_MASK | \
+                               TSC_STATE_DETECT_BIT_MASK | TSC_STATE_PROX_BIT_MASK)
+
+/**@} end of group TSC_LowPower_Macros */
+
+/** @defgroup TSC_LowPower_Enumerations Enumerations
+  @{
+*/
+
+/**@} end of group TSC_LowPower_Enumerations */
+
+/** @defgroup TSC_LowPower_Structures Structures
+  @{
+*/
+
+/**@} end of group TSC_LowPower_Structures */
+
+/** @defgroup TSC_LowPower_Variables Variables
+  @{
+*/
+
+/* Current scan mode */
+static TSC_LP_MODE_T        LowPowerMode;
+/* Tick_sec of the last Frame with an active object */
+static __IO TSC_tTick_sec_T LowPowerLastActive;
+/* Reference of each guard channel, set by the first guard Frame */
+static TSC_tMeas_T          LowPowerRefer[TSC_NB_GROUPS];
+static uint8_t              LowPowerReferValid;
+
+/**@} end of group TSC_LowPower_Variables */
+
+/** @defgroup TSC_LowPower_Functions Functions
+  @{
+*/
+
+static void TSC_LowPower_ConfigMode(TSC_LP_MODE_T mode);
+
+/*!
+ * @brief       Config the low-power scan
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        The full scan runs first, the guard scan starts after TOUCH_LP_IDLE_SEC
+ *              without any active object.
+ */
+void TSC_LowPower_Config(void)
+{
+    TSC_LowPower_ConfigMode(TSC_LP_MODE_ACTIVE);
+}
+
+/*!
+ * @brief       Check the guard channels of a Frame
+ *
+ * @param       frame: Pointer to the Frame read from the queue
+ *
+ * @retval      TSC_STATUS_OK if the Frame is a guard Frame, it must not be processed by the objects,
+ *              TSC_STATUS_BUSY otherwise
+ *
+ * @note        The full scan restarts when the delta of a guard channel reaches TOUCH_LP_WAKE_TH
+ *              or when the acquisition is in error.
+ */
+TSC_STATUS_T TSC_LowPower_ProcessFrame(CONST TSC_Frame_T *frame)
+{
+    TSC_tIndex_T idx;
+    TSC_tMeas_T  meas;
+    int32_t      delta;
+    uint8_t      wake = 0;
+
+    if (frame->Guard == 0)
+    {
+        return TSC_STATUS_BUSY;
+    }
+
+    if (frame->Status != TSC_STATUS_OK)
+    {
+        wake = 1;
+    }
+
+    for (idx = 0; (idx < TSC_Acq_ReadGuardCount()) && (wake == 0); idx++)
+    {
+        meas = TSC_Acq_ReadGuardMeas(frame, idx);
+
+        if (LowPowerReferValid == 0)
+        {
+            LowPowerRefer[idx] = meas;
+            continue;
+        }
+
+        /* A higher capacitance gives a lower measure */
+        delta = (int32_t)LowPowerRefer[idx] - (int32_t)meas;
+
+        if (delta >= TOUCH_LP_WAKE_TH)
+        {
+            wake = 1;
+        }
+        else if (delta <= 0)
+        {
+            LowPowerRefer[idx] = meas;
+        }
+        else
+        {
+            /* Follow the slow drift, 1/8 of the delta rounded up */
+            LowPowerRefer[idx] -= (TSC_tMeas_T)((delta + 7) >> 3);
+        }
+    }
+    LowPowerReferValid = 1;
+
+    if (wake)
+    {
+        TSC_LowPower_ConfigMode(TSC_LP_MODE_ACTIVE);
+    }
+
+    return TSC_STATUS_OK;
+}
+
+/*!
+ * @brief       Start the guard scan when the objects have been idle for TOUCH_LP_IDLE_SEC
+ *
+ * @param       objgrp: Group of objects, processed in the same Frame
+ *
+ * @retval      None
+ *
+ * @note        Objects in proximity, detect, touch, calibration or debounce states are active.
+ */
+void TSC_LowPower_ProcessGroup(CONST TSC_ObjectGroup_T *objgrp)
+{
+    if (LowPowerMode != TSC_LP_MODE_ACTIVE)
+    {
+        return;
+    }
+
+    if (objgrp->StateMask & LP_ACTIVE_STATE_MASK)
+    {
+        LowPowerLastActive = TSC_Globals.Tick_sec;
+    }
+    else if (TSC_Time_Delay_sec(TOUCH_LP_IDLE_SEC, &LowPowerLastActive) == TSC_STATUS_OK)
+    {
+        TSC_LowPower_ConfigMode(TSC_LP_MODE_GUARD);
+    }
+}
+
+/*!
+ * @brief       Return the current scan mode
+ *
+ * @param       None
+ *
+ * @retval      Scan mode (TSC_LP_MODE_T)
+ */
+TSC_LP_MODE_T TSC_LowPower_ReadMode(void)
+{
+    return LowPowerMode;
+}
+
+/*!
+ * @brief       Enter the Sleep mode during the guard scan
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Called by the application when no Frame is ready. The CPU is woken up by
+ *              the next interrupt: timing tick, end of the guard burst or application.
+ *              Between two guard bursts the timing tick comes every TOUCH_LP_SCAN_PERIOD ms
+ *              (at most every 65 ms), other interrupts such as the USB SOF still wake it up.
+ *              The Stop mode is not used as it stops the timer starting the guard bursts.
+ *              The Frame queue is checked again with the interrupts masked: a Frame written
+ *              after the check of the application would wait for the next wake-up. A pending
+ *              interrupt still ends WFI, its routine runs when the interrupts are unmasked.
+ */
+void TSC_LowPower_Sleep(void)
+{
+    if (LowPowerMode == TSC_LP_MODE_GUARD)
+    {
+        __disable_irq();
+        if (TSC_Acq_ReadFrame() == 0)
+        {
+            PMU_EnterSleepMode(PMU_SLEEPENTRY_WFI);
+        }
+        __enable_irq();
+    }
+}
+
+/*!
+ * @brief       Set the scan mode (private routine)
+ *
+ * @param       mode: Scan mode
+ *
+ * @retval      None
+ */
+static void TSC_LowPower_ConfigMode(TSC_LP_MODE_T mode)
+{
+    LowPowerMode = mode;
+
+    if (mode == TSC_LP_MODE_GUARD)
+    {
+        /* The hand is away: the first guard Frame gives the references */
+        LowPowerReferValid = 0;
+        TSC_Acq_ConfigGuardMode(1);
+    }
+    else
+    {
+        LowPowerLastActive = TSC_Globals.Tick_sec;
+        TSC_Acq_ConfigGuardMode(0);
+    }
+}
+
+#endif /* TOUCH_USE_LOWPOWER > 0 */
+
+/**@} end of group TSC_LowPower_Functions */
+/**@} end of group TSC_LowPower_Driver */
+/**@} end of group TSC_Driver_Library */
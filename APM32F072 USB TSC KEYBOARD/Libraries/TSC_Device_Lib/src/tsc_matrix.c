@@ -0,0 +1,950 @@
+/*!
+ * @file        tsc_matrix.c
+ *
+ * @brief       This file contains all functions to manage the Matrix sensors.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "tsc.h"
+#include "tsc_matrix.h"
+
+#if TOUCH_TOTAL_MATRICES > 0
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Matrix_Driver TSC Matrix Driver
+  @{
+*/
+
+/** @defgroup TSC_Matrix_Macros Macros
+  @{
+*/
+
+/* The Matrix is the "matrix" parameter of the functions */
+#define FOR_STATEID              matrix->p_Data->StateId
+#define FOR_CHANGE               matrix->p_Data->Change
+#define FOR_MATRIX_KEYCHANGE     matrix->p_Data->KeyChange
+#define FOR_MATRIX_KEY           matrix->p_Data->Key
+#define FOR_CANDIDATE            matrix->p_Data->Candidate
+#define FOR_COUNTER_DEB          matrix->p_Data->CounterDebounce
+#define FOR_NB_CHANNELS          (matrix->NumRow + matrix->NumCol)
+
+#define FOR_DETECTIN_TH          matrix->p_Param->DetectInTh
+#define FOR_DETECTOUT_TH         matrix->p_Param->DetectOutTh
+#define FOR_CALIB_TH             matrix->p_Param->CalibTh
+
+#define FOR_COUNTER_DEB_CALIB    matrix->p_Param->CounterDebCalib
+#define FOR_COUNTER_DEB_DETECT   matrix->p_Param->CounterDebDetect
+#define FOR_COUNTER_DEB_RELEASE  matrix->p_Param->CounterDebRelease
+#define FOR_COUNTER_DEB_ERROR    matrix->p_Param->CounterDebError
+
+#if TOUCH_COEFF_TH > 0
+#define MATRIX_TH(TH)            ((int32_t)((uint16_t)(TH) << TOUCH_COEFF_TH))
+#else
+#define MATRIX_TH(TH)            ((int32_t)(TH))
+#endif
+
+/* Two lines are adjacent */
+#define MATRIX_ADJACENT(a, b)    (((a) + 1 == (b)) || ((b) + 1 == (a)))
+
+/**@} end of group TSC_Matrix_Macros */
+
+/** @defgroup TSC_Matrix_Enumerations Enumerations
+  @{
+*/
+
+/**@} end of group TSC_Matrix_Enumerations */
+
+/** @defgroup TSC_Matrix_Structures Structures
+  @{
+*/
+
+/**@} end of group TSC_Matrix_Structures */
+
+/** @defgroup TSC_Matrix_Variables Variables
+  @{
+*/
+
+static TSC_tNum_T CalibDiv;
+
+/**@} end of group TSC_Matrix_Variables */
+
+/** @defgroup TSC_Matrix_Functions Functions
+  @{
+*/
+
+static TSC_BOOL_T TSC_Matrix_TestDataReady(CONST TSC_Matrix_T *matrix);
+static TSC_BOOL_T TSC_Matrix_TestAcqError(CONST TSC_Matrix_T *matrix);
+static TSC_BOOL_T TSC_Matrix_TestCalib(CONST TSC_Matrix_T *matrix);
+static TSC_tNum_T TSC_Matrix_ReadLines(TSC_Channel_Data_T *p_Ch, TSC_tNum_T numLine, int32_t th,
+                                       TSC_tIndex_T *p_First, TSC_tIndex_T *p_Second);
+static uint8_t TSC_Matrix_ReadKey(CONST TSC_Matrix_T *matrix, TSC_tThreshold_T th);
+static void TSC_Matrix_ConfigKey(CONST TSC_Matrix_T *matrix, uint8_t key);
+static void TSC_Matrix_ConfigErrorState(CONST TSC_Matrix_T *matrix, TSC_STATEID_T debStateId);
+static void TSC_Matrix_ProcessCalibrationState(CONST TSC_Matrix_T *matrix);
+static void TSC_Matrix_ProcessDebCalibrationState(CONST TSC_Matrix_T *matrix);
+static void TSC_Matrix_ProcessReleaseState(CONST TSC_Matrix_T *matrix);
+static void TSC_Matrix_ProcessDebDetectState(CONST TSC_Matrix_T *matrix);
+static void TSC_Matrix_ProcessDetectState(CONST TSC_Matrix_T *matrix);
+static void TSC_Matrix_ProcessDebReleaseDetectState(CONST TSC_Matrix_T *matrix);
+static void TSC_Matrix_ProcessDebErrorState(CONST TSC_Matrix_T *matrix);
+
+/*!
+ * @brief       Config parameters with default values from configuration file
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      None
+ */
+void TSC_Matrix_ConfigCtx(CONST TSC_Matrix_T *matrix)
+{
+    /* Debounce counters */
+    FOR_COUNTER_DEB_CALIB   = TOUCH_DEBOUNCE_CALIB;
+    FOR_COUNTER_DEB_DETECT  = TOUCH_DEBOUNCE_DETECT;
+    FOR_COUNTER_DEB_RELEASE = TOUCH_DEBOUNCE_RELEASE;
+    FOR_COUNTER_DEB_ERROR   = TOUCH_DEBOUNCE_ERROR;
+
+    /* Thresholds */
+    FOR_DETECTIN_TH  = TOUCH_MATRIX_DETECT_IN_TH;
+    FOR_DETECTOUT_TH = TOUCH_MATRIX_DETECT_OUT_TH;
+    FOR_CALIB_TH     = TOUCH_MATRIX_CALIB_TH;
+
+    FOR_MATRIX_KEY = TSC_MATRIX_NO_KEY;
+    FOR_CANDIDATE = TSC_MATRIX_NO_KEY;
+    FOR_MATRIX_KEYCHANGE = TSC_STATE_NOT_CHANGED;
+
+    /* Config state */
+    TSC_Matrix_ConfigCalibrationStateCtx(matrix, TOUCH_CALIB_DELAY);
+}
+
+/*!
+ * @brief       Process the State Machine
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      None
+ *
+ * @note        The Matrix is processed when its channels have a new measurement.
+ *              The Key is updated in the Detect state only: it is the crossing of
+ *              the strongest row and the strongest column.
+ */
+void TSC_Matrix_ProcessCtx(CONST TSC_Matrix_T *matrix)
+{
+    TSC_STATEID_T stateId;
+
+    if ((FOR_STATEID != TSC_STATEID_OFF) && (TSC_Matrix_TestDataReady(matrix) == TSC_FALSE))
+    {
+        return;
+    }
+
+    stateId = FOR_STATEID;
+    FOR_MATRIX_KEYCHANGE = TSC_STATE_NOT_CHANGED;
+
+    switch (FOR_STATEID)
+    {
+        case TSC_STATEID_CALIB:
+            TSC_Matrix_ProcessCalibrationState(matrix);
+            break;
+
+        case TSC_STATEID_DEB_CALIB:
+            TSC_Matrix_ProcessDebCalibrationState(matrix);
+            break;
+
+        case TSC_STATEID_RELEASE:
+            TSC_Matrix_ProcessReleaseState(matrix);
+            break;
+
+        case TSC_STATEID_DEB_DETECT:
+            TSC_Matrix_ProcessDebDetectState(matrix);
+            break;
+
+        case TSC_STATEID_DETECT:
+            TSC_Matrix_ProcessDetectState(matrix);
+            break;
+
+        case TSC_STATEID_DEB_RELEASE_DETECT:
+            TSC_Matrix_ProcessDebReleaseDetectState(matrix);
+            break;
+
+        case TSC_STATEID_DEB_ERROR_CALIB:
+        case TSC_STATEID_DEB_ERROR_RELEASE:
+        case TSC_STATEID_DEB_ERROR_DETECT:
+            TSC_Matrix_ProcessDebErrorState(matrix);
+            break;
+
+        /* Error and Off states */
+        default:
+            break;
+    }
+
+    /* Check if the new state has changed */
+    if (FOR_STATEID != stateId)
+    {
+        FOR_CHANGE = TSC_STATE_CHANGED;
+    }
+    else
+    {
+        FOR_CHANGE = TSC_STATE_NOT_CHANGED;
+    }
+}
+
+/*!
+ * @brief       Go in Calibration state
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @param       delay: Delay before calibration starts (stabilization of noise filter)
+ *
+ * @retval      None
+ */
+void TSC_Matrix_ConfigCalibrationStateCtx(CONST TSC_Matrix_T *matrix, TSC_tCounter_T delay)
+{
+    TSC_tIndex_T index;
+    TSC_Channel_Data_T *p_Ch = matrix->p_ChD;
+
+    FOR_STATEID = TSC_STATEID_CALIB;
+    FOR_CHANGE = TSC_STATE_CHANGED;
+    TSC_Matrix_ConfigKey(matrix, TSC_MATRIX_NO_KEY);
+
+    for (index = 0; index < FOR_NB_CHANNELS; index++)
+    {
+        p_Ch->Flag.ObjStatus = TSC_OBJ_STATUS_ON;
+        TSC_CH_REFER(p_Ch) = 0;
+        p_Ch++;
+    }
+
+    if (TSC_Params.NumCalibSample == 4)
+    {
+        CalibDiv = 2;
+    }
+    else if (TSC_Params.NumCalibSample == 16)
+    {
+        CalibDiv = 4;
+    }
+    else
+    {
+        TSC_Params.NumCalibSample = 8;
+        CalibDiv = 3;
+    }
+    /* If a noise filter is used, the counter must be initialized to a value
+     * different from 0 in order to stabilize the filter. */
+    FOR_COUNTER_DEB = (TSC_tCounter_T)(delay + (TSC_tCounter_T)TSC_Params.NumCalibSample);
+}
+
+/*!
+ * @brief       Go in Calibration state
+ *
+ * @param       delay: Delay before calibration starts (stabilization of noise filter)
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Matrix).
+ */
+void TSC_Matrix_ConfigCalibrationState(TSC_tCounter_T delay)
+{
+    TSC_Matrix_ConfigCalibrationStateCtx(TSC_Globals.For_Matrix, delay);
+}
+
+/*!
+ * @brief       Go in Release state with sensor "on"
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      None
+ *
+ * @note        The References must be already valid (restored calibration).
+ */
+void TSC_Matrix_ConfigReleaseStateCtx(CONST TSC_Matrix_T *matrix)
+{
+    TSC_tIndex_T index;
+    TSC_Channel_Data_T *p_Ch = matrix->p_ChD;
+
+    FOR_STATEID = TSC_STATEID_RELEASE;
+    FOR_CHANGE = TSC_STATE_CHANGED;
+    TSC_Matrix_ConfigKey(matrix, TSC_MATRIX_NO_KEY);
+
+    for (index = 0; index < FOR_NB_CHANNELS; index++)
+    {
+        p_Ch->Flag.ObjStatus = TSC_OBJ_STATUS_ON;
+        p_Ch++;
+    }
+}
+
+/*!
+ * @brief       Go in Release state with sensor "on"
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Matrix).
+ */
+void TSC_Matrix_ConfigReleaseState(void)
+{
+    TSC_Matrix_ConfigReleaseStateCtx(TSC_Globals.For_Matrix);
+}
+
+/*!
+ * @brief       Go in Off state with sensor "off"
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      None
+ */
+void TSC_Matrix_ConfigOffStateCtx(CONST TSC_Matrix_T *matrix)
+{
+    TSC_tIndex_T index;
+    TSC_Channel_Data_T *p_Ch = matrix->p_ChD;
+
+    FOR_STATEID = TSC_STATEID_OFF;
+    FOR_CHANGE = TSC_STATE_CHANGED;
+    TSC_Matrix_ConfigKey(matrix, TSC_MATRIX_NO_KEY);
+
+    for (index = 0; index < FOR_NB_CHANNELS; index++)
+    {
+        p_Ch->Flag.ObjStatus = TSC_OBJ_STATUS_OFF;
+        p_Ch++;
+    }
+}
+
+/*!
+ * @brief       Return the current state mask
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      State mask
+ */
+TSC_tNum_T TSC_Matrix_ReadStateMaskCtx(CONST TSC_Matrix_T *matrix)
+{
+    TSC_tNum_T stateMask;
+
+    switch (FOR_STATEID)
+    {
+        case TSC_STATEID_CALIB:
+            stateMask = TSC_STATEMASK_CALIB;
+            break;
+
+        case TSC_STATEID_DEB_CALIB:
+            stateMask = TSC_STATEMASK_DEB_CALIB;
+            break;
+
+        case TSC_STATEID_RELEASE:
+            stateMask = TSC_STATEMASK_RELEASE;
+            break;
+
+        case TSC_STATEID_DEB_DETECT:
+            stateMask = TSC_STATEMASK_DEB_DETECT;
+            break;
+
+        case TSC_STATEID_DETECT:
+            stateMask = TSC_STATEMASK_DETECT;
+            break;
+
+        case TSC_STATEID_DEB_RELEASE_DETECT:
+            stateMask = TSC_STATEMASK_DEB_RELEASE_DETECT;
+            break;
+
+        case TSC_STATEID_ERROR:
+            stateMask = TSC_STATEMASK_ERROR;
+            break;
+
+        case TSC_STATEID_DEB_ERROR_CALIB:
+            stateMask = TSC_STATEMASK_DEB_ERROR_CALIB;
+            break;
+
+        case TSC_STATEID_DEB_ERROR_RELEASE:
+            stateMask = TSC_STATEMASK_DEB_ERROR_RELEASE;
+            break;
+
+        case TSC_STATEID_DEB_ERROR_DETECT:
+            stateMask = TSC_STATEMASK_DEB_ERROR_DETECT;
+            break;
+
+        case TSC_STATEID_OFF:
+            stateMask = TSC_STATEMASK_OFF;
+            break;
+
+        default:
+            stateMask = TSC_STATEMASK_UNKNOWN;
+            break;
+    }
+
+    return stateMask;
+}
+
+/** @defgroup Private Functions
+  @{
+*/
+
+/*!
+ * @brief       Check and clear the new measurement flag of the channels
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      TSC_TRUE if a channel has a new measurement
+ */
+static TSC_BOOL_T TSC_Matrix_TestDataReady(CONST TSC_Matrix_T *matrix)
+{
+    TSC_tIndex_T index;
+    TSC_Channel_Data_T *p_Ch = matrix->p_ChD;
+    TSC_BOOL_T retval = TSC_FALSE;
+
+    for (index = 0; index < FOR_NB_CHANNELS; index++)
+    {
+        if (p_Ch->Flag.DataReady != 0)
+        {
+            p_Ch->Flag.DataReady = TSC_DATA_NOT_READY;
+            retval = TSC_TRUE;
+        }
+        p_Ch++;
+    }
+    return retval;
+}
+
+/*!
+ * @brief       Check the acquisition status of the channels
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      TSC_TRUE if a channel has an acquisition error (min or max)
+ */
+static TSC_BOOL_T TSC_Matrix_TestAcqError(CONST TSC_Matrix_T *matrix)
+{
+    TSC_tIndex_T index;
+    TSC_Channel_Data_T *p_Ch = matrix->p_ChD;
+
+    for (index = 0; index < FOR_NB_CHANNELS; index++)
+    {
+        if (p_Ch->Flag.AcqStatus & TSC_ACQ_STATUS_ERROR_MASK)
+        {
+            return TSC_TRUE;
+        }
+        p_Ch++;
+    }
+    return TSC_FALSE;
+}
+
+/*!
+ * @brief       Check the re-calibration condition
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      TSC_TRUE if the delta of a channel is below -CalibTh
+ */
+static TSC_BOOL_T TSC_Matrix_TestCalib(CONST TSC_Matrix_T *matrix)
+{
+    TSC_tIndex_T index;
+    TSC_Channel_Data_T *p_Ch = matrix->p_ChD;
+
+    for (index = 0; index < FOR_NB_CHANNELS; index++)
+    {
+        if ((int32_t)TSC_CH_DELTA(p_Ch) <= -MATRIX_TH(FOR_CALIB_TH))
+        {
+            return TSC_TRUE;
+        }
+        p_Ch++;
+    }
+    return TSC_FALSE;
+}
+
+/*!
+ * @brief       Find the active lines (rows or columns)
+ *
+ * @param       p_Ch: Pointer to the first Channel Data of the lines
+ *
+ * @param       numLine: Number of lines
+ *
+ * @param       th: Threshold of an active line
+ *
+ * @param       p_First: Returns the line with the highest delta
+ *
+ * @param       p_Second: Returns the line with the second highest delta
+ *
+ * @retval      Number of active lines
+ *
+ * @note        p_First and p_Second are only valid when one or two lines are active.
+ */
+static TSC_tNum_T TSC_Matrix_ReadLines(TSC_Channel_Data_T *p_Ch, TSC_tNum_T numLine, int32_t th,
+                                       TSC_tIndex_T *p_First, TSC_tIndex_T *p_Second)
+{
+    TSC_tIndex_T index;
+    TSC_tNum_T   numActive = 0;
+    int32_t      delta;
+    int32_t      first = -1;
+    int32_t      second = -1;
+
+    for (index = 0; index < numLine; index++)
+    {
+        delta = TSC_CH_DELTA(p_Ch);
+
+        if (delta >= th)
+        {
+            numActive++;
+
+            if (delta > first)
+            {
+                second = first;
+                *p_Second = *p_First;
+                first = delta;
+                *p_First = index;
+            }
+            else if (delta > second)
+            {
+                second = delta;
+                *p_Second = index;
+            }
+        }
+        p_Ch++;
+    }
+    return numActive;
+}
+
+/*!
+ * @brief       Resolve the pressed key from the row and column deltas
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @param       th: Threshold of an active row or column
+ *
+ * @retval      Key index, TSC_MATRIX_NO_KEY or TSC_MATRIX_GHOST
+ *
+ * @note        Two keys on the same row (or column) resolve to the strongest one.
+ *              Two keys on different rows and columns activate 2 rows and 2 columns:
+ *              the 4 crossings are candidates and the keys can not be resolved
+ *              (ghost keys), except when the rows and the columns are adjacent as
+ *              for a single finger between 4 keys.
+ */
+static uint8_t TSC_Matrix_ReadKey(CONST TSC_Matrix_T *matrix, TSC_tThreshold_T th)
+{
+    TSC_tIndex_T row1 = 0;
+    TSC_tIndex_T row2 = 0;
+    TSC_tIndex_T col1 = 0;
+    TSC_tIndex_T col2 = 0;
+    TSC_tNum_T   numRow;
+    TSC_tNum_T   numCol;
+
+    numRow = TSC_Matrix_ReadLines(matrix->p_ChD, matrix->NumRow, MATRIX_TH(th), &row1, &row2);
+    numCol = TSC_Matrix_ReadLines(matrix->p_ChD + matrix->NumRow, matrix->NumCol, MATRIX_TH(th), &col1, &col2);
+
+    /* A key needs a row and a column */
+    if ((numRow == 0) || (numCol == 0))
+    {
+        return TSC_MATRIX_NO_KEY;
+    }
+
+    if ((numRow > 1) && (numCol > 1))
+    {
+        if ((numRow > 2) || (numCol > 2) || !MATRIX_ADJACENT(row1, row2) || !MATRIX_ADJACENT(col1, col2))
+        {
+            return TSC_MATRIX_GHOST;
+        }
+    }
+
+    return (uint8_t)(row1 * matrix->NumCol + col1);
+}
+
+/*!
+ * @brief       Set the pressed key
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @param       key: Key index or TSC_MATRIX_NO_KEY
+ *
+ * @retval      None
+ */
+static void TSC_Matrix_ConfigKey(CONST TSC_Matrix_T *matrix, uint8_t key)
+{
+    if (FOR_MATRIX_KEY != key)
+    {
+        FOR_MATRIX_KEY = key;
+        FOR_MATRIX_KEYCHANGE = TSC_STATE_CHANGED;
+    }
+}
+
+/*!
+ * @brief       Go in Error state, after the error debounce
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @param       debStateId: Error debounce state
+ *
+ * @retval      None
+ */
+static void TSC_Matrix_ConfigErrorState(CONST TSC_Matrix_T *matrix, TSC_STATEID_T debStateId)
+{
+    FOR_COUNTER_DEB = FOR_COUNTER_DEB_ERROR;
+    if (FOR_COUNTER_DEB)
+    {
+        FOR_STATEID = debStateId;
+    }
+    else
+    {
+        FOR_STATEID = TSC_STATEID_ERROR;
+        TSC_Matrix_ConfigKey(matrix, TSC_MATRIX_NO_KEY);
+    }
+}
+
+/*!
+ * @brief       Calibration state processing
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      None
+ */
+static void TSC_Matrix_ProcessCalibrationState(CONST TSC_Matrix_T *matrix)
+{
+    TSC_tMeas_T   newMeas;
+    TSC_tIndex_T  index;
+    TSC_Channel_Data_T *p_Ch;
+
+    #if TOUCH_CALIB_DELAY > 0
+    /* Noise filter stabilization time */
+    if (FOR_COUNTER_DEB > (TSC_tCounter_T)TSC_Params.NumCalibSample)
+    {
+        FOR_COUNTER_DEB--;
+        return;
+    }
+    #endif
+
+    if (TSC_Matrix_TestAcqError(matrix))
+    {
+        TSC_Matrix_ConfigErrorState(matrix, TSC_STATEID_DEB_ERROR_CALIB);
+        return;
+    }
+
+    /* Process all channels */
+    p_Ch = matrix->p_ChD;
+
+    for (index = 0; index < FOR_NB_CHANNELS; index++)
+    {
+        /* Read the new measure or Calculate it */
+        #if TOUCH_USE_MEAS > 0
+        newMeas = TSC_CH_MEAS(p_Ch);
+        #else
+        newMeas = TSC_Acq_ComputeMeas(TSC_CH_REFER(p_Ch), TSC_CH_DELTA(p_Ch));
+        #endif
+
+        /* Verify the first Reference value */
+        if (FOR_COUNTER_DEB != (TSC_tCounter_T)TSC_Params.NumCalibSample)
+        {
+            TSC_CH_REFER(p_Ch) += newMeas;
+
+            if (TSC_CH_REFER(p_Ch) < newMeas)
+            {
+                TSC_CH_REFER(p_Ch) = 0;
+                FOR_STATEID = TSC_STATEID_ERROR;
+                return;
+            }
+        }
+        else
+        {
+            if (TSC_Acq_TestFirstReference(p_Ch, newMeas))
+            {
+                TSC_CH_REFER(p_Ch) = newMeas;
+            }
+            else
+            {
+                TSC_CH_REFER(p_Ch) = 0;
+                return;
+            }
+        }
+        p_Ch++;
+    }
+
+    if (FOR_COUNTER_DEB > 0)
+    {
+        FOR_COUNTER_DEB--;
+    }
+    if (FOR_COUNTER_DEB == 0)
+    {
+        /* Process all channels */
+        p_Ch = matrix->p_ChD;
+
+        for (index = 0; index < FOR_NB_CHANNELS; index++)
+        {
+            TSC_CH_REFER(p_Ch) >>= CalibDiv;
+            p_Ch->RefRest = 0;
+            TSC_CH_DELTA(p_Ch) = 0;
+            p_Ch++;
+        }
+        FOR_STATEID = TSC_STATEID_RELEASE;
+    }
+}
+
+/*!
+ * @brief       Debounce Calibration processing (previous state = Release)
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      None
+ */
+static void TSC_Matrix_ProcessDebCalibrationState(CONST TSC_Matrix_T *matrix)
+{
+    if (TSC_Matrix_TestCalib(matrix))
+    {
+        if (FOR_COUNTER_DEB > 0)
+        {
+            FOR_COUNTER_DEB--;
+        }
+        if (FOR_COUNTER_DEB == 0)
+        {
+            TSC_Matrix_ConfigCalibrationStateCtx(matrix, 0);
+        }
+    }
+    else
+    {
+        FOR_STATEID = TSC_STATEID_RELEASE;
+    }
+}
+
+/*!
+ * @brief       Release state processing
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      None
+ */
+static void TSC_Matrix_ProcessReleaseState(CONST TSC_Matrix_T *matrix)
+{
+    uint8_t key;
+
+    if (TSC_Matrix_TestAcqError(matrix))
+    {
+        TSC_Matrix_ConfigErrorState(matrix, TSC_STATEID_DEB_ERROR_RELEASE);
+        return;
+    }
+
+    key = TSC_Matrix_ReadKey(matrix, FOR_DETECTIN_TH);
+
+    if (key < TSC_MATRIX_GHOST)
+    {
+        FOR_CANDIDATE = key;
+        FOR_COUNTER_DEB = FOR_COUNTER_DEB_DETECT;
+        if (FOR_COUNTER_DEB)
+        {
+            FOR_STATEID = TSC_STATEID_DEB_DETECT;
+        }
+        else
+        {
+            FOR_STATEID = TSC_STATEID_DETECT;
+            TSC_Matrix_ConfigKey(matrix, key);
+        }
+    }
+    else if ((key == TSC_MATRIX_NO_KEY) && TSC_Matrix_TestCalib(matrix))
+    {
+        FOR_COUNTER_DEB = FOR_COUNTER_DEB_CALIB;
+        if (FOR_COUNTER_DEB)
+        {
+            FOR_STATEID = TSC_STATEID_DEB_CALIB;
+        }
+        else
+        {
+            TSC_Matrix_ConfigCalibrationStateCtx(matrix, 0);
+        }
+    }
+}
+
+/*!
+ * @brief       Debounce Detect processing (previous state = Release)
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      None
+ *
+ * @note        The same key must be found during the whole debounce.
+ */
+static void TSC_Matrix_ProcessDebDetectState(CONST TSC_Matrix_T *matrix)
+{
+    uint8_t key;
+
+    if (TSC_Matrix_TestAcqError(matrix))
+    {
+        TSC_Matrix_ConfigErrorState(matrix, TSC_STATEID_DEB_ERROR_RELEASE);
+        return;
+    }
+
+    key = TSC_Matrix_ReadKey(matrix, FOR_DETECTIN_TH);
+
+    if (key == FOR_CANDIDATE)
+    {
+        if (FOR_COUNTER_DEB > 0)
+        {
+            FOR_COUNTER_DEB--;
+        }
+        if (FOR_COUNTER_DEB == 0)
+        {
+            FOR_STATEID = TSC_STATEID_DETECT;
+            TSC_Matrix_ConfigKey(matrix, key);
+        }
+    }
+    else if (key < TSC_MATRIX_GHOST)
+    {
+        /* Another key: restart the debounce */
+        FOR_CANDIDATE = key;
+        FOR_COUNTER_DEB = FOR_COUNTER_DEB_DETECT;
+    }
+    else
+    {
+        FOR_STATEID = TSC_STATEID_RELEASE;
+    }
+}
+
+/*!
+ * @brief       Detect state processing
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      None
+ *
+ * @note        A ghost keeps the pressed key. A move to another key is debounced
+ *              as the Detect state.
+ */
+static void TSC_Matrix_ProcessDetectState(CONST TSC_Matrix_T *matrix)
+{
+    uint8_t key;
+
+    if (TSC_Matrix_TestAcqError(matrix))
+    {
+        TSC_Matrix_ConfigErrorState(matrix, TSC_STATEID_DEB_ERROR_DETECT);
+        return;
+    }
+
+    key = TSC_Matrix_ReadKey(matrix, FOR_DETECTOUT_TH);
+
+    if (key == TSC_MATRIX_NO_KEY)
+    {
+        FOR_COUNTER_DEB = FOR_COUNTER_DEB_RELEASE;
+        if (FOR_COUNTER_DEB)
+        {
+            FOR_STATEID = TSC_STATEID_DEB_RELEASE_DETECT;
+        }
+        else
+        {
+            FOR_STATEID = TSC_STATEID_RELEASE;
+            TSC_Matrix_ConfigKey(matrix, TSC_MATRIX_NO_KEY);
+        }
+    }
+    else if ((key == FOR_MATRIX_KEY) || (key == TSC_MATRIX_GHOST))
+    {
+        FOR_CANDIDATE = FOR_MATRIX_KEY;
+    }
+    else
+    {
+        if (key != FOR_CANDIDATE)
+        {
+            FOR_CANDIDATE = key;
+            FOR_COUNTER_DEB = FOR_COUNTER_DEB_DETECT;
+        }
+        if (FOR_COUNTER_DEB > 0)
+        {
+            FOR_COUNTER_DEB--;
+        }
+        if (FOR_COUNTER_DEB == 0)
+        {
+            TSC_Matrix_ConfigKey(matrix, key);
+        }
+    }
+}
+
+/*!
+ * @brief       Debounce Release processing (previous state = Detect)
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      None
+ */
+static void TSC_Matrix_ProcessDebReleaseDetectState(CONST TSC_Matrix_T *matrix)
+{
+    if (TSC_Matrix_TestAcqError(matrix))
+    {
+        TSC_Matrix_ConfigErrorState(matrix, TSC_STATEID_DEB_ERROR_DETECT);
+        return;
+    }
+
+    if (TSC_Matrix_ReadKey(matrix, FOR_DETECTOUT_TH) == TSC_MATRIX_NO_KEY)
+    {
+        if (FOR_COUNTER_DEB > 0)
+        {
+            FOR_COUNTER_DEB--;
+        }
+        if (FOR_COUNTER_DEB == 0)
+        {
+            FOR_STATEID = TSC_STATEID_RELEASE;
+            TSC_Matrix_ConfigKey(matrix, TSC_MATRIX_NO_KEY);
+        }
+    }
+    else
+    {
+        FOR_CANDIDATE = FOR_MATRIX_KEY;
+        FOR_STATEID = TSC_STATEID_DETECT;
+    }
+}
+
+/*!
+ * @brief       Debounce Error processing
+ *
+ * @param       matrix: Pointer to the Matrix
+ *
+ * @retval      None
+ */
+static void TSC_Matrix_ProcessDebErrorState(CONST TSC_Matrix_T *matrix)
+{
+    if (TSC_Matrix_TestAcqError(matrix))
+    {
+        if (FOR_COUNTER_DEB > 0)
+        {
+            FOR_COUNTER_DEB--;
+        }
+        if (FOR_COUNTER_DEB == 0)
+        {
+            FOR_STATEID = TSC_STATEID_ERROR;
+            TSC_Matrix_ConfigKey(matrix, TSC_MATRIX_NO_KEY);
+        }
+        return;
+    }
+
+    /* The error is gone: back to the previous state */
+    switch (FOR_STATEID)
+    {
+        case TSC_STATEID_DEB_ERROR_RELEASE:
+            FOR_STATEID = TSC_STATEID_RELEASE;
+            break;
+
+        case TSC_STATEID_DEB_ERROR_DETECT:
+            FOR_STATEID = TSC_STATEID_DETECT;
+            break;
+
+        default:
+            TSC_Matrix_ConfigCalibrationStateCtx(matrix, 0);
+            break;
+    }
+}
+
+/**@} Private Functions */
+
+/**@} end of group TSC_Matrix_Functions */
+/**@} end of group TSC_Matrix_Driver */
+/**@} end of group TSC_Driver_Library */
+
+#endif /* TOUCH_TOTAL_MATRICES > 0 */
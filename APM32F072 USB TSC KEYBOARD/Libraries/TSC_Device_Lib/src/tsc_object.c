@@ -63,6 +63,16 @@
   @{
 */
 
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+static void TSC_Obj_SetScanRate(TSC_Channel_Data_T *pChD, TSC_tNum_T numChannel, TSC_tNum_T stateMask);
+#endif
+#if TOUCH_USE_EVENT > 0
+static void TSC_Obj_UpdateEvent(TSC_ObjectGroup_T *objgrp, TSC_tIndex_T idxObj, TSC_tNum_T stateMask);
+#if TOUCH_TOTAL_MATRICES > 0
+static void TSC_Obj_UpdateMatrixEvent(TSC_ObjectGroup_T *objgrp, TSC_tIndex_T idxObj, uint8_t prevKey, uint8_t key);
+#endif
+#endif
+
 /*!
  * @brief       Config a group of Objects
  *
@@ -78,6 +88,10 @@ void TSC_Obj_ConfigGroup(TSC_ObjectGroup_T *objgrp)
 
     pObj = objgrp->p_Obj;
     objgrp->Change = TSC_STATE_NOT_CHANGED;
+#if TOUCH_USE_EVENT > 0
+    objgrp->PressMask = 0;
+    objgrp->ChangeMask = 0;
+#endif
 
     /* Process all objects */
     for (idxObj = 0; idxObj < objgrp->NbObjects; idxObj++)
@@ -134,6 +148,18 @@ void TSC_Obj_ConfigGroup(TSC_ObjectGroup_T *objgrp)
             stateMask |= TSC_Params.p_LinRotSta[TSC_Globals.For_LinRot->p_Data->StateId].StateMask;
             #endif
         }
+        else if(pObj->Type == TSC_OBJ_MATRIX)
+        {
+            #if TOUCH_TOTAL_MATRICES > 0
+            TSC_Matrix_ConfigCtx(TSC_Globals.For_Matrix);
+
+            if (TSC_Globals.For_Matrix->p_Data->Change)
+            {
+                objgrp->Change = TSC_STATE_CHANGED;
+            }
+            stateMask |= TSC_Matrix_ReadStateMaskCtx(TSC_Globals.For_Matrix);
+            #endif
+        }
         pObj++;
     }
     /* Update the object group state mask */
@@ -152,44 +178,87 @@ void TSC_Obj_ProcessGroup(TSC_ObjectGroup_T *objgrp)
     TSC_tIndex_T idxObj;
     CONST TSC_Object_T *pObj;
     TSC_tNum_T stateMask = 0;
+    TSC_tNum_T objStateMask;
+#if TOUCH_TOTAL_KEYS > 0
+    CONST TSC_TouchKey_T *key;
+#endif
+#if TOUCH_TOTAL_MATRICES > 0
+    CONST TSC_Matrix_T *matrix;
+#if TOUCH_USE_EVENT > 0
+    uint8_t prevKey;
+#endif
+#endif
 
     pObj = objgrp->p_Obj;
     objgrp->Change = TSC_STATE_NOT_CHANGED;
+#if TOUCH_USE_EVENT > 0
+    objgrp->ChangeMask = 0;
+#endif
 
     /* Process all objects */
     for (idxObj = 0; idxObj < objgrp->NbObjects; idxObj++)
     {
-        TSC_Obj_ConfigGlobalObj(pObj);
+        objStateMask = TSC_STATEMASK_UNKNOWN;
 
         if(pObj->Type == TSC_OBJ_TOUCHKEY)
         {
             #if TOUCH_TOTAL_TOUCHKEYS > 0
-            TSC_Globals.For_Key->p_Methods->Process();
+            key = (CONST TSC_TouchKey_T *)pObj->MyObj;
 
-            if (TSC_Globals.For_Key->p_Data->Change)
+            /* The library method does not need the global object */
+            if (key->p_Methods->Process == TSC_TouchKey_Process)
+            {
+                TSC_TouchKey_ProcessCtx(pObj);
+            }
+            else
+            {
+                TSC_Obj_ConfigGlobalObj(pObj);
+                key->p_Methods->Process();
+            }
+
+            if (key->p_Data->Change)
             {
                 objgrp->Change = TSC_STATE_CHANGED;
             }
 
-            stateMask |= TSC_Globals.For_Key->p_SM[TSC_Globals.For_Key->p_Data->StateId].StateMask;
+            objStateMask = key->p_SM[key->p_Data->StateId].StateMask;
+
+            #if TOUCH_USE_ACQ_INTERRUPT > 0
+            TSC_Obj_SetScanRate(key->p_ChD, 1, objStateMask);
+            #endif
             #endif
         }
         else if(pObj->Type == TSC_OBJ_TOUCHKEYB)
         {
             #if TOUCH_TOTAL_TOUCHKEYS_B > 0
-            TSC_Params.p_KeyMet->Process();
+            key = (CONST TSC_TouchKey_T *)pObj->MyObj;
 
-            if (TSC_Globals.For_Key->p_Data->Change)
+            if (TSC_Params.p_KeyMet->Process == TSC_TouchKey_Process)
+            {
+                TSC_TouchKey_ProcessCtx(pObj);
+            }
+            else
+            {
+                TSC_Obj_ConfigGlobalObj(pObj);
+                TSC_Params.p_KeyMet->Process();
+            }
+
+            if (key->p_Data->Change)
             {
                 objgrp->Change = TSC_STATE_CHANGED;
             }
 
-            stateMask |= TSC_Params.p_KeySta[TSC_Globals.For_Key->p_Data->StateId].StateMask;
+            objStateMask = TSC_Params.p_KeySta[key->p_Data->StateId].StateMask;
+
+            #if TOUCH_USE_ACQ_INTERRUPT > 0
+            TSC_Obj_SetScanRate(key->p_ChD, 1, objStateMask);
+            #endif
             #endif
         }
         else if((pObj->Type == TSC_OBJ_LINEAR)||(pObj->Type == TSC_OBJ_ROTARY))
         {
             #if TOUCH_TOTAL_LINROTS > 0
+            TSC_Obj_ConfigGlobalObj(pObj);
             TSC_Globals.For_LinRot->p_Methods->Process();
 
             if (TSC_Globals.For_LinRot->p_Data->Change)
@@ -197,12 +266,17 @@ void TSC_Obj_ProcessGroup(TSC_ObjectGroup_T *objgrp)
                 objgrp->Change = TSC_STATE_CHANGED;
             }
 
-            stateMask |= TSC_Globals.For_LinRot->p_SM[TSC_Globals.For_LinRot->p_Data->StateId].StateMask;
+            objStateMask = TSC_Globals.For_LinRot->p_SM[TSC_Globals.For_LinRot->p_Data->StateId].StateMask;
+
+            #if TOUCH_USE_ACQ_INTERRUPT > 0
+            TSC_Obj_SetScanRate(TSC_Globals.For_LinRot->p_ChD, TSC_Globals.For_LinRot->NumChannel, objStateMask);
+            #endif
             #endif
         }
         else if((pObj->Type == TSC_OBJ_LINEARB)||(pObj->Type == TSC_OBJ_ROTARYB))
         {
             #if TOUCH_TOTAL_LINROTS_B > 0
+            TSC_Obj_ConfigGlobalObj(pObj);
             TSC_Params.p_LinRotMet->Process();
 
             if (TSC_Globals.For_LinRot->p_Data->Change)
@@ -210,9 +284,48 @@ void TSC_Obj_ProcessGroup(TSC_ObjectGroup_T *objgrp)
                 objgrp->Change = TSC_STATE_CHANGED;
             }
 
-            stateMask |= TSC_Params.p_LinRotSta[TSC_Globals.For_LinRot->p_Data->StateId].StateMask;
+            objStateMask = TSC_Params.p_LinRotSta[TSC_Globals.For_LinRot->p_Data->StateId].StateMask;
+
+            #if TOUCH_USE_ACQ_INTERRUPT > 0
+            TSC_Obj_SetScanRate(TSC_Globals.For_LinRot->p_ChD, TSC_Globals.For_LinRot->NumChannel, objStateMask);
+            #endif
+            #endif
+        }
+        else if(pObj->Type == TSC_OBJ_MATRIX)
+        {
+            #if TOUCH_TOTAL_MATRICES > 0
+            matrix = (CONST TSC_Matrix_T *)pObj->MyObj;
+            #if TOUCH_USE_EVENT > 0
+            prevKey = matrix->p_Data->Key;
+            #endif
+
+            TSC_Matrix_ProcessCtx(matrix);
+
+            if (matrix->p_Data->Change)
+            {
+                objgrp->Change = TSC_STATE_CHANGED;
+            }
+
+            objStateMask = TSC_Matrix_ReadStateMaskCtx(matrix);
+
+            #if TOUCH_USE_ACQ_INTERRUPT > 0
+            TSC_Obj_SetScanRate(matrix->p_ChD, matrix->NumRow + matrix->NumCol, objStateMask);
+            #endif
+
+            #if TOUCH_USE_EVENT > 0
+            /* One event per key of the Matrix */
+            TSC_Obj_UpdateMatrixEvent(objgrp, idxObj, prevKey, matrix->p_Data->Key);
             #endif
+            #endif
+        }
+        stateMask |= objStateMask;
+
+#if TOUCH_USE_EVENT > 0
+        if (pObj->Type != TSC_OBJ_MATRIX)
+        {
+            TSC_Obj_UpdateEvent(objgrp, idxObj, objStateMask);
         }
+#endif
         pObj++;
     }
     /* Update the object group state mask */
@@ -243,7 +356,122 @@ void TSC_Obj_ConfigGlobalObj(CONST TSC_Object_T *pObj)
         TSC_Globals.For_LinRot = (TSC_LinRot_T *)pObj->MyObj;
         #endif
     }
+    else if(pObj->Type == TSC_OBJ_MATRIX)
+    {
+        #if TOUCH_TOTAL_MATRICES > 0
+        TSC_Globals.For_Matrix = (TSC_Matrix_T *)pObj->MyObj;
+        #endif
+    }
+}
+
+#if TOUCH_USE_ACQ_INTERRUPT > 0
+/*!
+ * @brief       Set the scan rate of the channels of an Object (private routine)
+ *
+ * @param       pChD: Pointer to the first Channel Data of the Object
+ *
+ * @param       numChannel: Number of channels of the Object
+ *
+ * @param       stateMask: State mask of the Object
+ *
+ * @retval      None
+ *
+ * @note        The channels of a released Object (or in error) are acquired at the idle rate.
+ */
+static void TSC_Obj_SetScanRate(TSC_Channel_Data_T *pChD, TSC_tNum_T numChannel, TSC_tNum_T stateMask)
+{
+    TSC_tNum_T idxChannel;
+    unsigned int idle = ((stateMask & TSC_STATEMASK_ACTIVE) == 0);
+
+    for (idxChannel = 0; idxChannel < numChannel; idxChannel++)
+    {
+        pChD[idxChannel].Flag.ScanIdle = idle;
+    }
+}
+#endif
+
+#if TOUCH_USE_EVENT > 0
+/*!
+ * @brief       Update the pressed objects of a group and write the events (private routine)
+ *
+ * @param       objgrp: Pointer to the group of objects
+ *
+ * @param       idxObj: Index of the object in the group
+ *
+ * @param       stateMask: State mask of the object
+ *
+ * @retval      None
+ *
+ * @note        The object is pressed in the Detect and Touch states and released when it
+ *              leaves them. The debounce states between them keep the previous status.
+ */
+static void TSC_Obj_UpdateEvent(TSC_ObjectGroup_T *objgrp, TSC_tIndex_T idxObj, TSC_tNum_T stateMask)
+{
+    uint32_t bit = (uint32_t)1 << idxObj;
+    uint32_t pressed;
+
+    if ((stateMask & TSC_EVENT_PRESS_MASK) == 0)
+    {
+        pressed = 0;
+    }
+    else if ((stateMask & TSC_STATE_DEBOUNCE_BIT_MASK) == 0)
+    {
+        pressed = bit;
+    }
+    else
+    {
+        return;
+    }
+
+    if ((objgrp->PressMask & bit) != pressed)
+    {
+        objgrp->PressMask ^= bit;
+        objgrp->ChangeMask |= bit;
+        TSC_Event_Write(pressed ? TSC_EVENT_PRESS : TSC_EVENT_RELEASE, idxObj, 0);
+    }
+}
+
+#if TOUCH_TOTAL_MATRICES > 0
+/*!
+ * @brief       Update a Matrix of a group and write the events of its keys (private routine)
+ *
+ * @param       objgrp: Pointer to the group of objects
+ *
+ * @param       idxObj: Index of the Matrix in the group
+ *
+ * @param       prevKey: Key before the processing of the Matrix
+ *
+ * @param       key: Key after the processing of the Matrix
+ *
+ * @retval      None
+ *
+ * @note        A move from a key to another one writes the release of the previous
+ *              key then the press of the new key.
+ */
+static void TSC_Obj_UpdateMatrixEvent(TSC_ObjectGroup_T *objgrp, TSC_tIndex_T idxObj, uint8_t prevKey, uint8_t key)
+{
+    uint32_t bit = (uint32_t)1 << idxObj;
+
+    if (key == prevKey)
+    {
+        return;
+    }
+
+    objgrp->ChangeMask |= bit;
+
+    if (prevKey != TSC_MATRIX_NO_KEY)
+    {
+        objgrp->PressMask &= ~bit;
+        TSC_Event_Write(TSC_EVENT_RELEASE, idxObj, prevKey);
+    }
+    if (key != TSC_MATRIX_NO_KEY)
+    {
+        objgrp->PressMask |= bit;
+        TSC_Event_Write(TSC_EVENT_PRESS, idxObj, key);
+    }
 }
+#endif
+#endif
 
 /**@} end of group TSC_Object_Functions */
 /**@} end of group TSC_Object_Driver */
@@ -0,0 +1,323 @@
+/*!
+ * @file        tsc_recovery.c
+ *
+ * @brief       This file contains all functions to isolate the TouchKeys in error and recalibrate them later.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "tsc.h"
+#include "tsc_recovery.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Recovery_Driver TSC Recovery Driver
+  @{
+*/
+
+/** @defgroup TSC_Recovery_Macros Macros
+  @{
+*/
+
+#if TOUCH_USE_RECOVERY > 0
+
+/**@} end of group TSC_Recovery_Macros */
+
+/** @defgroup TSC_Recovery_Enumerations Enumerations
+  @{
+*/
+
+/**@} end of group TSC_Recovery_Enumerations */
+
+/** @defgroup TSC_Recovery_Structures Structures
+  @{
+*/
+
+/**@} end of group TSC_Recovery_Structures */
+
+/** @defgroup TSC_Recovery_Variables Variables
+  @{
+*/
+
+/* Group of the TouchKeys */
+static CONST TSC_ObjectGroup_T *RecovGroup;
+/* Diagnostics of each object of the group */
+static TSC_Fault_T              RecovFault[TOUCH_TOTAL_OBJECTS];
+/* Tick_sec of the Error state (Off) or of the last unstable state (Retry) */
+static __IO TSC_tTick_sec_T     RecovLastTick[TOUCH_TOTAL_OBJECTS];
+/* Objects not in TSC_RECOV_STATE_OK (bit = object index, TOUCH_TOTAL_OBJECTS <= 32) */
+static uint32_t                 RecovFaults;
+
+/**@} end of group TSC_Recovery_Variables */
+
+/** @defgroup TSC_Recovery_Functions Functions
+  @{
+*/
+
+static TSC_STATUS_T TSC_Recovery_ReadIndex(CONST TSC_Object_T *pObj, TSC_tIndex_T *idxObj);
+
+/*!
+ * @brief       Config the recovery of the TouchKeys in error
+ *
+ * @param       objgrp: Group of the TouchKeys using the recovery state functions
+ *
+ * @retval      None
+ */
+void TSC_Recovery_Config(CONST TSC_ObjectGroup_T *objgrp)
+{
+    TSC_tIndex_T idxObj;
+
+    RecovGroup = objgrp;
+    RecovFaults = 0;
+
+    for (idxObj = 0; idxObj < TOUCH_TOTAL_OBJECTS; idxObj++)
+    {
+        RecovFault[idxObj].State = TSC_RECOV_STATE_OK;
+        RecovFault[idxObj].Errors = 0;
+        RecovFault[idxObj].Delay = TOUCH_RECOV_DELAY_MIN;
+        RecovFault[idxObj].AcqStatus = TSC_ACQ_STATUS_OK;
+    }
+}
+
+/*!
+ * @brief       Error state function: isolate the TouchKey
+ *
+ * @param       pObj: Pointer to the TouchKey object
+ *
+ * @retval      None
+ *
+ * @note        The TouchKey goes in Off state, its channel is no more acquired and the other
+ *              objects are still processed. Each Error state before TOUCH_RECOV_STABLE_SEC
+ *              of stable recalibration doubles the recalibration delay, up to TOUCH_RECOV_DELAY_MAX.
+ */
+void TSC_Recovery_ProcessErrorStateCtx(CONST TSC_Object_T *pObj)
+{
+    CONST TSC_TouchKey_T *key = (CONST TSC_TouchKey_T *)pObj->MyObj;
+    TSC_Fault_T *fault;
+    TSC_tIndex_T idxObj;
+
+    TSC_TouchKey_ConfigOffStateCtx(key);
+
+    if (TSC_Recovery_ReadIndex(pObj, &idxObj) != TSC_STATUS_OK)
+    {
+        return;
+    }
+
+    fault = &RecovFault[idxObj];
+
+    if (fault->State == TSC_RECOV_STATE_RETRY)
+    {
+        fault->Delay = (uint8_t)(fault->Delay << 1);
+        if (fault->Delay > TOUCH_RECOV_DELAY_MAX)
+        {
+            fault->Delay = TOUCH_RECOV_DELAY_MAX;
+        }
+    }
+
+    if (fault->Errors < 255)
+    {
+        fault->Errors++;
+    }
+    fault->AcqStatus = (uint8_t)key->p_ChD->Flag.AcqStatus;
+    fault->State = TSC_RECOV_STATE_OFF;
+    RecovLastTick[idxObj] = TSC_Globals.Tick_sec;
+    RecovFaults |= (uint32_t)1 << idxObj;
+}
+
+/*!
+ * @brief       Error state function: isolate the TouchKey
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Obj).
+ */
+void TSC_Recovery_ProcessErrorState(void)
+{
+    TSC_Recovery_ProcessErrorStateCtx(TSC_Globals.For_Obj);
+}
+
+/*!
+ * @brief       Off state function: recalibrate the TouchKey after the recovery delay
+ *
+ * @param       pObj: Pointer to the TouchKey object
+ *
+ * @retval      None
+ *
+ * @note        The TouchKeys turned off by the application are left off.
+ */
+void TSC_Recovery_ProcessOffStateCtx(CONST TSC_Object_T *pObj)
+{
+    TSC_Fault_T *fault;
+    TSC_tIndex_T idxObj;
+
+    if (TSC_Recovery_ReadIndex(pObj, &idxObj) != TSC_STATUS_OK)
+    {
+        return;
+    }
+
+    fault = &RecovFault[idxObj];
+
+    if (fault->State != TSC_RECOV_STATE_OFF)
+    {
+        return;
+    }
+
+    if (TSC_Time_Delay_sec(fault->Delay, &RecovLastTick[idxObj]) == TSC_STATUS_OK)
+    {
+        fault->State = TSC_RECOV_STATE_RETRY;
+        TSC_TouchKey_ConfigCalibrationStateCtx((CONST TSC_TouchKey_T *)pObj->MyObj, TOUCH_CALIB_DELAY);
+    }
+}
+
+/*!
+ * @brief       Off state function: recalibrate the TouchKey after the recovery delay
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Obj).
+ */
+void TSC_Recovery_ProcessOffState(void)
+{
+    TSC_Recovery_ProcessOffStateCtx(TSC_Globals.For_Obj);
+}
+
+/*!
+ * @brief       Check the recalibrated TouchKeys
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Called after TSC_Obj_ProcessGroup(). A recalibrated TouchKey out of the
+ *              Calibration and Error states for TOUCH_RECOV_STABLE_SEC is recovered:
+ *              its recalibration delay comes back to TOUCH_RECOV_DELAY_MIN.
+ */
+void TSC_Recovery_Process(void)
+{
+    CONST TSC_TouchKey_T *key;
+    TSC_STATEID_T stateId;
+    TSC_tIndex_T idxObj;
+
+    if ((RecovFaults == 0) || (RecovGroup == 0))
+    {
+        return;
+    }
+
+    for (idxObj = 0; (idxObj < RecovGroup->NbObjects) && (idxObj < TOUCH_TOTAL_OBJECTS); idxObj++)
+    {
+        if (RecovFault[idxObj].State != TSC_RECOV_STATE_RETRY)
+        {
+            continue;
+        }
+
+        key = (CONST TSC_TouchKey_T *)RecovGroup->p_Obj[idxObj].MyObj;
+        stateId = TSC_TouchKey_ReadStateIdCtx(key);
+
+        if ((stateId < TSC_STATEID_RELEASE) || (stateId >= TSC_STATEID_ERROR))
+        {
+            RecovLastTick[idxObj] = TSC_Globals.Tick_sec;
+        }
+        else if (TSC_Time_Delay_sec(TOUCH_RECOV_STABLE_SEC, &RecovLastTick[idxObj]) == TSC_STATUS_OK)
+        {
+            RecovFault[idxObj].State = TSC_RECOV_STATE_OK;
+            RecovFault[idxObj].Delay = TOUCH_RECOV_DELAY_MIN;
+            RecovFaults &= ~((uint32_t)1 << idxObj);
+        }
+    }
+}
+
+/*!
+ * @brief       Read the objects in fault
+ *
+ * @param       None
+ *
+ * @retval      Objects not in TSC_RECOV_STATE_OK (bit = object index)
+ */
+uint32_t TSC_Recovery_ReadFaults(void)
+{
+    return RecovFaults;
+}
+
+/*!
+ * @brief       Read the fault diagnostics of an object
+ *
+ * @param       idxObj: Index of the object in the group
+ *
+ * @param       fault: Pointer to the diagnostics
+ *
+ * @retval      TSC_STATUS_OK or TSC_STATUS_ERROR if the index is out of the group
+ */
+TSC_STATUS_T TSC_Recovery_Read(TSC_tIndex_T idxObj, TSC_Fault_T *fault)
+{
+    if ((RecovGroup == 0) || (idxObj >= RecovGroup->NbObjects) || (idxObj >= TOUCH_TOTAL_OBJECTS))
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    *fault = RecovFault[idxObj];
+
+    return TSC_STATUS_OK;
+}
+
+/*!
+ * @brief       Read the index of an object in the group (private routine)
+ *
+ * @param       pObj: Pointer to the object
+ *
+ * @param       idxObj: Pointer to the index
+ *
+ * @retval      TSC_STATUS_OK or TSC_STATUS_ERROR if the object is not a TouchKey of the group
+ *              or TSC_Recovery_Config() has not been called
+ */
+static TSC_STATUS_T TSC_Recovery_ReadIndex(CONST TSC_Object_T *pObj, TSC_tIndex_T *idxObj)
+{
+    if (RecovGroup == 0)
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    if ((pObj < RecovGroup->p_Obj) || (pObj >= &RecovGroup->p_Obj[RecovGroup->NbObjects]) ||
+        ((pObj - RecovGroup->p_Obj) >= TOUCH_TOTAL_OBJECTS))
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    if ((pObj->Type != TSC_OBJ_TOUCHKEY) && (pObj->Type != TSC_OBJ_TOUCHKEYB))
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    *idxObj = (TSC_tIndex_T)(pObj - RecovGroup->p_Obj);
+
+    return TSC_STATUS_OK;
+}
+
+#endif /* TOUCH_USE_RECOVERY > 0 */
+
+/**@} end of group TSC_Recovery_Functions */
+/**@} end of group TSC_Recovery_Driver */
+/**@} end of group TSC_Driver_Library */
@@ -0,0 +1,574 @@
+/*!
+ * @file        tsc_snapshot.c
+ *
+ * @brief       This file contains all functions to save and restore the calibration in flash.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "tsc.h"
+#include "tsc_snapshot.h"
+#include "apm32f0xx_fmc.h"
+#include "apm32f0xx_crc.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Snapshot_Driver TSC Snapshot Driver
+  @{
+*/
+
+/** @defgroup TSC_Snapshot_Macros Macros
+  @{
+*/
+
+#if TOUCH_USE_SNAPSHOT > 0
+
+/* Address of a record in the flash page */
+#define SNAP_RECORD(idx)  ((CONST TSC_Snapshot_T *)(TOUCH_SNAPSHOT_PAGE_ADDR + ((uint32_t)(idx) * sizeof(TSC_Snapshot_T))))
+
+/* Fields of the channel words */
+#define SNAP_REFER(w)         ((TSC_tRefer_T)((w) & 0xFFFF))
+#define SNAP_REFREST(w)       ((TSC_tRefRest_T)(((w) >> 16) & 0xFF))
+#define SNAP_NOISE_COUNT(w)   ((uint8_t)((w) >> 24))
+
+/* CTRL register fields of the pulse generator: CTPHSEL, CTPLSEL, SSERRVSEL, SSEN, SSCDFSEL and PGCDFSEL */
+#define SNAP_CTRL_MASK        (0xFFFFF000)
+
+/**@} end of group TSC_Snapshot_Macros */
+
+/** @defgroup TSC_Snapshot_Enumerations Enumerations
+  @{
+*/
+
+/**@} end of group TSC_Snapshot_Enumerations */
+
+/** @defgroup TSC_Snapshot_Structures Structures
+  @{
+*/
+
+/**@} end of group TSC_Snapshot_Structures */
+
+/** @defgroup TSC_Snapshot_Variables Variables
+  @{
+*/
+
+/* Copy of the last record of the flash page */
+static TSC_Snapshot_T Snap;
+/* Record being built by TSC_Snap_Save() */
+static TSC_Snapshot_T SnapWork;
+/* Index of the next free record */
+static TSC_tNum_T     SnapNext;
+/* Snap holds a valid record */
+static uint8_t        SnapStored;
+/* Snap is waiting to be checked against the first frames */
+static uint8_t        SnapRestore;
+/* Number of frames matching the snapshot */
+static uint8_t        SnapCheck;
+
+/**@} end of group TSC_Snapshot_Variables */
+
+/** @defgroup TSC_Snapshot_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Select the channels of an object
+ *
+ * @param       pObj: Pointer to the object
+ *
+ * @param       p_Ch: Returns the first channel of the object
+ *
+ * @retval      Number of channels of the object
+ *
+ * @note        The object becomes the current global object.
+ */
+static TSC_tNum_T TSC_Snap_ConfigObj(CONST TSC_Object_T *pObj, TSC_Channel_Data_T **p_Ch)
+{
+    TSC_tNum_T numChannel = 0;
+
+    TSC_Obj_ConfigGlobalObj(pObj);
+
+    switch (FOR_OBJ_TYPE)
+    {
+        #if TOUCH_TOTAL_KEYS > 0
+        case TSC_OBJ_TOUCHKEY:
+        case TSC_OBJ_TOUCHKEYB:
+            numChannel = 1;
+            *p_Ch = TSC_Globals.For_Key->p_ChD;
+            break;
+        #endif
+
+        #if TOUCH_TOTAL_LNRTS > 0
+        case TSC_OBJ_LINEAR:
+        case TSC_OBJ_LINEARB:
+        case TSC_OBJ_ROTARY:
+        case TSC_OBJ_ROTARYB:
+            numChannel = FOR_LINROT_NB_CHANNELS;
+            *p_Ch = TSC_Globals.For_LinRot->p_ChD;
+            break;
+        #endif
+
+        #if TOUCH_TOTAL_MATRICES > 0
+        case TSC_OBJ_MATRIX:
+            numChannel = FOR_MATRIX_NB_CHANNELS;
+            *p_Ch = TSC_Globals.For_Matrix->p_ChD;
+            break;
+        #endif
+        default:
+            break;
+    }
+
+    return numChannel;
+}
+
+/*!
+ * @brief       Return the state of the current global object
+ *
+ * @param       None
+ *
+ * @retval      State id
+ */
+static TSC_STATEID_T TSC_Snap_ReadStateId(void)
+{
+    #if TOUCH_TOTAL_LNRTS > 0
+    if (FOR_OBJ_TYPE & TSC_OBJ_TYPE_LINROT_MASK)
+    {
+        return FOR_LINROT_STATEID;
+    }
+    #endif
+
+    #if TOUCH_TOTAL_MATRICES > 0
+    if (FOR_OBJ_TYPE & TSC_OBJ_TYPE_MATRIX_MASK)
+    {
+        return FOR_MATRIX_STATEID;
+    }
+    #endif
+
+    #if TOUCH_TOTAL_KEYS > 0
+    return FOR_KEY_STATEID;
+    #else
+    return TSC_STATEID_OFF;
+    #endif
+}
+
+/*!
+ * @brief       Return the measure of a channel
+ *
+ * @param       p_Ch: Pointer to the channel data
+ *
+ * @retval      Measure
+ */
+static TSC_tMeas_T TSC_Snap_ReadMeas(TSC_Channel_Data_T *p_Ch)
+{
+    #if TOUCH_USE_MEAS > 0
+    return TSC_CH_MEAS(p_Ch);
+    #else
+    return TSC_Acq_ComputeMeas(TSC_CH_REFER(p_Ch), TSC_CH_DELTA(p_Ch));
+    #endif
+}
+
+/*!
+ * @brief       Calculate the CRC of a record with the CRC unit
+ *
+ * @param       rec: Pointer to the record (RAM or flash)
+ *
+ * @retval      CRC32 of all words except the CRC
+ */
+static uint32_t TSC_Snap_CalculateCrc(CONST TSC_Snapshot_T *rec)
+{
+    CRC_ResetDATA();
+    return CRC_CalculateBlockCRC((uint32_t *)rec, TSC_SNAP_RECORD_WORDS - 1);
+}
+
+/*!
+ * @brief       Check if a record of the flash page is erased
+ *
+ * @param       rec: Pointer to the record
+ *
+ * @retval      TSC_TRUE if all words are erased
+ */
+static TSC_BOOL_T TSC_Snap_TestErased(CONST TSC_Snapshot_T *rec)
+{
+    CONST uint32_t *p_Word = (CONST uint32_t *)rec;
+    TSC_tNum_T     idx;
+
+    for (idx = 0; idx < TSC_SNAP_RECORD_WORDS; idx++)
+    {
+        if (p_Word[idx] != 0xFFFFFFFF)
+        {
+            return TSC_FALSE;
+        }
+    }
+    return TSC_TRUE;
+}
+
+/*!
+ * @brief       Read the last valid snapshot of the flash page
+ *
+ * @param       objgrp: Pointer to the objects group
+ *
+ * @retval      Status (TSC_STATUS_ERROR if there is no valid snapshot)
+ *
+ * @note        Must be called once after TSC_Obj_ConfigGroup(). The records are written
+ *              one after the other in the page (wear leveling), the page is erased only
+ *              when it is full. A record is valid when its header matches the group and
+ *              its CRC is correct, so a record interrupted by a reset is skipped. The
+ *              records are in the order of the saves, the last valid one is the newest.
+ */
+TSC_STATUS_T TSC_Snap_Config(TSC_ObjectGroup_T *objgrp)
+{
+    CONST TSC_Object_T  *pObj;
+    CONST TSC_Snapshot_T *rec;
+    TSC_Channel_Data_T  *p_Ch = 0;
+    TSC_tIndex_T        idxObj;
+    TSC_tNum_T          numChannel = 0;
+    TSC_tNum_T          idx;
+    uint32_t            header;
+
+    RCM_EnableAHBPeriphClock(RCM_AHB_PERIPH_CRC);
+    CRC_Reset();
+
+    /* Number of channels of the group */
+    pObj = objgrp->p_Obj;
+    for (idxObj = 0; idxObj < objgrp->NbObjects; idxObj++)
+    {
+        numChannel += TSC_Snap_ConfigObj(pObj, &p_Ch);
+        pObj++;
+    }
+    header = (TSC_SNAP_MAGIC << 16) | ((uint32_t)numChannel << 8);
+
+    SnapStored = 0;
+    SnapRestore = 0;
+    SnapCheck = 0;
+
+    for (idx = 0; idx < TSC_SNAP_NUM_RECORDS; idx++)
+    {
+        rec = SNAP_RECORD(idx);
+
+        /* The records are contiguous, the first erased one ends the list */
+        if (TSC_Snap_TestErased(rec) == TSC_TRUE)
+        {
+            break;
+        }
+
+        if (((rec->Header & 0xFFFFFF00) == header) && (rec->Crc == TSC_Snap_CalculateCrc(rec)))
+        {
+            Snap = *rec;
+            SnapStored = 1;
+        }
+    }
+    SnapNext = idx;
+
+    if ((SnapStored == 0) || (numChannel > TOUCH_TOTAL_CHANNELS))
+    {
+        SnapStored = 0;
+        return TSC_STATUS_ERROR;
+    }
+
+    SnapRestore = 1;
+    return TSC_STATUS_OK;
+}
+
+/*!
+ * @brief       Apply the pulse generator settings of the saved calibration
+ *
+ * @param       None
+ *
+ * @retval      Status (TSC_STATUS_ERROR if there is no valid snapshot, the settings are kept)
+ *
+ * @note        Must be called after TSC_Config() while the acquisition is stopped. The saved
+ *              References are only valid with these settings: the startup tuning is not needed
+ *              when this function returns TSC_STATUS_OK.
+ */
+TSC_STATUS_T TSC_Snap_ConfigCtrl(void)
+{
+    if (SnapRestore == 0)
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    TSC->CTRL = (TSC->CTRL & ~SNAP_CTRL_MASK) | (Snap.Ctrl & SNAP_CTRL_MASK);
+    return TSC_STATUS_OK;
+}
+
+/*!
+ * @brief       Restore the snapshot if it matches the first frames
+ *              To be called after each frame and before TSC_Obj_ProcessGroup(), as long
+ *              as it returns TSC_STATUS_BUSY.
+ *
+ * @param       objgrp: Pointer to the objects group
+ *
+ * @retval      Status
+ *              - TSC_STATUS_BUSY: the snapshot is being checked
+ *              - TSC_STATUS_OK: the snapshot is restored, all objects are in Release state
+ *              - TSC_STATUS_ERROR: no snapshot or not matching, the normal calibration goes on
+ *
+ * @note        The objects calibrate in parallel during the check, so a rejected
+ *              snapshot does not delay the calibration. Each measure must be within
+ *              TOUCH_SNAPSHOT_MATCH_TH of the saved Reference during
+ *              TOUCH_SNAPSHOT_CHECK_SAMPLES frames.
+ */
+TSC_STATUS_T TSC_Snap_ProcessRestore(TSC_ObjectGroup_T *objgrp)
+{
+    CONST TSC_Object_T  *pObj;
+    TSC_Channel_Data_T  *p_Ch = 0;
+    TSC_tIndex_T        idxObj;
+    TSC_tIndex_T        idxChannel;
+    TSC_tNum_T          numChannel;
+    TSC_tNum_T          idx = 0;
+    TSC_tMeas_T         meas;
+    TSC_tRefer_T        refer;
+    uint32_t            word;
+
+    if (SnapRestore == 0)
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    /* The References have been measured with other pulse generator settings */
+    if ((TSC->CTRL & SNAP_CTRL_MASK) != Snap.Ctrl)
+    {
+        SnapRestore = 0;
+        return TSC_STATUS_ERROR;
+    }
+
+    /* Compare the measures with the saved References */
+    pObj = objgrp->p_Obj;
+    for (idxObj = 0; idxObj < objgrp->NbObjects; idxObj++)
+    {
+        numChannel = TSC_Snap_ConfigObj(pObj, &p_Ch);
+
+        /* Too late, the calibration is finished */
+        if (TSC_Snap_ReadStateId() != TSC_STATEID_CALIB)
+        {
+            SnapRestore = 0;
+            return TSC_STATUS_ERROR;
+        }
+
+        for (idxChannel = 0; idxChannel < numChannel; idxChannel++)
+        {
+            meas = TSC_Snap_ReadMeas(p_Ch);
+            refer = SNAP_REFER(Snap.Channel[2 * idx]);
+
+            if ((p_Ch->Flag.AcqStatus & TSC_ACQ_STATUS_ERROR_MASK) ||
+                (meas > refer + TOUCH_SNAPSHOT_MATCH_TH) || (meas + TOUCH_SNAPSHOT_MATCH_TH < refer))
+            {
+                SnapRestore = 0;
+                return TSC_STATUS_ERROR;
+            }
+            p_Ch++;
+            idx++;
+        }
+        pObj++;
+    }
+
+    SnapCheck++;
+    if (SnapCheck < TOUCH_SNAPSHOT_CHECK_SAMPLES)
+    {
+        return TSC_STATUS_BUSY;
+    }
+
+    /* Matching: load the References and go in Release state */
+    idx = 0;
+    pObj = objgrp->p_Obj;
+    for (idxObj = 0; idxObj < objgrp->NbObjects; idxObj++)
+    {
+        numChannel = TSC_Snap_ConfigObj(pObj, &p_Ch);
+
+        for (idxChannel = 0; idxChannel < numChannel; idxChannel++)
+        {
+            word = Snap.Channel[2 * idx];
+            meas = TSC_Snap_ReadMeas(p_Ch);
+            TSC_CH_REFER(p_Ch) = SNAP_REFER(word);
+            p_Ch->RefRest = SNAP_REFREST(word);
+            TSC_CH_DELTA(p_Ch) = TSC_Acq_ComputeDelta(TSC_CH_REFER(p_Ch), meas);
+
+            #if (TOUCH_TOTAL_KEYS > 0) && (TOUCH_USE_ADAPTIVE_DEBOUNCE > 0)
+            if (FOR_OBJ_TYPE & TSC_OBJ_TYPE_KEY_MASK)
+            {
+                TSC_Globals.For_Key->p_Data->NoiseCount = SNAP_NOISE_COUNT(word);
+                TSC_Globals.For_Key->p_Data->NoiseVar = (uint16_t)Snap.Channel[2 * idx + 1];
+            }
+            #endif
+            p_Ch++;
+            idx++;
+        }
+
+        #if TOUCH_TOTAL_LNRTS > 0
+        if (FOR_OBJ_TYPE & TSC_OBJ_TYPE_LINROT_MASK)
+        {
+            TSC_Linrot_ConfigReleaseState();
+        }
+        #endif
+        #if TOUCH_TOTAL_MATRICES > 0
+        if (FOR_OBJ_TYPE & TSC_OBJ_TYPE_MATRIX_MASK)
+        {
+            TSC_Matrix_ConfigReleaseState();
+        }
+        #endif
+        #if TOUCH_TOTAL_KEYS > 0
+        if (FOR_OBJ_TYPE & TSC_OBJ_TYPE_KEY_MASK)
+        {
+            TSC_TouchKey_ConfigReleaseState();
+        }
+        #endif
+        pObj++;
+    }
+
+    #if TOUCH_ECS_INCREMENTAL > 0
+    TSC_Ecs_ConfigKCoeff((TSC_tKCoeff_T)(Snap.Header & 0xFF));
+    #endif
+
+    SnapRestore = 0;
+    return TSC_STATUS_OK;
+}
+
+/*!
+ * @brief       Save the References in the flash page
+ *              To be called regularly by the application (every TOUCH_SNAPSHOT_PERIOD sec).
+ *
+ * @param       objgrp: Pointer to the objects group
+ *
+ * @retval      Status
+ *              - TSC_STATUS_BUSY: an object is not in Release state, nothing saved
+ *              - TSC_STATUS_OK: saved, or no Reference moved more than TOUCH_SNAPSHOT_SAVE_TH
+ *              - TSC_STATUS_ERROR: flash error
+ *
+ * @note        The CPU is stalled during the flash operations: about 1 ms to program a
+ *              record, about 30 ms to erase the page once every TSC_SNAP_NUM_RECORDS saves.
+ */
+TSC_STATUS_T TSC_Snap_Save(TSC_ObjectGroup_T *objgrp)
+{
+    CONST TSC_Object_T  *pObj;
+    TSC_Channel_Data_T  *p_Ch = 0;
+    TSC_tIndex_T        idxObj;
+    TSC_tIndex_T        idxChannel;
+    TSC_tNum_T          numChannel;
+    TSC_tNum_T          idx = 0;
+    TSC_tRefer_T        refer;
+    uint32_t            addr;
+    uint8_t             changed = 0;
+    FMC_STATE_T         state = FMC_STATE_COMPLETE;
+
+    /* Build the record */
+    pObj = objgrp->p_Obj;
+    for (idxObj = 0; idxObj < objgrp->NbObjects; idxObj++)
+    {
+        numChannel = TSC_Snap_ConfigObj(pObj, &p_Ch);
+
+        if (TSC_Snap_ReadStateId() != TSC_STATEID_RELEASE)
+        {
+            return TSC_STATUS_BUSY;
+        }
+
+        if ((idx + numChannel) > TOUCH_TOTAL_CHANNELS)
+        {
+            return TSC_STATUS_ERROR;
+        }
+
+        for (idxChannel = 0; idxChannel < numChannel; idxChannel++)
+        {
+            refer = TSC_CH_REFER(p_Ch);
+            SnapWork.Channel[2 * idx] = refer | ((uint32_t)p_Ch->RefRest << 16);
+            SnapWork.Channel[2 * idx + 1] = 0;
+
+            #if (TOUCH_TOTAL_KEYS > 0) && (TOUCH_USE_ADAPTIVE_DEBOUNCE > 0)
+            if (FOR_OBJ_TYPE & TSC_OBJ_TYPE_KEY_MASK)
+            {
+                SnapWork.Channel[2 * idx] |= (uint32_t)TSC_Globals.For_Key->p_Data->NoiseCount << 24;
+                SnapWork.Channel[2 * idx + 1] = TSC_Globals.For_Key->p_Data->NoiseVar;
+            }
+            #endif
+
+            if ((SnapStored == 0) ||
+                (refer > SNAP_REFER(Snap.Channel[2 * idx]) + TOUCH_SNAPSHOT_SAVE_TH) ||
+                (refer + TOUCH_SNAPSHOT_SAVE_TH < SNAP_REFER(Snap.Channel[2 * idx])))
+            {
+                changed = 1;
+            }
+            p_Ch++;
+            idx++;
+        }
+        pObj++;
+    }
+
+    SnapWork.Ctrl = TSC->CTRL & SNAP_CTRL_MASK;
+    if ((SnapStored == 0) || (SnapWork.Ctrl != Snap.Ctrl))
+    {
+        changed = 1;
+    }
+
+    if (changed == 0)
+    {
+        return TSC_STATUS_OK;
+    }
+
+    SnapWork.Header = (TSC_SNAP_MAGIC << 16) | ((uint32_t)idx << 8);
+
+    for (; idx < TOUCH_TOTAL_CHANNELS; idx++)
+    {
+        SnapWork.Channel[2 * idx] = 0;
+        SnapWork.Channel[2 * idx + 1] = 0;
+    }
+    #if TOUCH_ECS_INCREMENTAL > 0
+    SnapWork.Header |= TSC_Ecs_ReadKCoeff();
+    #endif
+    SnapWork.Crc = TSC_Snap_CalculateCrc(&SnapWork);
+
+    FMC_Unlock();
+    FMC_ClearStatusFlag(FMC_FLAG_PE | FMC_FLAG_WPE | FMC_FLAG_OC);
+
+    /* Page full: start again from the first record */
+    if (SnapNext >= TSC_SNAP_NUM_RECORDS)
+    {
+        state = FMC_ErasePage(TOUCH_SNAPSHOT_PAGE_ADDR);
+        SnapNext = 0;
+    }
+
+    /* The CRC is the last word written */
+    addr = (uint32_t)SNAP_RECORD(SnapNext);
+    for (idx = 0; (idx < TSC_SNAP_RECORD_WORDS) && (state == FMC_STATE_COMPLETE); idx++)
+    {
+        state = FMC_ProgramWord(addr + (idx * 4), ((uint32_t *)&SnapWork)[idx]);
+    }
+
+    FMC_Lock();
+
+    /* The record slot is used even if programming failed */
+    SnapNext++;
+
+    if ((state != FMC_STATE_COMPLETE) || (SNAP_RECORD(SnapNext - 1)->Crc != SnapWork.Crc))
+    {
+        return TSC_STATUS_ERROR;
+    }
+
+    Snap = SnapWork;
+    SnapStored = 1;
+    return TSC_STATUS_OK;
+}
+
+#endif /* TOUCH_USE_SNAPSHOT > 0 */
+
+/**@} end of group TSC_Snapshot_Functions */
+/**@} end of group TSC_Snapshot_Driver */
+/**@} end of group TSC_Driver_Library */
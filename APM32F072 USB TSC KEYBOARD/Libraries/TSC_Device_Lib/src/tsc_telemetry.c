@@ -0,0 +1,383 @@
+/*!
+ * @file        tsc_telemetry.c
+ *
+ * @brief       This file contains all functions to stream the per-frame telemetry records.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "tsc.h"
+#include "tsc_telemetry.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Telemetry_Driver TSC Telemetry Driver
+  @{
+*/
+
+/** @defgroup TSC_Telemetry_Macros Macros
+  @{
+*/
+
+#if TOUCH_USE_TELEMETRY > 0
+
+/* Index in the ring buffer, the size is a power of 2 */
+#define TELEM_INDEX(i)  ((i) & (TOUCH_TELEM_BUFFER_SIZE - 1))
+
+/**@} end of group TSC_Telemetry_Macros */
+
+/** @defgroup TSC_Telemetry_Enumerations Enumerations
+  @{
+*/
+
+/**@} end of group TSC_Telemetry_Enumerations */
+
+/** @defgroup TSC_Telemetry_Structures Structures
+  @{
+*/
+
+/**@} end of group TSC_Telemetry_Structures */
+
+/** @defgroup TSC_Telemetry_Variables Variables
+  @{
+*/
+
+/* Ring buffer of the records */
+static uint8_t TelemBuffer[TOUCH_TELEM_BUFFER_SIZE];
+/* Write and read counters, the used size is their difference */
+static uint16_t TelemWrite;
+static uint16_t TelemRead;
+/* Checksum of the record being written */
+static uint8_t TelemSum;
+/* Frame number of the next record */
+static uint8_t TelemSeq;
+/* Number of dropped records */
+static uint32_t TelemDrops;
+/* The stream is started */
+static uint8_t TelemStarted;
+/* Group of the records and its number of channels */
+static CONST TSC_ObjectGroup_T *TelemGroup;
+static TSC_tNum_T TelemNbChannels;
+
+/**@} end of group TSC_Telemetry_Variables */
+
+/** @defgroup TSC_Telemetry_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Select the channels of an object
+ *
+ * @param       pObj: Pointer to the object
+ *
+ * @param       p_Ch: Returns the first channel of the object
+ *
+ * @retval      Number of channels of the object
+ *
+ * @note        The object becomes the current global object.
+ */
+static TSC_tNum_T TSC_Telem_ConfigObj(CONST TSC_Object_T *pObj, TSC_Channel_Data_T **p_Ch)
+{
+    TSC_tNum_T numChannel = 0;
+
+    TSC_Obj_ConfigGlobalObj(pObj);
+
+    switch (pObj->Type)
+    {
+        #if TOUCH_TOTAL_KEYS > 0
+        case TSC_OBJ_TOUCHKEY:
+        case TSC_OBJ_TOUCHKEYB:
+            numChannel = 1;
+            *p_Ch = TSC_Globals.For_Key->p_ChD;
+            break;
+        #endif
+
+        #if TOUCH_TOTAL_LNRTS > 0
+        case TSC_OBJ_LINEAR:
+        case TSC_OBJ_LINEARB:
+        case TSC_OBJ_ROTARY:
+        case TSC_OBJ_ROTARYB:
+            numChannel = FOR_LINROT_NB_CHANNELS;
+            *p_Ch = TSC_Globals.For_LinRot->p_ChD;
+            break;
+        #endif
+
+        #if TOUCH_TOTAL_MATRICES > 0
+        case TSC_OBJ_MATRIX:
+            numChannel = FOR_MATRIX_NB_CHANNELS;
+            *p_Ch = TSC_Globals.For_Matrix->p_ChD;
+            break;
+        #endif
+        default:
+            break;
+    }
+
+    return numChannel;
+}
+
+/*!
+ * @brief       Return the state of the current global object
+ *
+ * @param       None
+ *
+ * @retval      State id
+ */
+static TSC_STATEID_T TSC_Telem_ReadStateId(void)
+{
+    #if TOUCH_TOTAL_LNRTS > 0
+    if (FOR_OBJ_TYPE & TSC_OBJ_TYPE_LINROT_MASK)
+    {
+        return FOR_LINROT_STATEID;
+    }
+    #endif
+
+    #if TOUCH_TOTAL_MATRICES > 0
+    if (FOR_OBJ_TYPE & TSC_OBJ_TYPE_MATRIX_MASK)
+    {
+        return FOR_MATRIX_STATEID;
+    }
+    #endif
+
+    #if TOUCH_TOTAL_KEYS > 0
+    return FOR_KEY_STATEID;
+    #else
+    return TSC_STATEID_OFF;
+    #endif
+}
+
+/*!
+ * @brief       Add a byte to the record being written
+ *
+ * @param       data: Byte to add
+ *
+ * @retval      None
+ */
+static void TSC_Telem_WriteByte(uint8_t data)
+{
+    TelemBuffer[TELEM_INDEX(TelemWrite)] = data;
+    TelemWrite++;
+    TelemSum += data;
+}
+
+/*!
+ * @brief       Add a 16-bit word to the record being written, little endian
+ *
+ * @param       data: Word to add
+ *
+ * @retval      None
+ */
+static void TSC_Telem_WriteHalfWord(uint16_t data)
+{
+    TSC_Telem_WriteByte((uint8_t)data);
+    TSC_Telem_WriteByte((uint8_t)(data >> 8));
+}
+
+/*!
+ * @brief       Config the telemetry of an objects group
+ *
+ * @param       objgrp: Pointer to the objects group
+ *
+ * @retval      None
+ *
+ * @note        Must be called once after TSC_Obj_ConfigGroup(). The stream is stopped.
+ */
+void TSC_Telem_Config(CONST TSC_ObjectGroup_T *objgrp)
+{
+    CONST TSC_Object_T  *pObj;
+    TSC_Channel_Data_T  *p_Ch = 0;
+    TSC_tIndex_T        idxObj;
+
+    TelemGroup = objgrp;
+    TelemNbChannels = 0;
+
+    pObj = objgrp->p_Obj;
+    for (idxObj = 0; idxObj < objgrp->NbObjects; idxObj++)
+    {
+        TelemNbChannels += TSC_Telem_ConfigObj(pObj, &p_Ch);
+        pObj++;
+    }
+
+    TelemStarted = 0;
+    TelemDrops = 0;
+}
+
+/*!
+ * @brief       Start the stream of the records
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        The ring buffer, the frame number and the drop counter are reset.
+ *              Must be called from the same context as TSC_Telem_Write().
+ */
+void TSC_Telem_Start(void)
+{
+    TelemWrite = 0;
+    TelemRead = 0;
+    TelemSeq = 0;
+    TelemDrops = 0;
+    TelemStarted = 1;
+}
+
+/*!
+ * @brief       Stop the stream of the records
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        The records already in the ring buffer can still be read.
+ */
+void TSC_Telem_Stop(void)
+{
+    TelemStarted = 0;
+}
+
+/*!
+ * @brief       Write the record of the last frame in the ring buffer
+ *              To be called after TSC_Obj_ProcessGroup().
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        The record is dropped and counted when the ring buffer is full,
+ *              its frame number is lost so the reader can see the gap.
+ */
+void TSC_Telem_Write(void)
+{
+    CONST TSC_Object_T  *pObj;
+    TSC_Channel_Data_T  *p_Ch = 0;
+    TSC_tIndex_T        idxObj;
+    TSC_tIndex_T        idxChannel;
+    TSC_tNum_T          numChannel;
+    uint16_t            size;
+    uint8_t             seq;
+
+    if ((TelemStarted == 0) || (TelemGroup == 0))
+    {
+        return;
+    }
+
+    seq = TelemSeq++;
+    size = TSC_TELEM_RECORD_SIZE(TelemNbChannels, TelemGroup->NbObjects);
+
+    if ((uint16_t)(TOUCH_TELEM_BUFFER_SIZE - (uint16_t)(TelemWrite - TelemRead)) < size)
+    {
+        TelemDrops++;
+        return;
+    }
+
+    TelemSum = 0;
+    TSC_Telem_WriteByte(TSC_TELEM_SYNC);
+    TSC_Telem_WriteByte((uint8_t)size);
+    TSC_Telem_WriteByte(seq);
+    TSC_Telem_WriteHalfWord((uint16_t)TSC_Globals.Tick_ms);
+    TSC_Telem_WriteByte((uint8_t)TelemNbChannels);
+    TSC_Telem_WriteByte((uint8_t)TelemGroup->NbObjects);
+
+    /* Channels */
+    pObj = TelemGroup->p_Obj;
+    for (idxObj = 0; idxObj < TelemGroup->NbObjects; idxObj++)
+    {
+        numChannel = TSC_Telem_ConfigObj(pObj, &p_Ch);
+
+        for (idxChannel = 0; idxChannel < numChannel; idxChannel++)
+        {
+            #if TOUCH_USE_MEAS > 0
+            TSC_Telem_WriteHalfWord((uint16_t)TSC_CH_MEAS(p_Ch));
+            #else
+            TSC_Telem_WriteHalfWord((uint16_t)TSC_Acq_ComputeMeas(TSC_CH_REFER(p_Ch), TSC_CH_DELTA(p_Ch)));
+            #endif
+            TSC_Telem_WriteHalfWord((uint16_t)TSC_CH_DELTA(p_Ch));
+            p_Ch++;
+        }
+        pObj++;
+    }
+
+    /* Objects */
+    pObj = TelemGroup->p_Obj;
+    for (idxObj = 0; idxObj < TelemGroup->NbObjects; idxObj++)
+    {
+        TSC_Telem_ConfigObj(pObj, &p_Ch);
+        TSC_Telem_WriteByte((uint8_t)TSC_Telem_ReadStateId());
+        pObj++;
+    }
+
+    TSC_Telem_WriteByte((uint8_t)(0 - TelemSum));
+}
+
+/*!
+ * @brief       Read the records from the ring buffer
+ *
+ * @param       buffer: Pointer to the destination
+ *
+ * @param       size: Size of the destination in bytes
+ *
+ * @retval      Number of bytes copied, only whole records are copied
+ *
+ * @note        Must be called from the same context as TSC_Telem_Write().
+ */
+uint16_t TSC_Telem_Read(uint8_t *buffer, uint16_t size)
+{
+    uint16_t count = 0;
+    uint16_t recSize;
+    uint16_t idx;
+
+    while (TelemRead != TelemWrite)
+    {
+        recSize = TelemBuffer[TELEM_INDEX(TelemRead + 1)];
+
+        if (recSize > (uint16_t)(size - count))
+        {
+            break;
+        }
+
+        for (idx = 0; idx < recSize; idx++)
+        {
+            buffer[count++] = TelemBuffer[TELEM_INDEX(TelemRead)];
+            TelemRead++;
+        }
+    }
+
+    return count;
+}
+
+/*!
+ * @brief       Return the number of dropped records since the start of the stream
+ *
+ * @param       None
+ *
+ * @retval      Number of dropped records
+ */
+uint32_t TSC_Telem_ReadDrops(void)
+{
+    return TelemDrops;
+}
+
+#endif /* TOUCH_USE_TELEMETRY > 0 */
+
+/**@} end of group TSC_Telemetry_Functions */
+/**@} end of group TSC_Telemetry_Driver */
+/**@} end of group TSC_Driver_Library */
@@ -88,24 +88,35 @@ TSC_STATUS_T TSC_Time_Config(void)
  * @param       None
  *
  * @retval      None
+ *
+ * @note        With TOUCH_USE_LOWPOWER one call can count several ticks: the timer
+ *              period is lengthened while the guard scan waits.
  */
 void TSC_Time_ProcessInterrupt(void)
 {
     static TSC_tTick_ms_T val_1s = 0;
+    TSC_tTick_ms_T step;
+
+    /* Start the guard burst of the low-power scan, the timer is slowed down during the guard wait */
+    #if TOUCH_USE_LOWPOWER > 0
+    step = TSC_Acq_ProcessScanTick();
+    #else
+    step = 1;
+    #endif
 
     /* Count 1 global tick every xxx ms (defined by TOUCH_TICK_FREQ parameter) */
-    TSC_Globals.Tick_ms++;
+    TSC_Globals.Tick_ms += step;
 
     /* Check if 1 second has elapsed */
-    val_1s++;
-    if (val_1s > (TOUCH_TICK_FREQ - 1))
+    val_1s += step;
+    while (val_1s > (TOUCH_TICK_FREQ - 1))
     {
         TSC_Globals.Tick_sec++;
         if (TSC_Globals.Tick_sec > 63)
         {
             TSC_Globals.Tick_sec = 0;
         }
-        val_1s = 0;
+        val_1s -= TOUCH_TICK_FREQ;
     }
 
     /* Callback function */
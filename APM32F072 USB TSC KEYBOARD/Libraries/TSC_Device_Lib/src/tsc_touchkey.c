@@ -41,35 +41,46 @@
 
 #if TOUCH_TOTAL_KEYS > 0
 
-#define FOR_MEAS                 TSC_Globals.For_Key->p_ChD->Meas
-#define FOR_DELTA                TSC_Globals.For_Key->p_ChD->Delta
-#define FOR_REFER                TSC_Globals.For_Key->p_ChD->Refer
-#define FOR_REFREST              TSC_Globals.For_Key->p_ChD->RefRest
-#define FOR_CHANNEL_DATA         TSC_Globals.For_Key->p_ChD
-#define FOR_ACQ_STATUS           TSC_Globals.For_Key->p_ChD->Flag.AcqStatus
-#define FOR_OBJ_STATUS           TSC_Globals.For_Key->p_ChD->Flag.ObjStatus
-#define FOR_DATA_READY           TSC_Globals.For_Key->p_ChD->Flag.DataReady
-
-#define FOR_STATEID              TSC_Globals.For_Key->p_Data->StateId
-#define FOR_CHANGE               TSC_Globals.For_Key->p_Data->Change
-#define FOR_COUNTER_DEB          TSC_Globals.For_Key->p_Data->CounterDebounce
-#define FOR_COUNTER_DTO          TSC_Globals.For_Key->p_Data->CounterDTO
-#define FOR_DXSLOCK              TSC_Globals.For_Key->p_Data->DxsLock
-
-#define FOR_PROXIN_TH            TSC_Globals.For_Key->p_Param->ProxInTh
-#define FOR_PROXOUT_TH           TSC_Globals.For_Key->p_Param->ProxOutTh
-#define FOR_DETECTIN_TH          TSC_Globals.For_Key->p_Param->DetectInTh
-#define FOR_DETECTOUT_TH         TSC_Globals.For_Key->p_Param->DetectOutTh
-#define FOR_CALIB_TH             TSC_Globals.For_Key->p_Param->CalibTh
-
-#define FOR_COUNTER_DEB_CALIB    TSC_Globals.For_Key->p_Param->CounterDebCalib
-#define FOR_COUNTER_DEB_PROX     TSC_Globals.For_Key->p_Param->CounterDebProx
-#define FOR_COUNTER_DEB_DETECT   TSC_Globals.For_Key->p_Param->CounterDebDetect
-#define FOR_COUNTER_DEB_RELEASE  TSC_Globals.For_Key->p_Param->CounterDebRelease
-#define FOR_COUNTER_DEB_ERROR    TSC_Globals.For_Key->p_Param->CounterDebError
+/* The TouchKey is the "key" parameter of the functions */
+#define FOR_MEAS                 TSC_CH_MEAS(key->p_ChD)
+#define FOR_DELTA                TSC_CH_DELTA(key->p_ChD)
+#define FOR_REFER                TSC_CH_REFER(key->p_ChD)
+#define FOR_REFREST              key->p_ChD->RefRest
+#define FOR_CHANNEL_DATA         key->p_ChD
+#define FOR_ACQ_STATUS           key->p_ChD->Flag.AcqStatus
+#define FOR_OBJ_STATUS           key->p_ChD->Flag.ObjStatus
+#define FOR_DATA_READY           key->p_ChD->Flag.DataReady
+
+#define FOR_STATEID              key->p_Data->StateId
+#define FOR_CHANGE               key->p_Data->Change
+#define FOR_COUNTER_DEB          key->p_Data->CounterDebounce
+#define FOR_COUNTER_DTO          key->p_Data->CounterDTO
+#define FOR_DXSLOCK              key->p_Data->DxsLock
+
+#define FOR_PROXIN_TH            key->p_Param->ProxInTh
+#define FOR_PROXOUT_TH           key->p_Param->ProxOutTh
+#define FOR_DETECTIN_TH          key->p_Param->DetectInTh
+#define FOR_DETECTOUT_TH         key->p_Param->DetectOutTh
+#define FOR_CALIB_TH             key->p_Param->CalibTh
+
+#define FOR_COUNTER_DEB_CALIB    key->p_Param->CounterDebCalib
+#define FOR_COUNTER_DEB_PROX     key->p_Param->CounterDebProx
+#define FOR_COUNTER_DEB_DETECT   key->p_Param->CounterDebDetect
+#define FOR_COUNTER_DEB_RELEASE  key->p_Param->CounterDebRelease
+#define FOR_COUNTER_DEB_ERROR    key->p_Param->CounterDebError
+
+#if TOUCH_USE_ADAPTIVE_DEBOUNCE > 0
+#define FOR_NOISE_COUNT          key->p_Data->NoiseCount
+#define FOR_NOISE_VAR            key->p_Data->NoiseVar
+#define DEB_DETECT               TSC_TouchKey_ReadDebounceDetectCtx(key)
+#define UPDATE_NOISE             {TSC_TouchKey_UpdateNoise(key);}
+#else
+#define DEB_DETECT               FOR_COUNTER_DEB_DETECT
+#define UPDATE_NOISE
+#endif
 
 #if TOUCH_DTO > 0
-#define DTO_READ_TIME  {TSC_TouchKey_DTOGetTime();}
+#define DTO_READ_TIME  {TSC_TouchKey_DTOGetTimeCtx(key);}
 #else
 #define DTO_READ_TIME
 #endif
@@ -110,16 +121,20 @@ static TSC_tNum_T CalibDiv;
   @{
 */
 
-void TSC_TouchKey_DTOGetTime(void);
+static void TSC_TouchKey_DTOGetTimeCtx(CONST TSC_TouchKey_T *key);
+static void TSC_TouchKey_ProcessStateCtx(CONST TSC_Object_T *pObj, CONST TSC_TouchKey_T *key, CONST TSC_State_T *p_SM);
+#if TOUCH_USE_ADAPTIVE_DEBOUNCE > 0
+static void TSC_TouchKey_UpdateNoise(CONST TSC_TouchKey_T *key);
+#endif
 
 /*!
  * @brief       Config parameters with default values from configuration file
  *
- * @param       None
+ * @param       key: Pointer to the TouchKey
  *
  * @retval      None
  */
-void TSC_TouchKey_Config(void)
+void TSC_TouchKey_ConfigCtx(CONST TSC_TouchKey_T *key)
 {
     /* Debounce counters */
     FOR_COUNTER_DEB_CALIB   = TOUCH_DEBOUNCE_CALIB;
@@ -140,18 +155,37 @@ void TSC_TouchKey_Config(void)
     FOR_CALIB_TH     = TOUCH_KEY_CALIB_TH;
 
     /* Config state */
-    TSC_TouchKey_ConfigCalibrationState(TOUCH_CALIB_DELAY);
+    TSC_TouchKey_ConfigCalibrationStateCtx(key, TOUCH_CALIB_DELAY);
 }
 
 /*!
- * @brief       Process the State Machine
+ * @brief       Config parameters with default values from configuration file
  *
  * @param       None
  *
  * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
  */
-void TSC_TouchKey_Process(void)
+void TSC_TouchKey_Config(void)
+{
+    TSC_TouchKey_ConfigCtx(TSC_Globals.For_Key);
+}
+
+/*!
+ * @brief       Process the State Machine
+ *
+ * @param       pObj: Pointer to the TouchKey object (TSC_OBJ_TOUCHKEY or TSC_OBJ_TOUCHKEYB)
+ *
+ * @retval      None
+ *
+ * @note        The global object (TSC_Globals) is only set for the state functions
+ *              which are not provided by the library, see TSC_TouchKey_ProcessStateCtx().
+ */
+void TSC_TouchKey_ProcessCtx(CONST TSC_Object_T *pObj)
 {
+    CONST TSC_TouchKey_T *key = (CONST TSC_TouchKey_T *)pObj->MyObj;
+    CONST TSC_State_T *p_SM = 0;
     TSC_STATEID_T stateID;
 
     if ((FOR_STATEID == TSC_STATEID_OFF) || (FOR_DATA_READY != 0))
@@ -160,19 +194,24 @@ void TSC_TouchKey_Process(void)
         stateID = FOR_STATEID;
 
         #if TOUCH_TOTAL_TOUCHKEYS > 0
-        if (TSC_Globals.For_Obj->Type == TSC_OBJ_TOUCHKEY)
+        if (pObj->Type == TSC_OBJ_TOUCHKEY)
         {
-            TSC_Globals.For_Key->p_SM[FOR_STATEID].StateFunc();
+            p_SM = key->p_SM;
         }
         #endif
 
         #if TOUCH_TOTAL_TOUCHKEYS_B > 0
-        if (TSC_Globals.For_Obj->Type == TSC_OBJ_TOUCHKEYB)
+        if (pObj->Type == TSC_OBJ_TOUCHKEYB)
         {
-            TSC_Params.p_KeySta[FOR_STATEID].StateFunc();
+            p_SM = TSC_Params.p_KeySta;
         }
         #endif
 
+        if (p_SM != 0)
+        {
+            TSC_TouchKey_ProcessStateCtx(pObj, key, p_SM);
+        }
+
         /* Check if the new state has changed */
         if (FOR_STATEID != stateID)
         {
@@ -196,14 +235,198 @@ void TSC_TouchKey_Process(void)
     }
 }
 
+/*!
+ * @brief       Process the State Machine
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Obj).
+ */
+void TSC_TouchKey_Process(void)
+{
+    TSC_TouchKey_ProcessCtx(TSC_Globals.For_Obj);
+}
+
+/*!
+ * @brief       Call the function of the current state (private routine)
+ *
+ * @param       pObj: Pointer to the TouchKey object
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @param       p_SM: Pointer to the State Machine of the TouchKey
+ *
+ * @retval      None
+ *
+ * @note        The library state functions (TouchKey and recovery) are called directly
+ *              with the TouchKey. Other state functions (application) have no parameter:
+ *              the global object (TSC_Globals.For_Obj, For_Key) is set before the call.
+ *              Only these calls use the global object, so a state machine made of
+ *              library functions never writes it.
+ */
+static void TSC_TouchKey_ProcessStateCtx(CONST TSC_Object_T *pObj, CONST TSC_TouchKey_T *key, CONST TSC_State_T *p_SM)
+{
+    void (*stateFunc)(void) = p_SM[FOR_STATEID].StateFunc;
+
+    switch (FOR_STATEID)
+    {
+        case TSC_STATEID_CALIB:
+            if (stateFunc == TSC_TouchKey_ProcessCalibrationState)
+            {
+                TSC_TouchKey_ProcessCalibrationStateCtx(key);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_DEB_CALIB:
+            if (stateFunc == TSC_TouchKey_ProcessDebCalibrationState)
+            {
+                TSC_TouchKey_ProcessDebCalibrationStateCtx(key);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_RELEASE:
+            if (stateFunc == TSC_TouchKey_ProcessReleaseState)
+            {
+                TSC_TouchKey_ProcessReleaseStateCtx(key);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_DEB_RELEASE_DETECT:
+            if (stateFunc == TSC_TouchKey_ProcessDebReleaseDetectState)
+            {
+                TSC_TouchKey_ProcessDebReleaseDetectStateCtx(key);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_DEB_RELEASE_TOUCH:
+            if (stateFunc == TSC_TouchKey_ProcessDebReleaseTouchState)
+            {
+                TSC_TouchKey_ProcessDebReleaseTouchStateCtx(key);
+                return;
+            }
+            break;
+
+        #if TOUCH_USE_PROX > 0
+        case TSC_STATEID_DEB_RELEASE_PROX:
+            if (stateFunc == TSC_TouchKey_ProcessDebReleaseProxState)
+            {
+                TSC_TouchKey_ProcessDebReleaseProxStateCtx(key);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_PROX:
+            if (stateFunc == TSC_TouchKey_ProcessProxState)
+            {
+                TSC_TouchKey_ProcessProxStateCtx(key);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_DEB_PROX:
+            if (stateFunc == TSC_TouchKey_ProcessDebProxState)
+            {
+                TSC_TouchKey_ProcessDebProxStateCtx(key);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_DEB_PROX_DETECT:
+            if (stateFunc == TSC_TouchKey_ProcessDebProxDetectState)
+            {
+                TSC_TouchKey_ProcessDebProxDetectStateCtx(key);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_DEB_PROX_TOUCH:
+            if (stateFunc == TSC_TouchKey_ProcessDebProxTouchState)
+            {
+                TSC_TouchKey_ProcessDebProxTouchStateCtx(key);
+                return;
+            }
+            break;
+        #endif
+
+        case TSC_STATEID_DETECT:
+            if (stateFunc == TSC_TouchKey_ProcessDetectState)
+            {
+                TSC_TouchKey_ProcessDetectStateCtx(key);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_DEB_DETECT:
+            if (stateFunc == TSC_TouchKey_ProcessDebDetectState)
+            {
+                TSC_TouchKey_ProcessDebDetectStateCtx(key);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_TOUCH:
+            if (stateFunc == TSC_TouchKey_ProcessTouchState)
+            {
+                TSC_TouchKey_ProcessTouchStateCtx(key);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_DEB_ERROR_CALIB:
+        case TSC_STATEID_DEB_ERROR_RELEASE:
+        case TSC_STATEID_DEB_ERROR_PROX:
+        case TSC_STATEID_DEB_ERROR_DETECT:
+        case TSC_STATEID_DEB_ERROR_TOUCH:
+            if (stateFunc == TSC_TouchKey_ProcessDebErrorState)
+            {
+                TSC_TouchKey_ProcessDebErrorStateCtx(key);
+                return;
+            }
+            break;
+
+        #if TOUCH_USE_RECOVERY > 0
+        case TSC_STATEID_ERROR:
+            if (stateFunc == TSC_Recovery_ProcessErrorState)
+            {
+                TSC_Recovery_ProcessErrorStateCtx(pObj);
+                return;
+            }
+            break;
+
+        case TSC_STATEID_OFF:
+            if (stateFunc == TSC_Recovery_ProcessOffState)
+            {
+                TSC_Recovery_ProcessOffStateCtx(pObj);
+                return;
+            }
+            break;
+        #endif
+
+        default:
+            break;
+    }
+
+    /* Application state function */
+    TSC_Obj_ConfigGlobalObj(pObj);
+    stateFunc();
+}
+
 /*!
  * @brief       Go in Calibration state
  *
+ * @param       key: Pointer to the TouchKey
+ *
  * @param       delay: Delay before calibration starts (stabilization of noise filter)
  *
  * @retval      None
  */
-void TSC_TouchKey_ConfigCalibrationState(TSC_tCounter_T delay)
+void TSC_TouchKey_ConfigCalibrationStateCtx(CONST TSC_TouchKey_T *key, TSC_tCounter_T delay)
 {
     FOR_STATEID = TSC_STATEID_CALIB;
     FOR_CHANGE = TSC_STATE_CHANGED;
@@ -226,47 +449,139 @@ void TSC_TouchKey_ConfigCalibrationState(TSC_tCounter_T delay)
      * different from 0 in order to stabilize the filter. */
     FOR_COUNTER_DEB = (TSC_tCounter_T)(delay + (TSC_tCounter_T)TSC_Params.NumCalibSample);
     FOR_REFER = 0;
+
+#if TOUCH_USE_ADAPTIVE_DEBOUNCE > 0
+    /* The noise is estimated again with the new reference */
+    FOR_NOISE_COUNT = 0;
+    FOR_NOISE_VAR = 0;
+#endif
+}
+
+/*!
+ * @brief       Go in Calibration state
+ *
+ * @param       delay: Delay before calibration starts (stabilization of noise filter)
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+void TSC_TouchKey_ConfigCalibrationState(TSC_tCounter_T delay)
+{
+    TSC_TouchKey_ConfigCalibrationStateCtx(TSC_Globals.For_Key, delay);
 }
 
 /*!
  * @brief       Go in Off state with sensor "off"
  *
- * @param       None
+ * @param       key: Pointer to the TouchKey
  *
  * @retval      None
  */
-void TSC_TouchKey_ConfigOffState(void)
+void TSC_TouchKey_ConfigOffStateCtx(CONST TSC_TouchKey_T *key)
 {
     FOR_STATEID = TSC_STATEID_OFF;
     FOR_CHANGE = TSC_STATE_CHANGED;
     FOR_OBJ_STATUS = TSC_OBJ_STATUS_OFF;
 }
 
+/*!
+ * @brief       Go in Off state with sensor "off"
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+void TSC_TouchKey_ConfigOffState(void)
+{
+    TSC_TouchKey_ConfigOffStateCtx(TSC_Globals.For_Key);
+}
 
 /*!
- * @brief       Go in Off state with sensor in "Burst mode only"
+ * @brief       Go in Release state with sensor "on"
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      None
+ *
+ * @note        The Reference must be already valid (restored calibration).
+ */
+void TSC_TouchKey_ConfigReleaseStateCtx(CONST TSC_TouchKey_T *key)
+{
+    FOR_STATEID = TSC_STATEID_RELEASE;
+    FOR_CHANGE = TSC_STATE_CHANGED;
+    FOR_OBJ_STATUS = TSC_OBJ_STATUS_ON;
+}
+
+/*!
+ * @brief       Go in Release state with sensor "on"
  *
  * @param       None
  *
  * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
  */
-void TSC_TouchKey_ConfigBurstOnlyState(void)
+void TSC_TouchKey_ConfigReleaseState(void)
+{
+    TSC_TouchKey_ConfigReleaseStateCtx(TSC_Globals.For_Key);
+}
+
+
+/*!
+ * @brief       Go in Off state with sensor in "Burst mode only"
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      None
+ */
+void TSC_TouchKey_ConfigBurstOnlyStateCtx(CONST TSC_TouchKey_T *key)
 {
     FOR_STATEID = TSC_STATEID_OFF;
     FOR_CHANGE = TSC_STATE_CHANGED;
     FOR_OBJ_STATUS = TSC_OBJ_STATUS_BURST_ONLY;
 }
 
+/*!
+ * @brief       Go in Off state with sensor in "Burst mode only"
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+void TSC_TouchKey_ConfigBurstOnlyState(void)
+{
+    TSC_TouchKey_ConfigBurstOnlyStateCtx(TSC_Globals.For_Key);
+}
+
+/*!
+ * @brief       Return the current state identifier
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      State id
+ */
+TSC_STATEID_T TSC_TouchKey_ReadStateIdCtx(CONST TSC_TouchKey_T *key)
+{
+    return(FOR_STATEID);
+}
+
 /*!
  * @brief       Return the current state identifier
  *
  * @param       None
  *
  * @retval      State id
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
  */
 TSC_STATEID_T TSC_TouchKey_ReadStateId(void)
 {
-    return(FOR_STATEID);
+    return TSC_TouchKey_ReadStateIdCtx(TSC_Globals.For_Key);
 }
 
 /*!
@@ -278,12 +593,13 @@ TSC_STATEID_T TSC_TouchKey_ReadStateId(void)
  */
 TSC_STATEMASK_T TSC_TouchKey_ReadStateMask(void)
 {
+    CONST TSC_TouchKey_T *key = TSC_Globals.For_Key;
     TSC_STATEMASK_T state_mask = TSC_STATEMASK_UNKNOWN;
 
 #if TOUCH_TOTAL_TOUCHKEYS > 0
     if (TSC_Globals.For_Obj->Type == TSC_OBJ_TOUCHKEY)
     {
-        state_mask = TSC_Globals.For_Key->p_SM[FOR_STATEID].StateMask;
+        state_mask = key->p_SM[FOR_STATEID].StateMask;
     }
 #endif
 
@@ -297,27 +613,137 @@ TSC_STATEMASK_T TSC_TouchKey_ReadStateMask(void)
     return state_mask;
 }
 
+/*!
+ * @brief       Return the Change flag
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      Change flag status
+ */
+TSC_tNum_T TSC_TouchKey_ReadChangeFlagCtx(CONST TSC_TouchKey_T *key)
+{
+    return(FOR_CHANGE);
+}
+
 /*!
  * @brief       Return the Change flag
  *
  * @param       None
  *
  * @retval      Change flag status
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
  */
 TSC_tNum_T TSC_TouchKey_ReadChangeFlag(void)
 {
-    return(FOR_CHANGE);
+    return TSC_TouchKey_ReadChangeFlagCtx(TSC_Globals.For_Key);
 }
 
+#if TOUCH_USE_ADAPTIVE_DEBOUNCE > 0
+/*!
+ * @brief       Return the Detect state debounce adapted to the measured noise
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      Debounce counter
+ *
+ * @note        The minimum debounce is used when the Detect in threshold is
+ *              TOUCH_DEBOUNCE_SNR times above the delta standard deviation. One
+ *              sample is added each time the standard deviation doubles, the
+ *              comparison is made on the squared values to avoid a square root.
+ */
+TSC_tCounter_T TSC_TouchKey_ReadDebounceDetectCtx(CONST TSC_TouchKey_T *key)
+{
+    TSC_tCounter_T deb = TOUCH_DEBOUNCE_DETECT_MIN;
+    uint32_t th;
+    uint32_t lim;
+
+    /* Not enough samples yet */
+    if (FOR_NOISE_COUNT < (1 << TOUCH_DEBOUNCE_NOISE_WEIGHT))
+    {
+        return FOR_COUNTER_DEB_DETECT;
+    }
+
+    th = (uint32_t)FOR_DETECTIN_TH << TOUCH_COEFF_TH;
+    lim = (th * th) / (TOUCH_DEBOUNCE_SNR * TOUCH_DEBOUNCE_SNR);
+
+    while ((deb < TOUCH_DEBOUNCE_DETECT_MAX) && (FOR_NOISE_VAR > lim))
+    {
+        deb++;
+        lim <<= 2;
+    }
+
+    return deb;
+}
+
+/*!
+ * @brief       Return the Detect state debounce adapted to the measured noise
+ *
+ * @param       None
+ *
+ * @retval      Debounce counter
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+TSC_tCounter_T TSC_TouchKey_ReadDebounceDetect(void)
+{
+    return TSC_TouchKey_ReadDebounceDetectCtx(TSC_Globals.For_Key);
+}
+
+/*!
+ * @brief       Update the delta variance of the TouchKey in Release state
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      None
+ *
+ * @note        The delta is centered on zero in Release state, so the variance is
+ *              the moving average of the squared delta. The delta is limited to
+ *              255 to keep the variance on 16 bits.
+ */
+static void TSC_TouchKey_UpdateNoise(CONST TSC_TouchKey_T *key)
+{
+    int32_t delta = FOR_DELTA;
+    int32_t sq;
+    int32_t var;
+
+    if (delta < 0)
+    {
+        delta = -delta;
+    }
+    if (delta > 255)
+    {
+        delta = 255;
+    }
+    sq = delta * delta;
+
+    if (FOR_NOISE_COUNT == 0)
+    {
+        var = sq;
+    }
+    else
+    {
+        var = FOR_NOISE_VAR;
+        var += (sq - var + (1 << (TOUCH_DEBOUNCE_NOISE_WEIGHT - 1))) >> TOUCH_DEBOUNCE_NOISE_WEIGHT;
+    }
+    FOR_NOISE_VAR = (uint16_t)var;
+
+    if (FOR_NOISE_COUNT < (1 << TOUCH_DEBOUNCE_NOISE_WEIGHT))
+    {
+        FOR_NOISE_COUNT++;
+    }
+}
+#endif
+
 #if TOUCH_USE_PROX > 0
 /*!
  * @brief       Debounce Release processing (previous state = Proximity)
  *
- * @param       None
+ * @param       key: Pointer to the TouchKey
  *
  * @retval      None
  */
-void TSC_TouchKey_ProcessDebReleaseProxState(void)
+void TSC_TouchKey_ProcessDebReleaseProxStateCtx(CONST TSC_TouchKey_T *key)
 {
     /* Acquisition error (min or max) */
     if (FOR_ACQ_STATUS & TSC_ACQ_STATUS_ERROR_MASK)
@@ -343,16 +769,30 @@ void TSC_TouchKey_ProcessDebReleaseProxState(void)
         }
     }
 }
+
+/*!
+ * @brief       Debounce Release processing (previous state = Proximity)
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+void TSC_TouchKey_ProcessDebReleaseProxState(void)
+{
+    TSC_TouchKey_ProcessDebReleaseProxStateCtx(TSC_Globals.For_Key);
+}
 #endif /*!< if TOUCH_USE_PROX > 0 */
 
 /*!
  * @brief       Debounce Release processing (previous state = Detect)
  *
- * @param       None
+ * @param       key: Pointer to the TouchKey
  *
  * @retval      None
  */
-void TSC_TouchKey_ProcessDebReleaseDetectState(void)
+void TSC_TouchKey_ProcessDebReleaseDetectStateCtx(CONST TSC_TouchKey_T *key)
 {
     /* Acquisition error (min or max) */
     if (FOR_ACQ_STATUS & TSC_ACQ_STATUS_ERROR_MASK)
@@ -387,15 +827,29 @@ void TSC_TouchKey_ProcessDebReleaseDetectState(void)
     }
 }
 
+/*!
+ * @brief       Debounce Release processing (previous state = Detect)
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+void TSC_TouchKey_ProcessDebReleaseDetectState(void)
+{
+    TSC_TouchKey_ProcessDebReleaseDetectStateCtx(TSC_Globals.For_Key);
+}
+
 /*!
  * @brief       Debounce Release processing (previous state = Touch)
  *              Same as Debounce Release Detect processing
  *
- * @param       None
+ * @param       key: Pointer to the TouchKey
  *
  * @retval      None
  */
-void TSC_TouchKey_ProcessDebReleaseTouchState(void)
+void TSC_TouchKey_ProcessDebReleaseTouchStateCtx(CONST TSC_TouchKey_T *key)
 {
     /* Acquisition error (min or max) */
     if (FOR_ACQ_STATUS & TSC_ACQ_STATUS_ERROR_MASK)
@@ -431,13 +885,28 @@ void TSC_TouchKey_ProcessDebReleaseTouchState(void)
 }
 
 /*!
- * @brief       Release state processing
+ * @brief       Debounce Release processing (previous state = Touch)
+ *              Same as Debounce Release Detect processing
  *
  * @param       None
  *
  * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
  */
-void TSC_TouchKey_ProcessReleaseState(void)
+void TSC_TouchKey_ProcessDebReleaseTouchState(void)
+{
+    TSC_TouchKey_ProcessDebReleaseTouchStateCtx(TSC_Globals.For_Key);
+}
+
+/*!
+ * @brief       Release state processing
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      None
+ */
+void TSC_TouchKey_ProcessReleaseStateCtx(CONST TSC_TouchKey_T *key)
 {
     /* Acquisition error (min or max) */
     if (FOR_ACQ_STATUS & TSC_ACQ_STATUS_ERROR_MASK)
@@ -457,7 +926,7 @@ void TSC_TouchKey_ProcessReleaseState(void)
         if TEST_DELTA(>=, FOR_DETECTIN_TH)
         {
             TEST_DELTA_NEGATIVE;
-            FOR_COUNTER_DEB = FOR_COUNTER_DEB_DETECT;
+            FOR_COUNTER_DEB = DEB_DETECT;
             if (FOR_COUNTER_DEB)
             {
                 FOR_STATEID = TSC_STATEID_DEB_DETECT;
@@ -487,6 +956,8 @@ void TSC_TouchKey_ProcessReleaseState(void)
         }
         #endif
 
+        UPDATE_NOISE;
+
         /* Check delta for re-calibration
             Warning: the threshold value is inverted in the macro */
         if TEST_DELTA_N(<=, FOR_CALIB_TH)
@@ -498,20 +969,34 @@ void TSC_TouchKey_ProcessReleaseState(void)
             }
             else
             {
-                TSC_TouchKey_ConfigCalibrationState(0);
+                TSC_TouchKey_ConfigCalibrationStateCtx(key, 0);
             }
         }
     }
 }
 
 /*!
- * @brief       Debounce Calibration processing (previous state = Release)
+ * @brief       Release state processing
  *
  * @param       None
  *
  * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
  */
-void TSC_TouchKey_ProcessDebCalibrationState(void)
+void TSC_TouchKey_ProcessReleaseState(void)
+{
+    TSC_TouchKey_ProcessReleaseStateCtx(TSC_Globals.For_Key);
+}
+
+/*!
+ * @brief       Debounce Calibration processing (previous state = Release)
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      None
+ */
+void TSC_TouchKey_ProcessDebCalibrationStateCtx(CONST TSC_TouchKey_T *key)
 {
     /* Acquisition error (min or max) */
     if (FOR_ACQ_STATUS & TSC_ACQ_STATUS_ERROR_MASK)
@@ -534,20 +1019,34 @@ void TSC_TouchKey_ProcessDebCalibrationState(void)
             }
             if (FOR_COUNTER_DEB == 0)
             {
-                TSC_TouchKey_ConfigCalibrationState(0);
+                TSC_TouchKey_ConfigCalibrationStateCtx(key, 0);
             }
         }
     }
 }
 
 /*!
- * @brief       Calibration state processing
+ * @brief       Debounce Calibration processing (previous state = Release)
  *
  * @param       None
  *
  * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
  */
-void TSC_TouchKey_ProcessCalibrationState(void)
+void TSC_TouchKey_ProcessDebCalibrationState(void)
+{
+    TSC_TouchKey_ProcessDebCalibrationStateCtx(TSC_Globals.For_Key);
+}
+
+/*!
+ * @brief       Calibration state processing
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      None
+ */
+void TSC_TouchKey_ProcessCalibrationStateCtx(CONST TSC_TouchKey_T *key)
 {
     TSC_tMeas_T newMeas;
 
@@ -621,15 +1120,29 @@ void TSC_TouchKey_ProcessCalibrationState(void)
     }
 }
 
+/*!
+ * @brief       Calibration state processing
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+void TSC_TouchKey_ProcessCalibrationState(void)
+{
+    TSC_TouchKey_ProcessCalibrationStateCtx(TSC_Globals.For_Key);
+}
+
 #if TOUCH_USE_PROX > 0
 /*!
  * @brief       Debounce Proximity processing (previous state = Release)
  *
- * @param       None
+ * @param       key: Pointer to the TouchKey
  *
  * @retval      None
  */
-void TSC_TouchKey_ProcessDebProxState(void)
+void TSC_TouchKey_ProcessDebProxStateCtx(CONST TSC_TouchKey_T *key)
 {
     /* Acquisition error (min or max) */
     if (FOR_ACQ_STATUS & TSC_ACQ_STATUS_ERROR_MASK)
@@ -641,7 +1154,7 @@ void TSC_TouchKey_ProcessDebProxState(void)
         if TEST_DELTA(>=, FOR_DETECTIN_TH)
         {
             TEST_DELTA_NEGATIVE;
-            FOR_COUNTER_DEB = FOR_COUNTER_DEB_DETECT;
+            FOR_COUNTER_DEB = DEB_DETECT;
             if (FOR_COUNTER_DEB)
             {
                 FOR_STATEID = TSC_STATEID_DEB_DETECT;
@@ -672,17 +1185,31 @@ void TSC_TouchKey_ProcessDebProxState(void)
         }
     }
 }
+
+/*!
+ * @brief       Debounce Proximity processing (previous state = Release)
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+void TSC_TouchKey_ProcessDebProxState(void)
+{
+    TSC_TouchKey_ProcessDebProxStateCtx(TSC_Globals.For_Key);
+}
 #endif
 
 #if TOUCH_USE_PROX > 0
 /*!
  * @brief       Debounce Proximity processing (previous state = Detect)
  *
- * @param       None
+ * @param       key: Pointer to the TouchKey
  *
  * @retval      None
  */
-void TSC_TouchKey_ProcessDebProxDetectState(void)
+void TSC_TouchKey_ProcessDebProxDetectStateCtx(CONST TSC_TouchKey_T *key)
 {
     /* Acquisition error (min or max) */
     if (FOR_ACQ_STATUS & TSC_ACQ_STATUS_ERROR_MASK)
@@ -724,17 +1251,31 @@ void TSC_TouchKey_ProcessDebProxDetectState(void)
         }
     }
 }
+
+/*!
+ * @brief       Debounce Proximity processing (previous state = Detect)
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+void TSC_TouchKey_ProcessDebProxDetectState(void)
+{
+    TSC_TouchKey_ProcessDebProxDetectStateCtx(TSC_Globals.For_Key);
+}
 #endif
 
 #if TOUCH_USE_PROX > 0
 /*!
  * @brief       Debounce Proximity processing (previous state = Touch)
  *
- * @param       None
+ * @param       key: Pointer to the TouchKey
  *
  * @retval      None
  */
-void TSC_TouchKey_ProcessDebProxTouchState(void)
+void TSC_TouchKey_ProcessDebProxTouchStateCtx(CONST TSC_TouchKey_T *key)
 {
     /* Acquisition error (min or max) */
     if (FOR_ACQ_STATUS & TSC_ACQ_STATUS_ERROR_MASK)
@@ -776,17 +1317,31 @@ void TSC_TouchKey_ProcessDebProxTouchState(void)
         }
     }
 }
+
+/*!
+ * @brief       Debounce Proximity processing (previous state = Touch)
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+void TSC_TouchKey_ProcessDebProxTouchState(void)
+{
+    TSC_TouchKey_ProcessDebProxTouchStateCtx(TSC_Globals.For_Key);
+}
 #endif
 
 #if TOUCH_USE_PROX > 0
 /*!
  * @brief       Proximity state processing
  *
- * @param       None
+ * @param       key: Pointer to the TouchKey
  *
  * @retval      None
  */
-void TSC_TouchKey_ProcessProxState(void)
+void TSC_TouchKey_ProcessProxStateCtx(CONST TSC_TouchKey_T *key)
 {
 #if TOUCH_DTO > 0
     TSC_tTick_sec_T tick_detected;
@@ -824,7 +1379,7 @@ void TSC_TouchKey_ProcessProxState(void)
         if TEST_DELTA(>=, FOR_DETECTIN_TH)
         {
             TEST_DELTA_NEGATIVE;
-            FOR_COUNTER_DEB = FOR_COUNTER_DEB_DETECT;
+            FOR_COUNTER_DEB = DEB_DETECT;
             if (FOR_COUNTER_DEB)
             {
                 FOR_STATEID = TSC_STATEID_DEB_DETECT;
@@ -847,22 +1402,36 @@ void TSC_TouchKey_ProcessProxState(void)
             /* Enter in calibration state if the DTO duration has elapsed */
             if (TSC_Time_Delay_sec(TSC_Params.DTO, &tick_detected) == TSC_STATUS_OK)
             {
-                TSC_TouchKey_ConfigCalibrationState(0);
+                TSC_TouchKey_ConfigCalibrationStateCtx(key, 0);
             }
         }
         #endif
     }
 }
+
+/*!
+ * @brief       Proximity state processing
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+void TSC_TouchKey_ProcessProxState(void)
+{
+    TSC_TouchKey_ProcessProxStateCtx(TSC_Globals.For_Key);
+}
 #endif
 
 /*!
  * @brief       Debounce Detect processing (previous state = Release or Proximity)
  *
- * @param       None
+ * @param       key: Pointer to the TouchKey
  *
  * @retval      None
  */
-void TSC_TouchKey_ProcessDebDetectState(void)
+void TSC_TouchKey_ProcessDebDetectStateCtx(CONST TSC_TouchKey_T *key)
 {
     /* Acquisition error (min or max) */
     if (FOR_ACQ_STATUS & TSC_ACQ_STATUS_ERROR_MASK)
@@ -912,13 +1481,27 @@ void TSC_TouchKey_ProcessDebDetectState(void)
 }
 
 /*!
- * @brief       Detect state processing
+ * @brief       Debounce Detect processing (previous state = Release or Proximity)
  *
  * @param       None
  *
  * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
  */
-void TSC_TouchKey_ProcessDetectState(void)
+void TSC_TouchKey_ProcessDebDetectState(void)
+{
+    TSC_TouchKey_ProcessDebDetectStateCtx(TSC_Globals.For_Key);
+}
+
+/*!
+ * @brief       Detect state processing
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      None
+ */
+void TSC_TouchKey_ProcessDetectStateCtx(CONST TSC_TouchKey_T *key)
 {
 #if TOUCH_DTO > 0
     TSC_tTick_sec_T tick_detected;
@@ -950,7 +1533,7 @@ void TSC_TouchKey_ProcessDetectState(void)
                 /* Enter in calibration state if the DTO duration has elapsed */
                 if (TSC_Time_Delay_sec(TSC_Params.DTO, &tick_detected) == TSC_STATUS_OK)
                 {
-                    TSC_TouchKey_ConfigCalibrationState(0);
+                    TSC_TouchKey_ConfigCalibrationStateCtx(key, 0);
                 }
             }
             #endif
@@ -987,13 +1570,27 @@ void TSC_TouchKey_ProcessDetectState(void)
 }
 
 /*!
- * @brief       Touch state processing, Same as Detect state
+ * @brief       Detect state processing
  *
  * @param       None
  *
  * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
  */
-void TSC_TouchKey_ProcessTouchState(void)
+void TSC_TouchKey_ProcessDetectState(void)
+{
+    TSC_TouchKey_ProcessDetectStateCtx(TSC_Globals.For_Key);
+}
+
+/*!
+ * @brief       Touch state processing, Same as Detect state
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      None
+ */
+void TSC_TouchKey_ProcessTouchStateCtx(CONST TSC_TouchKey_T *key)
 {
 #if TOUCH_DTO > 0
     TSC_tTick_sec_T tick_detected;
@@ -1025,7 +1622,7 @@ void TSC_TouchKey_ProcessTouchState(void)
                 /* Enter in calibration state if the DTO duration has elapsed */
                 if (TSC_Time_Delay_sec(TSC_Params.DTO, &tick_detected) == TSC_STATUS_OK)
                 {
-                    TSC_TouchKey_ConfigCalibrationState(0);
+                    TSC_TouchKey_ConfigCalibrationStateCtx(key, 0);
                 }
             }
             #endif
@@ -1062,16 +1659,28 @@ void TSC_TouchKey_ProcessTouchState(void)
 }
 
 /*!
- * @brief       Debounce error state processing
+ * @brief       Touch state processing, Same as Detect state
  *
  * @param       None
  *
  * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
  */
-void TSC_TouchKey_ProcessDebErrorState(void)
+void TSC_TouchKey_ProcessTouchState(void)
 {
-    volatile TSC_STATEMASK_T mask;
+    TSC_TouchKey_ProcessTouchStateCtx(TSC_Globals.For_Key);
+}
 
+/*!
+ * @brief       Debounce error state processing
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      None
+ */
+void TSC_TouchKey_ProcessDebErrorStateCtx(CONST TSC_TouchKey_T *key)
+{
     /* Acquisition error (min or max) */
     if (FOR_ACQ_STATUS & TSC_ACQ_STATUS_ERROR_MASK)
     {
@@ -1086,40 +1695,54 @@ void TSC_TouchKey_ProcessDebErrorState(void)
     }
     else /*!< Acquisition is OK or has NOISE */
     {
-        mask = TSC_TouchKey_ReadStateMask();
-        mask &= (TSC_STATEMASK_T)(~(TSC_STATE_DEBOUNCE_BIT_MASK | TSC_STATE_ERROR_BIT_MASK));
-
-        if(mask == TSC_STATEMASK_RELEASE)
+        /* Go back to the state given by the debounce error state */
+        switch (FOR_STATEID)
         {
-            FOR_STATEID = TSC_STATEID_RELEASE;
-        }
-        else if(mask == TSC_STATEMASK_PROX)
-        {
-            FOR_STATEID = TSC_STATEID_PROX;
-        }
-        else if(mask == TSC_STATEMASK_DETECT)
-        {
-            FOR_STATEID = TSC_STATEID_DETECT;
-        }
-        else if(mask == TSC_STATEMASK_TOUCH)
-        {
-            FOR_STATEID = TSC_STATEID_TOUCH;
-        }
-        else
-        {
-            TSC_TouchKey_ConfigCalibrationState(0);
+            case TSC_STATEID_DEB_ERROR_RELEASE:
+                FOR_STATEID = TSC_STATEID_RELEASE;
+                break;
+
+            case TSC_STATEID_DEB_ERROR_PROX:
+                FOR_STATEID = TSC_STATEID_PROX;
+                break;
+
+            case TSC_STATEID_DEB_ERROR_DETECT:
+                FOR_STATEID = TSC_STATEID_DETECT;
+                break;
+
+            case TSC_STATEID_DEB_ERROR_TOUCH:
+                FOR_STATEID = TSC_STATEID_TOUCH;
+                break;
+
+            default:
+                TSC_TouchKey_ConfigCalibrationStateCtx(key, 0);
+                break;
         }
     }
 }
 
 /*!
- * @brief       Read the current time in second and affect it to the DTO counter (Private)
+ * @brief       Debounce error state processing
  *
  * @param       None
  *
  * @retval      None
+ *
+ * @note        Applied to the current global object (TSC_Globals.For_Key).
+ */
+void TSC_TouchKey_ProcessDebErrorState(void)
+{
+    TSC_TouchKey_ProcessDebErrorStateCtx(TSC_Globals.For_Key);
+}
+
+/*!
+ * @brief       Read the current time in second and affect it to the DTO counter (Private)
+ *
+ * @param       key: Pointer to the TouchKey
+ *
+ * @retval      None
  */
-void TSC_TouchKey_DTOGetTime(void)
+static void TSC_TouchKey_DTOGetTimeCtx(CONST TSC_TouchKey_T *key)
 {
     disableInterrupts();
     FOR_COUNTER_DTO = (TSC_tCounter_T)TSC_Globals.Tick_sec;
@@ -0,0 +1,326 @@
+/*!
+ * @file        tsc_tune.c
+ *
+ * @brief       This file contains all functions to select the pulse generator settings from the channel measures.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2022-02-21
+ *
+ * @attention
+ *
+ *  Copyright (C) 2020-2022 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "tsc.h"
+#include "tsc_tune.h"
+
+/** @addtogroup TSC_Driver_Library TSC Driver Library
+  @{
+*/
+
+/** @addtogroup TSC_Tune_Driver TSC Tune Driver
+  @{
+*/
+
+/** @defgroup TSC_Tune_Macros Macros
+  @{
+*/
+
+#if TOUCH_USE_TUNE > 0
+
+/* CTRL register fields set by the tuning: CTPHSEL, CTPLSEL, SSERRVSEL, SSEN, SSCDFSEL and PGCDFSEL */
+#define TUNE_CTRL_MASK    (0xFFFFF000)
+
+/* Number of settings tried for each timing */
+#if TOUCH_TUNE_USE_SS > 0
+#define TUNE_SS_TRIES     (2)
+#else
+#define TUNE_SS_TRIES     (1)
+#endif
+
+/**@} end of group TSC_Tune_Macros */
+
+/** @defgroup TSC_Tune_Enumerations Enumerations
+  @{
+*/
+
+/**@} end of group TSC_Tune_Enumerations */
+
+/** @defgroup TSC_Tune_Structures Structures
+  @{
+*/
+
+/**
+ * @brief   Charge transfer timing
+ */
+typedef struct
+{
+    uint8_t  CtpHigh; /*!< CTPHSEL */
+    uint8_t  CtpLow;  /*!< CTPLSEL */
+    uint8_t  Pgcdf;   /*!< PGCDFSEL */
+} TuneTiming_T;
+
+/**@} end of group TSC_Tune_Structures */
+
+/** @defgroup TSC_Tune_Variables Variables
+  @{
+*/
+
+/* Timings tried, from the shortest charge transfer cycle (250ns at 48MHz) to the longest (10.7us) */
+static CONST TuneTiming_T TuneTimings[] =
+{
+    { 2, 2, 1 },
+    { 1, 1, 2 },
+    { 2, 2, 2 },
+    { 1, 1, 3 },
+    { 2, 2, 3 },
+    { 3, 3, 3 },
+    { 2, 2, 4 },
+    { 3, 3, 4 },
+    { 3, 3, 5 },
+    { 3, 3, 6 }
+};
+
+/* Measure statistics of each channel for the current setting */
+static uint32_t     TuneSum[TOUCH_TOTAL_CHANNELS];
+static TSC_tMeas_T  TuneMin[TOUCH_TOTAL_CHANNELS];
+static TSC_tMeas_T  TuneMax[TOUCH_TOTAL_CHANNELS];
+
+/**@} end of group TSC_Tune_Variables */
+
+/** @defgroup TSC_Tune_Functions Functions
+  @{
+*/
+
+static uint32_t TSC_Tune_ReadCtrl(CONST TSC_TuneResult_T *setting);
+static TSC_STATUS_T TSC_Tune_Measure(TSC_TuneResult_T *setting);
+
+/*!
+ * @brief       Select the fastest pulse generator settings
+ *
+ * @param       result: Settings selected and their measures
+ *
+ * @retval      TSC_STATUS_OK if the settings are applied,
+ *              TSC_STATUS_ERROR if no setting is valid, the tsc_config.h settings are kept
+ *
+ * @note        Each setting is measured on all channels during TOUCH_TUNE_SAMPLES acquisitions.
+ *              A setting is valid when all measures are within TOUCH_ACQ_MIN and TOUCH_ACQ_MAX
+ *              and the mean measure of each channel is at least TOUCH_TUNE_SNR times its
+ *              peak to peak noise. The valid setting with the shortest longest burst is applied.
+ *              A noisy timing is tried again with the spread spectrum if TOUCH_TUNE_USE_SS is set.
+ *              Must be called after TSC_Config() while the acquisition is stopped, the objects
+ *              must be calibrated again after.
+ */
+TSC_STATUS_T TSC_Tune_Process(TSC_TuneResult_T *result)
+{
+    uint32_t         ctrl = TSC->CTRL;
+    uint32_t         inten = TSC->INTEN;
+    uint32_t         idxTiming;
+    uint32_t         ss;
+    TSC_STATUS_T     status;
+    TSC_STATUS_T     retval = TSC_STATUS_ERROR;
+    TSC_TuneResult_T setting;
+
+    /* The end of acquisitions are polled */
+    TSC->INTEN = 0;
+
+    for (idxTiming = 0; idxTiming < (sizeof(TuneTimings) / sizeof(TuneTimings[0])); idxTiming++)
+    {
+        for (ss = 0; ss < TUNE_SS_TRIES; ss++)
+        {
+            setting.CtpHigh = TuneTimings[idxTiming].CtpHigh;
+            setting.CtpLow = TuneTimings[idxTiming].CtpLow;
+            setting.Pgcdf = TuneTimings[idxTiming].Pgcdf;
+            setting.SpreadSpectrum = (uint8_t)ss;
+
+            status = TSC_Tune_Measure(&setting);
+
+            if (status == TSC_STATUS_OK)
+            {
+                if ((retval != TSC_STATUS_OK) || (setting.BurstCycles < result->BurstCycles))
+                {
+                    *result = setting;
+                    retval = TSC_STATUS_OK;
+                }
+            }
+
+            /* Only the noise can be reduced by the spread spectrum */
+            if (status != TSC_STATUS_BUSY)
+            {
+                break;
+            }
+        }
+    }
+
+    if (retval == TSC_STATUS_OK)
+    {
+        ctrl = (ctrl & ~TUNE_CTRL_MASK) | TSC_Tune_ReadCtrl(result);
+    }
+    TSC->CTRL = ctrl;
+
+    /* Clear the flags of the last acquisition */
+    TSC->INTFCLR |= 0x03;
+    TSC->INTEN = inten;
+
+    return retval;
+}
+
+/*!
+ * @brief       Return the CTRL register fields of a setting (private routine)
+ *
+ * @param       setting: Setting
+ *
+ * @retval      CTRL register value, TUNE_CTRL_MASK bits only
+ */
+static uint32_t TSC_Tune_ReadCtrl(CONST TSC_TuneResult_T *setting)
+{
+    uint32_t ctrl;
+
+    ctrl = ((uint32_t)setting->CtpHigh << 28) | ((uint32_t)setting->CtpLow << 24) | ((uint32_t)setting->Pgcdf << 12);
+
+    if (setting->SpreadSpectrum)
+    {
+        ctrl |= ((uint32_t)TOUCH_TSC_SSERRVSEL << 17) | ((uint32_t)1 << 16) | ((uint32_t)TOUCH_TSC_SSCDFSEL << 15);
+    }
+
+    return ctrl & TUNE_CTRL_MASK;
+}
+
+/*!
+ * @brief       Measure all channels with a setting (private routine)
+ *
+ * @param       setting: Setting, its measures and burst time are updated
+ *
+ * @retval      TSC_STATUS_OK if the setting is valid,
+ *              TSC_STATUS_BUSY if a channel is too noisy,
+ *              TSC_STATUS_ERROR if a measure is out of range
+ */
+static TSC_STATUS_T TSC_Tune_Measure(TSC_TuneResult_T *setting)
+{
+    uint32_t           idxSample;
+    TSC_tIndex_T       idxBlock;
+    TSC_tIndex_T       idxChannel;
+    TSC_tIndexDest_T   idxDest;
+    TSC_tMeas_T        meas;
+    TSC_tMeas_T        mean;
+    TSC_tMeas_T        noise;
+    uint32_t           cycle;
+    TSC_STATUS_T       status;
+    TSC_STATUS_T       retval = TSC_STATUS_OK;
+    CONST TSC_Block_T  *block;
+    CONST TSC_Channel_Src_T  *pchSrc;
+    CONST TSC_Channel_Dest_T *pchDest;
+
+    TSC->CTRL = (TSC->CTRL & ~TUNE_CTRL_MASK) | TSC_Tune_ReadCtrl(setting);
+
+    for (idxDest = 0; idxDest < TOUCH_TOTAL_CHANNELS; idxDest++)
+    {
+        TuneSum[idxDest] = 0;
+        TuneMin[idxDest] = 0xFFFF;
+        TuneMax[idxDest] = 0;
+    }
+
+    for (idxSample = 0; idxSample < TOUCH_TUNE_SAMPLES; idxSample++)
+    {
+        block = TSC_Globals.Block_Array;
+
+        for (idxBlock = 0; idxBlock < TOUCH_TOTAL_BLOCKS; idxBlock++)
+        {
+            /* All channels are measured, whatever the state of their object */
+            TSC->IOCHCTRL = block->msk_IOCHCTRL_channels;
+            TSC->IOGCSTS = block->msk_IOGCSTS_groups;
+            TSC_Acq_StartPerConfigBlock();
+
+            do
+            {
+                status = TSC_Acq_WaitBlockEOA();
+            } while (status == TSC_STATUS_BUSY);
+
+            /* Max count reached */
+            if (status != TSC_STATUS_OK)
+            {
+                return TSC_STATUS_ERROR;
+            }
+
+            pchSrc = block->p_chSrc;
+            pchDest = block->p_chDest;
+
+            for (idxChannel = 0; idxChannel < block->NumChannel; idxChannel++)
+            {
+                idxDest = pchDest->IdxDest;
+                meas = TSC_Acq_ReadMeasurVal(pchSrc->IdxSrc);
+
+                TuneSum[idxDest] += meas;
+                if (meas < TuneMin[idxDest])
+                {
+                    TuneMin[idxDest] = meas;
+                }
+                if (meas > TuneMax[idxDest])
+                {
+                    TuneMax[idxDest] = meas;
+                }
+                pchSrc++;
+                pchDest++;
+            }
+            block++;
+        }
+    }
+
+    setting->MaxMeas = 0;
+    setting->MaxNoise = 0;
+
+    for (idxDest = 0; idxDest < TOUCH_TOTAL_CHANNELS; idxDest++)
+    {
+        if ((TuneMin[idxDest] < TOUCH_ACQ_MIN) || (TuneMax[idxDest] > TOUCH_ACQ_MAX))
+        {
+            return TSC_STATUS_ERROR;
+        }
+
+        mean = (TSC_tMeas_T)(TuneSum[idxDest] / TOUCH_TUNE_SAMPLES);
+        noise = (TSC_tMeas_T)(TuneMax[idxDest] - TuneMin[idxDest]);
+
+        /* A noise of 0 count is read as 1 count */
+        if (((uint32_t)(noise ? noise : 1) * TOUCH_TUNE_SNR) > mean)
+        {
+            retval = TSC_STATUS_BUSY;
+        }
+
+        if (mean > setting->MaxMeas)
+        {
+            setting->MaxMeas = mean;
+        }
+        if (noise > setting->MaxNoise)
+        {
+            setting->MaxNoise = noise;
+        }
+    }
+
+    /* One charge transfer cycle is the high and low pulses, plus half the spread spectrum deviation on average */
+    cycle = (uint32_t)(setting->CtpHigh + setting->CtpLow + 2) << setting->Pgcdf;
+    if (setting->SpreadSpectrum)
+    {
+        cycle += (((uint32_t)TOUCH_TSC_SSERRVSEL + 1) << TOUCH_TSC_SSCDFSEL) >> 1;
+    }
+    setting->BurstCycles = (uint32_t)setting->MaxMeas * cycle;
+
+    return retval;
+}
+
+#endif /* TOUCH_USE_TUNE > 0 */
+
+/**@} end of group TSC_Tune_Functions */
+/**@} end of group TSC_Tune_Driver */
+/**@} end of group TSC_Driver_Library */
@@ -0,0 +1,195 @@
+/*!
+ * @file        apm32f0xx.h
+ *
+ * @brief       Host replacement of the device header, the peripherals used by the
+ *              TSC library are simulated by tsc_sim.c
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __APM32F0XX_H
+#define __APM32F0XX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include <stdint.h>
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @defgroup TSC_Test_Device Device
+  @{
+*/
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+#define __IOM   volatile
+
+#define __STATIC_INLINE  static inline
+
+enum {BIT_RESET, BIT_SET};
+enum {RESET = 0, SET = !RESET};
+
+#define BIT0    0x00000001
+#define BIT1    0x00000002
+#define BIT2    0x00000004
+#define BIT3    0x00000008
+#define BIT4    0x00000010
+#define BIT5    0x00000020
+#define BIT6    0x00000040
+#define BIT7    0x00000080
+#define BIT8    0x00000100
+#define BIT9    0x00000200
+#define BIT10   0x00000400
+#define BIT11   0x00000800
+#define BIT12   0x00001000
+#define BIT13   0x00002000
+#define BIT14   0x00004000
+#define BIT15   0x00008000
+#define BIT16   0x00010000
+#define BIT17   0x00020000
+#define BIT18   0x00040000
+#define BIT19   0x00080000
+#define BIT20   0x00100000
+#define BIT21   0x00200000
+#define BIT22   0x00400000
+#define BIT23   0x00800000
+#define BIT24   0x01000000
+
+/**
+ * @brief   Interrupt numbers used by the TSC library
+ */
+typedef enum IRQn
+{
+    SysTick_IRQn = -1,
+    TSC_IRQn     = 8,
+    TMR14_IRQn   = 19
+} IRQn_Type;
+
+/**
+ * @brief   Counter register of a TSC group
+ */
+typedef struct
+{
+    __IO uint32_t IOGCNT;
+} TSC_IOGroupRegister_T;
+
+/**
+ * @brief   Touch Sensing Controller, same register names as the device header
+ */
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t INTEN;
+    __IO uint32_t INTFCLR;
+    __IO uint32_t INTSTS;
+    __IO uint32_t IOHCTRL;
+    uint32_t      RESERVED0;
+    __IO uint32_t IOASCTRL;
+    uint32_t      RESERVED1;
+    __IO uint32_t IOSMPCTRL;
+    uint32_t      RESERVED2;
+    __IO uint32_t IOCHCTRL;
+    uint32_t      RESERVED3;
+    __IO uint32_t IOGCSTS;
+    TSC_IOGroupRegister_T IOGxCNT[8];
+} TSC_T;
+
+/**
+ * @brief   Timer, only the registers used by the TSC library
+ */
+typedef struct
+{
+    __IO uint32_t CTRL1;
+    __IO uint32_t DIEN;
+    __IO uint32_t STS;
+    __IO uint32_t CNT;
+    __IO uint32_t PSC;
+    __IO uint32_t AUTORLD;
+    __IO uint32_t CC1;
+} TMR_T;
+
+/**
+ * @brief   GPIO, only the registers used by the TSC library
+ */
+typedef struct
+{
+    __IO uint32_t MODE;
+    __IO uint32_t ALFL;
+    __IO uint32_t ALFH;
+} GPIO_T;
+
+/**
+ * @brief   SysTick timer
+ */
+typedef struct
+{
+    __IO uint32_t CTRL;
+    __IO uint32_t LOAD;
+    __IO uint32_t VAL;
+} SysTick_Type;
+
+#define SysTick_CTRL_TICKINT_Msk  (1UL << 1)
+
+/* Simulated peripherals (tsc_sim.c) */
+extern TSC_T        SimTSC;
+extern TMR_T        SimTMR14;
+extern SysTick_Type SimSysTick;
+extern GPIO_T       SimGPIO[5];
+extern uint32_t     SystemCoreClock;
+
+#define TSC         (&SimTSC)
+#define TMR14       (&SimTMR14)
+#define SysTick     (&SimSysTick)
+#define GPIOA       (&SimGPIO[0])
+#define GPIOB       (&SimGPIO[1])
+#define GPIOC       (&SimGPIO[2])
+#define GPIOD       (&SimGPIO[3])
+#define GPIOE       (&SimGPIO[4])
+
+/* Core functions, the interrupt mask and the sleep are simulated */
+uint32_t SysTick_Config(uint32_t ticks);
+void     Sim_DisableIrq(void);
+void     Sim_EnableIrq(void);
+uint32_t Sim_ReadPrimask(void);
+void     Sim_WritePrimask(uint32_t primask);
+void     Sim_WaitForInterrupt(void);
+
+#define __DMB()               __sync_synchronize()
+#define __disable_irq()       Sim_DisableIrq()
+#define __enable_irq()        Sim_EnableIrq()
+#define __get_PRIMASK()       Sim_ReadPrimask()
+#define __set_PRIMASK(x)      Sim_WritePrimask(x)
+#define __WFI()               Sim_WaitForInterrupt()
+
+/**@} end of group TSC_Test_Device */
+/**@} end of group TSC_Test */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APM32F0XX_H */
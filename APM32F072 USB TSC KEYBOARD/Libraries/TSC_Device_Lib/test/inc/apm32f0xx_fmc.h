@@ -0,0 +1,63 @@
+/*!
+ * @file        apm32f0xx_fmc.h
+ *
+ * @brief       Host replacement of the FMC driver header
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __APM32F0XX_FMC_H
+#define __APM32F0XX_FMC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "apm32f0xx.h"
+
+typedef enum
+{
+    FMC_FLAG_PE  = ((uint8_t)0x04),
+    FMC_FLAG_WPE = ((uint8_t)0x10),
+    FMC_FLAG_OC  = ((uint8_t)0x20)
+} FMC_FLAG_T;
+
+typedef enum
+{
+    FMC_STATE_COMPLETE = ((uint8_t)0),
+    FMC_STATE_BUSY     = ((uint8_t)1),
+    FMC_STATE_PG_ERR   = ((uint8_t)2),
+    FMC_STATE_WRP_ERR  = ((uint8_t)3),
+    FMC_STATE_TIMEOUT  = ((uint8_t)4)
+} FMC_STATE_T;
+
+void FMC_Unlock(void);
+void FMC_Lock(void);
+FMC_STATE_T FMC_ErasePage(uint32_t pageAddr);
+FMC_STATE_T FMC_ProgramWord(uint32_t addr, uint32_t data);
+void FMC_ClearStatusFlag(uint8_t flag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APM32F0XX_FMC_H */
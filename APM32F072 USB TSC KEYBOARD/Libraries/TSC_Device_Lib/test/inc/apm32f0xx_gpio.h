@@ -0,0 +1,97 @@
+/*!
+ * @file        apm32f0xx_gpio.h
+ *
+ * @brief       Host replacement of the GPIO driver header
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __APM32F0XX_GPIO_H
+#define __APM32F0XX_GPIO_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "apm32f0xx.h"
+
+typedef enum
+{
+    GPIO_MODE_IN  = 0x00,
+    GPIO_MODE_OUT = 0x01,
+    GPIO_MODE_AF  = 0x02,
+    GPIO_MODE_AN  = 0x03
+} GPIO_MODE_T;
+
+typedef enum
+{
+    GPIO_OUT_TYPE_PP = 0x00,
+    GPIO_OUT_TYPE_OD = 0x01
+} GPIO_OUT_TYPE_T;
+
+typedef enum
+{
+    GPIO_SPEED_2MHz  = 0x00,
+    GPIO_SPEED_10MHz = 0x01,
+    GPIO_SPEED_50MHz = 0x03
+} GPIO_SPEED_T;
+
+typedef enum
+{
+    GPIO_PUPD_NO = 0x00,
+    GPIO_PUPD_PU = 0x01,
+    GPIO_PUPD_PD = 0x02
+} GPIO_PUPD_T;
+
+#define GPIO_PIN_0   ((uint16_t)BIT0)
+#define GPIO_PIN_1   ((uint16_t)BIT1)
+#define GPIO_PIN_2   ((uint16_t)BIT2)
+#define GPIO_PIN_3   ((uint16_t)BIT3)
+#define GPIO_PIN_4   ((uint16_t)BIT4)
+#define GPIO_PIN_5   ((uint16_t)BIT5)
+#define GPIO_PIN_6   ((uint16_t)BIT6)
+#define GPIO_PIN_7   ((uint16_t)BIT7)
+#define GPIO_PIN_8   ((uint16_t)BIT8)
+#define GPIO_PIN_9   ((uint16_t)BIT9)
+#define GPIO_PIN_10  ((uint16_t)BIT10)
+#define GPIO_PIN_11  ((uint16_t)BIT11)
+#define GPIO_PIN_12  ((uint16_t)BIT12)
+#define GPIO_PIN_13  ((uint16_t)BIT13)
+#define GPIO_PIN_14  ((uint16_t)BIT14)
+#define GPIO_PIN_15  ((uint16_t)BIT15)
+
+typedef struct
+{
+    uint16_t         pin;
+    GPIO_MODE_T      mode;
+    GPIO_OUT_TYPE_T  outtype;
+    GPIO_SPEED_T     speed;
+    GPIO_PUPD_T      pupd;
+} GPIO_Config_T;
+
+void GPIO_Config(GPIO_T* port, GPIO_Config_T* gpioConfig);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APM32F0XX_GPIO_H */
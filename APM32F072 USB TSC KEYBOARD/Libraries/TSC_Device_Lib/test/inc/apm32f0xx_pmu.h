@@ -0,0 +1,49 @@
+/*!
+ * @file        apm32f0xx_pmu.h
+ *
+ * @brief       Host replacement of the PMU driver header
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __APM32F0XX_PMU_H
+#define __APM32F0XX_PMU_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "apm32f0xx.h"
+
+typedef enum
+{
+    PMU_SLEEPENTRY_WFI = 0x00,
+    PMU_SLEEPENTRY_WFE = 0x01
+} PMU_SLEEPENTRY_T;
+
+void PMU_EnterSleepMode(PMU_SLEEPENTRY_T entry);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APM32F0XX_PMU_H */
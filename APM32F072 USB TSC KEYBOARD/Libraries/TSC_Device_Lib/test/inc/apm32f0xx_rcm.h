@@ -0,0 +1,55 @@
+/*!
+ * @file        apm32f0xx_rcm.h
+ *
+ * @brief       Host replacement of the RCM driver header
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __APM32F0XX_RCM_H
+#define __APM32F0XX_RCM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "apm32f0xx.h"
+
+typedef enum
+{
+    RCM_AHB_PERIPH_DMA1  = BIT0,
+    RCM_AHB_PERIPH_CRC   = BIT6,
+    RCM_AHB_PERIPH_GPIOA = BIT17,
+    RCM_AHB_PERIPH_GPIOB = BIT18,
+    RCM_AHB_PERIPH_GPIOC = BIT19,
+    RCM_AHB_PERIPH_GPIOD = BIT20,
+    RCM_AHB_PERIPH_GPIOE = BIT21,
+    RCM_AHB_PERIPH_TSC   = BIT24
+} RCM_AHB_PERIPH_T;
+
+void RCM_EnableAHBPeriphClock(uint32_t AHBPeriph);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APM32F0XX_RCM_H */
@@ -0,0 +1,58 @@
+/*!
+ * @file        apm32f0xx_tmr.h
+ *
+ * @brief       Host replacement of the TMR driver header
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __APM32F0XX_TMR_H
+#define __APM32F0XX_TMR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "apm32f0xx.h"
+
+typedef enum
+{
+    TMR_INT_UPDATE = 0x0001,
+    TMR_INT_CH1    = 0x0002
+} TMR_INT_T;
+
+typedef enum
+{
+    TMR_INT_FLAG_UPDATE = 0x0001,
+    TMR_INT_FLAG_CH1    = 0x0002
+} TMR_INT_FLAG_T;
+
+void TMR_EnableInterrupt(TMR_T* TMRx, uint16_t interrupt);
+void TMR_DisableInterrupt(TMR_T* TMRx, uint16_t interrupt);
+uint16_t TMR_ReadIntFlag(TMR_T* TMRx, TMR_INT_FLAG_T flag);
+void TMR_ClearIntFlag(TMR_T* TMRx, uint16_t flag);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __APM32F0XX_TMR_H */
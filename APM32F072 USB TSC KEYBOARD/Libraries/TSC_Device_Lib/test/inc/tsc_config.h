@@ -0,0 +1,426 @@
+/*!
+ * @file        tsc_config.h
+ *
+ * @brief       Acquisition parameters of the host tests, the values of the USBD_HID example.
+ *              Each parameter can be changed with -D on the compiler command line.
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+#ifndef __TSC_CONFIG_H
+#define __TSC_CONFIG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Config Config
+  @{
+*/
+
+/* Objects: one TouchKey per channel */
+#define TOUCH_TOTAL_TOUCHKEYS (0 TOUCH_SENSOR_KEYS(TSC_SNS_X_ONE))
+#define TOUCH_TOTAL_TOUCHKEYS_B (0)
+#define TOUCH_TOTAL_LINROTS (0)
+#define TOUCH_TOTAL_LINROTS_B (0)
+#define TOUCH_TOTAL_MATRICES (0)
+#define TOUCH_TOTAL_OBJECTS (TOUCH_TOTAL_TOUCHKEYS)
+#define TOUCH_SOA_CHANNEL_DATA MyChannels_Data
+#define TOUCH_DISCHARGE_TIMER TMR14
+
+/* IO types */
+#define NU      (0) //!< Not Used IO
+#define CHANNEL (1) //!< Channel IO
+#define SHIELD  (2) //!< Shield IO (= Channel IO but not acquired)
+#define SAMPCAP (3) //!< Sampling Capacitor IO
+
+/* Sensor description: TEST_KEYS 5 is the example board, 8 adds 3 keys */
+#ifndef TEST_KEYS
+#define TEST_KEYS (5)
+#endif
+
+#define TOUCH_SENSOR_CHANNELS(X) \
+    TOUCH_SENSOR_KEYS(X)
+
+#if TEST_KEYS == 8
+#define TOUCH_SENSOR_KEYS(X) \
+    X(0, 1, 4) \
+    X(1, 1, 2) \
+    X(2, 2, 2) \
+    X(3, 2, 3) \
+    X(4, 2, 4) \
+    X(5, 1, 3) \
+    X(6, 3, 2) \
+    X(7, 3, 3)
+
+#define TOUCH_SENSOR_SAMPCAPS(X) \
+    X(1, 1) \
+    X(2, 1) \
+    X(3, 1)
+#else
+#define TOUCH_SENSOR_KEYS(X) \
+    X(0, 1, 4) /*!< TouchKey 0: PA3 */ \
+    X(1, 1, 2) /*!< TouchKey 1: PA1 */ \
+    X(2, 2, 2) /*!< TouchKey 2: PA5 */ \
+    X(3, 2, 3) /*!< TouchKey 3: PA6 */ \
+    X(4, 2, 4) /*!< TouchKey 4: PA7 */
+
+#define TOUCH_SENSOR_SAMPCAPS(X) \
+    X(1, 1) /*!< PA0 */ \
+    X(2, 1) /*!< PA4 */
+#endif
+
+#define TOUCH_SENSOR_SHIELDS(X)
+
+/* Acquisition engine */
+#ifndef TOUCH_USE_MEAS
+#define TOUCH_USE_MEAS (1)
+#endif
+#ifndef TOUCH_USE_ZONE
+#define TOUCH_USE_ZONE (0)
+#endif
+#ifndef TOUCH_USE_PROX
+#define TOUCH_USE_PROX (1)
+#endif
+#ifndef TOUCH_USE_TIMER_CALLBACK
+#define TOUCH_USE_TIMER_CALLBACK (0)
+#endif
+#ifndef TOUCH_USE_ACQ_INTERRUPT
+#define TOUCH_USE_ACQ_INTERRUPT (1)
+#endif
+#ifndef TOUCH_ACQ_FRAME_QUEUE
+#define TOUCH_ACQ_FRAME_QUEUE (4)
+#endif
+#ifndef TOUCH_SCAN_IDLE_DIVIDER
+#define TOUCH_SCAN_IDLE_DIVIDER (4)
+#endif
+#ifndef TOUCH_USE_DMA_READOUT
+#define TOUCH_USE_DMA_READOUT (0)
+#endif
+#ifndef TOUCH_DMA_READOUT_CHANNEL
+#define TOUCH_DMA_READOUT_CHANNEL (7)
+#endif
+#ifndef TOUCH_USE_SOA
+#define TOUCH_USE_SOA (0)
+#endif
+#ifndef TOUCH_USE_FILTER_BANK
+#define TOUCH_USE_FILTER_BANK (1)
+#endif
+#ifndef TOUCH_FILTER_MAX_STAGES
+#define TOUCH_FILTER_MAX_STAGES (2)
+#endif
+#ifndef TOUCH_USE_ACQ_CYCLE_COUNT
+#define TOUCH_USE_ACQ_CYCLE_COUNT (0)
+#endif
+
+/* Calibration snapshot, the flash page is mapped by the test */
+#ifndef TOUCH_USE_SNAPSHOT
+#define TOUCH_USE_SNAPSHOT (0)
+#endif
+#ifndef TOUCH_SNAPSHOT_PAGE_ADDR
+#define TOUCH_SNAPSHOT_PAGE_ADDR (0x0801F800)
+#endif
+#ifndef TOUCH_SNAPSHOT_PAGE_SIZE
+#define TOUCH_SNAPSHOT_PAGE_SIZE (2048)
+#endif
+#ifndef TOUCH_SNAPSHOT_CHECK_SAMPLES
+#define TOUCH_SNAPSHOT_CHECK_SAMPLES (2)
+#endif
+#ifndef TOUCH_SNAPSHOT_MATCH_TH
+#define TOUCH_SNAPSHOT_MATCH_TH (50)
+#endif
+#ifndef TOUCH_SNAPSHOT_SAVE_TH
+#define TOUCH_SNAPSHOT_SAVE_TH (8)
+#endif
+#ifndef TOUCH_SNAPSHOT_PERIOD
+#define TOUCH_SNAPSHOT_PERIOD (60)
+#endif
+
+/* Events and gestures */
+#ifndef TOUCH_USE_EVENT
+#define TOUCH_USE_EVENT (1)
+#endif
+#ifndef TOUCH_EVENT_QUEUE_SIZE
+#define TOUCH_EVENT_QUEUE_SIZE (16)
+#endif
+#ifndef TOUCH_USE_GESTURE
+#define TOUCH_USE_GESTURE (1)
+#endif
+#ifndef TOUCH_GESTURE_QUEUE_SIZE
+#define TOUCH_GESTURE_QUEUE_SIZE (8)
+#endif
+#ifndef TOUCH_GESTURE_TAP_MS
+#define TOUCH_GESTURE_TAP_MS (250)
+#endif
+#ifndef TOUCH_GESTURE_DOUBLE_TAP_MS
+#define TOUCH_GESTURE_DOUBLE_TAP_MS (250)
+#endif
+#ifndef TOUCH_GESTURE_LONG_PRESS_MS
+#define TOUCH_GESTURE_LONG_PRESS_MS (800)
+#endif
+#ifndef TOUCH_GESTURE_REPEAT_MS
+#define TOUCH_GESTURE_REPEAT_MS (100)
+#endif
+#ifndef TOUCH_GESTURE_SWIPE_MS
+#define TOUCH_GESTURE_SWIPE_MS (400)
+#endif
+#ifndef TOUCH_GESTURE_SWIPE_DIST
+#define TOUCH_GESTURE_SWIPE_DIST (48)
+#endif
+
+/* Low-power guard scan */
+#ifndef TOUCH_USE_LOWPOWER
+#define TOUCH_USE_LOWPOWER (1)
+#endif
+#ifndef TOUCH_LP_IDLE_SEC
+#define TOUCH_LP_IDLE_SEC (10)
+#endif
+#ifndef TOUCH_LP_SCAN_PERIOD
+#define TOUCH_LP_SCAN_PERIOD (50)
+#endif
+#ifndef TOUCH_LP_WAKE_TH
+#define TOUCH_LP_WAKE_TH (10)
+#endif
+
+/* Startup tuning, off: it polls the end of acquisition */
+#ifndef TOUCH_USE_TUNE
+#define TOUCH_USE_TUNE (0)
+#endif
+#ifndef TOUCH_TUNE_SAMPLES
+#define TOUCH_TUNE_SAMPLES (8)
+#endif
+#ifndef TOUCH_TUNE_SNR
+#define TOUCH_TUNE_SNR (200)
+#endif
+#ifndef TOUCH_TUNE_USE_SS
+#define TOUCH_TUNE_USE_SS (1)
+#endif
+
+/* Recovery and telemetry */
+#ifndef TOUCH_USE_RECOVERY
+#define TOUCH_USE_RECOVERY (1)
+#endif
+#ifndef TOUCH_RECOV_DELAY_MIN
+#define TOUCH_RECOV_DELAY_MIN (1)
+#endif
+#ifndef TOUCH_RECOV_DELAY_MAX
+#define TOUCH_RECOV_DELAY_MAX (32)
+#endif
+#ifndef TOUCH_RECOV_STABLE_SEC
+#define TOUCH_RECOV_STABLE_SEC (30)
+#endif
+#ifndef TOUCH_USE_TELEMETRY
+#define TOUCH_USE_TELEMETRY (1)
+#endif
+#ifndef TOUCH_TELEM_BUFFER_SIZE
+#define TOUCH_TELEM_BUFFER_SIZE (1024)
+#endif
+
+/* Acquisition limits and calibration */
+#ifndef TOUCH_ACQ_MIN
+#define TOUCH_ACQ_MIN (10)
+#endif
+#ifndef TOUCH_ACQ_MAX
+#define TOUCH_ACQ_MAX (8191)
+#endif
+#ifndef TOUCH_CALIB_SAMPLES
+#define TOUCH_CALIB_SAMPLES (16)
+#endif
+#ifndef TOUCH_CALIB_DELAY
+#define TOUCH_CALIB_DELAY (0)
+#endif
+
+/* TouchKey thresholds */
+#ifndef TOUCH_KEY_PROX_IN_TH
+#define TOUCH_KEY_PROX_IN_TH (10)
+#endif
+#ifndef TOUCH_KEY_PROX_OUT_TH
+#define TOUCH_KEY_PROX_OUT_TH (5)
+#endif
+#ifndef TOUCH_KEY_DETECT_IN_TH
+#define TOUCH_KEY_DETECT_IN_TH (200)
+#endif
+#ifndef TOUCH_KEY_DETECT_OUT_TH
+#define TOUCH_KEY_DETECT_OUT_TH (150)
+#endif
+#ifndef TOUCH_KEY_CALIB_TH
+#define TOUCH_KEY_CALIB_TH (150)
+#endif
+#ifndef TOUCH_COEFF_TH
+#define TOUCH_COEFF_TH (0)
+#endif
+
+/* Linear/Rotary and Matrix thresholds, not used */
+#define TOUCH_LINROT_PROX_IN_TH (10)
+#define TOUCH_LINROT_PROX_OUT_TH (5)
+#define TOUCH_LINROT_DETECT_IN_TH (20)
+#define TOUCH_LINROT_DETECT_OUT_TH (15)
+#define TOUCH_LINROT_CALIB_TH (30)
+#define TOUCH_LINROT_USE_NORMDELTA (0)
+#define TOUCH_MATRIX_DETECT_IN_TH (60)
+#define TOUCH_MATRIX_DETECT_OUT_TH (40)
+#define TOUCH_MATRIX_CALIB_TH (50)
+#define TOUCH_USE_3CH_LIN_M1 (1)
+#define TOUCH_USE_3CH_LIN_M2 (1)
+#define TOUCH_USE_3CH_LIN_H (1)
+#define TOUCH_USE_3CH_ROT_M (1)
+#define TOUCH_USE_4CH_LIN_M1 (1)
+#define TOUCH_USE_4CH_LIN_M2 (1)
+#define TOUCH_USE_4CH_LIN_H (1)
+#define TOUCH_USE_4CH_ROT_M (1)
+#define TOUCH_USE_5CH_LIN_M1 (1)
+#define TOUCH_USE_5CH_LIN_M2 (1)
+#define TOUCH_USE_5CH_LIN_H (1)
+#define TOUCH_USE_5CH_ROT_M (1)
+#define TOUCH_USE_5CH_ROT_D (1)
+#define TOUCH_USE_6CH_LIN_M1 (1)
+#define TOUCH_USE_6CH_LIN_M2 (1)
+#define TOUCH_USE_6CH_LIN_H (1)
+#define TOUCH_USE_6CH_ROT_M (1)
+#define TOUCH_LINROT_RESOLUTION (7)
+#define TOUCH_LINROT_DIR_CHG_POS (10)
+#define TOUCH_LINROT_DIR_CHG_DEB (1)
+#define TOUCH_LINROT_USE_CENTROID (1)
+#define TOUCH_LINROT_POS_BITS (10)
+#define TOUCH_LINROT_SMOOTHING (2)
+#define TOUCH_LINROT_USE_VELOCITY (1)
+
+/* Debounce */
+#ifndef TOUCH_DEBOUNCE_PROX
+#define TOUCH_DEBOUNCE_PROX (3)
+#endif
+#ifndef TOUCH_DEBOUNCE_DETECT
+#define TOUCH_DEBOUNCE_DETECT (2)
+#endif
+#ifndef TOUCH_DEBOUNCE_RELEASE
+#define TOUCH_DEBOUNCE_RELEASE (3)
+#endif
+#ifndef TOUCH_DEBOUNCE_CALIB
+#define TOUCH_DEBOUNCE_CALIB (3)
+#endif
+#ifndef TOUCH_DEBOUNCE_ERROR
+#define TOUCH_DEBOUNCE_ERROR (3)
+#endif
+#ifndef TOUCH_USE_ADAPTIVE_DEBOUNCE
+#define TOUCH_USE_ADAPTIVE_DEBOUNCE (1)
+#endif
+#ifndef TOUCH_DEBOUNCE_DETECT_MIN
+#define TOUCH_DEBOUNCE_DETECT_MIN (0)
+#endif
+#ifndef TOUCH_DEBOUNCE_DETECT_MAX
+#define TOUCH_DEBOUNCE_DETECT_MAX (4)
+#endif
+#ifndef TOUCH_DEBOUNCE_SNR
+#define TOUCH_DEBOUNCE_SNR (8)
+#endif
+#ifndef TOUCH_DEBOUNCE_NOISE_WEIGHT
+#define TOUCH_DEBOUNCE_NOISE_WEIGHT (4)
+#endif
+
+/* ECS, DTO and DxS */
+#ifndef TOUCH_ECS_K_DIFFER
+#define TOUCH_ECS_K_DIFFER (10)
+#endif
+#ifndef TOUCH_ECS_K_SAME
+#define TOUCH_ECS_K_SAME (20)
+#endif
+#ifndef TOUCH_ECS_DELAY
+#define TOUCH_ECS_DELAY (500)
+#endif
+#ifndef TOUCH_ECS_INCREMENTAL
+#define TOUCH_ECS_INCREMENTAL (1)
+#endif
+#ifndef TOUCH_ECS_PERIOD
+#define TOUCH_ECS_PERIOD (100)
+#endif
+#ifndef TOUCH_ECS_MAX_SLICE
+#define TOUCH_ECS_MAX_SLICE (2)
+#endif
+#ifndef TOUCH_DTO
+#define TOUCH_DTO (10)
+#endif
+#ifndef TOUCH_USE_DXS
+#define TOUCH_USE_DXS (0)
+#endif
+
+/* Timing, TMR14 is simulated */
+#ifndef TOUCH_TICK_FREQ
+#define TOUCH_TICK_FREQ (1000)
+#endif
+#ifndef TOUCH_DELAY_DISCHARGE_US
+#define TOUCH_DELAY_DISCHARGE_US (106)
+#endif
+#ifndef TOUCH_USE_DISCHARGE_TIMER
+#define TOUCH_USE_DISCHARGE_TIMER (1)
+#endif
+#ifndef TOUCH_DISCHARGE_TIMER_PERIOD
+#define TOUCH_DISCHARGE_TIMER_PERIOD (1000)
+#endif
+
+/* Charge transfer */
+#ifndef TOUCH_TSC_GPIO_CONFIG
+#define TOUCH_TSC_GPIO_CONFIG (1)
+#endif
+#ifndef TOUCH_TSC_CTPHSEL
+#define TOUCH_TSC_CTPHSEL (1)
+#endif
+#ifndef TOUCH_TSC_CTPLSEL
+#define TOUCH_TSC_CTPLSEL (1)
+#endif
+#ifndef TOUCH_TSC_PGCDFSEL
+#define TOUCH_TSC_PGCDFSEL (3)
+#endif
+#ifndef TOUCH_TSC_IODEF
+#define TOUCH_TSC_IODEF (0)
+#endif
+#ifndef TOUCH_TSC_AMCFG
+#define TOUCH_TSC_AMCFG (0)
+#endif
+#ifndef TOUCH_TSC_SYNC_PIN
+#define TOUCH_TSC_SYNC_PIN (0)
+#endif
+#ifndef TOUCH_TSC_SYNC_POL
+#define TOUCH_TSC_SYNC_POL (0)
+#endif
+#ifndef TOUCH_TSC_USE_SSEN
+#define TOUCH_TSC_USE_SSEN (0)
+#endif
+#ifndef TOUCH_TSC_SSERRVSEL
+#define TOUCH_TSC_SSERRVSEL (0)
+#endif
+#ifndef TOUCH_TSC_SSCDFSEL
+#define TOUCH_TSC_SSCDFSEL (0)
+#endif
+
+#include "tsc_sensor.h"
+#include "tsc_check.h"
+
+/**@} end of group TSC_Test_Config */
+/**@} end of group TSC_Test */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_CONFIG_H */
@@ -0,0 +1,98 @@
+/*!
+ * @file        tsc_host.h
+ *
+ * @brief       Header of the host copy of the example touch configuration
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __TSC_HOST_H
+#define __TSC_HOST_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include <stdio.h>
+#include "tsc.h"
+#include "tsc_sim.h"
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Host Host
+  @{
+*/
+
+/** @defgroup TSC_Test_Host_Macros Macros
+  @{
+*/
+
+/* Check of a test, the failures are counted in HostFailures */
+#define HOST_CHECK(cond) \
+    do \
+    { \
+        if (!(cond)) \
+        { \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            HostFailures++; \
+        } \
+    } while (0)
+
+/**@} end of group TSC_Test_Host_Macros */
+
+/** @defgroup TSC_Test_Host_Variables Variables
+  @{
+*/
+
+extern CONST TSC_TouchKey_T MyTouchKeys[];
+extern CONST TSC_Object_T MyObjects[];
+extern TSC_ObjectGroup_T MyObjGroup;
+extern uint32_t Global_ProcessSensor;
+extern uint32_t HostFailures;
+#if TOUCH_USE_SNAPSHOT > 0
+extern uint8_t HostSnapSave;
+#endif
+
+/**@} end of group TSC_Test_Host_Variables */
+
+/** @defgroup TSC_Test_Host_Functions Functions
+  @{
+*/
+
+void         Host_Config(uint32_t seed);
+TSC_STATUS_T Host_Action(void);
+uint32_t     Host_ReadKeyIo(uint32_t key);
+void         Host_TouchKey(uint32_t key, uint16_t count);
+void         Host_RunFor(uint64_t cycles, void (*frameHandler)(void));
+int          Host_Report(void);
+
+/**@} end of group TSC_Test_Host_Functions */
+/**@} end of group TSC_Test_Host */
+/**@} end of group TSC_Test */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_HOST_H */
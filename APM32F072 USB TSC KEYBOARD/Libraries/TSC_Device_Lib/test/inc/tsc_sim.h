@@ -0,0 +1,111 @@
+/*!
+ * @file        tsc_sim.h
+ *
+ * @brief       Header of the simulated TSC, TMR14 and SysTick peripherals
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Define to prevent recursive inclusion */
+#ifndef __TSC_SIM_H
+#define __TSC_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Includes */
+#include "apm32f0xx.h"
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Sim Simulation
+  @{
+*/
+
+/** @defgroup TSC_Test_Sim_Macros Macros
+  @{
+*/
+
+/* HCLK of the simulated device */
+#define SIM_HCLK            (48000000)
+/* TMR14 counts microseconds (prescaler of 48 as in the example) */
+#define SIM_TMR_DIV         (SIM_HCLK / 1000000)
+/* Conversions of the simulated time */
+#define SIM_US(us)          ((uint64_t)(us) * (SIM_HCLK / 1000000))
+#define SIM_MS(ms)          ((uint64_t)(ms) * (SIM_HCLK / 1000))
+#define SIM_TO_US(cycles)   ((cycles) / (SIM_HCLK / 1000000))
+
+/**@} end of group TSC_Test_Sim_Macros */
+
+/** @defgroup TSC_Test_Sim_Structures Structures
+  @{
+*/
+
+/**
+ * @brief   Counters of the simulation
+ */
+typedef struct
+{
+    uint32_t Bursts;       /*!< Bursts acquired */
+    uint32_t MaxCountErr;  /*!< Bursts ended by a max count error */
+    uint32_t EarlyStart;   /*!< Bursts started before the end of the discharge */
+    uint32_t TimerMiss;    /*!< Auto-reload values written below the counter */
+    uint32_t Wakeups;      /*!< Interrupts ending a WFI */
+    uint64_t BurstTime;    /*!< HCLK cycles with a burst running */
+    uint64_t SleepTime;    /*!< HCLK cycles spent in WFI */
+} SIM_Stats_T;
+
+/**@} end of group TSC_Test_Sim_Structures */
+
+/** @defgroup TSC_Test_Sim_Variables Variables
+  @{
+*/
+
+extern SIM_Stats_T SimStats;
+
+/**@} end of group TSC_Test_Sim_Variables */
+
+/** @defgroup TSC_Test_Sim_Functions Functions
+  @{
+*/
+
+void     Sim_Reset(uint32_t seed);
+uint64_t Sim_ReadTime(void);
+void     Sim_ConfigCount(uint32_t ioMask, uint16_t count);
+void     Sim_ConfigNoise(uint32_t ioMask, uint16_t amplitude);
+void     Sim_ConfigDischarge(uint32_t us);
+int      Sim_ConfigFlash(uint32_t addr, uint32_t size);
+void     Sim_ConfigFlashFail(int32_t words);
+void     Sim_Sync(void);
+int      Sim_Step(void);
+void     Sim_RunFor(uint64_t cycles);
+
+/**@} end of group TSC_Test_Sim_Functions */
+/**@} end of group TSC_Test_Sim */
+/**@} end of group TSC_Test */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TSC_SIM_H */
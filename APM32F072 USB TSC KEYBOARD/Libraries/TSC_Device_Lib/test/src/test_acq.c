@@ -0,0 +1,254 @@
+/*!
+ * @file        test_acq.c
+ *
+ * @brief       Host test of the interrupt acquisition engine and of its Frame queue
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "tsc_host.h"
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Acq Acquisition
+  @{
+*/
+
+/** @defgroup TSC_Test_Acq_Macros Macros
+  @{
+*/
+
+/* Count of the electrodes, lowered by TEST_TOUCH_DELTA when touched */
+#define TEST_COUNT          (1500)
+#define TEST_TOUCH_DELTA    (300)
+#define TEST_NOISE          (4)
+/* Presses measured for the latency */
+#define TEST_PRESSES        (100)
+
+/**@} end of group TSC_Test_Acq_Macros */
+
+/** @defgroup TSC_Test_Acq_Variables Variables
+  @{
+*/
+
+static uint32_t         FrameCount;
+static TSC_tTick_ms_T   FrameTick;
+static uint32_t         FrameDisorder;
+
+/**@} end of group TSC_Test_Acq_Variables */
+
+/** @defgroup TSC_Test_Acq_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Main loop: process the Frames and check their order
+ *
+ * @param       cycles: HCLK cycles
+ *
+ * @retval      None
+ */
+static void Test_RunFor(uint64_t cycles)
+{
+    uint64_t end = Sim_ReadTime() + cycles;
+    CONST TSC_Frame_T *frame;
+
+    while (Sim_ReadTime() < end)
+    {
+        while ((frame = TSC_Acq_ReadFrame()) != 0)
+        {
+            if (FrameCount && ((int16_t)(TSC_tTick_ms_T)(frame->Tick - FrameTick) < 0))
+            {
+                FrameDisorder++;
+            }
+            FrameTick = frame->Tick;
+            FrameCount++;
+            Host_Action();
+        }
+        Sim_Step();
+    }
+}
+
+/*!
+ * @brief       Run until a key reaches a state
+ *
+ * @param       key: TouchKey index
+ *
+ * @param       stateId: State to reach
+ *
+ * @param       timeout: HCLK cycles
+ *
+ * @retval      HCLK cycles spent, timeout if the state is not reached
+ */
+static uint64_t Test_WaitState(uint32_t key, TSC_STATEID_T stateId, uint64_t timeout)
+{
+    uint64_t start = Sim_ReadTime();
+
+    while ((MyTouchKeys[key].p_Data->StateId != stateId) && ((Sim_ReadTime() - start) < timeout))
+    {
+        Test_RunFor(1);
+    }
+    return Sim_ReadTime() - start;
+}
+
+/*!
+ * @brief       Frame rate and calibration of all keys
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Test_FrameRate(void)
+{
+    uint32_t key;
+    uint32_t frames;
+    uint32_t bursts;
+
+    Host_Config(1);
+    Sim_ConfigCount(0xFFFFFFFF, TEST_COUNT);
+    Sim_ConfigNoise(0xFFFFFFFF, TEST_NOISE);
+
+    /* Calibration */
+    Test_RunFor(SIM_MS(1000));
+    for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+    {
+        HOST_CHECK(MyTouchKeys[key].p_Data->StateId == TSC_STATEID_RELEASE);
+        HOST_CHECK(MyTouchKeys[key].p_ChD->Meas > TEST_COUNT - 2 * TEST_NOISE);
+        HOST_CHECK(MyTouchKeys[key].p_ChD->Meas < TEST_COUNT + 2 * TEST_NOISE);
+    }
+
+    frames = FrameCount;
+    bursts = SimStats.Bursts;
+    Test_RunFor(SIM_MS(1000));
+    frames = FrameCount - frames;
+    bursts = SimStats.Bursts - bursts;
+
+    printf("frame rate: %u frames/s, %u bursts/s, %u keys in %u blocks\n",
+           (unsigned)frames, (unsigned)bursts, (unsigned)TOUCH_TOTAL_KEYS, (unsigned)TOUCH_TOTAL_BLOCKS);
+
+    HOST_CHECK(frames > 100);
+    HOST_CHECK(FrameDisorder == 0);
+    HOST_CHECK(TSC_Acq_ReadOverrun() == 0);
+    HOST_CHECK(SimStats.EarlyStart == 0);
+    HOST_CHECK(SimStats.TimerMiss == 0);
+    HOST_CHECK(SimStats.MaxCountErr == 0);
+}
+
+/*!
+ * @brief       Press to detect latency, the presses start at random times
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Test_Latency(void)
+{
+    uint64_t latency;
+    uint64_t sum = 0;
+    uint64_t min = UINT64_MAX;
+    uint64_t max = 0;
+    uint32_t idx;
+    uint32_t key;
+    uint32_t seed = 12345;
+
+    for (idx = 0; idx < TEST_PRESSES; idx++)
+    {
+        key = idx % TOUCH_TOTAL_KEYS;
+
+        /* Press at a random phase of the frame */
+        seed = seed * 1103515245 + 12345;
+        Test_RunFor(SIM_US(1000 + ((seed >> 8) % 5000)));
+
+        Host_TouchKey(key, TEST_COUNT - TEST_TOUCH_DELTA);
+        latency = Test_WaitState(key, TSC_STATEID_DETECT, SIM_MS(500));
+        HOST_CHECK(latency < SIM_MS(500));
+
+        sum += latency;
+        min = (latency < min) ? latency : min;
+        max = (latency > max) ? latency : max;
+
+        Host_TouchKey(key, TEST_COUNT);
+        HOST_CHECK(Test_WaitState(key, TSC_STATEID_RELEASE, SIM_MS(500)) < SIM_MS(500));
+    }
+
+    printf("press to detect: min %.2f ms, avg %.2f ms, max %.2f ms (%u presses)\n",
+           SIM_TO_US((double)min) / 1000, SIM_TO_US((double)sum / TEST_PRESSES) / 1000,
+           SIM_TO_US((double)max) / 1000, (unsigned)TEST_PRESSES);
+
+    HOST_CHECK(FrameDisorder == 0);
+    HOST_CHECK(TSC_Acq_ReadOverrun() == 0);
+    HOST_CHECK(SimStats.EarlyStart == 0);
+    HOST_CHECK(SimStats.TimerMiss == 0);
+}
+
+/*!
+ * @brief       Consumer stalled: the queue keeps the oldest Frames and counts the dropped ones
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Test_Overrun(void)
+{
+    CONST TSC_Frame_T *frame;
+    TSC_tTick_ms_T stallTick = TSC_Globals.Tick_ms;
+    TSC_tTick_ms_T lastTick = stallTick;
+    uint32_t queued = 0;
+
+    /* Interrupts only, the main loop does not read the queue for 100 ms */
+    Sim_RunFor(SIM_MS(100));
+    HOST_CHECK(TSC_Acq_ReadOverrun() > 0);
+
+    while ((frame = TSC_Acq_ReadFrame()) != 0)
+    {
+        HOST_CHECK((int16_t)(TSC_tTick_ms_T)(frame->Tick - lastTick) >= 0);
+        HOST_CHECK((TSC_tTick_ms_T)(frame->Tick - stallTick) < 20);
+        lastTick = frame->Tick;
+        TSC_Acq_ReleaseFrame();
+        queued++;
+    }
+
+    printf("stalled consumer: %u frames queued, %u dropped\n",
+           (unsigned)queued, (unsigned)TSC_Acq_ReadOverrun());
+    HOST_CHECK(queued == TOUCH_ACQ_FRAME_QUEUE - 1);
+
+    /* The next Frame is a new one */
+    FrameCount = 0;
+    Test_RunFor(SIM_MS(20));
+    HOST_CHECK(FrameCount > 0);
+    HOST_CHECK((TSC_tTick_ms_T)(FrameTick - stallTick) >= 100);
+    HOST_CHECK(SimStats.EarlyStart == 0);
+    HOST_CHECK(SimStats.TimerMiss == 0);
+}
+
+int main(void)
+{
+    Test_FrameRate();
+    Test_Latency();
+    Test_Overrun();
+    return Host_Report();
+}
+
+/**@} end of group TSC_Test_Acq_Functions */
+/**@} end of group TSC_Test_Acq */
+/**@} end of group TSC_Test */
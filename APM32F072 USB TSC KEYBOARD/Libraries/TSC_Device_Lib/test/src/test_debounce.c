@@ -0,0 +1,442 @@
+/*!
+ * @file        test_debounce.c
+ *
+ * @brief       Host replay of delta traces through the TouchKey state machine,
+ *              built with TOUCH_USE_ADAPTIVE_DEBOUNCE 0 and 1
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/*
+ * The trace is a list of samples "delta touch [section]", touch is 1 while the
+ * finger is on the key and section groups the samples in the report. Without
+ * argument a trace is generated from a fixed seed: for each noise level, idle
+ * samples with a gaussian noise and touches of 1.5 x TOUCH_KEY_DETECT_IN_TH.
+ *
+ *   test_debounce1 [trace.txt]       replay a trace
+ *   test_debounce1 -w trace.txt      write the generated trace
+ *
+ * Each touch gives the samples from its first sample to the Detect state, the
+ * Detect states entered without touch are false detections.
+ */
+
+/* Includes */
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tsc_host.h"
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Debounce Debounce
+  @{
+*/
+
+/** @defgroup TSC_Test_Debounce_Macros Macros
+  @{
+*/
+
+#define TEST_KEY            (0)
+/* Noise levels of the generated trace (delta standard deviation) */
+#define TEST_SECTIONS       (6)
+#define TEST_TOUCHES        (400)
+#define TEST_TOUCH_SAMPLES  (30)
+#define TEST_TOUCH_LEVEL    ((TOUCH_KEY_DETECT_IN_TH * 3) / 2)
+/* Latencies counted one by one, the longer ones are added to the last bin */
+#define TEST_BINS           (8)
+
+/**@} end of group TSC_Test_Debounce_Macros */
+
+/** @defgroup TSC_Test_Debounce_Structures Structures
+  @{
+*/
+
+typedef struct
+{
+    int16_t  Delta;
+    uint8_t  Touch;
+    uint8_t  Section;
+} TEST_Sample_T;
+
+typedef struct
+{
+    uint32_t Touches;
+    uint32_t Missed;
+    uint32_t FalseDetect;
+    uint32_t Bin[TEST_BINS + 1];
+    uint32_t Sum;
+    uint32_t IdleSamples;
+    double   NoiseSum;
+} TEST_Stats_T;
+
+/**@} end of group TSC_Test_Debounce_Structures */
+
+/** @defgroup TSC_Test_Debounce_Variables Variables
+  @{
+*/
+
+static CONST uint16_t TestNoise[TEST_SECTIONS] = { 5, 15, 25, 35, 50, 65 };
+
+static TEST_Sample_T *Trace;
+static uint32_t       TraceSize;
+static uint8_t        TraceGenerated;
+static TEST_Stats_T   Stats[256];
+static uint32_t       RandSeed = 2023;
+
+/**@} end of group TSC_Test_Debounce_Variables */
+
+/** @defgroup TSC_Test_Debounce_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Return a uniform random number in ]0, 1[
+ *
+ * @param       None
+ *
+ * @retval      Random number
+ */
+static double Test_Random(void)
+{
+    RandSeed ^= RandSeed << 13;
+    RandSeed ^= RandSeed >> 17;
+    RandSeed ^= RandSeed << 5;
+    return (RandSeed + 0.5) / 4294967296.0;
+}
+
+/*!
+ * @brief       Return a gaussian random number (Box-Muller)
+ *
+ * @param       sd: Standard deviation
+ *
+ * @retval      Random number
+ */
+static int16_t Test_Gauss(double sd)
+{
+    double value = sd * sqrt(-2.0 * log(Test_Random())) * cos(6.283185307179586 * Test_Random());
+
+    return (int16_t)lround(value);
+}
+
+/*!
+ * @brief       Add a sample to the trace
+ *
+ * @param       delta: Delta
+ *
+ * @param       touch: 1 if the finger is on the key
+ *
+ * @param       section: Section of the report
+ *
+ * @retval      None
+ */
+static void Test_AddSample(int32_t delta, uint8_t touch, uint8_t section)
+{
+    static uint32_t capacity = 0;
+
+    if (TraceSize == capacity)
+    {
+        capacity = capacity ? capacity * 2 : 4096;
+        Trace = realloc(Trace, capacity * sizeof(TEST_Sample_T));
+        if (Trace == 0)
+        {
+            exit(2);
+        }
+    }
+    Trace[TraceSize].Delta = (int16_t)delta;
+    Trace[TraceSize].Touch = touch;
+    Trace[TraceSize].Section = section;
+    TraceSize++;
+}
+
+/*!
+ * @brief       Generate the trace: idle and touches for each noise level
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Test_Generate(void)
+{
+    uint32_t section, touch, idx, idle;
+
+    for (section = 0; section < TEST_SECTIONS; section++)
+    {
+        for (touch = 0; touch < TEST_TOUCHES; touch++)
+        {
+            idle = 60 + (uint32_t)(Test_Random() * 60);
+            for (idx = 0; idx < idle; idx++)
+            {
+                Test_AddSample(Test_Gauss(TestNoise[section]), 0, (uint8_t)section);
+            }
+            for (idx = 0; idx < TEST_TOUCH_SAMPLES; idx++)
+            {
+                Test_AddSample(TEST_TOUCH_LEVEL + Test_Gauss(TestNoise[section]), 1, (uint8_t)section);
+            }
+        }
+    }
+}
+
+/*!
+ * @brief       Read a trace file
+ *
+ * @param       name: File name
+ *
+ * @retval      0 if the trace is read
+ */
+static int Test_ReadTrace(const char *name)
+{
+    FILE *file = fopen(name, "r");
+    char line[64];
+    int  delta, touch, section;
+
+    if (file == 0)
+    {
+        return -1;
+    }
+    while (fgets(line, sizeof(line), file))
+    {
+        section = 0;
+        if ((line[0] != '#') && (sscanf(line, "%d %d %d", &delta, &touch, &section) >= 2))
+        {
+            Test_AddSample(delta, (uint8_t)(touch != 0), (uint8_t)section);
+        }
+    }
+    fclose(file);
+    return 0;
+}
+
+/*!
+ * @brief       Write the trace to a file
+ *
+ * @param       name: File name
+ *
+ * @retval      0 if the trace is written
+ */
+static int Test_WriteTrace(const char *name)
+{
+    FILE *file = fopen(name, "w");
+    uint32_t idx;
+
+    if (file == 0)
+    {
+        return -1;
+    }
+    fprintf(file, "# delta touch section\n");
+    for (idx = 0; idx < TraceSize; idx++)
+    {
+        fprintf(file, "%d %u %u\n", Trace[idx].Delta, Trace[idx].Touch, Trace[idx].Section);
+    }
+    fclose(file);
+    return 0;
+}
+
+/*!
+ * @brief       Give a delta to the TouchKey and run its state machine
+ *
+ * @param       delta: Delta
+ *
+ * @retval      New state
+ */
+static TSC_STATEID_T Test_Process(int16_t delta)
+{
+    CONST TSC_TouchKey_T *key = &MyTouchKeys[TEST_KEY];
+
+    key->p_ChD->Delta = delta;
+    key->p_ChD->Flag.DataReady = TSC_DATA_READY;
+    key->p_ChD->Flag.AcqStatus = TSC_ACQ_STATUS_OK;
+    TSC_TouchKey_ProcessCtx(&MyObjects[TEST_KEY]);
+    return key->p_Data->StateId;
+}
+
+/*!
+ * @brief       Replay the trace and fill the statistics of each section
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Test_Replay(void)
+{
+    CONST TSC_TouchKey_T *key = &MyTouchKeys[TEST_KEY];
+    TEST_Stats_T  *stats;
+    TSC_STATEID_T state, last;
+    uint32_t idx;
+    uint32_t age = 0;
+    uint8_t  pending = 0;
+
+    TSC_TouchKey_ConfigCtx(key);
+    TSC_TouchKey_ConfigReleaseStateCtx(key);
+    last = key->p_Data->StateId;
+
+    for (idx = 0; idx < TraceSize; idx++)
+    {
+        stats = &Stats[Trace[idx].Section];
+
+        /* Start of a touch */
+        if (Trace[idx].Touch && ((idx == 0) || !Trace[idx - 1].Touch))
+        {
+            stats->Touches++;
+            pending = 1;
+            age = 0;
+        }
+        if (!Trace[idx].Touch && pending)
+        {
+            stats->Missed++;
+            pending = 0;
+        }
+
+        state = Test_Process(Trace[idx].Delta);
+        age++;
+
+        if ((state == TSC_STATEID_DETECT) && (last != TSC_STATEID_DETECT) && (last != TSC_STATEID_TOUCH))
+        {
+            if (pending)
+            {
+                stats->Bin[(age < TEST_BINS) ? age : TEST_BINS]++;
+                stats->Sum += age;
+                pending = 0;
+            }
+            else if (!Trace[idx].Touch)
+            {
+                stats->FalseDetect++;
+            }
+        }
+
+#if TOUCH_USE_ADAPTIVE_DEBOUNCE > 0
+        /* Noise estimated by the key in Release state */
+        if (!Trace[idx].Touch && (state == TSC_STATEID_RELEASE))
+        {
+            stats->IdleSamples++;
+            stats->NoiseSum += sqrt(key->p_Data->NoiseVar);
+        }
+#endif
+        last = state;
+    }
+}
+
+/*!
+ * @brief       Print the latency distribution of each section
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Test_Print(void)
+{
+    TEST_Stats_T *stats;
+    uint32_t section, bin, detected;
+
+#if TOUCH_USE_ADAPTIVE_DEBOUNCE > 0
+    printf("adaptive debounce: detect debounce %u..%u, SNR %u, detect threshold %u\n",
+           TOUCH_DEBOUNCE_DETECT_MIN, TOUCH_DEBOUNCE_DETECT_MAX, TOUCH_DEBOUNCE_SNR, TOUCH_KEY_DETECT_IN_TH);
+#else
+    printf("static debounce: detect debounce %u, detect threshold %u\n",
+           TOUCH_DEBOUNCE_DETECT, TOUCH_KEY_DETECT_IN_TH);
+#endif
+    printf("section  noise  est.  touches  latency in samples:");
+    for (bin = 1; bin < TEST_BINS; bin++)
+    {
+        printf(" %4u", (unsigned)bin);
+    }
+    printf("  >=%u  avg   missed  false\n", (unsigned)TEST_BINS);
+
+    for (section = 0; section < 256; section++)
+    {
+        stats = &Stats[section];
+        if (stats->Touches == 0)
+        {
+            continue;
+        }
+        detected = stats->Touches - stats->Missed;
+
+        /* The noise level is only known for the generated trace */
+        if (TraceGenerated && (section < TEST_SECTIONS))
+        {
+            printf("%7u  %5u", (unsigned)section, (unsigned)TestNoise[section]);
+        }
+        else
+        {
+            printf("%7u  %5s", (unsigned)section, "-");
+        }
+        /* Standard deviation estimated by the key, adaptive debounce only */
+        if (stats->IdleSamples)
+        {
+            printf("  %4.1f", stats->NoiseSum / stats->IdleSamples);
+        }
+        else
+        {
+            printf("  %4s", "-");
+        }
+        printf("  %7u  %19s", (unsigned)stats->Touches, "");
+        for (bin = 1; bin <= TEST_BINS; bin++)
+        {
+            printf(" %4u", (unsigned)stats->Bin[bin]);
+        }
+        printf("  %4.2f  %6u  %5u\n", detected ? (double)stats->Sum / detected : 0.0,
+               (unsigned)stats->Missed, (unsigned)stats->FalseDetect);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t section;
+
+    if ((argc == 2) && (argv[1][0] != '-'))
+    {
+        if (Test_ReadTrace(argv[1]) != 0)
+        {
+            printf("cannot read %s\n", argv[1]);
+            return 2;
+        }
+        Test_Replay();
+        Test_Print();
+        return 0;
+    }
+
+    Test_Generate();
+    TraceGenerated = 1;
+    if ((argc == 3) && (strcmp(argv[1], "-w") == 0))
+    {
+        return Test_WriteTrace(argv[2]) ? 2 : 0;
+    }
+
+    Test_Replay();
+    Test_Print();
+
+    for (section = 0; section < TEST_SECTIONS; section++)
+    {
+        HOST_CHECK(Stats[section].Missed == 0);
+    }
+
+    /* Low noise: the debounce is the configured one for all touches */
+#if TOUCH_USE_ADAPTIVE_DEBOUNCE > 0
+    HOST_CHECK(Stats[0].Bin[1 + TOUCH_DEBOUNCE_DETECT_MIN] == Stats[0].Touches);
+#else
+    HOST_CHECK(Stats[0].Bin[1 + TOUCH_DEBOUNCE_DETECT] == Stats[0].Touches);
+#endif
+    HOST_CHECK(Stats[0].FalseDetect == 0);
+    return Host_Report();
+}
+
+/**@} end of group TSC_Test_Debounce_Functions */
+/**@} end of group TSC_Test_Debounce */
+/**@} end of group TSC_Test */
@@ -0,0 +1,297 @@
+/*!
+ * @file        test_gesture.c
+ *
+ * @brief       Host replay of a press/release script through the gesture recognition
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/*
+ * The script gives the events of a TouchKey (object 0) and of a Linear sensor
+ * (object 1) and the gestures expected at each ms. The events are passed to
+ * TSC_Gesture_ProcessEvent(), then TSC_Gesture_Process() is called every ms
+ * as after each frame, and the gestures read must be the expected ones at the
+ * expected tick, in the same order.
+ *
+ * The script is replayed from two start ticks: the second one makes
+ * TSC_Globals.Tick_ms wrap during the long press and its repeats.
+ */
+
+/* Includes */
+#include "tsc_host.h"
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Gesture Gesture
+  @{
+*/
+
+/** @defgroup TSC_Test_Gesture_Macros Macros
+  @{
+*/
+
+#define TEST_KEY            (0)
+#define TEST_LINEAR         (1)
+
+/* Start ticks of the replays, the second one wraps at the long press of 4000 */
+#define TEST_START          (1000)
+#define TEST_START_WRAP     ((TSC_tTick_ms_T)(0x10000 - 4500))
+
+/* Script operations */
+#define TEST_PRESS          (0)
+#define TEST_RELEASE        (1)
+#define TEST_POSITION       (2)
+#define TEST_GESTURE        (3)
+
+/**@} end of group TSC_Test_Gesture_Macros */
+
+/** @defgroup TSC_Test_Gesture_Structures Structures
+  @{
+*/
+
+/* Step of the script */
+typedef struct
+{
+    uint16_t Time;    /*!< ms from the start of the script */
+    uint8_t  Op;      /*!< TEST_PRESS, TEST_RELEASE, TEST_POSITION or TEST_GESTURE */
+    uint8_t  Index;   /*!< Object */
+    uint8_t  Type;    /*!< Expected gesture type */
+    int16_t  Value;   /*!< RawPosition, or expected Count (long press, repeat) or Distance (swipe) */
+    uint16_t Speed;   /*!< Expected swipe speed */
+} TEST_Step_T;
+
+/**@} end of group TSC_Test_Gesture_Structures */
+
+/** @defgroup TSC_Test_Gesture_Variables Variables
+  @{
+*/
+
+/* Timings of tsc_config.h: tap 250, double tap 250, long press 800, repeat 100, swipe 400, 48 */
+static const TEST_Step_T TestScript[] =
+{
+    /* Tap: sent when the double tap gap has elapsed */
+    {    0, TEST_PRESS,    TEST_KEY },
+    {  100, TEST_RELEASE,  TEST_KEY },
+    {  350, TEST_GESTURE,  TEST_KEY, TSC_GESTURE_TAP },
+
+    /* Double tap */
+    { 1000, TEST_PRESS,    TEST_KEY },
+    { 1100, TEST_RELEASE,  TEST_KEY },
+    { 1200, TEST_PRESS,    TEST_KEY },
+    { 1300, TEST_RELEASE,  TEST_KEY },
+    { 1300, TEST_GESTURE,  TEST_KEY, TSC_GESTURE_DOUBLE_TAP },
+
+    /* Second press held: the first tap, then the long press (PRESS_TAP falls through),
+       the deadline of the double tap gap (2350) is replaced by the long press one */
+    { 2000, TEST_PRESS,    TEST_KEY },
+    { 2100, TEST_RELEASE,  TEST_KEY },
+    { 2200, TEST_PRESS,    TEST_KEY },
+    { 3000, TEST_GESTURE,  TEST_KEY, TSC_GESTURE_TAP },
+    { 3000, TEST_GESTURE,  TEST_KEY, TSC_GESTURE_LONG_PRESS, 0 },
+    { 3100, TEST_GESTURE,  TEST_KEY, TSC_GESTURE_REPEAT, 1 },
+    { 3200, TEST_GESTURE,  TEST_KEY, TSC_GESTURE_REPEAT, 2 },
+    { 3250, TEST_RELEASE,  TEST_KEY },
+
+    /* Long press and repeats */
+    { 4000, TEST_PRESS,    TEST_KEY },
+    { 4800, TEST_GESTURE,  TEST_KEY, TSC_GESTURE_LONG_PRESS, 0 },
+    { 4900, TEST_GESTURE,  TEST_KEY, TSC_GESTURE_REPEAT, 1 },
+    { 5000, TEST_GESTURE,  TEST_KEY, TSC_GESTURE_REPEAT, 2 },
+    { 5100, TEST_GESTURE,  TEST_KEY, TSC_GESTURE_REPEAT, 3 },
+    { 5150, TEST_RELEASE,  TEST_KEY },
+
+    /* Too long for a tap, too short for a long press: no gesture */
+    { 6000, TEST_PRESS,    TEST_KEY },
+    { 6500, TEST_RELEASE,  TEST_KEY },
+
+    /* Swipe forward: 70 in 200 ms */
+    { 7000, TEST_POSITION, TEST_LINEAR, 0, 10 },
+    { 7000, TEST_PRESS,    TEST_LINEAR },
+    { 7100, TEST_POSITION, TEST_LINEAR, 0, 80 },
+    { 7200, TEST_RELEASE,  TEST_LINEAR },
+    { 7200, TEST_GESTURE,  TEST_LINEAR, TSC_GESTURE_SWIPE, 70, 350 },
+
+    /* Same move too slow for a swipe, too long for a tap: no gesture */
+    { 8000, TEST_POSITION, TEST_LINEAR, 0, 10 },
+    { 8000, TEST_PRESS,    TEST_LINEAR },
+    { 8300, TEST_POSITION, TEST_LINEAR, 0, 80 },
+    { 8500, TEST_RELEASE,  TEST_LINEAR },
+
+    /* Swipe backward: -60 in 150 ms */
+    { 9000, TEST_POSITION, TEST_LINEAR, 0, 80 },
+    { 9000, TEST_PRESS,    TEST_LINEAR },
+    { 9100, TEST_POSITION, TEST_LINEAR, 0, 20 },
+    { 9150, TEST_RELEASE,  TEST_LINEAR },
+    { 9150, TEST_GESTURE,  TEST_LINEAR, TSC_GESTURE_SWIPE, -60, 400 },
+
+    /* Short move: tap on the Linear sensor */
+    { 10000, TEST_PRESS,   TEST_LINEAR },
+    { 10050, TEST_POSITION, TEST_LINEAR, 0, 40 },
+    { 10100, TEST_RELEASE, TEST_LINEAR },
+    { 10350, TEST_GESTURE, TEST_LINEAR, TSC_GESTURE_TAP },
+
+    /* End of the script */
+    { 11000, TEST_RELEASE, TEST_KEY }
+};
+
+#define TEST_STEPS          (sizeof(TestScript) / sizeof(TestScript[0]))
+
+/* Objects of the script: only the Linear sensor data is read */
+static TSC_LinRotData_T TestLinData;
+
+static TSC_LinRot_T TestLinear =
+{
+    &TestLinData
+};
+
+static CONST TSC_Object_T TestObjects[2] =
+{
+    { TSC_OBJ_TOUCHKEY, (TSC_TouchKey_T *)&MyTouchKeys[0] },
+    { TSC_OBJ_LINEAR,   (TSC_TouchKey_T *)&TestLinear }
+};
+
+static TSC_ObjectGroup_T TestGroup =
+{
+    &TestObjects[0],
+    2,
+    0x00,
+    TSC_STATE_NOT_CHANGED
+};
+
+/**@} end of group TSC_Test_Gesture_Variables */
+
+/** @defgroup TSC_Test_Gesture_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Return the next expected gesture of the script
+ *
+ * @param       step: Index of the step to start from
+ *
+ * @retval      Index of the step, TEST_STEPS if none
+ */
+static uint32_t Test_NextExpected(uint32_t step)
+{
+    while ((step < TEST_STEPS) && (TestScript[step].Op != TEST_GESTURE))
+    {
+        step++;
+    }
+    return step;
+}
+
+/*!
+ * @brief       Replay the script
+ *
+ * @param       start: Tick_ms at the start of the script
+ *
+ * @retval      Number of gestures read
+ */
+static uint32_t Test_Replay(TSC_tTick_ms_T start)
+{
+    CONST TEST_Step_T *step;
+    TSC_Event_T event;
+    TSC_Gesture_T gesture;
+    uint32_t input = 0;
+    uint32_t expect;
+    uint32_t time;
+    uint32_t read = 0;
+
+    TSC_Gesture_Config(&TestGroup);
+    expect = Test_NextExpected(0);
+
+    for (time = 0; time <= TestScript[TEST_STEPS - 1].Time; time++)
+    {
+        TSC_Globals.Tick_ms = (TSC_tTick_ms_T)(start + time);
+
+        /* Events and positions of this ms */
+        for (; (input < TEST_STEPS) && (TestScript[input].Time == time); input++)
+        {
+            step = &TestScript[input];
+            if (step->Op == TEST_POSITION)
+            {
+                TestLinData.RawPosition = step->Value;
+            }
+            else if (step->Op != TEST_GESTURE)
+            {
+                event.Type  = (step->Op == TEST_PRESS) ? TSC_EVENT_PRESS : TSC_EVENT_RELEASE;
+                event.Index = step->Index;
+                event.Key   = 0;
+                event.Tick  = TSC_Globals.Tick_ms;
+                TSC_Gesture_ProcessEvent(&event);
+            }
+        }
+
+        TSC_Gesture_Process();
+
+        while (TSC_Gesture_Read(&gesture) == TSC_STATUS_OK)
+        {
+            read++;
+            if ((expect == TEST_STEPS) || (TestScript[expect].Time != time))
+            {
+                printf("start %u, %u ms: unexpected gesture %u on object %u\n",
+                       (unsigned)start, (unsigned)time, gesture.Type, gesture.Index);
+                HostFailures++;
+                continue;
+            }
+
+            step = &TestScript[expect];
+            if ((gesture.Type != step->Type) || (gesture.Index != step->Index) ||
+                ((step->Type == TSC_GESTURE_SWIPE) && ((gesture.Distance != step->Value) || (gesture.Speed != step->Speed))) ||
+                ((step->Type != TSC_GESTURE_SWIPE) && (gesture.Count != step->Value)))
+            {
+                printf("start %u, %u ms: gesture %u on object %u (count %u, distance %d, speed %u), "
+                       "expected %u on object %u\n", (unsigned)start, (unsigned)time, gesture.Type,
+                       gesture.Index, gesture.Count, gesture.Distance, gesture.Speed, step->Type, step->Index);
+                HostFailures++;
+            }
+            expect = Test_NextExpected(expect + 1);
+        }
+
+        /* The gestures of this ms have all been read */
+        while ((expect < TEST_STEPS) && (TestScript[expect].Time == time))
+        {
+            printf("start %u, %u ms: missing gesture %u on object %u\n",
+                   (unsigned)start, (unsigned)time, TestScript[expect].Type, TestScript[expect].Index);
+            HostFailures++;
+            expect = Test_NextExpected(expect + 1);
+        }
+    }
+    return read;
+}
+
+int main(void)
+{
+    uint32_t read;
+
+    read = Test_Replay(TEST_START);
+    printf("start %u: %u gestures\n", (unsigned)TEST_START, (unsigned)read);
+
+    read = Test_Replay(TEST_START_WRAP);
+    printf("start %u: %u gestures\n", (unsigned)TEST_START_WRAP, (unsigned)read);
+
+    return Host_Report();
+}
+
+/**@} end of group TSC_Test_Gesture_Functions */
+/**@} end of group TSC_Test_Gesture */
+/**@} end of group TSC_Test */
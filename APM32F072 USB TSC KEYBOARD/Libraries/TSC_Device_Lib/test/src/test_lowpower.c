@@ -0,0 +1,189 @@
+/*!
+ * @file        test_lowpower.c
+ *
+ * @brief       Host test of the low-power guard scan: duty and wake-ups of the two scan
+ *              modes, wake-up by a touch and Frame written just before the Sleep mode
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/*
+ * The main loop is the one of the example: a Frame is processed when one is
+ * ready, else TSC_LowPower_Sleep() is called. In the full scan the CPU does not
+ * sleep and the loop waits for the next simulated event.
+ *
+ * The figures are those of the simulation: time with a burst running, time in
+ * WFI and interrupts ending a WFI. They are not current measurements, the USB
+ * interrupts of the example are not simulated and the main loop takes no
+ * simulated time, so the WFI share is an upper bound.
+ */
+
+/* Includes */
+#include "tsc_host.h"
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_LowPower Low Power
+  @{
+*/
+
+/** @defgroup TSC_Test_LowPower_Macros Macros
+  @{
+*/
+
+#define TEST_KEY            (0)
+#define TEST_COUNT          (1500)
+#define TEST_NOISE          (2)
+#define TEST_TOUCH_COUNT    (TEST_COUNT - 2 * TOUCH_KEY_DETECT_IN_TH)
+/* Time of each measure */
+#define TEST_PERIOD         SIM_MS(5000)
+
+/**@} end of group TSC_Test_LowPower_Macros */
+
+/** @defgroup TSC_Test_LowPower_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Run the main loop of the example
+ *
+ * @param       cycles: HCLK cycles
+ *
+ * @retval      None
+ */
+static void Test_RunFor(uint64_t cycles)
+{
+    uint64_t end = Sim_ReadTime() + cycles;
+
+    while (Sim_ReadTime() < end)
+    {
+        if (Host_Action() == TSC_STATUS_OK)
+        {
+            continue;
+        }
+
+        if (TSC_LowPower_ReadMode() == TSC_LP_MODE_GUARD)
+        {
+            TSC_LowPower_Sleep();
+        }
+        else
+        {
+            Sim_Step();
+        }
+    }
+}
+
+/*!
+ * @brief       Run the main loop and print the figures of the scan mode
+ *
+ * @param       name: Name of the scan mode
+ *
+ * @param       sleep: Returns the time in WFI, in per mille
+ *
+ * @retval      Duty returned by TSC_Acq_ReadScanDuty(), in per mille
+ */
+static uint16_t Test_Measure(const char *name, uint32_t *sleep)
+{
+    SIM_Stats_T start = SimStats;
+    uint64_t burstTime;
+    uint64_t sleepTime;
+    uint32_t wakeups;
+    uint16_t duty;
+    uint16_t wakeRate;
+
+    TSC_Acq_ReadScanDuty(0);
+    Test_RunFor(TEST_PERIOD);
+    duty = TSC_Acq_ReadScanDuty(&wakeRate);
+
+    burstTime = SimStats.BurstTime - start.BurstTime;
+    sleepTime = SimStats.SleepTime - start.SleepTime;
+    wakeups = SimStats.Wakeups - start.Wakeups;
+    *sleep = (uint32_t)((sleepTime * 1000) / TEST_PERIOD);
+
+    printf("%-6s scan: duty %u/1000, timer wake-ups %u/s, bursts %.1f/1000 of the time, "
+           "WFI %.1f/1000 of the time, %.0f wake-ups/s\n", name, duty, wakeRate,
+           (double)(burstTime * 1000) / TEST_PERIOD, (double)(sleepTime * 1000) / TEST_PERIOD,
+           (double)wakeups * SIM_HCLK / TEST_PERIOD);
+    return duty;
+}
+
+int main(void)
+{
+    uint64_t start;
+    uint64_t slept;
+    uint32_t sleepActive, sleepGuard;
+    uint16_t dutyActive, dutyGuard;
+    uint32_t frames;
+
+    Host_Config(3);
+    Sim_ConfigCount(0xFFFFFFFF, TEST_COUNT);
+    Sim_ConfigNoise(0xFFFFFFFF, TEST_NOISE);
+
+    /* Calibration, then the full scan while no object is active */
+    Test_RunFor(SIM_MS(1000));
+    HOST_CHECK(TSC_LowPower_ReadMode() == TSC_LP_MODE_ACTIVE);
+    dutyActive = Test_Measure("full", &sleepActive);
+
+    /* Guard scan after TOUCH_LP_IDLE_SEC */
+    Test_RunFor(SIM_MS(TOUCH_LP_IDLE_SEC * 1000));
+    HOST_CHECK(TSC_LowPower_ReadMode() == TSC_LP_MODE_GUARD);
+    dutyGuard = Test_Measure("guard", &sleepGuard);
+    HOST_CHECK(TSC_LowPower_ReadMode() == TSC_LP_MODE_GUARD);
+    HOST_CHECK(dutyGuard < dutyActive);
+    HOST_CHECK(sleepGuard > sleepActive);
+
+    /* A guard Frame is written after the check of the main loop, before the Sleep mode:
+       the CPU must not sleep until the next interrupt */
+    for (frames = 0; (frames < 10) && (TSC_LowPower_ReadMode() == TSC_LP_MODE_GUARD); frames++)
+    {
+        while (TSC_Acq_ReadFrame() == 0)
+        {
+            Sim_Step();
+        }
+        start = Sim_ReadTime();
+        TSC_LowPower_Sleep();
+        slept = Sim_ReadTime() - start;
+        HOST_CHECK(slept == 0);
+        Host_Action();
+    }
+    printf("guard Frame ready before the Sleep mode: %u checked\n", (unsigned)frames);
+
+    /* A touch restarts the full scan */
+    Host_TouchKey(TEST_KEY, TEST_TOUCH_COUNT);
+    start = Sim_ReadTime();
+    while ((MyTouchKeys[TEST_KEY].p_Data->StateId != TSC_STATEID_DETECT) &&
+           (Sim_ReadTime() - start < SIM_MS(1000)))
+    {
+        Test_RunFor(SIM_US(100));
+    }
+    HOST_CHECK(TSC_LowPower_ReadMode() == TSC_LP_MODE_ACTIVE);
+    HOST_CHECK(MyTouchKeys[TEST_KEY].p_Data->StateId == TSC_STATEID_DETECT);
+    printf("touch in the guard scan: detected after %.1f ms (scan period %u ms)\n",
+           SIM_TO_US((double)(Sim_ReadTime() - start)) / 1000, (unsigned)TOUCH_LP_SCAN_PERIOD);
+    HOST_CHECK(Sim_ReadTime() - start < SIM_MS(TOUCH_LP_SCAN_PERIOD + 50));
+
+    return Host_Report();
+}
+
+/**@} end of group TSC_Test_LowPower_Functions */
+/**@} end of group TSC_Test_LowPower */
+/**@} end of group TSC_Test */
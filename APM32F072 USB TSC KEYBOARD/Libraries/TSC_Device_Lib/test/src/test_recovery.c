@@ -0,0 +1,214 @@
+/*!
+ * @file        test_recovery.c
+ *
+ * @brief       Host test of the recovery of a failing key: the other keys are still
+ *              acquired, the recalibration delay doubles and the fault is reported
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/*
+ * The electrode of TEST_KEY_FAIL counts above TOUCH_ACQ_MAX, its channel is
+ * in TSC_ACQ_STATUS_ERROR_MAX. The test is built with TOUCH_ACQ_MAX below the
+ * max count value (8191), which the saturated counter reads. The recalibrations of the key are timed from
+ * its Off state to its Calibration state, then the electrode is repaired and
+ * the fault must be cleared after TOUCH_RECOV_STABLE_SEC.
+ */
+
+/* Includes */
+#include "tsc_host.h"
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Recovery Recovery
+  @{
+*/
+
+/** @defgroup TSC_Test_Recovery_Macros Macros
+  @{
+*/
+
+#define TEST_KEY_FAIL       (2)
+#define TEST_KEY_TOUCH      (0)
+#define TEST_COUNT          (1500)
+#define TEST_NOISE          (2)
+#define TEST_FAIL_COUNT     (TOUCH_ACQ_MAX + 500)
+#define TEST_TOUCH_COUNT    (TEST_COUNT - 2 * TOUCH_KEY_DETECT_IN_TH)
+/* Recalibrations timed while the electrode fails */
+#define TEST_RETRIES        (8)
+
+/**@} end of group TSC_Test_Recovery_Macros */
+
+/** @defgroup TSC_Test_Recovery_Variables Variables
+  @{
+*/
+
+/* Recalibrations of the failing key */
+static uint32_t TestRetries;
+static uint64_t TestRetryTime[TEST_RETRIES + 2];
+static TSC_STATEID_T TestLastState;
+
+/* Frames processed with the other key acquired without error */
+static uint32_t TestOtherFrames;
+
+/**@} end of group TSC_Test_Recovery_Variables */
+
+/** @defgroup TSC_Test_Recovery_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Time the recalibrations of the failing key, called after each Frame
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Test_Frame(void)
+{
+    TSC_STATEID_T state = MyTouchKeys[TEST_KEY_FAIL].p_Data->StateId;
+
+    if ((TestLastState == TSC_STATEID_OFF) && (state != TSC_STATEID_OFF) &&
+        (TestRetries < TEST_RETRIES + 2))
+    {
+        TestRetryTime[TestRetries++] = Sim_ReadTime();
+    }
+    TestLastState = state;
+
+    if (MyTouchKeys[TEST_KEY_TOUCH].p_ChD->Flag.AcqStatus == TSC_ACQ_STATUS_OK)
+    {
+        TestOtherFrames++;
+    }
+}
+
+/*!
+ * @brief       Run until a TouchKey reaches a state
+ *
+ * @param       key: TouchKey index
+ *
+ * @param       state: State to reach
+ *
+ * @param       timeout: Longest time in HCLK cycles
+ *
+ * @retval      Time to reach the state in ms, or -1
+ */
+static double Test_Wait(uint32_t key, TSC_STATEID_T state, uint64_t timeout)
+{
+    uint64_t start = Sim_ReadTime();
+
+    while (MyTouchKeys[key].p_Data->StateId != state)
+    {
+        if (Sim_ReadTime() - start > timeout)
+        {
+            return -1;
+        }
+        Host_RunFor(SIM_US(500), Test_Frame);
+    }
+    return SIM_TO_US((double)(Sim_ReadTime() - start)) / 1000;
+}
+
+int main(void)
+{
+    TSC_Fault_T fault;
+    uint32_t retry;
+    uint32_t delay;
+    uint32_t frames;
+    uint8_t errors;
+    double interval;
+
+    /* No guard scan: the keys stay acquired while the failing key is off */
+    Host_Config(4);
+    Sim_ConfigCount(0xFFFFFFFF, TEST_COUNT);
+    Sim_ConfigNoise(0xFFFFFFFF, TEST_NOISE);
+    Host_RunFor(SIM_MS(1000), Test_Frame);
+    HOST_CHECK(TSC_Recovery_ReadFaults() == 0);
+
+    /* The electrode fails: debounce error, Error, then Off */
+    Host_TouchKey(TEST_KEY_FAIL, TEST_FAIL_COUNT);
+    printf("failing key: off after %.1f ms\n",
+           Test_Wait(TEST_KEY_FAIL, TSC_STATEID_OFF, SIM_MS(1000)));
+    HOST_CHECK(TSC_Recovery_ReadFaults() == (1U << TEST_KEY_FAIL));
+    HOST_CHECK(TSC_Recovery_Read(TEST_KEY_FAIL, &fault) == TSC_STATUS_OK);
+    HOST_CHECK(fault.State == TSC_RECOV_STATE_OFF);
+    HOST_CHECK(fault.Errors == 1);
+    HOST_CHECK(fault.Delay == TOUCH_RECOV_DELAY_MIN);
+    HOST_CHECK(fault.AcqStatus == TSC_ACQ_STATUS_ERROR_MAX);
+    HOST_CHECK(MyTouchKeys[TEST_KEY_FAIL].p_ChD->Flag.ObjStatus != TSC_OBJ_STATUS_ON);
+
+    /* The other keys are still acquired and detect a touch */
+    frames = TestOtherFrames;
+    Host_TouchKey(TEST_KEY_TOUCH, TEST_TOUCH_COUNT);
+    printf("other key: detected after %.1f ms\n",
+           Test_Wait(TEST_KEY_TOUCH, TSC_STATEID_DETECT, SIM_MS(1000)));
+    HOST_CHECK(MyTouchKeys[TEST_KEY_TOUCH].p_Data->StateId == TSC_STATEID_DETECT);
+    Host_TouchKey(TEST_KEY_TOUCH, TEST_COUNT);
+    HOST_CHECK(Test_Wait(TEST_KEY_TOUCH, TSC_STATEID_RELEASE, SIM_MS(1000)) >= 0);
+    HOST_CHECK(TestOtherFrames > frames);
+    HOST_CHECK(TSC_Recovery_Read(TEST_KEY_TOUCH, &fault) == TSC_STATUS_OK);
+    HOST_CHECK(fault.State == TSC_RECOV_STATE_OK);
+
+    /* Recalibrations with a doubled delay while the electrode still fails */
+    TestRetries = 0;
+    while ((TestRetries < TEST_RETRIES) && (Sim_ReadTime() < SIM_MS(400000)))
+    {
+        Host_RunFor(SIM_MS(100), Test_Frame);
+    }
+    HOST_CHECK(TestRetries == TEST_RETRIES);
+
+    printf("recalibrations after:");
+    for (retry = 1, delay = TOUCH_RECOV_DELAY_MIN; retry < TestRetries; retry++)
+    {
+        interval = SIM_TO_US((double)(TestRetryTime[retry] - TestRetryTime[retry - 1])) / 1000000;
+        printf(" %.1f", interval);
+
+        /* Tick_sec counts whole seconds: the delay is reached within 1 s */
+        delay = (delay * 2 > TOUCH_RECOV_DELAY_MAX) ? TOUCH_RECOV_DELAY_MAX : delay * 2;
+        HOST_CHECK((interval > delay - 1) && (interval < delay + 1));
+    }
+    printf(" s\n");
+
+    HOST_CHECK(TSC_Recovery_Read(TEST_KEY_FAIL, &fault) == TSC_STATUS_OK);
+    HOST_CHECK(fault.Delay == TOUCH_RECOV_DELAY_MAX);
+    HOST_CHECK(fault.AcqStatus == TSC_ACQ_STATUS_ERROR_MAX);
+    errors = fault.Errors;
+    HOST_CHECK(errors >= TEST_RETRIES);
+
+    /* Repaired: recalibrated at the next delay, the fault is cleared once stable */
+    Host_TouchKey(TEST_KEY_FAIL, TEST_COUNT);
+    HOST_CHECK(Test_Wait(TEST_KEY_FAIL, TSC_STATEID_RELEASE, SIM_MS((TOUCH_RECOV_DELAY_MAX + 2) * 1000)) >= 0);
+    HOST_CHECK(TSC_Recovery_Read(TEST_KEY_FAIL, &fault) == TSC_STATUS_OK);
+    HOST_CHECK(fault.State == TSC_RECOV_STATE_RETRY);
+
+    Host_RunFor(SIM_MS((TOUCH_RECOV_STABLE_SEC + 2) * 1000), Test_Frame);
+    HOST_CHECK(TSC_Recovery_ReadFaults() == 0);
+    HOST_CHECK(TSC_Recovery_Read(TEST_KEY_FAIL, &fault) == TSC_STATUS_OK);
+    HOST_CHECK(fault.State == TSC_RECOV_STATE_OK);
+    HOST_CHECK(fault.Delay == TOUCH_RECOV_DELAY_MIN);
+    HOST_CHECK(fault.Errors == errors);
+    printf("repaired key: %u errors, fault cleared\n", fault.Errors);
+
+    return Host_Report();
+}
+
+/**@} end of group TSC_Test_Recovery_Functions */
+/**@} end of group TSC_Test_Recovery */
+/**@} end of group TSC_Test */
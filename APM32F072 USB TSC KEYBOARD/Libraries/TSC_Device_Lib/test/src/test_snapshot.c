@@ -0,0 +1,195 @@
+/*!
+ * @file        test_snapshot.c
+ *
+ * @brief       Host test of the calibration snapshot: saves over the whole flash page,
+ *              restore of the newest record and reset while a record is programmed
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "tsc_host.h"
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Snapshot Snapshot
+  @{
+*/
+
+/** @defgroup TSC_Test_Snapshot_Macros Macros
+  @{
+*/
+
+#define TEST_COUNT          (1500)
+/* Drift between two saves, above TOUCH_SNAPSHOT_SAVE_TH. The counts only
+   rise so that the keys stay in Release state (negative delta) */
+#define TEST_DRIFT          (12)
+/* Measures after reset, within TOUCH_SNAPSHOT_MATCH_TH of the saved References */
+#define TEST_OFFSET         (30)
+#define TEST_NOISE          (2)
+/* Saves: the page is erased once */
+#define TEST_SAVES          (TSC_SNAP_NUM_RECORDS + 5)
+
+/**@} end of group TSC_Test_Snapshot_Macros */
+
+/** @defgroup TSC_Test_Snapshot_Variables Variables
+  @{
+*/
+
+/* References of the last record saved */
+static TSC_tRefer_T SavedRefer[TOUCH_TOTAL_KEYS];
+
+/**@} end of group TSC_Test_Snapshot_Variables */
+
+/** @defgroup TSC_Test_Snapshot_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Start again as after a reset, the flash page is kept
+ *
+ * @param       count: Count of the electrodes
+ *
+ * @retval      Time for all keys to reach the Release state, in HCLK cycles
+ */
+static uint64_t Test_Reset(uint16_t count)
+{
+    uint32_t key;
+    uint32_t released = 0;
+
+    Host_Config(2);
+    Sim_ConfigCount(0xFFFFFFFF, count);
+    Sim_ConfigNoise(0xFFFFFFFF, TEST_NOISE);
+
+    while ((released < TOUCH_TOTAL_KEYS) && (Sim_ReadTime() < SIM_MS(2000)))
+    {
+        Host_RunFor(1, 0);
+        for (released = 0, key = 0; key < TOUCH_TOTAL_KEYS; key++)
+        {
+            released += (MyTouchKeys[key].p_Data->StateId == TSC_STATEID_RELEASE);
+        }
+    }
+    return Sim_ReadTime();
+}
+
+/*!
+ * @brief       Save the References and keep them for the check after reset
+ *
+ * @param       None
+ *
+ * @retval      Status of TSC_Snap_Save()
+ */
+static TSC_STATUS_T Test_Save(void)
+{
+    TSC_STATUS_T status = TSC_Snap_Save(&MyObjGroup);
+    uint32_t key;
+
+    if (status == TSC_STATUS_OK)
+    {
+        for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+        {
+            SavedRefer[key] = MyTouchKeys[key].p_ChD->Refer;
+        }
+    }
+    return status;
+}
+
+/*!
+ * @brief       Check that the References are the saved ones
+ *
+ * @param       None
+ *
+ * @retval      1 if all References match
+ */
+static int Test_CheckRestored(void)
+{
+    uint32_t key;
+
+    for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+    {
+        if (MyTouchKeys[key].p_ChD->Refer != SavedRefer[key])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+int main(void)
+{
+    uint64_t calibTime, restoreTime;
+    uint32_t save;
+    uint16_t count = TEST_COUNT;
+
+    if (Sim_ConfigFlash(TOUCH_SNAPSHOT_PAGE_ADDR, TOUCH_SNAPSHOT_PAGE_SIZE) != 0)
+    {
+        printf("cannot map the flash page at 0x%08X\n", TOUCH_SNAPSHOT_PAGE_ADDR);
+        return 2;
+    }
+
+    /* The snapshot is only saved by the test */
+    HostSnapSave = 0;
+
+    /* Empty page: normal calibration */
+    calibTime = Test_Reset(count);
+    HOST_CHECK(Sim_ReadTime() < SIM_MS(2000));
+
+    /* Saves over the whole page, the References drift between two saves */
+    for (save = 0; save < TEST_SAVES; save++)
+    {
+        count += TEST_DRIFT;
+        Sim_ConfigCount(0xFFFFFFFF, count);
+        Host_RunFor(SIM_MS(3000), 0);
+        HOST_CHECK(Test_Save() == TSC_STATUS_OK);
+    }
+
+    /* Reset: the newest record is restored, the measures are still close to it */
+    restoreTime = Test_Reset(count + TEST_OFFSET);
+    HOST_CHECK(Test_CheckRestored());
+    printf("%u records per page, %u saves: calibration %.1f ms, restore %.1f ms\n",
+           (unsigned)TSC_SNAP_NUM_RECORDS, (unsigned)TEST_SAVES,
+           SIM_TO_US((double)calibTime) / 1000, SIM_TO_US((double)restoreTime) / 1000);
+    HOST_CHECK(restoreTime < calibTime);
+
+    /* Reset while the next record is programmed: the previous record is restored */
+    Sim_ConfigCount(0xFFFFFFFF, count + TEST_DRIFT);
+    Host_RunFor(SIM_MS(3000), 0);
+    Sim_ConfigFlashFail(3);
+    HOST_CHECK(TSC_Snap_Save(&MyObjGroup) == TSC_STATUS_ERROR);
+    Sim_ConfigFlashFail(-1);
+
+    Test_Reset(count + TEST_OFFSET);
+    HOST_CHECK(Test_CheckRestored());
+
+    /* The next save after the torn record is the newest one */
+    Sim_ConfigCount(0xFFFFFFFF, count + 2 * TEST_DRIFT);
+    Host_RunFor(SIM_MS(3000), 0);
+    HOST_CHECK(Test_Save() == TSC_STATUS_OK);
+    Test_Reset(count + 2 * TEST_DRIFT + TEST_OFFSET);
+    HOST_CHECK(Test_CheckRestored());
+
+    return Host_Report();
+}
+
+/**@} end of group TSC_Test_Snapshot_Functions */
+/**@} end of group TSC_Test_Snapshot */
+/**@} end of group TSC_Test */
@@ -0,0 +1,443 @@
+/*!
+ * @file        test_telemetry.c
+ *
+ * @brief       Host round trip of the telemetry stream: records written after each frame,
+ *              read as the example does, then decoded by Host/tsc_telemetry.c
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/*
+ * After each frame the test keeps the values the record must carry, then reads
+ * the ring buffer in TEST_TX_SIZE pieces as TSC_TelemetryHandler() does. The
+ * reads are paused for TEST_UNREAD frames: the ring buffer fills and the next
+ * records are dropped.
+ *
+ * The stream is checked record by record (sync, size, checksum, frame number
+ * and values), then written to a file and decoded by TEST_DECODER. The CSV of
+ * the decoder must give the same values, and the lost records must be the
+ * dropped ones. A copy of the stream with one corrupted byte must lose only
+ * the record of this byte.
+ */
+
+/* Includes */
+#include "tsc_host.h"
+#include <stdlib.h>
+#include <string.h>
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Telemetry Telemetry
+  @{
+*/
+
+/** @defgroup TSC_Test_Telemetry_Macros Macros
+  @{
+*/
+
+#define TEST_KEY            (0)
+#define TEST_COUNT          (1500)
+#define TEST_NOISE          (2)
+#define TEST_TOUCH_COUNT    (TEST_COUNT - 2 * TOUCH_KEY_DETECT_IN_TH)
+
+/* Size of the reads, TELEM_TX_SIZE of the example */
+#define TEST_TX_SIZE        (256)
+/* Frames without read, less than 256 so the frame number gap is not ambiguous */
+#define TEST_UNREAD         (100)
+/* Record corrupted in the copy of the stream */
+#define TEST_CORRUPT        (40)
+
+#define TEST_RECORD_SIZE    TSC_TELEM_RECORD_SIZE(TOUCH_TOTAL_KEYS, TOUCH_TOTAL_KEYS)
+#define TEST_FRAMES_MAX     (4096)
+
+/* Files of the decoder, in the build directory */
+#define TEST_BIN            TEST_OUT "/test_telemetry.bin"
+#define TEST_CSV            TEST_OUT "/test_telemetry.csv"
+#define TEST_LOG            TEST_OUT "/test_telemetry.log"
+
+/**@} end of group TSC_Test_Telemetry_Macros */
+
+/** @defgroup TSC_Test_Telemetry_Structures Structures
+  @{
+*/
+
+/* Values of the record of a frame */
+typedef struct
+{
+    uint16_t Tick;
+    uint16_t Meas[TOUCH_TOTAL_KEYS];
+    int16_t  Delta[TOUCH_TOTAL_KEYS];
+    uint8_t  State[TOUCH_TOTAL_KEYS];
+} TEST_Record_T;
+
+/**@} end of group TSC_Test_Telemetry_Structures */
+
+/** @defgroup TSC_Test_Telemetry_Variables Variables
+  @{
+*/
+
+/* Expected records, by frame since TSC_Telem_Start() */
+static TEST_Record_T TestExpected[TEST_FRAMES_MAX];
+static uint32_t TestFrames;
+
+/* Stream read from the ring buffer */
+static uint8_t TestStream[TEST_FRAMES_MAX * TEST_RECORD_SIZE];
+static uint32_t TestLength;
+static uint8_t TestReading;
+
+/* Frame of each record of the stream */
+static uint32_t TestRecordFrame[TEST_FRAMES_MAX];
+
+/**@} end of group TSC_Test_Telemetry_Variables */
+
+/** @defgroup TSC_Test_Telemetry_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Read the ring buffer as the telemetry handler of the example
+ *
+ * @param       None
+ *
+ * @retval      Number of bytes read
+ */
+static uint16_t Test_Read(void)
+{
+    uint16_t length = 0;
+
+    if (TestLength + TEST_TX_SIZE <= sizeof(TestStream))
+    {
+        length = TSC_Telem_Read(&TestStream[TestLength], TEST_TX_SIZE);
+        TestLength += length;
+    }
+    return length;
+}
+
+/*!
+ * @brief       Keep the values of the record just written, called after each frame
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Test_Frame(void)
+{
+    TEST_Record_T *rec;
+    uint32_t key;
+
+    if (TestFrames < TEST_FRAMES_MAX)
+    {
+        rec = &TestExpected[TestFrames];
+        rec->Tick = (uint16_t)TSC_Globals.Tick_ms;
+        for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+        {
+            rec->Meas[key]  = (uint16_t)TSC_CH_MEAS(MyTouchKeys[key].p_ChD);
+            rec->Delta[key] = (int16_t)TSC_CH_DELTA(MyTouchKeys[key].p_ChD);
+            rec->State[key] = (uint8_t)MyTouchKeys[key].p_Data->StateId;
+        }
+    }
+    TestFrames++;
+
+    if (TestReading)
+    {
+        Test_Read();
+    }
+}
+
+/*!
+ * @brief       Compare the values of a frame with the expected ones
+ *
+ * @param       frame: Frame since TSC_Telem_Start()
+ *
+ * @param       rec: Values decoded
+ *
+ * @retval      1 if equal
+ */
+static int Test_Compare(uint32_t frame, CONST TEST_Record_T *rec)
+{
+    if ((frame >= TEST_FRAMES_MAX) || (frame >= TestFrames))
+    {
+        return 0;
+    }
+    return memcmp(&TestExpected[frame], rec, sizeof(TEST_Record_T)) == 0;
+}
+
+/*!
+ * @brief       Check the records of the stream, without resync
+ *
+ * @param       lost: Returns the number of frames without record
+ *
+ * @retval      Number of records
+ */
+static uint32_t Test_Parse(uint32_t *lost)
+{
+    CONST uint8_t *p;
+    TEST_Record_T rec;
+    uint32_t pos = 0;
+    uint32_t records = 0;
+    uint32_t frame = 0;
+    uint32_t key;
+    uint32_t i;
+    uint8_t sum;
+
+    *lost = 0;
+    while (pos < TestLength)
+    {
+        p = &TestStream[pos];
+        if ((TestLength - pos < TEST_RECORD_SIZE) || (p[0] != TSC_TELEM_SYNC) ||
+            (p[1] != TEST_RECORD_SIZE) || (p[5] != TOUCH_TOTAL_KEYS) || (p[6] != TOUCH_TOTAL_KEYS))
+        {
+            printf("bad record header at byte %u\n", (unsigned)pos);
+            HostFailures++;
+            break;
+        }
+
+        for (sum = 0, i = 0; i < TEST_RECORD_SIZE; i++)
+        {
+            sum += p[i];
+        }
+        HOST_CHECK(sum == 0);
+
+        /* Frame number: the gap is the number of dropped records */
+        if (records > 0)
+        {
+            *lost += (uint8_t)(p[2] - (uint8_t)frame - 1);
+            frame += (uint8_t)(p[2] - (uint8_t)frame);
+        }
+        HOST_CHECK(p[2] == (uint8_t)frame);
+
+        rec.Tick = (uint16_t)(p[3] | (p[4] << 8));
+        p += 7;
+        for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+        {
+            rec.Meas[key]  = (uint16_t)(p[0] | (p[1] << 8));
+            rec.Delta[key] = (int16_t)(p[2] | (p[3] << 8));
+            p += 4;
+        }
+        for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+        {
+            rec.State[key] = *p++;
+        }
+        if (!Test_Compare(frame, &rec))
+        {
+            printf("record of frame %u: values differ\n", (unsigned)frame);
+            HostFailures++;
+        }
+
+        TestRecordFrame[records++] = frame;
+        pos += TEST_RECORD_SIZE;
+    }
+    return records;
+}
+
+/*!
+ * @brief       Decode a stream with the host decoder and check its CSV
+ *
+ * @param       stream: Stream bytes
+ *
+ * @param       length: Number of bytes
+ *
+ * @param       skip: Frame whose record must be missing, or -1
+ *
+ * @param       lost: Returns the number of lost records printed by the decoder
+ *
+ * @param       resync: Returns the number of bytes skipped by the decoder
+ *
+ * @retval      Number of records of the CSV matching the expected ones, -1 on error
+ */
+static int32_t Test_Decode(CONST uint8_t *stream, uint32_t length, int32_t skip,
+                           uint32_t *lost, uint32_t *resync)
+{
+    char line[1024];
+    char header[1024];
+    TEST_Record_T rec;
+    FILE *f;
+    char *p;
+    uint32_t records = 0;
+    uint32_t frame = 0;
+    uint32_t rows = 0;
+    uint32_t seq;
+    uint32_t key;
+    int32_t matched = 0;
+    int len;
+
+    f = fopen(TEST_BIN, "wb");
+    if ((f == NULL) || (fwrite(stream, 1, length, f) != length))
+    {
+        printf("cannot write %s\n", TEST_BIN);
+        return -1;
+    }
+    fclose(f);
+
+    if (system(TEST_DECODER " -p " TEST_BIN " -o " TEST_CSV " 2> " TEST_LOG) != 0)
+    {
+        printf("%s failed\n", TEST_DECODER);
+        return -1;
+    }
+
+    /* Summary: records, lost and skipped bytes */
+    f = fopen(TEST_LOG, "r");
+    if ((f == NULL) || (fscanf(f, "%u records, %u lost, %u bytes skipped", &records, lost, resync) != 3))
+    {
+        printf("no summary in %s\n", TEST_LOG);
+        return -1;
+    }
+    fclose(f);
+
+    f = fopen(TEST_CSV, "r");
+    if (f == NULL)
+    {
+        printf("cannot read %s\n", TEST_CSV);
+        return -1;
+    }
+
+    /* Column names of the layout */
+    len = snprintf(header, sizeof(header), "seq,tick");
+    for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+    {
+        len += snprintf(&header[len], sizeof(header) - len, ",meas%u,delta%u", (unsigned)key, (unsigned)key);
+    }
+    for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+    {
+        len += snprintf(&header[len], sizeof(header) - len, ",state%u", (unsigned)key);
+    }
+    HOST_CHECK((fgets(line, sizeof(line), f) != NULL) && (strcspn(line, "\n") == (size_t)len) &&
+               (strncmp(line, header, len) == 0));
+
+    while (fgets(line, sizeof(line), f) != NULL)
+    {
+        seq = (uint32_t)strtoul(line, &p, 10);
+        if (rows > 0)
+        {
+            frame += (uint8_t)(seq - (uint8_t)frame);
+        }
+        rows++;
+
+        rec.Tick = (uint16_t)strtoul(p + 1, &p, 10);
+        for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+        {
+            rec.Meas[key]  = (uint16_t)strtoul(p + 1, &p, 10);
+            rec.Delta[key] = (int16_t)strtol(p + 1, &p, 10);
+        }
+        for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+        {
+            rec.State[key] = (uint8_t)strtoul(p + 1, &p, 10);
+        }
+
+        if ((seq == (uint8_t)frame) && ((int32_t)frame != skip) && Test_Compare(frame, &rec))
+        {
+            matched++;
+        }
+        else
+        {
+            printf("CSV row %u (frame %u): values differ\n", (unsigned)rows, (unsigned)frame);
+        }
+    }
+    fclose(f);
+
+    HOST_CHECK(rows == records);
+    return matched;
+}
+
+int main(void)
+{
+    static uint8_t corrupt[sizeof(TestStream)];
+    uint32_t records, lost, resync;
+    uint32_t unread, kept, frames;
+    uint32_t pos;
+    int32_t matched;
+
+    Host_Config(6);
+    Sim_ConfigCount(0xFFFFFFFF, TEST_COUNT);
+    Sim_ConfigNoise(0xFFFFFFFF, TEST_NOISE);
+
+    /* Calibration, no record before the start of the stream */
+    Host_RunFor(SIM_MS(1000), Test_Frame);
+    HOST_CHECK(TSC_Telem_Read(TestStream, TEST_TX_SIZE) == 0);
+
+    /* Stream read after each frame, with a touch and a release */
+    TSC_Telem_Start();
+    TestFrames = 0;
+    TestReading = 1;
+    Host_RunFor(SIM_MS(300), Test_Frame);
+    Host_TouchKey(TEST_KEY, TEST_TOUCH_COUNT);
+    Host_RunFor(SIM_MS(300), Test_Frame);
+    HOST_CHECK(MyTouchKeys[TEST_KEY].p_Data->StateId == TSC_STATEID_DETECT);
+    Host_TouchKey(TEST_KEY, TEST_COUNT);
+    Host_RunFor(SIM_MS(300), Test_Frame);
+    HOST_CHECK(TSC_Telem_ReadDrops() == 0);
+
+    /* Reads paused: the ring buffer keeps the first records, the next ones are dropped */
+    TestReading = 0;
+    unread = TestFrames + TEST_UNREAD;
+    while (TestFrames < unread)
+    {
+        Host_RunFor(1, Test_Frame);
+    }
+    kept = TOUCH_TELEM_BUFFER_SIZE / TEST_RECORD_SIZE;
+    HOST_CHECK(TSC_Telem_ReadDrops() == TEST_UNREAD - kept);
+
+    /* Reads resumed: the record of the first frame is written before the read and dropped,
+       then the stream is stopped and the ring buffer drained */
+    TestReading = 1;
+    Host_RunFor(SIM_MS(300), Test_Frame);
+    HOST_CHECK(TSC_Telem_ReadDrops() == TEST_UNREAD - kept + 1);
+    TSC_Telem_Stop();
+    frames = TestFrames;
+    Host_RunFor(SIM_MS(10), Test_Frame);
+    while (Test_Read() > 0)
+    {
+    }
+    HOST_CHECK(TestFrames <= TEST_FRAMES_MAX);
+
+    /* Framing and values of the records */
+    records = Test_Parse(&lost);
+    printf("stream: %u frames, %u records of %u bytes, %u lost, %u dropped\n", (unsigned)frames,
+           (unsigned)records, (unsigned)TEST_RECORD_SIZE, (unsigned)lost, (unsigned)TSC_Telem_ReadDrops());
+    HOST_CHECK(lost == TSC_Telem_ReadDrops());
+    HOST_CHECK(records + lost == frames);
+
+    /* Same stream through the host decoder */
+    matched = Test_Decode(TestStream, TestLength, -1, &lost, &resync);
+    printf("decoder: %d records matched, %u lost, %u bytes skipped\n", (int)matched,
+           (unsigned)lost, (unsigned)resync);
+    HOST_CHECK(matched == (int32_t)records);
+    HOST_CHECK(lost == TSC_Telem_ReadDrops());
+    HOST_CHECK(resync == 0);
+
+    /* A corrupted delta: only this record fails its checksum and is lost */
+    memcpy(corrupt, TestStream, TestLength);
+    pos = TEST_CORRUPT * TEST_RECORD_SIZE + 7 + 2;
+    corrupt[pos] ^= 0x10;
+    matched = Test_Decode(corrupt, TestLength, TestRecordFrame[TEST_CORRUPT], &lost, &resync);
+    printf("corrupted record %u: %d records matched, %u lost, %u bytes skipped\n",
+           (unsigned)TEST_CORRUPT, (int)matched, (unsigned)lost, (unsigned)resync);
+    HOST_CHECK(matched == (int32_t)records - 1);
+    HOST_CHECK(lost == TSC_Telem_ReadDrops() + 1);
+    HOST_CHECK(resync > 0);
+
+    return Host_Report();
+}
+
+/**@} end of group TSC_Test_Telemetry_Functions */
+/**@} end of group TSC_Test_Telemetry */
+/**@} end of group TSC_Test */
@@ -0,0 +1,451 @@
+/*!
+ * @file        test_trace.c
+ *
+ * @brief       Host comparison of the TouchKey processing: TSC_Obj_ProcessGroup()
+ *              (TouchKey given to the state functions) against the dispatch through
+ *              the global object used before TSC_TouchKey_ProcessCtx()
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/*
+ * The same generated measures are processed twice from the same configuration:
+ * first by TSC_Obj_ProcessGroup(), then by Test_LegacyProcessGroup(), a copy of
+ * the TouchKey part of TSC_Obj_ProcessGroup() and TSC_TouchKey_Process() before
+ * the TouchKey was passed to the state functions: TSC_Globals.For_Key is set and
+ * the state function of the table is called without parameter.
+ *
+ * The Frames are built by the test and read with TSC_Acq_ReadFrameResult(), the
+ * channels of the idle keys are skipped as by the acquisition engine. The
+ * measures hold touches at the proximity, between and detection levels, drift
+ * and measures out of the TOUCH_ACQ_MIN/MAX range that take the keys through
+ * the debounce error, Error and Off states of the recovery.
+ *
+ * After each Frame the state, counters, reference, delta and change flag of all
+ * keys and the state mask and change flag of the group are hashed, the two runs
+ * must give the same hash for every Frame.
+ *
+ *   test_trace [frames]
+ */
+
+/* Includes */
+#include <stdlib.h>
+#include <string.h>
+#include "tsc_host.h"
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Trace Trace
+  @{
+*/
+
+/** @defgroup TSC_Test_Trace_Macros Macros
+  @{
+*/
+
+#define TEST_FRAMES         (2000000)
+/* Time between two Frames */
+#define TEST_FRAME_MS       (3)
+#define TEST_COUNT          (1500)
+#define TEST_NOISE          (6)
+/* Touch depths: proximity, between proximity and detection, detection */
+#define TEST_DEPTHS         (3)
+/* Out of range measures */
+#define TEST_ERROR_HIGH     (TOUCH_ACQ_MAX + 100)
+#define TEST_ERROR_LOW      (TOUCH_ACQ_MIN - 5)
+
+/**@} end of group TSC_Test_Trace_Macros */
+
+/** @defgroup TSC_Test_Trace_Structures Structures
+  @{
+*/
+
+/* Generated measures of a key */
+typedef struct
+{
+    int32_t  Base;      /*!< Count without touch */
+    uint16_t Depth;     /*!< Count lowered by the touch */
+    uint16_t Error;     /*!< Out of range measure, 0 if none */
+    uint32_t Left;      /*!< Frames left in the current touch or error */
+} TEST_Key_T;
+
+/**@} end of group TSC_Test_Trace_Structures */
+
+/** @defgroup TSC_Test_Trace_Variables Variables
+  @{
+*/
+
+extern TSC_Channel_Data_T MyChannels_Data[];
+extern TSC_TouchKeyData_T MyKeys_Data[];
+
+static const uint16_t TestDepth[TEST_DEPTHS] =
+{
+    (TOUCH_KEY_PROX_IN_TH + TOUCH_KEY_DETECT_OUT_TH) / 2,
+    (TOUCH_KEY_DETECT_OUT_TH + TOUCH_KEY_DETECT_IN_TH) / 2,
+    TOUCH_KEY_DETECT_IN_TH + 100
+};
+
+static TEST_Key_T TestKey[TOUCH_TOTAL_KEYS];
+static uint32_t TestSeed;
+static uint16_t TestSec;
+
+/* Frames spent in each state by all keys */
+static uint32_t TestVisits[TSC_STATEID_OFF + 1];
+
+/**@} end of group TSC_Test_Trace_Variables */
+
+/** @defgroup TSC_Test_Trace_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Pseudo-random number, same sequence for a seed
+ *
+ * @param       range: Upper bound (excluded)
+ *
+ * @retval      Number from 0 to range - 1
+ */
+static uint32_t Test_Rand(uint32_t range)
+{
+    TestSeed = TestSeed * 1103515245 + 12345;
+    return ((TestSeed >> 8) & 0xFFFFFF) % range;
+}
+
+/*!
+ * @brief       Start a run: configuration as after reset and same measures
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Test_Start(void)
+{
+    uint32_t key;
+
+    memset(MyChannels_Data, 0, sizeof(TSC_Channel_Data_T) * TOUCH_TOTAL_CHANNELS);
+    memset(MyKeys_Data, 0, sizeof(TSC_TouchKeyData_T) * TOUCH_TOTAL_KEYS);
+    TSC_Globals.Tick_ms = 0;
+    TSC_Globals.Tick_sec = 0;
+    TestSec = 0;
+
+    /* The simulation is not run, the Frames are built by the test */
+    Host_Config(1);
+
+    TestSeed = 12345;
+    for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+    {
+        TestKey[key].Base = TEST_COUNT + 20 * key;
+        TestKey[key].Depth = 0;
+        TestKey[key].Error = 0;
+        TestKey[key].Left = 0;
+    }
+}
+
+/*!
+ * @brief       Advance the global time by one Frame, as TSC_Time_ProcessInterrupt()
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Test_Tick(void)
+{
+    TSC_Globals.Tick_ms += TEST_FRAME_MS;
+    TestSec += TEST_FRAME_MS;
+    while (TestSec >= TOUCH_TICK_FREQ)
+    {
+        TestSec -= TOUCH_TICK_FREQ;
+        TSC_Globals.Tick_sec = (TSC_Globals.Tick_sec + 1) & 63;
+    }
+}
+
+/*!
+ * @brief       Build the next Frame
+ *
+ * @param       idx: Index of the Frame
+ *
+ * @param       frame: Frame to fill
+ *
+ * @retval      None
+ */
+static void Test_BuildFrame(uint32_t idx, TSC_Frame_T *frame)
+{
+    TEST_Key_T *tk;
+    uint32_t key;
+    uint32_t event;
+
+    memset(frame, 0, sizeof(*frame));
+    frame->Status = TSC_STATUS_OK;
+
+    for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+    {
+        tk = &TestKey[key];
+
+        /* Slow drift of the count */
+        if (Test_Rand(64) == 0)
+        {
+            tk->Base += (Test_Rand(2) ? 1 : -1);
+            if (tk->Base < TEST_COUNT - 200)
+            {
+                tk->Base = TEST_COUNT - 200;
+            }
+            if (tk->Base > TEST_COUNT + 300)
+            {
+                tk->Base = TEST_COUNT + 300;
+            }
+        }
+
+        if (tk->Left > 0)
+        {
+            tk->Left--;
+        }
+        else
+        {
+            tk->Depth = 0;
+            tk->Error = 0;
+            event = Test_Rand(20000);
+            if (event < 160)
+            {
+                tk->Depth = TestDepth[event % TEST_DEPTHS];
+                tk->Left = 1 + Test_Rand(300);
+            }
+            else if (event < 162)
+            {
+                tk->Error = Test_Rand(2) ? TEST_ERROR_HIGH : TEST_ERROR_LOW;
+                tk->Left = 1 + Test_Rand(40);
+            }
+        }
+
+        if (tk->Error)
+        {
+            frame->Meas[key] = tk->Error;
+            frame->Status = TSC_STATUS_ERROR;
+        }
+        else
+        {
+            frame->Meas[key] = tk->Base - tk->Depth + (int32_t)Test_Rand(2 * TEST_NOISE + 1) - TEST_NOISE;
+        }
+
+        /* The idle channels are acquired every TOUCH_SCAN_IDLE_DIVIDER Frames */
+        if ((MyChannels_Data[key].Flag.ScanIdle == 0) || ((idx % TOUCH_SCAN_IDLE_DIVIDER) == 0))
+        {
+            frame->Acquired |= (uint32_t)1 << key;
+        }
+    }
+    frame->Tick = TSC_Globals.Tick_ms;
+}
+
+/*!
+ * @brief       Process a group as before TSC_TouchKey_ProcessCtx(): TouchKeys only
+ *
+ * @param       objgrp: Pointer to the group of objects
+ *
+ * @retval      None
+ */
+static void Test_LegacyProcessGroup(TSC_ObjectGroup_T *objgrp)
+{
+    TSC_tIndex_T idxObj;
+    CONST TSC_Object_T *pObj;
+    TSC_tNum_T stateMask = 0;
+    TSC_STATEID_T stateID;
+
+    pObj = objgrp->p_Obj;
+    objgrp->Change = TSC_STATE_NOT_CHANGED;
+
+    for (idxObj = 0; idxObj < objgrp->NbObjects; idxObj++)
+    {
+        TSC_Obj_ConfigGlobalObj(pObj);
+
+        /* TSC_TouchKey_Process() */
+        if ((TSC_Globals.For_Key->p_Data->StateId == TSC_STATEID_OFF) ||
+            (TSC_Globals.For_Key->p_ChD->Flag.DataReady != 0))
+        {
+            TSC_Globals.For_Key->p_ChD->Flag.DataReady = TSC_DATA_NOT_READY;
+            stateID = TSC_Globals.For_Key->p_Data->StateId;
+
+            TSC_Globals.For_Key->p_SM[TSC_Globals.For_Key->p_Data->StateId].StateFunc();
+
+            if (TSC_Globals.For_Key->p_Data->StateId != stateID)
+            {
+                TSC_Globals.For_Key->p_Data->Change = TSC_STATE_CHANGED;
+            }
+            else
+            {
+                TSC_Globals.For_Key->p_Data->Change = TSC_STATE_NOT_CHANGED;
+            }
+        }
+
+        if (TSC_Globals.For_Key->p_Data->Change)
+        {
+            objgrp->Change = TSC_STATE_CHANGED;
+        }
+        stateMask |= TSC_Globals.For_Key->p_SM[TSC_Globals.For_Key->p_Data->StateId].StateMask;
+
+        /* TSC_Obj_SetScanRate() */
+        TSC_Globals.For_Key->p_ChD->Flag.ScanIdle =
+            ((TSC_Globals.For_Key->p_SM[TSC_Globals.For_Key->p_Data->StateId].StateMask & TSC_STATEMASK_ACTIVE) == 0);
+
+        pObj++;
+    }
+    objgrp->StateMask = stateMask;
+}
+
+/*!
+ * @brief       Hash of the key and group data after a Frame (FNV-1a)
+ *
+ * @param       None
+ *
+ * @retval      Hash
+ */
+static uint64_t Test_Hash(void)
+{
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    int32_t value[9];
+    uint32_t key;
+    uint32_t idx;
+
+    for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+    {
+        value[0] = MyTouchKeys[key].p_Data->StateId;
+        value[1] = MyTouchKeys[key].p_Data->CounterDebounce;
+        value[2] = MyTouchKeys[key].p_Data->CounterDTO;
+        value[3] = MyTouchKeys[key].p_Data->Change;
+        value[4] = MyTouchKeys[key].p_ChD->Refer;
+        value[5] = MyTouchKeys[key].p_ChD->Delta;
+        value[6] = MyTouchKeys[key].p_ChD->Flag.ObjStatus;
+        value[7] = MyTouchKeys[key].p_ChD->Flag.ScanIdle;
+        value[8] = (key == 0) ? (int32_t)((MyObjGroup.StateMask << 1) | MyObjGroup.Change) : 0;
+
+        for (idx = 0; idx < 9; idx++)
+        {
+            hash = (hash ^ (uint32_t)value[idx]) * 0x100000001B3ULL;
+        }
+    }
+    return hash;
+}
+
+/*!
+ * @brief       Run the Frames through one of the two paths
+ *
+ * @param       legacy: 1 for the dispatch through the global object
+ *
+ * @param       frames: Number of Frames
+ *
+ * @param       trace: Hash of each Frame, written by the first run and checked by the second
+ *
+ * @retval      Index of the first different Frame, frames if none
+ */
+static uint32_t Test_Run(int legacy, uint32_t frames, uint64_t *trace)
+{
+    TSC_Frame_T frame;
+    uint32_t idx;
+    uint32_t key;
+    uint64_t hash;
+
+    Test_Start();
+
+    for (idx = 0; idx < frames; idx++)
+    {
+        Test_Tick();
+        Test_BuildFrame(idx, &frame);
+        TSC_Acq_ReadFrameResult(&frame, 0, 0);
+
+        if (legacy)
+        {
+            Test_LegacyProcessGroup(&MyObjGroup);
+        }
+        else
+        {
+            TSC_Obj_ProcessGroup(&MyObjGroup);
+        }
+        TSC_Recovery_Process();
+        TSC_Ecs_ProcessSlice(&MyObjGroup);
+
+        hash = Test_Hash();
+        if (!legacy)
+        {
+            trace[idx] = hash;
+            for (key = 0; key < TOUCH_TOTAL_KEYS; key++)
+            {
+                TestVisits[MyTouchKeys[key].p_Data->StateId]++;
+            }
+        }
+        else if (trace[idx] != hash)
+        {
+            return idx;
+        }
+    }
+    return frames;
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t frames = TEST_FRAMES;
+    uint32_t state;
+    uint32_t diff;
+    uint64_t *trace;
+
+    if (argc > 1)
+    {
+        frames = strtoul(argv[1], 0, 0);
+    }
+
+    trace = malloc(sizeof(uint64_t) * frames);
+    if (trace == 0)
+    {
+        return 2;
+    }
+
+    Test_Run(0, frames, trace);
+    diff = Test_Run(1, frames, trace);
+
+    printf("%u keys, %u frames: ", (unsigned)TOUCH_TOTAL_KEYS, (unsigned)frames);
+    if (diff == frames)
+    {
+        printf("same trace\n");
+    }
+    else
+    {
+        printf("first difference at frame %u\n", (unsigned)diff);
+    }
+    HOST_CHECK(diff == frames);
+
+    printf("key frames by state:");
+    for (state = 0; state <= TSC_STATEID_OFF; state++)
+    {
+        printf(" %u", (unsigned)TestVisits[state]);
+    }
+    printf("\n");
+
+    /* The trace goes through the touch, debounce error, Error and Off states */
+    HOST_CHECK(TestVisits[TSC_STATEID_PROX] > 0);
+    HOST_CHECK(TestVisits[TSC_STATEID_DETECT] > 0);
+    HOST_CHECK(TestVisits[TSC_STATEID_DEB_ERROR_RELEASE] > 0);
+    HOST_CHECK(TestVisits[TSC_STATEID_ERROR] + TestVisits[TSC_STATEID_OFF] > 0);
+
+    free(trace);
+    return Host_Report();
+}
+
+/**@} end of group TSC_Test_Trace_Functions */
+/**@} end of group TSC_Test_Trace */
+/**@} end of group TSC_Test */
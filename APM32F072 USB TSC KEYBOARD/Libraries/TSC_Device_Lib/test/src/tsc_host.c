@@ -0,0 +1,442 @@
+/*!
+ * @file        tsc_host.c
+ *
+ * @brief       Host copy of the example touch configuration (USBD_HID tsc_user.c),
+ *              acquired with the interrupt engine on the simulated TSC
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/* Includes */
+#include "tsc_host.h"
+#include "apm32f0xx_int.h"
+#include "apm32f0xx_tmr.h"
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Host Host
+  @{
+*/
+
+/** @defgroup TSC_Test_Host_Variables Variables
+  @{
+*/
+
+uint32_t HostFailures = 0;
+
+/* Source and Configuration (ROM), ordered by Block */
+CONST TSC_Channel_Src_T MyChannels_Src[TOUCH_TOTAL_CHANNELS] =
+{
+    TOUCH_SENSOR_CHANNELS(TSC_SENSOR_SRC)
+};
+
+/* Destination (ROM), ordered by Block */
+CONST TSC_Channel_Dest_T MyChannels_Dest[TOUCH_TOTAL_CHANNELS] =
+{
+    TOUCH_SENSOR_CHANNELS(TSC_SENSOR_DEST)
+};
+
+/* Data (RAM) */
+TSC_Channel_Data_T MyChannels_Data[TOUCH_TOTAL_CHANNELS];
+
+/* List (ROM) */
+CONST TSC_Block_T MyBlocks[TOUCH_TOTAL_BLOCKS] =
+{
+    TSC_SENSOR_BLOCK(0, MyChannels_Src, MyChannels_Dest, MyChannels_Data),
+#if TOUCH_TOTAL_BLOCKS > 1
+    TSC_SENSOR_BLOCK(1, MyChannels_Src, MyChannels_Dest, MyChannels_Data),
+#endif
+#if TOUCH_TOTAL_BLOCKS > 2
+    TSC_SENSOR_BLOCK(2, MyChannels_Src, MyChannels_Dest, MyChannels_Data),
+#endif
+};
+
+/* TouchKeys data and parameters (RAM) */
+TSC_TouchKeyData_T MyKeys_Data[TOUCH_TOTAL_KEYS];
+TSC_TouchKeyParam_T MyKeys_Param[TOUCH_TOTAL_KEYS];
+
+void MyKeys_ProcessErrorState(void);
+void MyKeys_ProcessOffState(void);
+
+/* State Machine (ROM), same as the example */
+CONST TSC_State_T MyKeys_StateMachine[] =
+{
+    { TSC_STATEMASK_CALIB,              TSC_TouchKey_ProcessCalibrationState },    /*!< 0 */
+    { TSC_STATEMASK_DEB_CALIB,          TSC_TouchKey_ProcessDebCalibrationState }, /*!< 1 */
+    { TSC_STATEMASK_RELEASE,            TSC_TouchKey_ProcessReleaseState },        /*!< 2 */
+#if TOUCH_USE_PROX > 0
+    { TSC_STATEMASK_DEB_RELEASE_PROX,   TSC_TouchKey_ProcessDebReleaseProxState }, /*!< 3 */
+#else
+    { TSC_STATEMASK_DEB_RELEASE_PROX,   0 }, /*!< 3 */
+#endif
+    { TSC_STATEMASK_DEB_RELEASE_DETECT, TSC_TouchKey_ProcessDebReleaseDetectState }, /*!< 4 */
+    { TSC_STATEMASK_DEB_RELEASE_TOUCH,  TSC_TouchKey_ProcessDebReleaseTouchState },  /*!< 5 */
+#if TOUCH_USE_PROX > 0
+    { TSC_STATEMASK_PROX,               TSC_TouchKey_ProcessProxState },          /*!< 6 */
+    { TSC_STATEMASK_DEB_PROX,           TSC_TouchKey_ProcessDebProxState },       /*!< 7 */
+    { TSC_STATEMASK_DEB_PROX_DETECT,    TSC_TouchKey_ProcessDebProxDetectState }, /*!< 8 */
+    { TSC_STATEMASK_DEB_PROX_TOUCH,     TSC_TouchKey_ProcessDebProxTouchState },  /*!< 9 */
+#else
+    { TSC_STATEMASK_PROX,               0 }, /*!< 6 */
+    { TSC_STATEMASK_DEB_PROX,           0 }, /*!< 7 */
+    { TSC_STATEMASK_DEB_PROX_DETECT,    0 }, /*!< 8 */
+    { TSC_STATEMASK_DEB_PROX_TOUCH,     0 }, /*!< 9 */
+#endif
+    { TSC_STATEMASK_DETECT,             TSC_TouchKey_ProcessDetectState },    /*!< 10 */
+    { TSC_STATEMASK_DEB_DETECT,         TSC_TouchKey_ProcessDebDetectState }, /*!< 11 */
+    { TSC_STATEMASK_TOUCH,              TSC_TouchKey_ProcessTouchState },     /*!< 12 */
+#if TOUCH_USE_RECOVERY > 0
+    { TSC_STATEMASK_ERROR,              TSC_Recovery_ProcessErrorState },    /*!< 13 */
+#else
+    { TSC_STATEMASK_ERROR,              MyKeys_ProcessErrorState },          /*!< 13 */
+#endif
+    { TSC_STATEMASK_DEB_ERROR_CALIB,    TSC_TouchKey_ProcessDebErrorState }, /*!< 14 */
+    { TSC_STATEMASK_DEB_ERROR_RELEASE,  TSC_TouchKey_ProcessDebErrorState }, /*!< 15 */
+    { TSC_STATEMASK_DEB_ERROR_PROX,     TSC_TouchKey_ProcessDebErrorState }, /*!< 16 */
+    { TSC_STATEMASK_DEB_ERROR_DETECT,   TSC_TouchKey_ProcessDebErrorState }, /*!< 17 */
+    { TSC_STATEMASK_DEB_ERROR_TOUCH,    TSC_TouchKey_ProcessDebErrorState }, /*!< 18 */
+#if TOUCH_USE_RECOVERY > 0
+    { TSC_STATEMASK_OFF,                TSC_Recovery_ProcessOffState } /*!< 19 */
+#else
+    { TSC_STATEMASK_OFF,                MyKeys_ProcessOffState } /*!< 19 */
+#endif
+};
+
+/* Methods for "extended" type (ROM) */
+CONST TSC_TouchKeyMethods_T MyKeys_Methods =
+{
+    TSC_TouchKey_Config,
+    TSC_TouchKey_Process
+};
+
+/* TouchKeys list (ROM), one TouchKey per channel */
+#define MY_TOUCHKEY(ch, g, io) \
+    { &MyKeys_Data[ch], &MyKeys_Param[ch], &MyChannels_Data[ch], MyKeys_StateMachine, &MyKeys_Methods },
+
+CONST TSC_TouchKey_T MyTouchKeys[TOUCH_TOTAL_KEYS] =
+{
+    TOUCH_SENSOR_KEYS(MY_TOUCHKEY)
+};
+
+/* List (ROM) */
+#define MY_OBJECT(ch, g, io) \
+    { TSC_OBJ_TOUCHKEY, (TSC_TouchKey_T *)&MyTouchKeys[ch] },
+
+CONST TSC_Object_T MyObjects[TOUCH_TOTAL_OBJECTS] =
+{
+    TOUCH_SENSOR_KEYS(MY_OBJECT)
+};
+
+#if TOUCH_USE_FILTER_BANK > 0
+/* Filter chain of the TouchKeys (ROM), same as the example */
+CONST TSC_FilterStage_T MyKeys_FilterStages[] =
+{
+    { TSC_FILT_MEDIAN3,      0,  0 },
+    { TSC_FILT_ADAPTIVE_IIR, 64, 2 }
+};
+
+CONST TSC_FilterChain_T MyKeys_Filter =
+{
+    MyKeys_FilterStages, /*!< First stage */
+    2                    /*!< Number of stages */
+};
+#endif
+
+/* Group (RAM) */
+TSC_ObjectGroup_T MyObjGroup =
+{
+    &MyObjects[0],        /*!< First object */
+    TOUCH_TOTAL_OBJECTS,  /*!< Number of objects */
+    0x00,                 /*!< State mask reset value */
+    TSC_STATE_NOT_CHANGED /*!< Current state */
+};
+
+TSC_Params_T TSC_Params =
+{
+    TOUCH_ACQ_MIN,
+    TOUCH_ACQ_MAX,
+    TOUCH_CALIB_SAMPLES,
+    TOUCH_DTO,
+    MyKeys_StateMachine,    /*!< Default state machine for TouchKeys */
+    &MyKeys_Methods,        /*!< Default methods for TouchKeys */
+};
+
+uint32_t Global_ProcessSensor;
+
+#if TOUCH_USE_SNAPSHOT > 0
+/* Hold the last time value for the calibration snapshot */
+__IO TSC_tTick_sec_T Global_Snap_last_tick;
+/* 0 when the test saves the snapshot itself */
+uint8_t HostSnapSave = 1;
+#endif
+
+/**@} end of group TSC_Test_Host_Variables */
+
+/** @defgroup TSC_Test_Host_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Executed when a sensor is in Error state, as in the example
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+void MyKeys_ProcessErrorState(void)
+{
+    TSC_TouchKey_ConfigOffState();
+}
+
+/*!
+ * @brief       Executed when a sensor is in Off state
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+void MyKeys_ProcessOffState(void)
+{
+}
+
+/*!
+ * @brief       TSC interrupt routine of the example
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+void TSC_IRQHandler(void)
+{
+    TSC_Acq_ProcessInterrupt();
+}
+
+/*!
+ * @brief       TMR14 interrupt routine of the example: discharge end and time base
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+void TMR14_IRQHandler(void)
+{
+    TSC_Acq_ProcessDischarge();
+
+    if (TMR_ReadIntFlag(TMR14, TMR_INT_FLAG_UPDATE) == SET)
+    {
+        TMR_ClearIntFlag(TMR14, TMR_INT_FLAG_UPDATE);
+        TSC_Time_ProcessInterrupt();
+    }
+}
+
+/*!
+ * @brief       Reset the simulation and config the Touch Driver as TSC_User_Config()
+ *
+ * @param       seed: Seed of the measure noise
+ *
+ * @retval      None
+ */
+void Host_Config(uint32_t seed)
+{
+    Sim_Reset(seed);
+
+    /* APM_EVAL_TMR14_Init(1000, 48): 1 us count, 1 ms update */
+    TMR14->AUTORLD = TOUCH_DISCHARGE_TIMER_PERIOD - 1;
+    TMR_EnableInterrupt(TMR14, TMR_INT_UPDATE);
+    TMR14->CTRL1 |= 0x01;
+
+#if TOUCH_USE_EVENT > 0
+    TSC_Event_Config();
+#endif
+    TSC_Obj_ConfigGroup(&MyObjGroup);
+#if TOUCH_ECS_INCREMENTAL > 0
+    TSC_Ecs_ConfigGroup(&MyObjGroup);
+#endif
+#if TOUCH_USE_GESTURE > 0
+    TSC_Gesture_Config(&MyObjGroup);
+#endif
+#if TOUCH_USE_LOWPOWER > 0
+    TSC_LowPower_Config();
+#endif
+#if TOUCH_USE_RECOVERY > 0
+    TSC_Recovery_Config(&MyObjGroup);
+#endif
+#if TOUCH_USE_TELEMETRY > 0
+    TSC_Telem_Config(&MyObjGroup);
+#endif
+#if TOUCH_USE_SNAPSHOT > 0
+    TSC_Snap_Config(&MyObjGroup);
+#endif
+#if TOUCH_USE_FILTER_BANK > 0
+    TSC_Filt_ConfigChannels(0, TOUCH_TOTAL_KEYS, &MyKeys_Filter);
+#endif
+    TSC_Config(MyBlocks);
+    TSC_Acq_StartEngine();
+}
+
+/*!
+ * @brief       Process a frame as TSC_User_Action()
+ *
+ * @param       None
+ *
+ * @retval      TSC_STATUS_OK if a frame has been processed
+ */
+TSC_STATUS_T Host_Action(void)
+{
+    CONST TSC_Frame_T *frame;
+
+    frame = TSC_Acq_ReadFrame();
+    if (frame == 0)
+    {
+        return TSC_STATUS_BUSY;
+    }
+
+#if TOUCH_USE_LOWPOWER > 0
+    if (TSC_LowPower_ProcessFrame(frame) == TSC_STATUS_OK)
+    {
+        TSC_Acq_ReleaseFrame();
+        return TSC_STATUS_BUSY;
+    }
+#endif
+
+    TSC_Acq_ReadFrameResult(frame, 0, 0);
+    TSC_Acq_ReleaseFrame();
+
+#if TOUCH_USE_SNAPSHOT > 0
+    TSC_Snap_ProcessRestore(&MyObjGroup);
+#endif
+
+    TSC_Obj_ProcessGroup(&MyObjGroup);
+    TSC_Dxs_FirstObj(&MyObjGroup);
+
+#if TOUCH_USE_RECOVERY > 0
+    TSC_Recovery_Process();
+#endif
+
+#if TOUCH_USE_TELEMETRY > 0
+    TSC_Telem_Write();
+#endif
+
+#if TOUCH_USE_LOWPOWER > 0
+    TSC_LowPower_ProcessGroup(&MyObjGroup);
+#endif
+
+    if (TSC_Ecs_ProcessSlice(&MyObjGroup) == TSC_STATUS_OK)
+    {
+        Global_ProcessSensor = 0;
+    }
+    else
+    {
+        Global_ProcessSensor = 1;
+    }
+
+#if TOUCH_USE_SNAPSHOT > 0
+    if (HostSnapSave && (TSC_Time_Delay_sec(TOUCH_SNAPSHOT_PERIOD, &Global_Snap_last_tick) == TSC_STATUS_OK))
+    {
+        TSC_Snap_Save(&MyObjGroup);
+    }
+#endif
+    return TSC_STATUS_OK;
+}
+
+/*!
+ * @brief       Return the channel IO of a TouchKey
+ *
+ * @param       key: TouchKey index
+ *
+ * @retval      TSC_GROUPx_IOy mask
+ */
+uint32_t Host_ReadKeyIo(uint32_t key)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < TOUCH_TOTAL_CHANNELS; idx++)
+    {
+        if (MyChannels_Dest[idx].IdxDest == key)
+        {
+            return MyChannels_Src[idx].msk_IOCHCTRL_channel;
+        }
+    }
+    return 0;
+}
+
+/*!
+ * @brief       Set the count of a TouchKey electrode
+ *
+ * @param       key: TouchKey index
+ *
+ * @param       count: Count acquired alone, a finger lowers it
+ *
+ * @retval      None
+ */
+void Host_TouchKey(uint32_t key, uint16_t count)
+{
+    Sim_ConfigCount(Host_ReadKeyIo(key), count);
+}
+
+/*!
+ * @brief       Run the main loop of the example for a time
+ *
+ * @param       cycles: HCLK cycles
+ *
+ * @param       frameHandler: Called after each processed frame, or 0
+ *
+ * @retval      None
+ */
+void Host_RunFor(uint64_t cycles, void (*frameHandler)(void))
+{
+    uint64_t end = Sim_ReadTime() + cycles;
+
+    while (Sim_ReadTime() < end)
+    {
+        while (Host_Action() == TSC_STATUS_OK)
+        {
+            if (frameHandler)
+            {
+                frameHandler();
+            }
+        }
+        Sim_Step();
+    }
+}
+
+/*!
+ * @brief       Print the result of the test
+ *
+ * @param       None
+ *
+ * @retval      Exit status: 0 if all checks passed
+ */
+int Host_Report(void)
+{
+    if (HostFailures)
+    {
+        printf("FAIL: %u check(s) failed\n", (unsigned)HostFailures);
+        return 1;
+    }
+    printf("PASS\n");
+    return 0;
+}
+
+/**@} end of group TSC_Test_Host_Functions */
+/**@} end of group TSC_Test_Host */
+/**@} end of group TSC_Test */
@@ -0,0 +1,875 @@
+/*!
+ * @file        tsc_sim.c
+ *
+ * @brief       Simulated TSC, TMR14 and SysTick peripherals of the host tests
+ *
+ * @version     V1.0.0
+ *
+ * @date        2023-02-06
+ *
+ * @attention
+ *
+ *  Copyright (C) 2023 Geehy Semiconductor
+ *
+ *  You may not use this file except in compliance with the
+ *  GEEHY COPYRIGHT NOTICE (GEEHY SOFTWARE PACKAGE LICENSE).
+ *
+ *  The program is only for reference, which is distributed in the hope
+ *  that it will be useful and instructional for customers to develop
+ *  their software. Unless required by applicable law or agreed to in
+ *  writing, the program is distributed on an "AS IS" BASIS, WITHOUT
+ *  ANY WARRANTY OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the GEEHY SOFTWARE PACKAGE LICENSE for the governing permissions
+ *  and limitations under the License.
+ */
+
+/*
+ * The firmware runs in zero simulated time: the time only moves forward in
+ * Sim_Step() and in WFI, to the next peripheral event. The registers are plain
+ * memory, the writes of the firmware are applied by Sim_Sync():
+ *  - TSC: INTFCLR clears INTSTS, the START bit starts a burst. All groups are
+ *    acquired in parallel, the burst lasts the largest count of the groups times
+ *    the charge transfer period. A group counts Ns / (1/N1 + 1/N2 ...) where Ni
+ *    is the count of each of its channel IOs acquired alone (ganged IOs add
+ *    their capacitance), with a triangular noise. The count stops at the max
+ *    count value with MCEF set.
+ *  - TMR14: up counter of 1 us, update and compare 1 flags. An auto-reload value
+ *    written below the counter makes the counter roll over at 0xFFFF without
+ *    update, this is counted in SimStats.TimerMiss.
+ *  - The TSC interrupt has the priority over the TMR14 interrupt, the routines are
+ *    not nested. PRIMASK delays them to __enable_irq() / __set_PRIMASK(0).
+ */
+
+/* Includes */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "tsc_sim.h"
+#include "apm32f0xx_int.h"
+#include "apm32f0xx_gpio.h"
+#include "apm32f0xx_rcm.h"
+#include "apm32f0xx_misc.h"
+#include "apm32f0xx_tmr.h"
+#include "apm32f0xx_pmu.h"
+#include "apm32f0xx_fmc.h"
+#include "apm32f0xx_crc.h"
+
+/** @addtogroup TSC_Test TSC Host Test
+  @{
+*/
+
+/** @addtogroup TSC_Test_Sim Simulation
+  @{
+*/
+
+/** @defgroup TSC_Test_Sim_Macros Macros
+  @{
+*/
+
+/* Count of an IO not configured by the test */
+#define SIM_COUNT_DEFAULT   (1500)
+/* Interrupt routines run in a row before the simulation stops */
+#define SIM_IRQ_STORM       (1000)
+
+/**@} end of group TSC_Test_Sim_Macros */
+
+/** @defgroup TSC_Test_Sim_Variables Variables
+  @{
+*/
+
+/* Simulated peripherals */
+TSC_T        SimTSC;
+TMR_T        SimTMR14;
+SysTick_Type SimSysTick;
+GPIO_T       SimGPIO[5];
+uint32_t     SystemCoreClock = SIM_HCLK;
+
+SIM_Stats_T  SimStats;
+
+/* Time in HCLK cycles */
+static uint64_t SimTime;
+static uint32_t SimPrimask;
+static uint8_t  SimInIrq;
+static uint32_t SimSeed;
+
+/* Count and noise amplitude of each IO acquired alone */
+static uint16_t SimCount[32];
+static uint16_t SimNoise[32];
+/* Shortest time between two bursts to discharge the capacitors */
+static uint32_t SimDischargeUs;
+
+/* Burst being acquired */
+static uint8_t  BurstRun;
+static uint8_t  BurstDone;
+static uint8_t  BurstMce;
+static uint32_t BurstGroups;
+static uint16_t BurstCount[8];
+static uint64_t BurstEnd;
+static uint64_t BurstLastEnd;
+
+/* Time of the next count of TMR14 */
+static uint64_t TmrNextCount;
+
+/* Flash page used by the calibration snapshot */
+static uint32_t FlashAddr;
+static uint32_t FlashSize;
+static uint8_t  FlashLocked = 1;
+/* Words programmed before the simulated reset, -1 = no reset */
+static int32_t  FlashFailAfter = -1;
+
+/* CRC unit */
+static uint32_t CrcData;
+
+/**@} end of group TSC_Test_Sim_Variables */
+
+/** @defgroup TSC_Test_Sim_Functions Functions
+  @{
+*/
+
+/*!
+ * @brief       Return a pseudo random number (xorshift32)
+ *
+ * @param       None
+ *
+ * @retval      Random number
+ */
+static uint32_t Sim_Random(void)
+{
+    SimSeed ^= SimSeed << 13;
+    SimSeed ^= SimSeed >> 17;
+    SimSeed ^= SimSeed << 5;
+    return SimSeed;
+}
+
+/*!
+ * @brief       Reset the simulated peripherals and the time
+ *
+ * @param       seed: Seed of the measure noise, not 0
+ *
+ * @retval      None
+ */
+void Sim_Reset(uint32_t seed)
+{
+    uint32_t idx;
+
+    memset(&SimTSC, 0, sizeof(SimTSC));
+    memset(&SimTMR14, 0, sizeof(SimTMR14));
+    memset(&SimSysTick, 0, sizeof(SimSysTick));
+    memset(SimGPIO, 0, sizeof(SimGPIO));
+    memset(&SimStats, 0, sizeof(SimStats));
+
+    for (idx = 0; idx < 32; idx++)
+    {
+        SimCount[idx] = SIM_COUNT_DEFAULT;
+        SimNoise[idx] = 0;
+    }
+
+    SimTime = 0;
+    SimPrimask = 0;
+    SimInIrq = 0;
+    SimSeed = seed ? seed : 1;
+    SimDischargeUs = 100;
+    BurstRun = 0;
+    BurstDone = 0;
+    TmrNextCount = SIM_TMR_DIV;
+}
+
+/*!
+ * @brief       Return the simulated time
+ *
+ * @param       None
+ *
+ * @retval      HCLK cycles since Sim_Reset()
+ */
+uint64_t Sim_ReadTime(void)
+{
+    return SimTime;
+}
+
+/*!
+ * @brief       Set the count of channel IOs acquired alone
+ *
+ * @param       ioMask: IOs (TSC_GROUPx_IOy masks)
+ *
+ * @param       count: Count, a touch lowers it
+ *
+ * @retval      None
+ */
+void Sim_ConfigCount(uint32_t ioMask, uint16_t count)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < 32; idx++)
+    {
+        if (ioMask & ((uint32_t)1 << idx))
+        {
+            SimCount[idx] = count;
+        }
+    }
+}
+
+/*!
+ * @brief       Set the noise of channel IOs
+ *
+ * @param       ioMask: IOs (TSC_GROUPx_IOy masks)
+ *
+ * @param       amplitude: Largest deviation of the count, triangular distribution
+ *
+ * @retval      None
+ */
+void Sim_ConfigNoise(uint32_t ioMask, uint16_t amplitude)
+{
+    uint32_t idx;
+
+    for (idx = 0; idx < 32; idx++)
+    {
+        if (ioMask & ((uint32_t)1 << idx))
+        {
+            SimNoise[idx] = amplitude;
+        }
+    }
+}
+
+/*!
+ * @brief       Set the shortest time between two bursts
+ *
+ * @param       us: Discharge time, a burst started earlier is counted in SimStats.EarlyStart
+ *
+ * @retval      None
+ */
+void Sim_ConfigDischarge(uint32_t us)
+{
+    SimDischargeUs = us;
+}
+
+/*!
+ * @brief       Map the flash page of the calibration snapshot at its device address
+ *
+ * @param       addr: Address of the page
+ *
+ * @param       size: Size of the page
+ *
+ * @retval      0 if the page is mapped and erased
+ */
+int Sim_ConfigFlash(uint32_t addr, uint32_t size)
+{
+    uintptr_t base = addr & ~(uintptr_t)0xFFF;
+    size_t    len = ((addr + size + 0xFFF) & ~(uintptr_t)0xFFF) - base;
+    void      *page;
+
+    if (FlashSize == 0)
+    {
+        page = mmap((void *)base, len, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+        if (page != (void *)base)
+        {
+            return -1;
+        }
+    }
+
+    FlashAddr = addr;
+    FlashSize = size;
+    memset((void *)(uintptr_t)addr, 0xFF, size);
+    return 0;
+}
+
+/*!
+ * @brief       Simulate a reset while the flash is programmed
+ *
+ * @param       words: Words programmed before the reset, the next ones are not written
+ *
+ * @retval      None
+ */
+void Sim_ConfigFlashFail(int32_t words)
+{
+    FlashFailAfter = words;
+}
+
+/*!
+ * @brief       Return the charge transfer period of the TSC
+ *
+ * @param       None
+ *
+ * @retval      HCLK cycles per count
+ */
+static uint32_t Sim_ReadCountCycles(void)
+{
+    uint32_t ctph = (SimTSC.CTRL >> 28) & 0x0F;
+    uint32_t ctpl = (SimTSC.CTRL >> 24) & 0x0F;
+    uint32_t pgcdf = (SimTSC.CTRL >> 12) & 0x07;
+
+    return ((ctph + 1) + (ctpl + 1)) << pgcdf;
+}
+
+/*!
+ * @brief       Start a burst on the enabled groups
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Sim_StartBurst(void)
+{
+    uint32_t maxCount = ((uint32_t)256 << ((SimTSC.CTRL >> 5) & 0x07)) - 1;
+    uint32_t longest = 0;
+    uint32_t g, io, bit;
+    uint32_t count;
+    uint32_t noise;
+    int32_t  delta;
+    double   inverse;
+
+    if (BurstDone && ((SimTime - BurstLastEnd) < SIM_US(SimDischargeUs)))
+    {
+        SimStats.EarlyStart++;
+    }
+
+    BurstGroups = SimTSC.IOGCSTS & 0xFF;
+    BurstMce = 0;
+
+    for (g = 0; g < 8; g++)
+    {
+        if ((BurstGroups & (1U << g)) == 0)
+        {
+            continue;
+        }
+
+        inverse = 0;
+        noise = 0;
+        for (io = 0; io < 4; io++)
+        {
+            bit = 1U << (g * 4 + io);
+            if ((SimTSC.IOCHCTRL & bit) && ((SimTSC.IOSMPCTRL & bit) == 0) && SimCount[g * 4 + io])
+            {
+                inverse += 1.0 / SimCount[g * 4 + io];
+                noise = (SimNoise[g * 4 + io] > noise) ? SimNoise[g * 4 + io] : noise;
+            }
+        }
+
+        /* No electrode: the sampling capacitor is never charged */
+        count = maxCount + 1;
+        if (inverse > 0)
+        {
+            count = (uint32_t)(1.0 / inverse + 0.5);
+            if (noise)
+            {
+                delta = (int32_t)(Sim_Random() % (noise + 1)) + (int32_t)(Sim_Random() % (noise + 1)) - (int32_t)noise;
+                count = ((int32_t)count + delta > 1) ? (uint32_t)((int32_t)count + delta) : 1;
+            }
+        }
+
+        if (count > maxCount)
+        {
+            count = maxCount;
+            BurstMce = 1;
+        }
+        BurstCount[g] = (uint16_t)count;
+        longest = (count > longest) ? count : longest;
+    }
+
+    BurstRun = 1;
+    BurstEnd = SimTime + (uint64_t)(longest ? longest : 1) * Sim_ReadCountCycles();
+    SimStats.BurstTime += BurstEnd - SimTime;
+}
+
+/*!
+ * @brief       End the burst: counters, flags and START bit
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Sim_EndBurst(void)
+{
+    uint32_t g;
+
+    for (g = 0; g < 8; g++)
+    {
+        if (BurstGroups & (1U << g))
+        {
+            SimTSC.IOGxCNT[g].IOGCNT = BurstCount[g];
+        }
+    }
+
+    SimTSC.INTSTS |= BurstMce ? 0x03 : 0x01;
+    SimTSC.CTRL &= ~(uint32_t)0x02;
+    BurstRun = 0;
+    BurstDone = 1;
+    BurstLastEnd = SimTime;
+    SimStats.Bursts++;
+    SimStats.MaxCountErr += BurstMce;
+}
+
+/*!
+ * @brief       Apply the register writes of the firmware
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+void Sim_Sync(void)
+{
+    if (SimTSC.INTFCLR)
+    {
+        SimTSC.INTSTS &= ~(SimTSC.INTFCLR & 0x03);
+        SimTSC.INTFCLR = 0;
+    }
+
+    if (((SimTSC.CTRL & 0x03) == 0x03) && (BurstRun == 0))
+    {
+        Sim_StartBurst();
+    }
+}
+
+/*!
+ * @brief       Return the counts of TMR14 before its next update and compare events
+ *
+ * @param       toUpdate: Counts before the update, or before the roll over
+ *
+ * @param       toCompare: Counts before the compare 1 match
+ *
+ * @retval      None
+ */
+static void Sim_ReadTimerEvents(uint32_t *toUpdate, uint32_t *toCompare)
+{
+    uint32_t cnt = SimTMR14.CNT & 0xFFFF;
+    uint32_t arr = SimTMR14.AUTORLD & 0xFFFF;
+    uint32_t cc1 = SimTMR14.CC1 & 0xFFFF;
+
+    *toUpdate = (cnt > arr) ? (0x10000 - cnt) : (arr - cnt + 1);
+    *toCompare = (cc1 > cnt) ? (cc1 - cnt) : (*toUpdate + cc1);
+}
+
+/*!
+ * @brief       Run TMR14 up to a time
+ *
+ * @param       time: HCLK cycles
+ *
+ * @retval      None
+ */
+static void Sim_AdvanceTimer(uint64_t time)
+{
+    uint32_t toUpdate, toCompare;
+    uint64_t counts, step;
+
+    if ((SimTMR14.CTRL1 & 0x01) == 0)
+    {
+        TmrNextCount = time + SIM_TMR_DIV;
+        return;
+    }
+
+    while (TmrNextCount <= time)
+    {
+        counts = ((time - TmrNextCount) / SIM_TMR_DIV) + 1;
+        Sim_ReadTimerEvents(&toUpdate, &toCompare);
+
+        step = counts;
+        step = (toUpdate < step) ? toUpdate : step;
+        step = (toCompare < step) ? toCompare : step;
+
+        TmrNextCount += step * SIM_TMR_DIV;
+
+        if (step == toUpdate)
+        {
+            if ((SimTMR14.CNT & 0xFFFF) > (SimTMR14.AUTORLD & 0xFFFF))
+            {
+                SimStats.TimerMiss++;
+            }
+            else
+            {
+                SimTMR14.STS |= TMR_INT_FLAG_UPDATE;
+            }
+            SimTMR14.CNT = 0;
+        }
+        else
+        {
+            SimTMR14.CNT += (uint32_t)step;
+        }
+
+        if (SimTMR14.CNT == (SimTMR14.CC1 & 0xFFFF))
+        {
+            SimTMR14.STS |= TMR_INT_FLAG_CH1;
+        }
+    }
+}
+
+/*!
+ * @brief       Return the time of the next peripheral event
+ *
+ * @param       None
+ *
+ * @retval      HCLK cycles
+ */
+static uint64_t Sim_ReadNextEvent(void)
+{
+    uint32_t toUpdate, toCompare;
+    uint64_t next = UINT64_MAX;
+
+    if (SimTMR14.CTRL1 & 0x01)
+    {
+        Sim_ReadTimerEvents(&toUpdate, &toCompare);
+        next = TmrNextCount + ((uint64_t)((toUpdate < toCompare) ? toUpdate : toCompare) - 1) * SIM_TMR_DIV;
+    }
+
+    if (BurstRun && (BurstEnd < next))
+    {
+        next = BurstEnd;
+    }
+
+    return next;
+}
+
+/*!
+ * @brief       Move the time to the next peripheral event
+ *
+ * @param       None
+ *
+ * @retval      0 if there is no event
+ */
+static int Sim_Advance(void)
+{
+    uint64_t next;
+    uint32_t reload;
+
+    Sim_Sync();
+    next = Sim_ReadNextEvent();
+    if (next == UINT64_MAX)
+    {
+        return 0;
+    }
+
+    Sim_AdvanceTimer(next);
+    SimTime = next;
+    if (BurstRun && (BurstEnd <= SimTime))
+    {
+        Sim_EndBurst();
+    }
+
+    /* SysTick is a down counter */
+    reload = SimSysTick.LOAD + 1;
+    SimSysTick.VAL = SimSysTick.LOAD - (uint32_t)(SimTime % reload);
+    return 1;
+}
+
+/*!
+ * @brief       Check if an interrupt is pending
+ *
+ * @param       None
+ *
+ * @retval      1 if the TSC or TMR14 interrupt is pending
+ */
+static int Sim_ReadIrqPending(void)
+{
+    return ((SimTSC.INTSTS & SimTSC.INTEN & 0x03) != 0) ||
+           ((SimTMR14.STS & SimTMR14.DIEN & 0x03) != 0);
+}
+
+/*!
+ * @brief       Run the pending interrupt routines
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+static void Sim_Dispatch(void)
+{
+    uint32_t storm = 0;
+
+    if (SimInIrq)
+    {
+        return;
+    }
+
+    Sim_Sync();
+    while ((SimPrimask == 0) && Sim_ReadIrqPending())
+    {
+        SimInIrq = 1;
+        if (SimTSC.INTSTS & SimTSC.INTEN & 0x03)
+        {
+            TSC_IRQHandler();
+        }
+        else
+        {
+            TMR14_IRQHandler();
+        }
+        SimInIrq = 0;
+        Sim_Sync();
+
+        if (++storm > SIM_IRQ_STORM)
+        {
+            fprintf(stderr, "sim: interrupt flags not cleared at %llu us\n", (unsigned long long)SIM_TO_US(SimTime));
+            exit(2);
+        }
+    }
+}
+
+/*!
+ * @brief       Move the time to the next peripheral event and run the interrupt routines
+ *
+ * @param       None
+ *
+ * @retval      0 if there is no event
+ */
+int Sim_Step(void)
+{
+    if (Sim_Advance() == 0)
+    {
+        return 0;
+    }
+
+    Sim_Dispatch();
+    return 1;
+}
+
+/*!
+ * @brief       Run the peripherals and interrupt routines without the main loop
+ *
+ * @param       cycles: HCLK cycles
+ *
+ * @retval      None
+ */
+void Sim_RunFor(uint64_t cycles)
+{
+    uint64_t end = SimTime + cycles;
+
+    while ((Sim_ReadNextEvent() <= end) && Sim_Step())
+    {
+    }
+}
+
+/*!
+ * @brief       Simulated __disable_irq()
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+void Sim_DisableIrq(void)
+{
+    SimPrimask = 1;
+}
+
+/*!
+ * @brief       Simulated __enable_irq(), the pending interrupts are taken
+ *
+ * @param       None
+ *
+ * @retval      None
+ */
+void Sim_EnableIrq(void)
+{
+    SimPrimask = 0;
+    Sim_Dispatch();
+}
+
+/*!
+ * @brief       Simulated __get_PRIMASK()
+ *
+ * @param       None
+ *
+ * @retval      PRIMASK
+ */
+uint32_t Sim_ReadPrimask(void)
+{
+    return SimPrimask;
+}
+
+/*!
+ * @brief       Simulated __set_PRIMASK()
+ *
+ * @param       primask: PRIMASK
+ *
+ * @retval      None
+ */
+void Sim_WritePrimask(uint32_t primask)
+{
+    SimPrimask = primask & 0x01;
+    Sim_Dispatch();
+}
+
+/*!
+ * @brief       Simulated __WFI(): wait for a pending interrupt
+ *
+ * @param       None
+ *
+ * @retval      None
+ *
+ * @note        As on the Cortex-M0, a pending interrupt ends the wait even with
+ *              PRIMASK set, the routine then runs at __enable_irq().
+ */
+void Sim_WaitForInterrupt(void)
+{
+    uint64_t start = SimTime;
+
+    Sim_Sync();
+    while (!Sim_ReadIrqPending())
+    {
+        if (Sim_Advance() == 0)
+        {
+            return;
+        }
+    }
+
+    SimStats.SleepTime += SimTime - start;
+    SimStats.Wakeups++;
+    Sim_Dispatch();
+}
+
+/*!
+ * @brief       Simulated SysTick_Config(), the SysTick interrupt is not used
+ *
+ * @param       ticks: Reload value + 1
+ *
+ * @retval      0
+ */
+uint32_t SysTick_Config(uint32_t ticks)
+{
+    SimSysTick.LOAD = (ticks - 1) & 0x00FFFFFF;
+    SimSysTick.VAL = SimSysTick.LOAD;
+    SimSysTick.CTRL = 0x07;
+    return 0;
+}
+
+void GPIO_Config(GPIO_T* port, GPIO_Config_T* gpioConfig)
+{
+    (void)port;
+    (void)gpioConfig;
+}
+
+void RCM_EnableAHBPeriphClock(uint32_t AHBPeriph)
+{
+    (void)AHBPeriph;
+}
+
+void NVIC_EnableIRQRequest(IRQn_Type irq, uint8_t priority)
+{
+    (void)irq;
+    (void)priority;
+}
+
+void TMR_EnableInterrupt(TMR_T* TMRx, uint16_t interrupt)
+{
+    TMRx->DIEN |= interrupt;
+}
+
+void TMR_DisableInterrupt(TMR_T* TMRx, uint16_t interrupt)
+{
+    TMRx->DIEN &= ~(uint32_t)interrupt;
+}
+
+uint16_t TMR_ReadIntFlag(TMR_T* TMRx, TMR_INT_FLAG_T flag)
+{
+    return ((TMRx->STS & flag) && (TMRx->DIEN & flag)) ? SET : RESET;
+}
+
+void TMR_ClearIntFlag(TMR_T* TMRx, uint16_t flag)
+{
+    TMRx->STS &= ~(uint32_t)flag;
+}
+
+void PMU_EnterSleepMode(PMU_SLEEPENTRY_T entry)
+{
+    (void)entry;
+    __WFI();
+}
+
+void FMC_Unlock(void)
+{
+    FlashLocked = 0;
+}
+
+void FMC_Lock(void)
+{
+    FlashLocked = 1;
+}
+
+void FMC_ClearStatusFlag(uint8_t flag)
+{
+    (void)flag;
+}
+
+/*!
+ * @brief       Erase the simulated flash page
+ *
+ * @param       pageAddr: Address of the page
+ *
+ * @retval      FMC_STATE_COMPLETE or an error
+ */
+FMC_STATE_T FMC_ErasePage(uint32_t pageAddr)
+{
+    if (FlashLocked || (FlashSize == 0) || (pageAddr != FlashAddr))
+    {
+        return FMC_STATE_WRP_ERR;
+    }
+
+    memset((void *)(uintptr_t)FlashAddr, 0xFF, FlashSize);
+    return FMC_STATE_COMPLETE;
+}
+
+/*!
+ * @brief       Program a word of the simulated flash page
+ *
+ * @param       addr: Address of the word
+ *
+ * @param       data: Value
+ *
+ * @retval      FMC_STATE_COMPLETE or an error, a word is only programmed once after the erase
+ */
+FMC_STATE_T FMC_ProgramWord(uint32_t addr, uint32_t data)
+{
+    uint32_t *word = (uint32_t *)(uintptr_t)addr;
+
+    if (FlashLocked || (addr < FlashAddr) || ((addr + 4) > (FlashAddr + FlashSize)) || (addr & 0x03))
+    {
+        return FMC_STATE_WRP_ERR;
+    }
+    if ((*word != 0xFFFFFFFF) || (FlashFailAfter == 0))
+    {
+        return FMC_STATE_PG_ERR;
+    }
+    if (FlashFailAfter > 0)
+    {
+        FlashFailAfter--;
+    }
+
+    *word = data;
+    return FMC_STATE_COMPLETE;
+}
+
+void CRC_Reset(void)
+{
+    CrcData = 0xFFFFFFFF;
+}
+
+void CRC_ResetDATA(void)
+{
+    CrcData = 0xFFFFFFFF;
+}
+
+/*!
+ * @brief       CRC-32 of the CRC unit: polynomial 0x04C11DB7, 32-bit words, MSB first
+ *
+ * @param       pBuffer: Words
+ *
+ * @param       bufferLength: Number of words
+ *
+ * @retval      CRC
+ */
+uint32_t CRC_CalculateBlockCRC(uint32_t pBuffer[], uint32_t bufferLength)
+{
+    uint32_t idx, bit;
+
+    for (idx = 0; idx < bufferLength; idx++)
+    {
+        CrcData ^= pBuffer[idx];
+        for (bit = 0; bit < 32; bit++)
+        {
+            CrcData = (CrcData & 0x80000000) ? ((CrcData << 1) ^ 0x04C11DB7) : (CrcData << 1);
+        }
+    }
+    return CrcData;
+}
+
+/**@} end of group TSC_Test_Sim_Functions */
+/**@} end of group TSC_Test_Sim */
+/**@} end of group TSC_Test */
@@ -42,15 +42,46 @@
   @{
 */
 
-#define USBD_HID_MOUSE_REPORT_DESC_SIZE         63
+/* Keyboard report protocol, 0: 6KRO boot report, 1: NKRO bitmap report */
+#ifndef USBD_HID_KEYBOARD_NKRO
+#define USBD_HID_KEYBOARD_NKRO                  0
+#endif
+
+/* Consumer and system control reports with report IDs, 0: keyboard only */
+#ifndef USBD_HID_COMPOSITE
+#define USBD_HID_COMPOSITE                      0
+#endif
+
+#if USBD_HID_KEYBOARD_NKRO
+#define USBD_HID_KEYBOARD_REPORT_DESC_SIZE      53
+#else
+#define USBD_HID_KEYBOARD_REPORT_DESC_SIZE      63
+#endif
+#if USBD_HID_COMPOSITE
+#define USBD_HID_MOUSE_REPORT_DESC_SIZE         (USBD_HID_KEYBOARD_REPORT_DESC_SIZE + 2 + 25 + 25)
+#else
+#define USBD_HID_MOUSE_REPORT_DESC_SIZE         USBD_HID_KEYBOARD_REPORT_DESC_SIZE
+#endif
 #define USBD_HID_DESC_SIZE                      9
 #define USBD_HID_FS_INTERVAL                    10
 #define USBD_HID_HS_INTERVAL                    7
 #define USBD_HID_IN_EP_ADDR                     0x81
 #define USBD_HID_OUT_EP_ADDR                    0x01
+#if USBD_HID_KEYBOARD_NKRO
+#define USBD_HID_IN_EP_SIZE                     0x20
+#elif USBD_HID_COMPOSITE
+#define USBD_HID_IN_EP_SIZE                     0x10
+#else
 #define USBD_HID_IN_EP_SIZE                     0x08
+#endif
 #define USBD_HID_FS_MP_SIZE                     0x40
 
+/* Interrupt OUT endpoint for the output reports, 0: output reports by SET_REPORT only */
+#ifndef USBD_HID_OUT_EP_EN
+#define USBD_HID_OUT_EP_EN                      0
+#endif
+#define USBD_HID_OUT_EP_SIZE                    0x08
+
 #define USBD_CLASS_SET_IDLE                     0x0A
 #define USBD_CLASS_GET_IDLE                     0x02
 
@@ -60,6 +91,82 @@
 #define USBD_CLASS_SET_PROTOCOL                 0x0B
 #define USBD_CLASS_GET_PROTOCOL                 0x03
 
+#define USBD_HID_PROTOCOL_BOOT                  0x00
+#define USBD_HID_PROTOCOL_REPORT                0x01
+
+/* Report type of GET_REPORT and SET_REPORT (wValue high byte) */
+#define USBD_HID_REQ_REPORT_INPUT               0x01
+#define USBD_HID_REQ_REPORT_OUTPUT              0x02
+#define USBD_HID_REQ_REPORT_FEATURE             0x03
+
+/* Keyboard LED output report */
+#define USBD_HID_LED_NUM_LOCK                   0x01
+#define USBD_HID_LED_CAPS_LOCK                  0x02
+#define USBD_HID_LED_SCROLL_LOCK                0x04
+#define USBD_HID_LED_COMPOSE                    0x08
+#define USBD_HID_LED_KANA                       0x10
+#define USBD_HID_LED_MASK                       0x1F
+
+/* Boot keyboard report: modifiers, reserved, then the key usages */
+#define USBD_HID_BOOT_REPORT_SIZE               8
+#define USBD_HID_BOOT_KEY_OFFSET                2
+#define USBD_HID_BOOT_KEYS                      6
+/* NKRO keyboard report: modifiers, then the bitmap of the usages 0x00 to 0xDF */
+#define USBD_HID_NKRO_REPORT_SIZE               29
+#define USBD_HID_NKRO_KEY_OFFSET                1
+
+/* Consumer and system control reports: report ID, then one 16-bit usage */
+#define USBD_HID_REPORT_ID_KEYBOARD             0x01
+#define USBD_HID_REPORT_ID_CONSUMER             0x02
+#define USBD_HID_REPORT_ID_SYSTEM               0x03
+#define USBD_HID_USAGE_REPORT_SIZE              3
+#define USBD_HID_CONSUMER_USAGE_MAX             0x03FF
+#define USBD_HID_SYSTEM_USAGE_MAX               0x00B7
+
+#define USBD_HID_CONSUMER_SCAN_NEXT             0x00B5
+#define USBD_HID_CONSUMER_SCAN_PREVIOUS         0x00B6
+#define USBD_HID_CONSUMER_PLAY_PAUSE            0x00CD
+#define USBD_HID_CONSUMER_MUTE                  0x00E2
+#define USBD_HID_CONSUMER_VOLUME_UP             0x00E9
+#define USBD_HID_CONSUMER_VOLUME_DOWN           0x00EA
+#define USBD_HID_SYSTEM_POWER_DOWN              0x0081
+#define USBD_HID_SYSTEM_SLEEP                   0x0082
+#define USBD_HID_SYSTEM_WAKE_UP                 0x0083
+
+#define USBD_HID_KEY_ERROR_ROLLOVER             0x01
+#define USBD_HID_KEY_FIRST                      0x04
+#define USBD_HID_KEY_MODIFIER_FIRST             0xE0
+#define USBD_HID_KEY_USAGE_MAX                  0xE7
+
+/* Key map: bitmap of the pressed keyboard usages */
+#define USBD_HID_KEYMAP_WORDS                   ((USBD_HID_KEY_USAGE_MAX >> 5) + 1)
+#define USBD_HID_KEYMAP_SET(map, usage)         ((map)[(usage) >> 5] |= ((uint32_t)1 << ((usage) & 0x1F)))
+#define USBD_HID_KEYMAP_CLR(map, usage)         ((map)[(usage) >> 5] &= ~((uint32_t)1 << ((usage) & 0x1F)))
+#define USBD_HID_KEYMAP_TEST(map, usage)        (((map)[(usage) >> 5] >> ((usage) & 0x1F)) & 1)
+
+/* Reports waiting for the IN endpoint, power of 2 */
+#ifndef USBD_HID_QUEUE_SIZE
+#define USBD_HID_QUEUE_SIZE                     8
+#endif
+
+#if ((USBD_HID_QUEUE_SIZE < 2) || (USBD_HID_QUEUE_SIZE > 128) || \
+     ((USBD_HID_QUEUE_SIZE & (USBD_HID_QUEUE_SIZE - 1)) != 0))
+#error "USBD_HID_QUEUE_SIZE can be (2, 4, 8, 16, 32, 64, 128)."
+#endif
+
+/* Do not queue a report identical to the previous one */
+#ifndef USBD_HID_QUEUE_COALESCE
+#define USBD_HID_QUEUE_COALESCE                 1
+#endif
+
+#define USBD_HID_REPORT_MAX_SIZE                USBD_HID_IN_EP_SIZE
+#if USBD_HID_COMPOSITE
+#define USBD_HID_QUEUE_NUM                      3
+#else
+#define USBD_HID_QUEUE_NUM                      1
+#endif
+#define USBD_HID_QUEUE_INDEX(i)                 ((i) & (USBD_HID_QUEUE_SIZE - 1))
+
 /**@} end of group USBD_HID_Macros*/
 
 /** @defgroup USBD_HID_Enumerates Enumerates
@@ -75,22 +182,98 @@ typedef enum
     USBD_HID_BUSY,
 } USBD_HID_STATE_T;
 
+/**
+ * @brief    HID report type, each one has its own queue
+ */
+typedef enum
+{
+    USBD_HID_REPORT_KEYBOARD,
+    USBD_HID_REPORT_CONSUMER,
+    USBD_HID_REPORT_SYSTEM,
+} USBD_HID_REPORT_TYPE_T;
+
 /**@} end of group USBD_HID_Enumerates*/
 
 /** @defgroup USBD_HID_Structures Structures
   @{
   */
 
+/**
+ * @brief    HID report
+ */
+typedef struct
+{
+    uint8_t             length;
+    uint8_t             data[USBD_HID_REPORT_MAX_SIZE];
+} USBD_HID_REPORT_T;
+
+/**
+ * @brief    HID report queue statistics
+ */
+typedef struct
+{
+    uint32_t            overflow;
+    uint32_t            coalesced;
+    uint8_t             maxUsed;
+} USBD_HID_QUEUE_STAT_T;
+
+/**
+ * @brief    HID report queue, written by the application and read by the
+ *           IN endpoint interrupt. The reports are built in place in the slots
+ *           and sent from them, the report being sent stays in the queue.
+ */
+typedef struct
+{
+    __IO uint8_t        write;
+    __IO uint8_t        read;
+    uint8_t             lastValid;
+    uint8_t             acquired;
+    USBD_HID_REPORT_T   report[USBD_HID_QUEUE_SIZE];
+    USBD_HID_QUEUE_STAT_T stat;
+} USBD_HID_QUEUE_T;
+
+/**
+ * @brief    HID keyboard key map of the last queued report
+ */
+typedef struct
+{
+    uint32_t            keyMap[USBD_HID_KEYMAP_WORDS];
+    uint8_t             keyOrder[USBD_HID_BOOT_KEYS];
+    uint8_t             keyOrderNum;
+    uint8_t             protocol;
+    uint8_t             valid;
+} USBD_HID_KEYBOARD_T;
+
+/**
+ * @brief    HID interface handler, the callbacks are called from the USB interrupt
+ */
+typedef struct
+{
+    const char*  itfName;
+    USBD_STA_T (*ItfInit)(void);
+    USBD_STA_T (*ItfDeInit)(void);
+    USBD_STA_T (*ItfSetLed)(uint8_t ledState);
+} USBD_HID_INTERFACE_T;
+
 /**
  * @brief    HID information management
  */
 typedef struct
 {
-    uint8_t             state;
+    __IO uint8_t        state;
     uint8_t             epInAddr;
+    uint8_t             epOutAddr;
     uint8_t             altSettingStatus;
     uint8_t             idleStatus;
     uint8_t             protocol;
+    uint8_t             txQueue;
+    USBD_HID_QUEUE_T    queue[USBD_HID_QUEUE_NUM];
+    USBD_HID_KEYBOARD_T keyboard;
+    uint16_t            usage[USBD_HID_QUEUE_NUM];
+    uint8_t             ledState;
+    uint8_t             ctrlReportLen;
+    uint8_t             ctrlReport[USBD_HID_REPORT_MAX_SIZE];
+    uint8_t             outReport[USBD_HID_OUT_EP_SIZE];
 } USBD_HID_INFO_T;
 
 extern USBD_CLASS_T USBD_HID_CLASS;
@@ -102,7 +285,17 @@ extern USBD_CLASS_T USBD_HID_CLASS;
   */
 
 uint8_t USBD_HID_ReadInterval(USBD_INFO_T* usbInfo);
+USBD_STA_T USBD_HID_RegisterItf(USBD_INFO_T* usbInfo, USBD_HID_INTERFACE_T* itf);
+uint8_t USBD_HID_ReadLedState(USBD_INFO_T* usbInfo);
+uint8_t* USBD_HID_AcquireReport(USBD_INFO_T* usbInfo, uint8_t reportType);
+USBD_STA_T USBD_HID_CommitReport(USBD_INFO_T* usbInfo, uint8_t reportType, uint16_t length);
 USBD_STA_T USBD_HID_TxReport(USBD_INFO_T* usbInfo, uint8_t* report, uint16_t length);
+USBD_STA_T USBD_HID_TxKeyMap(USBD_INFO_T* usbInfo, const uint32_t* keyMap, const uint8_t* keyOrder, uint8_t keyOrderNum);
+#if USBD_HID_COMPOSITE
+USBD_STA_T USBD_HID_TxConsumer(USBD_INFO_T* usbInfo, uint16_t usage);
+USBD_STA_T USBD_HID_TxSystem(USBD_INFO_T* usbInfo, uint16_t usage);
+#endif
+USBD_STA_T USBD_HID_ReadQueueStat(USBD_INFO_T* usbInfo, uint8_t reportType, USBD_HID_QUEUE_STAT_T* stat);
 
 /**@} end of group USBD_HID_Functions */
 /**@} end of group USBD_HID_Class */
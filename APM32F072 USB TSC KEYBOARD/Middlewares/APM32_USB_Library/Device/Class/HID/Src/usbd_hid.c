@@ -47,7 +47,30 @@ static USBD_STA_T USBD_HID_ClassInitHandler(USBD_INFO_T* usbInfo, uint8_t cfgInd
 static USBD_STA_T USBD_HID_ClassDeInitHandler(USBD_INFO_T* usbInfo, uint8_t cfgIndex);
 static USBD_STA_T USBD_HID_SOFHandler(USBD_INFO_T* usbInfo);
 static USBD_STA_T USBD_HID_SetupHandler(USBD_INFO_T* usbInfo, USBD_REQ_SETUP_T* req);
+static USBD_STA_T USBD_HID_RxEP0Handler(USBD_INFO_T* usbInfo);
 static USBD_STA_T USBD_HID_DataInHandler(USBD_INFO_T* usbInfo, uint8_t epNum);
+#if USBD_HID_OUT_EP_EN
+static USBD_STA_T USBD_HID_DataOutHandler(USBD_INFO_T* usbInfo, uint8_t epNum);
+#endif
+
+static USBD_STA_T USBD_HID_TxNextQueue(USBD_INFO_T* usbInfo, USBD_HID_INFO_T* usbDevHID);
+static USBD_STA_T USBD_HID_TxStart(USBD_INFO_T* usbInfo, USBD_HID_INFO_T* usbDevHID);
+#if USBD_HID_QUEUE_COALESCE
+static uint8_t USBD_HID_TestSameReport(USBD_HID_REPORT_T* report1, USBD_HID_REPORT_T* report2);
+#endif
+static USBD_STA_T USBD_HID_OutReportHandler(USBD_INFO_T* usbInfo, USBD_HID_INFO_T* usbDevHID, \
+                                            uint8_t* report, uint16_t length);
+static uint8_t USBD_HID_ReadCtrlReport(USBD_HID_INFO_T* usbDevHID, uint8_t reportType, uint8_t reportID);
+static uint16_t USBD_HID_KeyMapReport(uint8_t* report, uint8_t protocol, const uint32_t* keyMap, \
+                                      const uint8_t* keyOrder, uint8_t keyOrderNum);
+static uint16_t USBD_HID_BootKeyReport(uint8_t* report, const uint32_t* keyMap, \
+                                       const uint8_t* keyOrder, uint8_t keyOrderNum);
+#if USBD_HID_KEYBOARD_NKRO
+static uint16_t USBD_HID_NkroKeyReport(uint8_t* report, const uint32_t* keyMap);
+#endif
+#if USBD_HID_COMPOSITE
+static USBD_STA_T USBD_HID_TxUsage(USBD_INFO_T* usbInfo, uint8_t reportType, uint8_t reportID, uint16_t usage);
+#endif
 
 static USBD_DESC_INFO_T USBD_HID_ReportDescHandler(uint8_t usbSpeed);
 static USBD_DESC_INFO_T USBD_HID_DescHandler(uint8_t usbSpeed);
@@ -71,10 +94,14 @@ USBD_CLASS_T USBD_HID_CLASS =
     /* Control endpoint */
     USBD_HID_SetupHandler,
     NULL,
-    NULL,
+    USBD_HID_RxEP0Handler,
     /* Specific endpoint */
     USBD_HID_DataInHandler,
+#if USBD_HID_OUT_EP_EN
+    USBD_HID_DataOutHandler,
+#else
     NULL,
+#endif
     NULL,
     NULL,
 };
@@ -109,11 +136,75 @@ uint8_t USBD_HIDDesc[USBD_HID_DESC_SIZE] =
 /**
  * @brief   HID mouse report descriptor
  */
+#if USBD_HID_KEYBOARD_NKRO
+uint8_t USBD_HIDReportDesc[USBD_HID_MOUSE_REPORT_DESC_SIZE] =
+{
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x06,                    // USAGE (Keyboard)
+    0xa1, 0x01,                    // COLLECTION (Application)
+#if USBD_HID_COMPOSITE
+    0x85, USBD_HID_REPORT_ID_KEYBOARD, //   REPORT_ID (Keyboard)
+#endif
+    0x05, 0x07,                    //   USAGE_PAGE (Keyboard)
+    0x19, 0xe0,                    //   USAGE_MINIMUM (Keyboard LeftControl)
+    0x29, 0xe7,                    //   USAGE_MAXIMUM (Keyboard Right GUI)
+    0x15, 0x00,                    //   LOGICAL_MINIMUM (0)
+    0x25, 0x01,                    //   LOGICAL_MAXIMUM (1)
+    0x75, 0x01,                    //   REPORT_SIZE (1)
+    0x95, 0x08,                    //   REPORT_COUNT (8)
+    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
+    0x95, 0x05,                    //   REPORT_COUNT (5)
+    0x75, 0x01,                    //   REPORT_SIZE (1)
+    0x05, 0x08,                    //   USAGE_PAGE (LEDs)
+    0x19, 0x01,                    //   USAGE_MINIMUM (Num Lock)
+    0x29, 0x05,                    //   USAGE_MAXIMUM (Kana)
+    0x91, 0x02,                    //   OUTPUT (Data,Var,Abs)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0x75, 0x03,                    //   REPORT_SIZE (3)
+    0x91, 0x03,                    //   OUTPUT (Cnst,Var,Abs)
+    0x95, 0xe0,                    //   REPORT_COUNT (224)
+    0x75, 0x01,                    //   REPORT_SIZE (1)
+    0x05, 0x07,                    //   USAGE_PAGE (Keyboard)
+    0x19, 0x00,                    //   USAGE_MINIMUM (Reserved (no event indicated))
+    0x29, 0xdf,                    //   USAGE_MAXIMUM (0xDF)
+    0x81, 0x02,                    //   INPUT (Data,Var,Abs)
+    0xc0,                          // END_COLLECTION
+#if USBD_HID_COMPOSITE
+    0x05, 0x0c,                    // USAGE_PAGE (Consumer Devices)
+    0x09, 0x01,                    // USAGE (Consumer Control)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, USBD_HID_REPORT_ID_CONSUMER, //   REPORT_ID (Consumer)
+    0x19, 0x01,                    //   USAGE_MINIMUM (0x001)
+    0x2a, 0xff, 0x03,              //   USAGE_MAXIMUM (0x3FF)
+    0x15, 0x01,                    //   LOGICAL_MINIMUM (1)
+    0x26, 0xff, 0x03,              //   LOGICAL_MAXIMUM (1023)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0x75, 0x10,                    //   REPORT_SIZE (16)
+    0x81, 0x00,                    //   INPUT (Data,Ary,Abs)
+    0xc0,                          // END_COLLECTION
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x80,                    // USAGE (System Control)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, USBD_HID_REPORT_ID_SYSTEM, //   REPORT_ID (System)
+    0x19, 0x01,                    //   USAGE_MINIMUM (0x01)
+    0x2a, 0xb7, 0x00,              //   USAGE_MAXIMUM (0xB7)
+    0x15, 0x01,                    //   LOGICAL_MINIMUM (1)
+    0x26, 0xb7, 0x00,              //   LOGICAL_MAXIMUM (183)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0x75, 0x10,                    //   REPORT_SIZE (16)
+    0x81, 0x00,                    //   INPUT (Data,Ary,Abs)
+    0xc0,                          // END_COLLECTION
+#endif
+};
+#else
 uint8_t USBD_HIDReportDesc[USBD_HID_MOUSE_REPORT_DESC_SIZE] =
 {
     0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
     0x09, 0x06,                    // USAGE (Keyboard)
     0xa1, 0x01,                    // COLLECTION (Application)
+#if USBD_HID_COMPOSITE
+    0x85, USBD_HID_REPORT_ID_KEYBOARD, //   REPORT_ID (Keyboard)
+#endif
     0x05, 0x07,                    //   USAGE_PAGE (Keyboard)
     0x19, 0xe0,                    //   USAGE_MINIMUM (Keyboard LeftControl)
     0x29, 0xe7,                    //   USAGE_MAXIMUM (Keyboard Right GUI)
@@ -142,9 +233,35 @@ uint8_t USBD_HIDReportDesc[USBD_HID_MOUSE_REPORT_DESC_SIZE] =
     0x19, 0x00,                    //   USAGE_MINIMUM (Reserved (no event indicated))
     0x29, 0x65,                    //   USAGE_MAXIMUM (Keyboard Application)
     0x81, 0x00,                    //   INPUT (Data,Ary,Abs)
-    0xc0                           // END_COLLECTION
-           /* End Collection                       */
+    0xc0,                          // END_COLLECTION
+#if USBD_HID_COMPOSITE
+    0x05, 0x0c,                    // USAGE_PAGE (Consumer Devices)
+    0x09, 0x01,                    // USAGE (Consumer Control)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, USBD_HID_REPORT_ID_CONSUMER, //   REPORT_ID (Consumer)
+    0x19, 0x01,                    //   USAGE_MINIMUM (0x001)
+    0x2a, 0xff, 0x03,              //   USAGE_MAXIMUM (0x3FF)
+    0x15, 0x01,                    //   LOGICAL_MINIMUM (1)
+    0x26, 0xff, 0x03,              //   LOGICAL_MAXIMUM (1023)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0x75, 0x10,                    //   REPORT_SIZE (16)
+    0x81, 0x00,                    //   INPUT (Data,Ary,Abs)
+    0xc0,                          // END_COLLECTION
+    0x05, 0x01,                    // USAGE_PAGE (Generic Desktop)
+    0x09, 0x80,                    // USAGE (System Control)
+    0xa1, 0x01,                    // COLLECTION (Application)
+    0x85, USBD_HID_REPORT_ID_SYSTEM, //   REPORT_ID (System)
+    0x19, 0x01,                    //   USAGE_MINIMUM (0x01)
+    0x2a, 0xb7, 0x00,              //   USAGE_MAXIMUM (0xB7)
+    0x15, 0x01,                    //   LOGICAL_MINIMUM (1)
+    0x26, 0xb7, 0x00,              //   LOGICAL_MAXIMUM (183)
+    0x95, 0x01,                    //   REPORT_COUNT (1)
+    0x75, 0x10,                    //   REPORT_SIZE (16)
+    0x81, 0x00,                    //   INPUT (Data,Ary,Abs)
+    0xc0,                          // END_COLLECTION
+#endif
 };
+#endif
 
 /**@} end of group USBD_HID_Variables*/
 
@@ -195,7 +312,35 @@ static USBD_STA_T USBD_HID_ClassInitHandler(USBD_INFO_T* usbInfo, uint8_t cfgInd
     USBD_EP_OpenCallback(usbInfo, usbDevHID->epInAddr, EP_TYPE_INTERRUPT, USBD_HID_IN_EP_SIZE);
     usbInfo->devEpIn[usbDevHID->epInAddr & 0x0F].useStatus = ENABLE;
 
+#if USBD_HID_OUT_EP_EN
+    usbDevHID->epOutAddr = USBD_HID_OUT_EP_ADDR;
+
+    if (usbInfo->devSpeed == USBD_SPEED_FS)
+    {
+        usbInfo->devEpOut[usbDevHID->epOutAddr & 0x0F].interval = USBD_HID_FS_INTERVAL;
+    }
+    else
+    {
+        usbInfo->devEpOut[usbDevHID->epOutAddr & 0x0F].interval = USBD_HID_HS_INTERVAL;
+    }
+
+    USBD_EP_OpenCallback(usbInfo, usbDevHID->epOutAddr, EP_TYPE_INTERRUPT, USBD_HID_OUT_EP_SIZE);
+    usbInfo->devEpOut[usbDevHID->epOutAddr & 0x0F].useStatus = ENABLE;
+#endif
+
     usbDevHID->state = USBD_HID_IDLE;
+    usbDevHID->protocol = USBD_HID_PROTOCOL_REPORT;
+
+    if ((usbInfo->devClassUserData[usbInfo->classID] != NULL) && \
+        (((USBD_HID_INTERFACE_T *)usbInfo->devClassUserData[usbInfo->classID])->ItfInit != NULL))
+    {
+        ((USBD_HID_INTERFACE_T *)usbInfo->devClassUserData[usbInfo->classID])->ItfInit();
+    }
+
+#if USBD_HID_OUT_EP_EN
+    /* Ready for the first output report */
+    USBD_EP_ReceiveCallback(usbInfo, usbDevHID->epOutAddr, usbDevHID->outReport, USBD_HID_OUT_EP_SIZE);
+#endif
 
     return usbStatus;
 }
@@ -214,13 +359,31 @@ static USBD_STA_T USBD_HID_ClassDeInitHandler(USBD_INFO_T* usbInfo, uint8_t cfgI
     USBD_STA_T usbStatus = USBD_OK;
     USBD_HID_INFO_T* usbDevHID = (USBD_HID_INFO_T*)usbInfo->devClass[usbInfo->classID]->classData;
 
+    /* Not configured */
+    if (usbDevHID == NULL)
+    {
+        return usbStatus;
+    }
+
     /* Close HID EP */
     USBD_EP_CloseCallback(usbInfo, usbDevHID->epInAddr);
     usbInfo->devEpIn[usbDevHID->epInAddr & 0x0F].interval = 0;
     usbInfo->devEpIn[usbDevHID->epInAddr & 0x0F].useStatus = DISABLE;
 
+#if USBD_HID_OUT_EP_EN
+    USBD_EP_CloseCallback(usbInfo, usbDevHID->epOutAddr);
+    usbInfo->devEpOut[usbDevHID->epOutAddr & 0x0F].interval = 0;
+    usbInfo->devEpOut[usbDevHID->epOutAddr & 0x0F].useStatus = DISABLE;
+#endif
+
     if (usbInfo->devClass[usbInfo->classID]->classData != NULL)
     {
+        if ((usbInfo->devClassUserData[usbInfo->classID] != NULL) && \
+            (((USBD_HID_INTERFACE_T *)usbInfo->devClassUserData[usbInfo->classID])->ItfDeInit != NULL))
+        {
+            ((USBD_HID_INTERFACE_T *)usbInfo->devClassUserData[usbInfo->classID])->ItfDeInit();
+        }
+
         free(usbInfo->devClass[usbInfo->classID]->classData);
         usbInfo->devClass[usbInfo->classID]->classData = 0;
     }
@@ -237,7 +400,16 @@ static USBD_STA_T USBD_HID_ClassDeInitHandler(USBD_INFO_T* usbInfo, uint8_t cfgI
  */
 static USBD_STA_T USBD_HID_SOFHandler(USBD_INFO_T* usbInfo)
 {
-    USBD_STA_T  usbStatus = USBD_BUSY;
+    USBD_STA_T  usbStatus = USBD_OK;
+    USBD_HID_INFO_T* usbDevHID = (USBD_HID_INFO_T*)usbInfo->devClass[usbInfo->classID]->classData;
+
+    if (usbDevHID == NULL)
+    {
+        return USBD_FAIL;
+    }
+
+    /* A report left queued by a failed start is sent at the next frame */
+    USBD_HID_TxStart(usbInfo, usbDevHID);
 
     return usbStatus;
 }
@@ -262,6 +434,7 @@ static USBD_STA_T USBD_HID_SetupHandler(USBD_INFO_T* usbInfo, USBD_REQ_SETUP_T*
     uint16_t wValue = req->DATA_FIELD.wValue[0] | req->DATA_FIELD.wValue[1] << 8;
     uint16_t wLength = req->DATA_FIELD.wLength[0] | req->DATA_FIELD.wLength[1] << 8;
     uint16_t status = 0x0000;
+    uint8_t length;
 
     if (usbDevHID == NULL)
     {
@@ -371,6 +544,34 @@ static USBD_STA_T USBD_HID_SetupHandler(USBD_INFO_T* usbInfo, USBD_REQ_SETUP_T*
                     USBD_CtrlSendData(usbInfo, (uint8_t*)&usbDevHID->protocol, 1);
                     break;
 
+                case USBD_CLASS_SET_REPORT:
+                    /* Output report in the data stage, see USBD_HID_RxEP0Handler */
+                    if ((req->DATA_FIELD.wValue[1] != USBD_HID_REQ_REPORT_OUTPUT) || (wLength == 0) || \
+                        (wLength > sizeof(usbDevHID->ctrlReport)))
+                    {
+                        USBD_REQ_CtrlError(usbInfo, req);
+                        usbStatus = USBD_FAIL;
+                    }
+                    else
+                    {
+                        usbDevHID->ctrlReportLen = wLength;
+                        USBD_CtrlReceiveData(usbInfo, usbDevHID->ctrlReport, wLength);
+                    }
+                    break;
+
+                case USBD_CLASS_GET_REPORT:
+                    length = USBD_HID_ReadCtrlReport(usbDevHID, req->DATA_FIELD.wValue[1], req->DATA_FIELD.wValue[0]);
+                    if (length == 0)
+                    {
+                        USBD_REQ_CtrlError(usbInfo, req);
+                        usbStatus = USBD_FAIL;
+                    }
+                    else
+                    {
+                        USBD_CtrlSendData(usbInfo, usbDevHID->ctrlReport, length < wLength ? length : wLength);
+                    }
+                    break;
+
                 default:
                     USBD_REQ_CtrlError(usbInfo, req);
                     usbStatus = USBD_FAIL;
@@ -392,6 +593,207 @@ static USBD_STA_T USBD_HID_SetupHandler(USBD_INFO_T* usbInfo, USBD_REQ_SETUP_T*
     return usbStatus;
 }
 
+/*!
+ * @brief       USB device HID EP0 receive handler
+ *
+ * @param       usbInfo: usb device information
+ *
+ * @retval      USB device operation status
+ */
+static USBD_STA_T USBD_HID_RxEP0Handler(USBD_INFO_T* usbInfo)
+{
+    USBD_STA_T  usbStatus = USBD_OK;
+    USBD_HID_INFO_T* usbDevHID = (USBD_HID_INFO_T*)usbInfo->devClass[usbInfo->classID]->classData;
+
+    if (usbDevHID == NULL)
+    {
+        return USBD_FAIL;
+    }
+
+    /* Data stage of SET_REPORT */
+    if (usbDevHID->ctrlReportLen != 0)
+    {
+        usbStatus = USBD_HID_OutReportHandler(usbInfo, usbDevHID, usbDevHID->ctrlReport, usbDevHID->ctrlReportLen);
+        usbDevHID->ctrlReportLen = 0;
+    }
+
+    return usbStatus;
+}
+
+#if USBD_HID_OUT_EP_EN
+/*!
+ * @brief       USB device HID OUT data handler
+ *
+ * @param       usbInfo: usb device information
+ *
+ * @param       epNum: endpoint number
+ *
+ * @retval      USB device operation status
+ */
+static USBD_STA_T USBD_HID_DataOutHandler(USBD_INFO_T* usbInfo, uint8_t epNum)
+{
+    USBD_STA_T  usbStatus = USBD_OK;
+    USBD_HID_INFO_T* usbDevHID = (USBD_HID_INFO_T*)usbInfo->devClass[usbInfo->classID]->classData;
+    uint32_t length;
+
+    if (usbDevHID == NULL)
+    {
+        return USBD_FAIL;
+    }
+
+    length = USBD_EP_ReadRxDataLenCallback(usbInfo, epNum);
+    USBD_HID_OutReportHandler(usbInfo, usbDevHID, usbDevHID->outReport, (uint16_t)length);
+
+    /* Ready for the next output report */
+    USBD_EP_ReceiveCallback(usbInfo, usbDevHID->epOutAddr, usbDevHID->outReport, USBD_HID_OUT_EP_SIZE);
+
+    return usbStatus;
+}
+#endif
+
+/*!
+ * @brief       USB device HID output report handler
+ *
+ * @param       usbInfo: usb device information
+ *
+ * @param       usbDevHID: HID information
+ *
+ * @param       report: output report
+ *
+ * @param       length: report length
+ *
+ * @retval      USB device operation status
+ *
+ * @note        The interface is only called when the LED state changes.
+ */
+static USBD_STA_T USBD_HID_OutReportHandler(USBD_INFO_T* usbInfo, USBD_HID_INFO_T* usbDevHID, \
+                                            uint8_t* report, uint16_t length)
+{
+    USBD_HID_INTERFACE_T* itf = (USBD_HID_INTERFACE_T *)usbInfo->devClassUserData[usbInfo->classID];
+    uint8_t ledState;
+
+#if USBD_HID_COMPOSITE
+    /* Report ID of the keyboard in report protocol */
+    if (usbDevHID->protocol != USBD_HID_PROTOCOL_BOOT)
+    {
+        if ((length < 2) || (report[0] != USBD_HID_REPORT_ID_KEYBOARD))
+        {
+            return USBD_FAIL;
+        }
+        report++;
+        length--;
+    }
+#endif
+
+    if (length == 0)
+    {
+        return USBD_FAIL;
+    }
+
+    ledState = report[0] & USBD_HID_LED_MASK;
+    if (ledState != usbDevHID->ledState)
+    {
+        usbDevHID->ledState = ledState;
+
+        if ((itf != NULL) && (itf->ItfSetLed != NULL))
+        {
+            itf->ItfSetLed(ledState);
+        }
+    }
+
+    return USBD_OK;
+}
+
+/*!
+ * @brief       USB device HID write the report of GET_REPORT
+ *
+ * @param       usbDevHID: HID information
+ *
+ * @param       reportType: input or output report
+ *
+ * @param       reportID: report ID, 0 without report ID
+ *
+ * @retval      Report length in ctrlReport, 0 if the report does not exist
+ *
+ * @note        An input report is the last queued one, an output report is the LED state.
+ */
+static uint8_t USBD_HID_ReadCtrlReport(USBD_HID_INFO_T* usbDevHID, uint8_t reportType, uint8_t reportID)
+{
+    uint8_t* report = usbDevHID->ctrlReport;
+    uint8_t length = 0;
+
+#if USBD_HID_COMPOSITE
+    uint8_t queueIndex;
+
+    if (usbDevHID->protocol != USBD_HID_PROTOCOL_BOOT)
+    {
+        switch (reportID)
+        {
+            case USBD_HID_REPORT_ID_KEYBOARD:
+                queueIndex = USBD_HID_REPORT_KEYBOARD;
+                break;
+
+            case USBD_HID_REPORT_ID_CONSUMER:
+                queueIndex = USBD_HID_REPORT_CONSUMER;
+                break;
+
+            case USBD_HID_REPORT_ID_SYSTEM:
+                queueIndex = USBD_HID_REPORT_SYSTEM;
+                break;
+
+            default:
+                return 0;
+        }
+
+        if (queueIndex != USBD_HID_REPORT_KEYBOARD)
+        {
+            if (reportType != USBD_HID_REQ_REPORT_INPUT)
+            {
+                return 0;
+            }
+
+            report[0] = reportID;
+            report[1] = (uint8_t)usbDevHID->usage[queueIndex];
+            report[2] = (uint8_t)(usbDevHID->usage[queueIndex] >> 8);
+
+            return USBD_HID_USAGE_REPORT_SIZE;
+        }
+
+        if (reportType == USBD_HID_REQ_REPORT_OUTPUT)
+        {
+            report[length++] = reportID;
+        }
+    }
+    else if (reportID != 0)
+    {
+        return 0;
+    }
+#else
+    if (reportID != 0)
+    {
+        return 0;
+    }
+#endif
+
+    switch (reportType)
+    {
+        case USBD_HID_REQ_REPORT_INPUT:
+            length = USBD_HID_KeyMapReport(report, usbDevHID->protocol, usbDevHID->keyboard.keyMap, \
+                                           usbDevHID->keyboard.keyOrder, usbDevHID->keyboard.keyOrderNum);
+            break;
+
+        case USBD_HID_REQ_REPORT_OUTPUT:
+            report[length++] = usbDevHID->ledState;
+            break;
+
+        default:
+            length = 0;
+            break;
+    }
+
+    return length;
+}
+
 /*!
  * @brief       USB device HID IN data handler
  *
@@ -410,8 +812,100 @@ static USBD_STA_T USBD_HID_DataInHandler(USBD_INFO_T* usbInfo, uint8_t epNum)
     {
         return USBD_FAIL;
     }
-    
-    usbDevHID->state = USBD_HID_IDLE;
+
+    /* Free the report read by the host and send the next one */
+    usbDevHID->queue[usbDevHID->txQueue].read++;
+
+    if (USBD_HID_TxNextQueue(usbInfo, usbDevHID) != USBD_OK)
+    {
+        usbDevHID->state = USBD_HID_IDLE;
+    }
+
+    return usbStatus;
+}
+
+#if USBD_HID_QUEUE_COALESCE
+/*!
+ * @brief       USB device HID compare two reports
+ *
+ * @param       report1: first report
+ *
+ * @param       report2: second report
+ *
+ * @retval      1 if the reports are identical, else 0
+ */
+static uint8_t USBD_HID_TestSameReport(USBD_HID_REPORT_T* report1, USBD_HID_REPORT_T* report2)
+{
+    return (report1->length == report2->length) && (memcmp(report1->data, report2->data, report1->length) == 0);
+}
+#endif
+
+/*!
+ * @brief       USB device HID send the oldest report of the next queue not empty
+ *
+ * @param       usbInfo: usb device information
+ *
+ * @param       usbDevHID: HID information
+ *
+ * @retval      USBD_OK if a report is sent, USBD_BUSY if all queues are empty
+ *
+ * @note        The queues are served in turn, starting after the last one sent.
+ */
+static USBD_STA_T USBD_HID_TxNextQueue(USBD_INFO_T* usbInfo, USBD_HID_INFO_T* usbDevHID)
+{
+    USBD_HID_QUEUE_T* queue;
+    USBD_HID_REPORT_T* report;
+    uint8_t index = usbDevHID->txQueue;
+    uint8_t i;
+
+    for (i = 0; i < USBD_HID_QUEUE_NUM; i++)
+    {
+        index = (index + 1) % USBD_HID_QUEUE_NUM;
+        queue = &usbDevHID->queue[index];
+
+        if (queue->read != queue->write)
+        {
+            usbDevHID->txQueue = index;
+            report = &queue->report[USBD_HID_QUEUE_INDEX(queue->read)];
+
+            return USBD_EP_TransferCallback(usbInfo, usbDevHID->epInAddr, report->data, report->length);
+        }
+    }
+
+    return USBD_BUSY;
+}
+
+/*!
+ * @brief       USB device HID start the endpoint if it is idle and a report is queued
+ *
+ * @param       usbInfo: usb device information
+ *
+ * @param       usbDevHID: HID information
+ *
+ * @retval      USBD_OK if a report is sent
+ *
+ * @note        Called from the commit and from the SOF interrupt, the state is
+ *              tested and set with the interrupts masked. The endpoint stays
+ *              idle if the transfer is refused, the next SOF tries again.
+ */
+static USBD_STA_T USBD_HID_TxStart(USBD_INFO_T* usbInfo, USBD_HID_INFO_T* usbDevHID)
+{
+    USBD_STA_T usbStatus = USBD_BUSY;
+    uint32_t primask;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (usbDevHID->state == USBD_HID_IDLE)
+    {
+        usbStatus = USBD_HID_TxNextQueue(usbInfo, usbDevHID);
+        if (usbStatus == USBD_OK)
+        {
+            usbDevHID->state = USBD_HID_BUSY;
+        }
+    }
+
+    __set_PRIMASK(primask);
 
     return usbStatus;
 }
@@ -451,7 +945,103 @@ static USBD_DESC_INFO_T USBD_HID_DescHandler(uint8_t usbSpeed)
 }
 
 /*!
- * @brief     USB device HID send report descriptor
+ * @brief     USB device HID acquire the next report slot
+ *
+ * @param     usbInfo: usb device information
+ *
+ * @param     reportType: queue of the report (USBD_HID_REPORT_TYPE_T)
+ *
+ * @retval    Report buffer of USBD_HID_REPORT_MAX_SIZE bytes to fill in place,
+ *            NULL if the device is not configured or the queue is full
+ *
+ * @note      The slot is owned by the class, it is sent from there after
+ *            USBD_HID_CommitReport(). Acquiring again before the commit
+ *            returns the same slot. Must be called from a single context.
+ */
+uint8_t* USBD_HID_AcquireReport(USBD_INFO_T* usbInfo, uint8_t reportType)
+{
+    USBD_HID_INFO_T* usbDevHID = (USBD_HID_INFO_T*)USBD_HID_CLASS.classData;
+    USBD_HID_QUEUE_T* queue;
+
+    if ((usbDevHID == NULL) || (usbInfo->devState != USBD_DEV_CONFIGURE) || (reportType >= USBD_HID_QUEUE_NUM))
+    {
+        return NULL;
+    }
+
+    queue = &usbDevHID->queue[reportType];
+
+    if ((uint8_t)(queue->write - queue->read) >= USBD_HID_QUEUE_SIZE)
+    {
+        /* The host does not read the reports fast enough */
+        queue->stat.overflow++;
+        return NULL;
+    }
+
+    queue->acquired = 1;
+
+    return queue->report[USBD_HID_QUEUE_INDEX(queue->write)].data;
+}
+
+/*!
+ * @brief     USB device HID commit the report acquired by USBD_HID_AcquireReport()
+ *
+ * @param     usbInfo: usb device information
+ *
+ * @param     reportType: queue of the report (USBD_HID_REPORT_TYPE_T)
+ *
+ * @param     length: report data length
+ *
+ * @retval    USBD_OK if the report is queued (or identical to the previous one),
+ *            USBD_FAIL if no slot is acquired or the report is too long
+ *
+ * @note      The report is written into the endpoint buffer here when the
+ *            endpoint is idle, else by the IN endpoint interrupt. If the
+ *            transfer is refused, the SOF interrupt starts it again.
+ */
+USBD_STA_T USBD_HID_CommitReport(USBD_INFO_T* usbInfo, uint8_t reportType, uint16_t length)
+{
+    USBD_HID_INFO_T* usbDevHID = (USBD_HID_INFO_T*)USBD_HID_CLASS.classData;
+    USBD_HID_QUEUE_T* queue;
+    USBD_HID_REPORT_T* slot;
+    uint8_t used;
+
+    if ((usbDevHID == NULL) || (reportType >= USBD_HID_QUEUE_NUM) || \
+        (usbDevHID->queue[reportType].acquired == 0) || (length > USBD_HID_REPORT_MAX_SIZE))
+    {
+        return USBD_FAIL;
+    }
+
+    queue = &usbDevHID->queue[reportType];
+    queue->acquired = 0;
+
+    slot = &queue->report[USBD_HID_QUEUE_INDEX(queue->write)];
+    slot->length = (uint8_t)length;
+
+#if USBD_HID_QUEUE_COALESCE
+    /* The host has already the same state */
+    if ((queue->lastValid) && (USBD_HID_TestSameReport(slot, &queue->report[USBD_HID_QUEUE_INDEX(queue->write - 1)])))
+    {
+        queue->stat.coalesced++;
+        return USBD_OK;
+    }
+#endif
+    queue->lastValid = 1;
+
+    used = (uint8_t)(queue->write - queue->read) + 1;
+    if (used > queue->stat.maxUsed)
+    {
+        queue->stat.maxUsed = used;
+    }
+
+    /* Publish the report, then start the endpoint if it is not sending */
+    queue->write++;
+    USBD_HID_TxStart(usbInfo, usbDevHID);
+
+    return USBD_OK;
+}
+
+/*!
+ * @brief     USB device HID send report
  *
  * @param     usbInfo: usb device information
  *
@@ -459,35 +1049,441 @@ static USBD_DESC_INFO_T USBD_HID_DescHandler(uint8_t usbSpeed)
  *
  * @param     length: report data length
  *
- * @retval    usb descriptor information
+ * @retval    USBD_OK if the report is queued (or identical to the previous one),
+ *            USBD_BUSY if the queue is full, USBD_FAIL if the device is not
+ *            configured or the report is too long
+ *
+ * @note      The report is copied, the buffer can be reused on return.
+ *            USBD_HID_AcquireReport() and USBD_HID_CommitReport() avoid the copy.
+ *            The report goes to the keyboard queue.
  */
 USBD_STA_T USBD_HID_TxReport(USBD_INFO_T* usbInfo, uint8_t* report, uint16_t length)
 {
-    USBD_STA_T  usbStatus = USBD_OK;
-    USBD_HID_INFO_T* usbDevHID = (USBD_HID_INFO_T*)usbInfo->devClass[usbInfo->classID]->classData;
+    uint8_t* slot;
 
-    if (usbDevHID == NULL)
+    if ((USBD_HID_CLASS.classData == NULL) || (usbInfo->devState != USBD_DEV_CONFIGURE) || \
+        (length > USBD_HID_REPORT_MAX_SIZE))
     {
         return USBD_FAIL;
     }
 
-    switch (usbInfo->devState)
+    slot = USBD_HID_AcquireReport(usbInfo, USBD_HID_REPORT_KEYBOARD);
+    if (slot == NULL)
     {
-        case USBD_DEV_CONFIGURE:
-            if (usbDevHID->state == USBD_HID_IDLE)
+        return USBD_BUSY;
+    }
+
+    memcpy(slot, report, length);
+
+    return USBD_HID_CommitReport(usbInfo, USBD_HID_REPORT_KEYBOARD, length);
+}
+
+/*!
+ * @brief     USB device HID write the keyboard report of a key map
+ *
+ * @param     report: report buffer of USBD_HID_REPORT_MAX_SIZE bytes
+ *
+ * @param     protocol: boot or report protocol
+ *
+ * @param     keyMap: pressed usages, USBD_HID_KEYMAP_WORDS words
+ *
+ * @param     keyOrder: first pressed usages of the boot report, oldest press first
+ *
+ * @param     keyOrderNum: number of usages in keyOrder
+ *
+ * @retval    report length
+ */
+static uint16_t USBD_HID_KeyMapReport(uint8_t* report, uint8_t protocol, const uint32_t* keyMap, \
+                                      const uint8_t* keyOrder, uint8_t keyOrderNum)
+{
+    uint16_t length = 0;
+
+#if USBD_HID_COMPOSITE
+    /* No report ID in boot protocol */
+    if (protocol != USBD_HID_PROTOCOL_BOOT)
+    {
+        report[length++] = USBD_HID_REPORT_ID_KEYBOARD;
+    }
+#endif
+
+#if USBD_HID_KEYBOARD_NKRO
+    if (protocol != USBD_HID_PROTOCOL_BOOT)
+    {
+        length += USBD_HID_NkroKeyReport(&report[length], keyMap);
+    }
+    else
+#endif
+    {
+        length += USBD_HID_BootKeyReport(&report[length], keyMap, keyOrder, keyOrderNum);
+    }
+
+    return length;
+}
+
+/*!
+ * @brief     USB device HID write the boot keyboard report of a key map
+ *
+ * @param     report: report buffer of USBD_HID_BOOT_REPORT_SIZE bytes
+ *
+ * @param     keyMap: pressed usages, USBD_HID_KEYMAP_WORDS words
+ *
+ * @param     keyOrder: first pressed usages, oldest press first
+ *
+ * @param     keyOrderNum: number of usages in keyOrder
+ *
+ * @retval    report length
+ *
+ * @note      The keys of keyOrder found in the key map are sent first in
+ *            press order, the other keys follow in usage order. With more
+ *            than USBD_HID_BOOT_KEYS keys, all key bytes are ErrorRollOver.
+ */
+static uint16_t USBD_HID_BootKeyReport(uint8_t* report, const uint32_t* keyMap, \
+                                       const uint8_t* keyOrder, uint8_t keyOrderNum)
+{
+    uint32_t bits;
+    uint32_t listed[USBD_HID_KEY_MODIFIER_FIRST >> 5] = {0};
+    uint8_t num = 0;
+    uint8_t i;
+    uint8_t usage;
+
+    memset(report, 0, USBD_HID_BOOT_REPORT_SIZE);
+    report[0] = (uint8_t)(keyMap[USBD_HID_KEY_MODIFIER_FIRST >> 5] >> (USBD_HID_KEY_MODIFIER_FIRST & 0x1F));
+
+    for (i = 0; (i < keyOrderNum) && (num < USBD_HID_BOOT_KEYS); i++)
+    {
+        usage = keyOrder[i];
+        if ((usage < USBD_HID_KEY_FIRST) || (usage >= USBD_HID_KEY_MODIFIER_FIRST) || \
+            (USBD_HID_KEYMAP_TEST(keyMap, usage) == 0) || (USBD_HID_KEYMAP_TEST(listed, usage) != 0))
+        {
+            continue;
+        }
+
+        USBD_HID_KEYMAP_SET(listed, usage);
+        report[USBD_HID_BOOT_KEY_OFFSET + num++] = usage;
+    }
+
+    for (i = 0; i < (USBD_HID_KEY_MODIFIER_FIRST >> 5); i++)
+    {
+        bits = keyMap[i] & ~listed[i];
+        if (i == 0)
+        {
+            /* No event and error codes */
+            bits &= ~(((uint32_t)1 << USBD_HID_KEY_FIRST) - 1);
+        }
+
+        for (usage = i << 5; bits != 0; usage++, bits >>= 1)
+        {
+            if ((bits & 1) == 0)
             {
-                usbDevHID->state = USBD_HID_BUSY;
-                USBD_EP_TransferCallback(usbInfo, usbDevHID->epInAddr, report, length);
+                continue;
             }
-            break;
 
-        default:
-            break;
+            if (num == USBD_HID_BOOT_KEYS)
+            {
+                memset(&report[USBD_HID_BOOT_KEY_OFFSET], USBD_HID_KEY_ERROR_ROLLOVER, USBD_HID_BOOT_KEYS);
+                return USBD_HID_BOOT_REPORT_SIZE;
+            }
+            report[USBD_HID_BOOT_KEY_OFFSET + num++] = usage;
+        }
+    }
+
+    return USBD_HID_BOOT_REPORT_SIZE;
+}
+
+#if USBD_HID_KEYBOARD_NKRO
+/*!
+ * @brief     USB device HID write the NKRO keyboard report of a key map
+ *
+ * @param     report: report buffer of USBD_HID_NKRO_REPORT_SIZE bytes
+ *
+ * @param     keyMap: pressed usages, USBD_HID_KEYMAP_WORDS words
+ *
+ * @retval    report length
+ */
+static uint16_t USBD_HID_NkroKeyReport(uint8_t* report, const uint32_t* keyMap)
+{
+    uint8_t i;
+
+    report[0] = (uint8_t)(keyMap[USBD_HID_KEY_MODIFIER_FIRST >> 5] >> (USBD_HID_KEY_MODIFIER_FIRST & 0x1F));
+
+    for (i = 0; i < (USBD_HID_NKRO_REPORT_SIZE - USBD_HID_NKRO_KEY_OFFSET); i++)
+    {
+        report[USBD_HID_NKRO_KEY_OFFSET + i] = (uint8_t)(keyMap[i >> 2] >> ((i & 3) << 3));
+    }
+
+    /* No event and error codes */
+    report[USBD_HID_NKRO_KEY_OFFSET] &= (uint8_t)~((1 << USBD_HID_KEY_FIRST) - 1);
+
+    return USBD_HID_NKRO_REPORT_SIZE;
+}
+#endif
+
+/*!
+ * @brief     USB device HID send the keyboard report of a key map
+ *
+ * @param     usbInfo: usb device information
+ *
+ * @param     keyMap: pressed usages, USBD_HID_KEYMAP_WORDS words,
+ *            use USBD_HID_KEYMAP_SET() to add a usage
+ *
+ * @param     keyOrder: pressed usages of the key map, oldest press first,
+ *            NULL to send the boot report in usage order
+ *
+ * @param     keyOrderNum: number of usages in keyOrder
+ *
+ * @retval    USBD_OK if the report is queued or the keys have not changed,
+ *            USBD_BUSY if the queue is full, USBD_FAIL if the device is not
+ *            configured
+ *
+ * @note      The key map is compared word by word with the one of the last
+ *            queued report, a report is only queued when it has changed.
+ *            The report is the NKRO bitmap in report protocol and the 6KRO
+ *            boot report in boot protocol (SET_PROTOCOL(0)). Only the boot
+ *            report uses keyOrder, so the host sees its six keys in press order.
+ *            With USBD_HID_COMPOSITE, the report ID is added in report protocol.
+ */
+USBD_STA_T USBD_HID_TxKeyMap(USBD_INFO_T* usbInfo, const uint32_t* keyMap, const uint8_t* keyOrder, uint8_t keyOrderNum)
+{
+    USBD_HID_INFO_T* usbDevHID = (USBD_HID_INFO_T*)USBD_HID_CLASS.classData;
+    USBD_HID_KEYBOARD_T* keyboard;
+    USBD_STA_T usbStatus;
+    uint8_t* report;
+    uint16_t length;
+    uint8_t protocol;
+    uint8_t i;
+
+    if ((usbDevHID == NULL) || (usbInfo->devState != USBD_DEV_CONFIGURE))
+    {
+        return USBD_FAIL;
+    }
+
+    keyboard = &usbDevHID->keyboard;
+    protocol = usbDevHID->protocol;
+
+    if ((keyboard->valid) && (keyboard->protocol == protocol))
+    {
+        for (i = 0; i < USBD_HID_KEYMAP_WORDS; i++)
+        {
+            if (keyboard->keyMap[i] != keyMap[i])
+            {
+                break;
+            }
+        }
+
+        if (i == USBD_HID_KEYMAP_WORDS)
+        {
+            return USBD_OK;
+        }
+    }
+
+    report = USBD_HID_AcquireReport(usbInfo, USBD_HID_REPORT_KEYBOARD);
+    if (report == NULL)
+    {
+        return USBD_BUSY;
+    }
+
+    if (keyOrder == NULL)
+    {
+        keyOrderNum = 0;
+    }
+
+    length = USBD_HID_KeyMapReport(report, protocol, keyMap, keyOrder, keyOrderNum);
+
+    usbStatus = USBD_HID_CommitReport(usbInfo, USBD_HID_REPORT_KEYBOARD, length);
+    if (usbStatus == USBD_OK)
+    {
+        /* More keys than the boot report are sent as ErrorRollOver */
+        if (keyOrderNum > USBD_HID_BOOT_KEYS)
+        {
+            keyOrderNum = USBD_HID_BOOT_KEYS;
+        }
+
+        memcpy(keyboard->keyMap, keyMap, sizeof(keyboard->keyMap));
+        if (keyOrderNum > 0)
+        {
+            memcpy(keyboard->keyOrder, keyOrder, keyOrderNum);
+        }
+        keyboard->keyOrderNum = keyOrderNum;
+        keyboard->protocol = protocol;
+        keyboard->valid = 1;
+    }
+
+    return usbStatus;
+}
+
+#if USBD_HID_COMPOSITE
+/*!
+ * @brief     USB device HID send a usage report
+ *
+ * @param     usbInfo: usb device information
+ *
+ * @param     reportType: queue of the report (USBD_HID_REPORT_TYPE_T)
+ *
+ * @param     reportID: report ID
+ *
+ * @param     usage: pressed usage, 0 = released
+ *
+ * @retval    USBD_OK if the report is queued or the usage has not changed,
+ *            USBD_BUSY if the queue is full, USBD_FAIL if the device is not
+ *            configured or in boot protocol
+ */
+static USBD_STA_T USBD_HID_TxUsage(USBD_INFO_T* usbInfo, uint8_t reportType, uint8_t reportID, uint16_t usage)
+{
+    USBD_HID_INFO_T* usbDevHID = (USBD_HID_INFO_T*)USBD_HID_CLASS.classData;
+    USBD_STA_T usbStatus;
+    uint8_t* report;
+
+    if ((usbDevHID == NULL) || (usbInfo->devState != USBD_DEV_CONFIGURE) || \
+        (usbDevHID->protocol == USBD_HID_PROTOCOL_BOOT))
+    {
+        return USBD_FAIL;
+    }
+
+    if (usbDevHID->usage[reportType] == usage)
+    {
+        return USBD_OK;
+    }
+
+    report = USBD_HID_AcquireReport(usbInfo, reportType);
+    if (report == NULL)
+    {
+        return USBD_BUSY;
+    }
+
+    report[0] = reportID;
+    report[1] = (uint8_t)usage;
+    report[2] = (uint8_t)(usage >> 8);
+
+    usbStatus = USBD_HID_CommitReport(usbInfo, reportType, USBD_HID_USAGE_REPORT_SIZE);
+    if (usbStatus == USBD_OK)
+    {
+        usbDevHID->usage[reportType] = usage;
     }
 
     return usbStatus;
 }
 
+/*!
+ * @brief     USB device HID send the consumer control report
+ *
+ * @param     usbInfo: usb device information
+ *
+ * @param     usage: pressed usage of the Consumer page (up to
+ *            USBD_HID_CONSUMER_USAGE_MAX), 0 = released
+ *
+ * @retval    USBD_OK if the report is queued or the usage has not changed,
+ *            USBD_BUSY if the queue is full, USBD_FAIL if the device is not
+ *            configured, in boot protocol or the usage is not valid
+ *
+ * @note      A step (volume, track) is the usage followed by 0.
+ */
+USBD_STA_T USBD_HID_TxConsumer(USBD_INFO_T* usbInfo, uint16_t usage)
+{
+    if (usage > USBD_HID_CONSUMER_USAGE_MAX)
+    {
+        return USBD_FAIL;
+    }
+
+    return USBD_HID_TxUsage(usbInfo, USBD_HID_REPORT_CONSUMER, USBD_HID_REPORT_ID_CONSUMER, usage);
+}
+
+/*!
+ * @brief     USB device HID send the system control report
+ *
+ * @param     usbInfo: usb device information
+ *
+ * @param     usage: pressed usage of the Generic Desktop page (System Control,
+ *            up to USBD_HID_SYSTEM_USAGE_MAX), 0 = released
+ *
+ * @retval    USBD_OK if the report is queued or the usage has not changed,
+ *            USBD_BUSY if the queue is full, USBD_FAIL if the device is not
+ *            configured, in boot protocol or the usage is not valid
+ */
+USBD_STA_T USBD_HID_TxSystem(USBD_INFO_T* usbInfo, uint16_t usage)
+{
+    if (usage > USBD_HID_SYSTEM_USAGE_MAX)
+    {
+        return USBD_FAIL;
+    }
+
+    return USBD_HID_TxUsage(usbInfo, USBD_HID_REPORT_SYSTEM, USBD_HID_REPORT_ID_SYSTEM, usage);
+}
+#endif
+
+/*!
+ * @brief     USB device HID read the report queue statistics
+ *
+ * @param     usbInfo: usb device information
+ *
+ * @param     reportType: queue of the reports (USBD_HID_REPORT_TYPE_T)
+ *
+ * @param     stat: statistics since the device has been configured
+ *
+ * @retval    usb device status
+ */
+USBD_STA_T USBD_HID_ReadQueueStat(USBD_INFO_T* usbInfo, uint8_t reportType, USBD_HID_QUEUE_STAT_T* stat)
+{
+    USBD_HID_INFO_T* usbDevHID = (USBD_HID_INFO_T*)USBD_HID_CLASS.classData;
+
+    if ((usbDevHID == NULL) || (reportType >= USBD_HID_QUEUE_NUM))
+    {
+        return USBD_FAIL;
+    }
+
+    *stat = usbDevHID->queue[reportType].stat;
+
+    return USBD_OK;
+}
+
+/*!
+ * @brief     USB device HID register interface handler
+ *
+ * @param     usbInfo: usb device information
+ *
+ * @param     itf: interface handler
+ *
+ * @retval    USB device operation status
+ */
+USBD_STA_T USBD_HID_RegisterItf(USBD_INFO_T* usbInfo, USBD_HID_INTERFACE_T* itf)
+{
+    USBD_STA_T usbStatus = USBD_FAIL;
+    uint8_t classIndex;
+
+    if (itf != NULL)
+    {
+        /* Index of the HID class in the registered classes */
+        for (classIndex = 0; classIndex < usbInfo->classNum; classIndex++)
+        {
+            if (usbInfo->devClass[classIndex] == &USBD_HID_CLASS)
+            {
+                usbInfo->devClassUserData[classIndex] = itf;
+                usbStatus = USBD_OK;
+            }
+        }
+    }
+
+    return usbStatus;
+}
+
+/*!
+ * @brief     USB device HID read the keyboard LED state
+ *
+ * @param     usbInfo: usb device information
+ *
+ * @retval    LED state of the last output report (USBD_HID_LED_NUM_LOCK...)
+ */
+uint8_t USBD_HID_ReadLedState(USBD_INFO_T* usbInfo)
+{
+    USBD_HID_INFO_T* usbDevHID = (USBD_HID_INFO_T*)USBD_HID_CLASS.classData;
+
+    if (usbDevHID == NULL)
+    {
+        return 0;
+    }
+
+    return usbDevHID->ledState;
+}
+
 /*!
  * @brief     USB device HID read interval
  *
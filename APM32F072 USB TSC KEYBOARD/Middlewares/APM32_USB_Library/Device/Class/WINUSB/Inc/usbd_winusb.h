@@ -50,9 +50,9 @@
 #define USBD_WINUSB_CMD_MP_SIZE                     0x08
 #define USBD_WINUSB_DATA_MP_SIZE                    0x07
 
-#define USBD_WINUSB_CMD_EP_ADDR                     0x82
-#define USBD_WINUSB_DATA_IN_EP_ADDR                 0x81
-#define USBD_WINUSB_DATA_OUT_EP_ADDR                0x01
+#define USBD_WINUSB_CMD_EP_ADDR                     0x83
+#define USBD_WINUSB_DATA_IN_EP_ADDR                 0x82
+#define USBD_WINUSB_DATA_OUT_EP_ADDR                0x02
 
 #define USBD_WINUSB_FS_INTERVAL                     16
 #define USBD_WINUSB_HS_INTERVAL                     16
@@ -309,6 +309,12 @@ static USBD_STA_T USBD_WINUSB_ClassDeInitHandler(USBD_INFO_T* usbInfo, uint8_t c
     USBD_STA_T usbStatus = USBD_OK;
     USBD_WINUSB_INFO_T* usbDevWINUSB = (USBD_WINUSB_INFO_T*)usbInfo->devClass[usbInfo->classID]->classData;
 
+    /* Not configured */
+    if (usbDevWINUSB == NULL)
+    {
+        return usbStatus;
+    }
+
     /* Close WINUSB EP */
     USBD_EP_CloseCallback(usbInfo, usbDevWINUSB->epOutAddr);
     usbInfo->devEpOut[usbDevWINUSB->epOutAddr & 0x0F].useStatus = DISABLE;
@@ -391,6 +397,7 @@ static USBD_STA_T USBD_WINUSB_SetupHandler(USBD_INFO_T* usbInfo, USBD_REQ_SETUP_
     
     USBD_DESC_INFO_T descInfo;
     
+    descInfo.desc = NULL;
     request = req->DATA_FIELD.bRequest;
     reqType = usbInfo->reqSetup.DATA_FIELD.bmRequest.REQ_TYPE_B.type;
     
@@ -482,6 +489,8 @@ static USBD_STA_T USBD_WINUSB_SetupHandler(USBD_INFO_T* usbInfo, USBD_REQ_SETUP_
                     switch(wIndex)
                     {
                         case USBD_WINUSB_DESC_FEATURE:
+                            /* bFirstInterfaceNumber of the WinUSB function */
+                            USBD_WinUsbOsFeatureDesc[16] = usbInfo->devClassItf[usbInfo->classID];
                             descInfo = USBD_WinUsbFeatureDescHandler(usbInfo->devSpeed);
 
                             descInfo.size = descInfo.size < wLength ? descInfo.size : wLength;
@@ -610,7 +619,7 @@ static USBD_STA_T USBD_WINUSB_DataOutHandler(USBD_INFO_T* usbInfo, uint8_t epNum
 USBD_STA_T USBD_WINUSB_ConfigTxBuffer(USBD_INFO_T* usbInfo, uint8_t *buffer, uint32_t length)
 {
     USBD_STA_T  usbStatus = USBD_OK;
-    USBD_WINUSB_INFO_T* usbDevWINUSB = (USBD_WINUSB_INFO_T*)usbInfo->devClass[usbInfo->classID]->classData;
+    USBD_WINUSB_INFO_T* usbDevWINUSB = (USBD_WINUSB_INFO_T*)USBD_WINUSB_CLASS.classData;
     
     if (usbDevWINUSB == NULL)
     {
@@ -635,7 +644,7 @@ USBD_STA_T USBD_WINUSB_ConfigTxBuffer(USBD_INFO_T* usbInfo, uint8_t *buffer, uin
 USBD_STA_T USBD_WINUSB_ConfigRxBuffer(USBD_INFO_T* usbInfo, uint8_t *buffer)
 {
     USBD_STA_T  usbStatus = USBD_OK;
-    USBD_WINUSB_INFO_T* usbDevWINUSB = (USBD_WINUSB_INFO_T*)usbInfo->devClass[usbInfo->classID]->classData;
+    USBD_WINUSB_INFO_T* usbDevWINUSB = (USBD_WINUSB_INFO_T*)USBD_WINUSB_CLASS.classData;
     
     if (usbDevWINUSB == NULL)
     {
@@ -659,11 +668,19 @@ USBD_STA_T USBD_WINUSB_ConfigRxBuffer(USBD_INFO_T* usbInfo, uint8_t *buffer)
 USBD_STA_T USBD_WINUSB_RegisterItf(USBD_INFO_T* usbInfo, USBD_WINUSB_INTERFACE_T* itf)
 {
     USBD_STA_T usbStatus = USBD_FAIL;
+    uint8_t classIndex;
 
     if (itf != NULL)
     {
-        usbInfo->devClassUserData[usbInfo->classID] = itf;
-        usbStatus = USBD_OK;
+        /* Index of the WINUSB class in the registered classes */
+        for (classIndex = 0; classIndex < usbInfo->classNum; classIndex++)
+        {
+            if (usbInfo->devClass[classIndex] == &USBD_WINUSB_CLASS)
+            {
+                usbInfo->devClassUserData[classIndex] = itf;
+                usbStatus = USBD_OK;
+            }
+        }
     }
 
     return usbStatus;
@@ -679,7 +696,7 @@ USBD_STA_T USBD_WINUSB_RegisterItf(USBD_INFO_T* usbInfo, USBD_WINUSB_INTERFACE_T
 USBD_STA_T USBD_WINUSB_TxPacket(USBD_INFO_T* usbInfo)
 {
     USBD_STA_T usbStatus = USBD_BUSY;
-    USBD_WINUSB_INFO_T* usbDevWINUSB = (USBD_WINUSB_INFO_T*)usbInfo->devClass[usbInfo->classID]->classData;
+    USBD_WINUSB_INFO_T* usbDevWINUSB = (USBD_WINUSB_INFO_T*)USBD_WINUSB_CLASS.classData;
     
     if (usbDevWINUSB == NULL)
     {
@@ -710,7 +727,7 @@ USBD_STA_T USBD_WINUSB_TxPacket(USBD_INFO_T* usbInfo)
 USBD_STA_T USBD_WINUSB_RxPacket(USBD_INFO_T* usbInfo)
 {
     USBD_STA_T usbStatus = USBD_BUSY;
-    USBD_WINUSB_INFO_T* usbDevWINUSB = (USBD_WINUSB_INFO_T*)usbInfo->devClass[usbInfo->classID]->classData;
+    USBD_WINUSB_INFO_T* usbDevWINUSB = (USBD_WINUSB_INFO_T*)USBD_WINUSB_CLASS.classData;
     
     if (usbDevWINUSB == NULL)
     {
@@ -248,6 +248,7 @@ typedef struct
     uint32_t mp;
     uint16_t useStatus;
     uint16_t interval;
+    uint8_t  classID;
 } USBD_EP_INFO_T;
 
 /**
@@ -363,8 +364,10 @@ typedef struct _USBD_INFO_T
     USBD_CLASS_T*           devClass[USBD_SUP_CLASS_MAX_NUM];
 
     void*                   devClassUserData[USBD_SUP_CLASS_MAX_NUM];
+    uint8_t                 devClassItf[USBD_SUP_CLASS_MAX_NUM];
     uint32_t                classID;
     uint32_t                classNum;
+    uint32_t                devReqClassID;
 
     void*                   cfgDesc;
     USBD_REQ_SETUP_T        reqSetup;
@@ -68,6 +68,10 @@ USBD_STA_T USBD_Init(USBD_INFO_T* usbInfo, USBD_SPEED_T usbDevSpeed, \
                      USBD_CLASS_T* usbDevClass, \
                      void (*userCallbackFunc)(struct _USBD_INFO_T*, uint8_t));
 USBD_STA_T USBD_DeInit(USBD_INFO_T* usbInfo);
+USBD_STA_T USBD_RegisterClass(USBD_INFO_T* usbInfo, USBD_CLASS_T* usbDevClass, uint8_t itfNum);
+USBD_STA_T USBD_ConfigDevReqClass(USBD_INFO_T* usbInfo, USBD_CLASS_T* usbDevClass);
+USBD_STA_T USBD_ClassInit(USBD_INFO_T* usbInfo, uint8_t cfgIndex);
+USBD_STA_T USBD_ClassDeInit(USBD_INFO_T* usbInfo, uint8_t cfgIndex);
 void USBD_HardwareInit(USBD_INFO_T* usbInfo);
 void USBD_HardwareReset(USBD_INFO_T* usbInfo);
 USBD_STA_T USBD_SetSpeed(USBD_INFO_T* usbInfo, USBD_DEVICE_SPEED_T speed);
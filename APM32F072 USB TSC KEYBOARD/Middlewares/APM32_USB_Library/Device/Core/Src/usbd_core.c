@@ -40,6 +40,9 @@
   @{
   */
 
+static uint8_t USBD_ReadItfClassIndex(USBD_INFO_T* usbInfo, uint8_t itfNum);
+static uint8_t USBD_ReadEpClassIndex(USBD_INFO_T* usbInfo, uint8_t epAddr);
+
 /*!
  * @brief     USB device core init
  *
@@ -76,6 +79,7 @@ USBD_STA_T USBD_Init(USBD_INFO_T* usbInfo, USBD_SPEED_T usbDevSpeed, \
     }
     else
     {
+        usbInfo->devClassItf[usbInfo->classNum] = 0;
         usbInfo->devClass[usbInfo->classNum++] = usbDevClass;
     }
 
@@ -105,10 +109,7 @@ USBD_STA_T USBD_DeInit(USBD_INFO_T* usbInfo)
     
     usbInfo->devState = USBD_DEV_DEFAULT;
     
-    if(usbInfo->devClass[0] != NULL)
-    {
-        usbInfo->devClass[0]->ClassDeInitHandler(usbInfo, usbInfo->devCfg);
-    }
+    USBD_ClassDeInit(usbInfo, usbInfo->devCfg);
     
     if(usbInfo->dataPoint != NULL)
     {
@@ -122,6 +123,197 @@ USBD_STA_T USBD_DeInit(USBD_INFO_T* usbInfo)
     return usbStatus;
 }
 
+/*!
+ * @brief     USB device register a class after the class of USBD_Init()
+ *
+ * @param     usbInfo : usb handler information
+ *
+ * @param     usbDevClass : class handler
+ *
+ * @param     itfNum : number of the first interface of the class
+ *
+ * @retval    usb device status
+ *
+ * @note      The class of USBD_Init() starts at interface 0. The requests to an
+ *            interface go to the class with the nearest lower first interface, the
+ *            requests to an endpoint go to the class which has opened it.
+ *            The class and vendor requests to the device go to the class of USBD_Init(),
+ *            use USBD_ConfigDevReqClass() to select another class whatever the order
+ *            of registration.
+ */
+USBD_STA_T USBD_RegisterClass(USBD_INFO_T* usbInfo, USBD_CLASS_T* usbDevClass, uint8_t itfNum)
+{
+    if ((usbDevClass == NULL) || (usbInfo->classNum >= USBD_SUP_CLASS_MAX_NUM))
+    {
+        return USBD_FAIL;
+    }
+
+    usbInfo->devClassItf[usbInfo->classNum] = itfNum;
+    usbInfo->devClass[usbInfo->classNum++] = usbDevClass;
+
+    return USBD_OK;
+}
+
+/*!
+ * @brief     USB device select the class of the device class and vendor requests
+ *
+ * @param     usbInfo : usb handler information
+ *
+ * @param     usbDevClass : registered class handler
+ *
+ * @retval    usb device status
+ *
+ * @note      The device requests carry no interface number, so they can not be routed
+ *            like the interface requests. Call it after USBD_RegisterClass(), e.g. for
+ *            the class which answers the MS OS vendor request of the device.
+ */
+USBD_STA_T USBD_ConfigDevReqClass(USBD_INFO_T* usbInfo, USBD_CLASS_T* usbDevClass)
+{
+    uint8_t i;
+
+    for (i = 0; i < usbInfo->classNum; i++)
+    {
+        if (usbInfo->devClass[i] == usbDevClass)
+        {
+            usbInfo->devReqClassID = i;
+            return USBD_OK;
+        }
+    }
+
+    return USBD_FAIL;
+}
+
+/*!
+ * @brief     USB device init all registered classes
+ *
+ * @param     usbInfo : usb handler information
+ *
+ * @param     cfgIndex : configuration index
+ *
+ * @retval    usb device status
+ */
+USBD_STA_T USBD_ClassInit(USBD_INFO_T* usbInfo, uint8_t cfgIndex)
+{
+    USBD_STA_T usbStatus = USBD_OK;
+    uint8_t classIndex;
+    uint8_t i;
+
+    for (i = 1; i < 16; i++)
+    {
+        usbInfo->devEpIn[i].classID = 0xFF;
+        usbInfo->devEpOut[i].classID = 0xFF;
+    }
+
+    for (classIndex = 0; classIndex < usbInfo->classNum; classIndex++)
+    {
+        usbInfo->classID = classIndex;
+
+        if (usbInfo->devClass[classIndex]->ClassInitHandler(usbInfo, cfgIndex) != USBD_OK)
+        {
+            usbStatus = USBD_FAIL;
+            break;
+        }
+
+        /* The endpoints opened by the class */
+        for (i = 1; i < 16; i++)
+        {
+            if ((usbInfo->devEpIn[i].useStatus == ENABLE) && (usbInfo->devEpIn[i].classID == 0xFF))
+            {
+                usbInfo->devEpIn[i].classID = classIndex;
+            }
+
+            if ((usbInfo->devEpOut[i].useStatus == ENABLE) && (usbInfo->devEpOut[i].classID == 0xFF))
+            {
+                usbInfo->devEpOut[i].classID = classIndex;
+            }
+        }
+    }
+
+    return usbStatus;
+}
+
+/*!
+ * @brief     USB device de-init all registered classes
+ *
+ * @param     usbInfo : usb handler information
+ *
+ * @param     cfgIndex : configuration index
+ *
+ * @retval    usb device status
+ */
+USBD_STA_T USBD_ClassDeInit(USBD_INFO_T* usbInfo, uint8_t cfgIndex)
+{
+    USBD_STA_T usbStatus = USBD_OK;
+    uint8_t classIndex;
+
+    for (classIndex = 0; classIndex < usbInfo->classNum; classIndex++)
+    {
+        if (usbInfo->devClass[classIndex]->ClassDeInitHandler != NULL)
+        {
+            usbInfo->classID = classIndex;
+
+            if (usbInfo->devClass[classIndex]->ClassDeInitHandler(usbInfo, cfgIndex) != USBD_OK)
+            {
+                usbStatus = USBD_FAIL;
+            }
+        }
+    }
+
+    return usbStatus;
+}
+
+/*!
+ * @brief     USB device read the class of an interface
+ *
+ * @param     usbInfo : usb handler information
+ *
+ * @param     itfNum : interface number
+ *
+ * @retval    class index, 0xFF if no class
+ */
+static uint8_t USBD_ReadItfClassIndex(USBD_INFO_T* usbInfo, uint8_t itfNum)
+{
+    uint8_t classIndex = 0xFF;
+    uint8_t i;
+
+    for (i = 0; i < usbInfo->classNum; i++)
+    {
+        if (usbInfo->devClassItf[i] <= itfNum)
+        {
+            if ((classIndex == 0xFF) || (usbInfo->devClassItf[i] >= usbInfo->devClassItf[classIndex]))
+            {
+                classIndex = i;
+            }
+        }
+    }
+
+    return classIndex;
+}
+
+/*!
+ * @brief     USB device read the class of an endpoint
+ *
+ * @param     usbInfo : usb handler information
+ *
+ * @param     epAddr : endpoint address
+ *
+ * @retval    class index, 0xFF if no class
+ */
+static uint8_t USBD_ReadEpClassIndex(USBD_INFO_T* usbInfo, uint8_t epAddr)
+{
+    if ((epAddr & 0x0F) == 0)
+    {
+        return usbInfo->classID;
+    }
+
+    if ((epAddr & 0x80) == 0x80)
+    {
+        return usbInfo->devEpIn[epAddr & 0x0F].classID;
+    }
+
+    return usbInfo->devEpOut[epAddr & 0x0F].classID;
+}
+
 /*!
  * @brief     USB device set speed
  *
@@ -221,6 +413,7 @@ USBD_STA_T USBD_SetupStage(USBD_INFO_T* usbInfo, uint8_t* setup)
 
                 case USBD_REQ_TYPE_CLASS:
                 case USBD_REQ_TYPE_VENDOR:
+                    usbInfo->classID = usbInfo->devReqClassID;
                     usbInfo->devClass[usbInfo->classID]->ClassSetup(usbInfo, &usbInfo->reqSetup);
                     break;
 
@@ -243,14 +436,24 @@ USBD_STA_T USBD_SetupStage(USBD_INFO_T* usbInfo, uint8_t* setup)
                         case USBD_DEV_CONFIGURE:
                             if(request == USBD_VEN_REQ_MS_CODE)
                             {
-                                usbInfo->devClass[usbInfo->classID]->ClassSetup(usbInfo, &usbInfo->reqSetup);
+                                /* The interface of the OS property request is in wValue */
+                                classIndex = USBD_ReadItfClassIndex(usbInfo, usbInfo->reqSetup.DATA_FIELD.wValue[0]);
+                                if (classIndex != 0xFF)
+                                {
+                                    usbInfo->classID = classIndex;
+                                    usbInfo->devClass[classIndex]->ClassSetup(usbInfo, &usbInfo->reqSetup);
+                                }
+                                else
+                                {
+                                    USBD_REQ_CtrlError(usbInfo, &usbInfo->reqSetup);
+                                }
                             }
                             else
                             {
                                 if (usbInfo->reqSetup.DATA_FIELD.wIndex[0] <= USBD_SUP_INTERFACE_MAX_NUM)
                                 {
                                     /* Add multi class support */
-                                    classIndex = 0;
+                                    classIndex = USBD_ReadItfClassIndex(usbInfo, usbInfo->reqSetup.DATA_FIELD.wIndex[0]);
                                     if ((classIndex != 0xFF) && (classIndex < USBD_SUP_CLASS_MAX_NUM))
                                     {
                                         usbInfo->classID = classIndex;
@@ -406,7 +609,7 @@ USBD_STA_T USBD_SetupStage(USBD_INFO_T* usbInfo, uint8_t* setup)
                                         USBD_CtrlSendStatus(usbInfo);
 
                                         /* Add multi class support */
-                                        classIndex = 0;
+                                        classIndex = USBD_ReadEpClassIndex(usbInfo, epAddr);
                                         if ((classIndex != 0xFF) && (classIndex < USBD_SUP_CLASS_MAX_NUM))
                                         {
                                             usbInfo->classID = classIndex;
@@ -468,7 +671,7 @@ USBD_STA_T USBD_SetupStage(USBD_INFO_T* usbInfo, uint8_t* setup)
                 case USBD_REQ_TYPE_CLASS:
                 case USBD_REQ_TYPE_VENDOR:
                     /* Add multi class support */
-                    classIndex = 0;
+                    classIndex = USBD_ReadEpClassIndex(usbInfo, epAddr);
                     if ((classIndex != 0xFF) && (classIndex < USBD_SUP_CLASS_MAX_NUM))
                     {
                         usbInfo->classID = classIndex;
@@ -514,7 +717,7 @@ USBD_STA_T USBD_DataOutStage(USBD_INFO_T* usbInfo, uint8_t epNum, uint8_t* buffe
     if (epNum != 0)
     {
         /* Add multi class support */
-        classIndex = 0;
+        classIndex = USBD_ReadEpClassIndex(usbInfo, epNum);
 
         if ((classIndex != 0xFF) && (classIndex < USBD_SUP_CLASS_MAX_NUM))
         {
@@ -522,7 +725,7 @@ USBD_STA_T USBD_DataOutStage(USBD_INFO_T* usbInfo, uint8_t epNum, uint8_t* buffe
             {
                 if (usbInfo->devClass[classIndex]->ClassDataOut != NULL)
                 {
-                    usbInfo->classNum = classIndex;
+                    usbInfo->classID = classIndex;
                     usbStatus = usbInfo->devClass[classIndex]->ClassDataOut(usbInfo, epNum);
 
                     if (usbStatus != USBD_OK)
@@ -550,26 +753,8 @@ USBD_STA_T USBD_DataOutStage(USBD_INFO_T* usbInfo, uint8_t epNum, uint8_t* buffe
                 }
                 else
                 {
-                    switch (usbInfo->reqSetup.DATA_FIELD.bmRequest.REQ_TYPE_B.recipient)
-                    {
-                        case USBD_RECIPIENT_DEVICE:
-                            classIndex = 0;
-                            break;
-
-                        case USBD_RECIPIENT_INTERFACE:
-                            /* Add multi class support */
-                            classIndex = 0;
-                            break;
-
-                        case USBD_RECIPIENT_ENDPOINT:
-                            /* Add multi class support */
-                            classIndex = 0;
-                            break;
-
-                        default:
-                            classIndex = 0;
-                            break;
-                    }
+                    /* Class of the SETUP stage */
+                    classIndex = usbInfo->classID;
 
                     if (classIndex < USBD_SUP_CLASS_MAX_NUM)
                     {
@@ -577,7 +762,6 @@ USBD_STA_T USBD_DataOutStage(USBD_INFO_T* usbInfo, uint8_t epNum, uint8_t* buffe
                         {
                             if (usbInfo->devClass[classIndex]->ClassRxEP0 != NULL)
                             {
-                                usbInfo->classNum = classIndex;
                                 usbInfo->devClass[classIndex]->ClassRxEP0(usbInfo);
                             }
                         }
@@ -616,7 +800,7 @@ USBD_STA_T USBD_DataInStage(USBD_INFO_T* usbInfo, uint8_t epNum, uint8_t* buffer
     if (epNum)
     {
         /* Add multi class support */
-        classIndex = 0;
+        classIndex = USBD_ReadEpClassIndex(usbInfo, epNum | 0x80);
         if ((classIndex != 0xFF) && (classIndex < USBD_SUP_CLASS_MAX_NUM))
         {
             if (usbInfo->devState == USBD_DEV_CONFIGURE)
@@ -664,14 +848,14 @@ USBD_STA_T USBD_DataInStage(USBD_INFO_T* usbInfo, uint8_t epNum, uint8_t* buffer
                 }
                 else
                 {
-                    classIndex = 0;
+                    /* Class of the SETUP stage */
+                    classIndex = usbInfo->classID;
 
                     if (usbInfo->devState == USBD_DEV_CONFIGURE)
                     {
-                        if (usbInfo->devClass[USBD_EP_0]->ClassTxEP0 != NULL)
+                        if (usbInfo->devClass[classIndex]->ClassTxEP0 != NULL)
                         {
-                            usbInfo->classID = classIndex;
-                            usbInfo->devClass[USBD_EP_0]->ClassTxEP0(usbInfo);
+                            usbInfo->devClass[classIndex]->ClassTxEP0(usbInfo);
                         }
                     }
                     USBD_EP_StallCallback(usbInfo, 0x80);
@@ -751,15 +935,9 @@ USBD_STA_T USBD_Reset(USBD_INFO_T* usbInfo)
     usbInfo->devState               = USBD_DEV_DEFAULT;
     usbInfo->devEp0State            = USBD_DEV_EP0_IDLE;
 
-    if ((usbInfo->devClass[0] != NULL) && \
-            (usbInfo->devClass[0]->ClassDeInitHandler != NULL))
+    if (USBD_ClassDeInit(usbInfo, usbInfo->devCfg) != USBD_OK)
     {
-        usbStatus = usbInfo->devClass[0]->ClassDeInitHandler(usbInfo, \
-                    usbInfo->devCfg);
-        if (usbStatus != USBD_OK)
-        {
-            usbStatus = USBD_FAIL;
-        }
+        usbStatus = USBD_FAIL;
     }
 
     /* Open EP0 OUT */
@@ -787,13 +965,17 @@ USBD_STA_T USBD_Reset(USBD_INFO_T* usbInfo)
 USBD_STA_T USBD_HandleSOF(USBD_INFO_T* usbInfo)
 {
     USBD_STA_T usbStatus = USBD_OK;
+    uint8_t classIndex;
 
     if (usbInfo->devState == USBD_DEV_CONFIGURE)
     {
-        if ((usbInfo->devClass[0] != NULL) && \
-                usbInfo->devClass[0]->ClassSofHandler != NULL)
+        for (classIndex = 0; classIndex < usbInfo->classNum; classIndex++)
         {
-            usbInfo->devClass[0]->ClassSofHandler(usbInfo);
+            if (usbInfo->devClass[classIndex]->ClassSofHandler != NULL)
+            {
+                usbInfo->classID = classIndex;
+                usbInfo->devClass[classIndex]->ClassSofHandler(usbInfo);
+            }
         }
     }
 
@@ -888,19 +1070,16 @@ USBD_STA_T USBD_Disconnect(USBD_INFO_T* usbInfo)
 
     usbInfo->devState = USBD_DEV_DEFAULT;
 
-    if (usbInfo->devClass[0] != NULL)
-    {
-        reqStatus = usbInfo->devClass[0]->ClassDeInitHandler(usbInfo, usbInfo->devCfg);
+    reqStatus = USBD_ClassDeInit(usbInfo, usbInfo->devCfg);
 
-        switch (reqStatus)
-        {
-            case USBD_OK:
-                break;
+    switch (reqStatus)
+    {
+        case USBD_OK:
+            break;
 
-            default:
-                usbStatus = USBD_FAIL;
-                break;
-        }
+        default:
+            usbStatus = USBD_FAIL;
+            break;
     }
 
     usbInfo->userCallback(usbInfo, USBD_USER_DISCONNECT);